@@ -0,0 +1,104 @@
+// Compares ranking clinics by distance through Clinic::getDistanceFrom (one
+// object at a time) against the structure-of-arrays batch kernels.
+//
+//   cmake -DBUILD_BENCHMARKS=ON .. && make geo_distance_benchmark
+//   ./geo_distance_benchmark [clinic_count] [iterations]
+
+#include "../include/models/Clinic.h"
+#include "../include/utils/GeoDistance.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace healthcare;
+
+namespace {
+
+template<typename Func>
+double measureNsPerClinic(Func&& func, size_t clinic_count, int iterations) {
+    func();  // Warm caches and the kernel dispatch
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / (static_cast<double>(clinic_count) * iterations);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t clinic_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    // Clinics scattered around a district, queried from its centre
+    const double query_latitude = 26.85;
+    const double query_longitude = 80.95;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> offset(-1.5, 1.5);
+
+    std::vector<std::unique_ptr<models::Clinic>> clinics;
+    utils::geo::CoordinateStore store;
+    store.reserve(clinic_count);
+
+    for (size_t i = 0; i < clinic_count; ++i) {
+        models::Address address{};
+        address.latitude = query_latitude + offset(rng);
+        address.longitude = query_longitude + offset(rng);
+
+        auto clinic = std::make_unique<models::Clinic>();
+        clinic->setAddress(address);
+        clinics.push_back(std::move(clinic));
+        store.add(address.latitude, address.longitude);
+    }
+
+    std::vector<double> per_object(clinic_count);
+    std::vector<double> scalar(clinic_count);
+    std::vector<double> vectorized(clinic_count);
+    volatile double sink = 0.0;
+
+    double per_object_ns = measureNsPerClinic([&]() {
+        for (size_t i = 0; i < clinic_count; ++i) {
+            per_object[i] = clinics[i]->getDistanceFrom(query_latitude, query_longitude);
+        }
+        sink = sink + per_object[clinic_count / 2];
+    }, clinic_count, iterations);
+
+    auto run_kernel = [&](utils::geo::DistanceKernel kernel, std::vector<double>& out) {
+        return measureNsPerClinic([&]() {
+            store.distancesFrom(kernel, query_latitude, query_longitude, out.data());
+            sink = sink + out[clinic_count / 2];
+        }, clinic_count, iterations);
+    };
+
+    double scalar_ns = run_kernel(utils::geo::DistanceKernel::SCALAR, scalar);
+    double avx2_ns = 0.0;
+    bool has_avx2 = utils::geo::isDistanceKernelSupported(utils::geo::DistanceKernel::AVX2);
+    if (has_avx2) {
+        avx2_ns = run_kernel(utils::geo::DistanceKernel::AVX2, vectorized);
+    }
+
+    const std::vector<double>& batch = has_avx2 ? vectorized : scalar;
+    double max_error_km = 0.0;
+    for (size_t i = 0; i < clinic_count; ++i) {
+        max_error_km = std::max(max_error_km, std::fabs(batch[i] - per_object[i]));
+    }
+
+    std::printf("clinics=%zu iterations=%d active_kernel=%s\n", clinic_count, iterations,
+                utils::geo::distanceKernelName(utils::geo::activeDistanceKernel()));
+    std::printf("%-24s %10.2f ns/clinic\n", "Clinic::getDistanceFrom", per_object_ns);
+    std::printf("%-24s %10.2f ns/clinic\n", "batch scalar", scalar_ns);
+    if (has_avx2) {
+        std::printf("%-24s %10.2f ns/clinic\n", "batch avx2", avx2_ns);
+    } else {
+        std::printf("%-24s %10s\n", "batch avx2", "unsupported");
+    }
+    std::printf("max |batch - per-object| = %.3g km\n", max_error_km);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Compares serializing model lists through toJson() into an nlohmann::json DOM
+// and dump() against streaming the same lists with JsonWriter. Doctor and
+// Clinic are the lists the streamed endpoints return; byte-for-byte equality
+// of every model's writeJson() is covered by tests/utils/JsonWriterTest.cpp.
+//
+//   cmake -DBUILD_BENCHMARKS=ON .. && make json_writer_benchmark
+//   ./json_writer_benchmark [items_per_list] [iterations]
+
+#include "../include/models/Clinic.h"
+#include "../include/models/Doctor.h"
+#include "../include/utils/JsonWriter.h"
+#include "../include/utils/Uuid.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace healthcare;
+
+namespace {
+
+// Free text with the characters that need escaping or are multi-byte
+const std::vector<std::string> kSampleText = {
+    "Fever and cough for 3 days",
+    "Patient says \"sharp\" pain\nnear the left knee",
+    "Tab\tseparated\\notes",
+    "Follow-up in 2 weeks \xe2\x80\x94 bring reports",
+    "\xe0\xa4\xb8\xe0\xa4\xbf\xe0\xa4\xb0\xe0\xa4\xa6\xe0\xa4\xb0\xe0\xa5\x8d\xe0\xa4\xa6",
+    "",
+};
+
+const std::vector<double> kSampleAmounts = {0.0, 299.0, 499.5, 1250.75, 0.1, 1e7};
+
+struct Sampler {
+    std::mt19937 rng{42};
+
+    std::string id() { return utils::Uuid::generate().toString(); }
+    const std::string& text() { return kSampleText[rng() % kSampleText.size()]; }
+    double amount() { return kSampleAmounts[rng() % kSampleAmounts.size()]; }
+    std::int64_t time() { return 1700000000 + static_cast<std::int64_t>(rng() % 10000000); }
+    bool flag() { return rng() % 2 == 0; }
+};
+
+nlohmann::json doctorJson(Sampler& s) {
+    return {
+        {"id", s.id()}, {"created_at", s.time()}, {"updated_at", s.time()}, {"is_deleted", false},
+        {"user_id", s.id()}, {"medical_license_number", "UP-12345"}, {"qualification", "MBBS, MD"},
+        {"years_of_experience", static_cast<int>(s.rng() % 40)}, {"status", "VERIFIED"},
+        {"consultation_fee", s.amount()}, {"consultation_duration_minutes", 15},
+        {"consultation_types", {"ONLINE", "OFFLINE"}}, {"rating", 4.3}, {"total_reviews", 128},
+        {"availability_pattern", "{\"MONDAY\":[\"09:00-13:00\"]}"}, {"is_available_today", s.flag()},
+        {"bio", s.text()}, {"languages", "hi,en"},
+        {"specializations", {{{"id", "cardio"}, {"name", "Cardiology"}, {"description", s.text()}, {"category", "MEDICAL"}}}},
+        {"clinic_ids", {s.id(), s.id()}},
+        {"documents", {{{"id", s.id()}, {"type", "medical_license"}, {"url", "https://cdn.example.com/l.pdf"},
+                        {"is_verified", true}, {"uploaded_at", s.time()}, {"verified_at", s.time()}}}}
+    };
+}
+
+nlohmann::json clinicJson(Sampler& s) {
+    return {
+        {"id", s.id()}, {"created_at", s.time()}, {"updated_at", s.time()}, {"is_deleted", false},
+        {"name", "Sanjeevani Clinic"}, {"description", s.text()}, {"registration_number", "REG-778"},
+        {"status", "ACTIVE"},
+        {"contact_info", {{"phone_primary", "+915222345678"}, {"phone_secondary", ""},
+                          {"email", "desk@example.com"}, {"website", ""}}},
+        {"address", {{"street_address", s.text()}, {"landmark", "Near bus stand"}, {"city", "Lucknow"},
+                     {"state", "Uttar Pradesh"}, {"pincode", "226001"}, {"country", "India"},
+                     {"latitude", 26.8467}, {"longitude", 80.9462}}},
+        {"timezone", "Asia/Kolkata"},
+        {"working_hours", {{{"day_of_week", "MONDAY"}, {"start_time", "09:00"}, {"end_time", "18:00"},
+                            {"is_closed", false}, {"break_start", "13:00"}, {"break_end", "14:00"}}}},
+        {"facilities", {{{"name", "Pharmacy"}, {"description", s.text()}, {"is_available", true}}}},
+        {"services", {"General medicine", "Pathology"}}, {"logo_url", ""}, {"image_urls", nlohmann::json::array()},
+        {"rating", 4.1}, {"total_reviews", 57}, {"owner_id", s.id()}, {"doctor_ids", {s.id()}},
+        {"has_emergency_services", s.flag()}, {"emergency_contact", "108"}
+    };
+}
+
+template<typename Model>
+std::vector<Model> makeModels(size_t count, nlohmann::json (*make_json)(Sampler&), Sampler& sampler) {
+    std::vector<Model> models(count);
+    for (auto& model : models) {
+        model.fromJson(make_json(sampler));
+    }
+    return models;
+}
+
+struct Result {
+    double dom_ns = 0.0;
+    double stream_ns = 0.0;
+    size_t bytes = 0;
+};
+
+template<typename Model>
+Result compare(const std::vector<Model>& models, int iterations) {
+    auto dom_dump = [&]() {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& model : models) {
+            list.push_back(model.toJson());
+        }
+        return list.dump();
+    };
+
+    std::string buffer;
+    auto stream = [&]() -> const std::string& {
+        buffer.clear();
+        utils::JsonWriter writer(buffer);
+        writer.beginArray();
+        for (const auto& model : models) {
+            model.writeJson(writer);
+        }
+        writer.endArray();
+        return buffer;
+    };
+
+    Result result;
+    result.bytes = stream().size();
+
+    auto measure = [&](auto&& func) {
+        volatile size_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink = sink + func().size();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<double>(elapsed.count()) / (static_cast<double>(models.size()) * iterations);
+    };
+    result.dom_ns = measure(dom_dump);
+    result.stream_ns = measure(stream);
+    return result;
+}
+
+void report(const char* name, const Result& result) {
+    std::printf("%-12s %10.1f %12.1f %8.1fx %10zu\n", name, result.dom_ns, result.stream_ns,
+                result.dom_ns / result.stream_ns, result.bytes);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t item_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    Sampler sampler;
+    auto doctors = makeModels<models::Doctor>(item_count, doctorJson, sampler);
+    auto clinics = makeModels<models::Clinic>(item_count, clinicJson, sampler);
+
+    std::printf("items_per_list=%zu iterations=%d\n", item_count, iterations);
+    std::printf("%-12s %10s %12s %9s %10s\n", "model", "dom ns/item", "stream ns/item", "speedup", "bytes");
+
+    report("Doctor", compare(doctors, iterations));
+    report("Clinic", compare(clinics, iterations));
+    return 0;
+}
\ No newline at end of file
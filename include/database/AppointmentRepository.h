@@ -2,9 +2,16 @@
 
 #include "BaseRepository.h"
 #include "../models/Appointment.h"
+#include <optional>
 
 namespace healthcare::database {
 
+struct SlotRange {
+    std::string doctor_id;
+    std::chrono::system_clock::time_point start_time;
+    std::chrono::system_clock::time_point end_time;
+};
+
 class AppointmentRepository : public BaseRepository<models::Appointment> {
 public:
     AppointmentRepository() : BaseRepository("appointments") {}
@@ -24,6 +31,11 @@ public:
                            const std::chrono::system_clock::time_point& start_time,
                            const std::chrono::system_clock::time_point& end_time);
     
+    // Set-based conflict check for batch booking. Takes a transaction-scoped advisory lock
+    // per doctor, then returns the indices of slots overlapping an active appointment.
+    std::vector<size_t> findConflictingSlots(const std::vector<SlotRange>& slots,
+                                             DatabaseManager::Transaction& transaction);
+    
     // Statistics
     int countByDoctor(const std::string& doctor_id);
     int countByClinic(const std::string& clinic_id);
@@ -36,6 +48,15 @@ protected:
     std::vector<std::string> getUpdateValues(const models::Appointment& entity) const override;
     std::vector<std::string> getColumnNames() const override;
     std::vector<std::string> getSearchableColumns() const override;
+
+private:
+    // Runs a select over live rows; operation labels the latency histogram, so pass a literal
+    QueryResult<models::Appointment> findWhere(std::string_view operation, const std::string& where_clause,
+                                               const std::vector<std::string>& params,
+                                               const std::string& order_clause = "start_time ASC");
+    // Empty when the query fails, so callers can tell "none" from "unknown"
+    std::optional<int> countWhere(std::string_view operation, const std::string& where_clause,
+                                  const std::vector<std::string>& params);
 };
 
 } // namespace healthcare::database
\ No newline at end of file
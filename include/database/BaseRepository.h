@@ -3,9 +3,14 @@
 #include "DatabaseManager.h"
 #include "../models/BaseEntity.h"
 #include "../utils/Logger.h"
+#include "../utils/Metrics.h"
+#include "../utils/Tracing.h"
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <chrono>
 #include <optional>
 #include <pqxx/pqxx>
@@ -61,6 +66,7 @@ struct FilterParams {
     
     std::string buildWhereClause() const;
     std::vector<std::string> getParameterValues() const;
+    static std::string escapeLikePattern(const std::string& term);
 };
 
 template<typename T>
@@ -109,6 +115,8 @@ public:
     virtual QueryResult<T> createInTransaction(const T& entity, DatabaseManager::Transaction& transaction);
     virtual QueryResult<T> updateInTransaction(const T& entity, DatabaseManager::Transaction& transaction);
     virtual bool deleteInTransaction(const std::string& id, DatabaseManager::Transaction& transaction);
+    virtual QueryResult<T> createBatchInTransaction(const std::vector<T>& entities,
+                                                    DatabaseManager::Transaction& transaction);
     
     // Cache operations
     virtual void cacheEntity(const T& entity, int ttl_seconds = 3600);
@@ -136,11 +144,22 @@ public:
     
     RepositoryStats getStats() const { return stats_; }
     void resetStats() { stats_ = RepositoryStats{}; }
+    
+    // Observers for committed writes, shared by every repository of this entity type.
+    // Register at startup before requests are served. Writes made through a
+    // caller's transaction are not reported; the caller calls notifyChanged after commit.
+    using ChangeListener = std::function<void(const T&)>;
+    using RemoveListener = std::function<void(const std::string&)>;
+    static void addChangeListener(ChangeListener listener) { changeListeners().push_back(std::move(listener)); }
+    static void addRemoveListener(RemoveListener listener) { removeListeners().push_back(std::move(listener)); }
+    static void notifyChanged(const T& entity);
+    static void notifyRemoved(const std::string& id);
 
 protected:
     std::string table_name_;
     DatabaseManager& db_manager_;
     mutable RepositoryStats stats_;
+    mutable std::mutex stats_mutex_;
     
     // Pure virtual methods that must be implemented by derived classes
     virtual T mapRowToEntity(const pqxx::row& row) const = 0;
@@ -156,10 +175,12 @@ protected:
                                 const std::string& limit_clause = "") const;
     
     std::string buildInsertQuery(const std::vector<std::string>& columns) const;
+    std::string buildMultiRowInsertQuery(const std::vector<std::string>& columns, size_t row_count) const;
     std::string buildUpdateQuery(const std::vector<std::string>& columns, 
                                 const std::string& where_clause) const;
     std::string buildDeleteQuery(const std::string& where_clause) const;
     std::string buildCountQuery(const std::string& where_clause = "") const;
+    static std::string whereKeyword(const std::string& where_clause);
     
     std::string escapeIdentifier(const std::string& identifier) const;
     std::string buildPlaceholders(int count, int start_index = 1) const;
@@ -169,6 +190,15 @@ protected:
     void logError(const std::string& operation, const std::string& error) const;
     void updateStats(bool success, double duration_ms) const;
     
+    static std::vector<ChangeListener>& changeListeners() {
+        static std::vector<ChangeListener> listeners;
+        return listeners;
+    }
+    static std::vector<RemoveListener>& removeListeners() {
+        static std::vector<RemoveListener> listeners;
+        return listeners;
+    }
+    
     // Cache key generation
     std::string generateCacheKey(const std::string& id) const;
     std::string generateListCacheKey(const std::string& suffix = "") const;
@@ -177,17 +207,22 @@ protected:
     bool validateEntity(const T& entity) const;
     bool validateId(const std::string& id) const;
     
-    // Query execution with error handling and timing
+    // Query execution with error handling and timing. query_name labels the
+    // latency histogram (db_query_duration_seconds{table, query}); pass a literal
     template<typename Func>
-    auto executeWithTiming(Func&& func) const -> decltype(func()) {
+    auto executeWithTiming(std::string_view query_name, Func&& func) const -> decltype(func()) {
         auto start = std::chrono::high_resolution_clock::now();
         bool success = false;
+        auto& latency = queryLatencyFamily().series(table_name_, query_name);
+        utils::TraceSpan span("db.query", utils::SpanKind::INTERNAL, "db.table", table_name_);
+        span.setAttribute("db.operation", query_name);
         
         try {
             auto result = func();
             success = true;
             
             auto end = std::chrono::high_resolution_clock::now();
+            latency.record(end - start);
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
             double duration_ms = duration.count() / 1000.0;
             
@@ -196,6 +231,8 @@ protected:
             
         } catch (const std::exception& e) {
             auto end = std::chrono::high_resolution_clock::now();
+            latency.record(end - start);
+            span.setError();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
             double duration_ms = duration.count() / 1000.0;
             
@@ -205,6 +242,17 @@ protected:
         }
     }
     
+    // Runs a parameterized statement on a caller-held transaction and reports it to
+    // DatabaseManager::logQuery, which pooled statements already go through
+    pqxx::result execParams(pqxx::work& work, const std::string& query,
+                            const std::vector<std::string>& params) const;
+    
+    static utils::LatencyFamily& queryLatencyFamily() {
+        static utils::LatencyFamily& family = utils::MetricsRegistry::getInstance().latencyFamily(
+            "db_query_duration_seconds", "Repository query latency", {"table", "query"});
+        return family;
+    }
+    
     // Batch processing helpers
     std::vector<std::vector<T>> chunkEntities(const std::vector<T>& entities, int chunk_size = 100) const;
     QueryResult<T> processBatchInChunks(const std::vector<T>& entities, 
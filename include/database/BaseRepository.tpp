@@ -9,7 +9,7 @@ template<typename T>
 QueryResult<T> BaseRepository<T>::create(const T& entity) {
     REPO_VALIDATE_ENTITY(entity)
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("create", [&]() {
         try {
             auto columns = getColumnNames();
             auto values = getInsertValues(entity);
@@ -27,6 +27,7 @@ QueryResult<T> BaseRepository<T>::create(const T& entity) {
             
             // Cache the created entity
             cacheEntity(created_entity);
+            notifyChanged(created_entity);
             
             return QueryResult<T>({created_entity});
             
@@ -50,7 +51,7 @@ QueryResult<T> BaseRepository<T>::findById(const std::string& id) {
     
     stats_.cache_misses++;
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("findById", [&]() {
         try {
             std::string query = buildSelectQuery(getIdColumn() + " = $1");
             auto result = db_manager_.executeQuery(query, {id});
@@ -77,7 +78,7 @@ template<typename T>
 QueryResult<T> BaseRepository<T>::update(const T& entity) {
     REPO_VALIDATE_ENTITY(entity)
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("update", [&]() {
         try {
             auto columns = getColumnNames();
             auto values = getUpdateValues(entity);
@@ -98,6 +99,7 @@ QueryResult<T> BaseRepository<T>::update(const T& entity) {
             
             // Update cache
             cacheEntity(updated_entity);
+            notifyChanged(updated_entity);
             
             return QueryResult<T>({updated_entity});
             
@@ -110,15 +112,18 @@ QueryResult<T> BaseRepository<T>::update(const T& entity) {
 
 template<typename T>
 bool BaseRepository<T>::deleteById(const std::string& id) {
-    REPO_VALIDATE_ID(id)
+    if (!validateId(id)) {
+        return false;
+    }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("deleteById", [&]() {
         try {
             std::string query = buildDeleteQuery(getIdColumn() + " = $1");
             db_manager_.executeQuery(query, {id});
             
             // Remove from cache
             removeCachedEntity(id);
+            notifyRemoved(id);
             
             return true;
             
@@ -131,9 +136,11 @@ bool BaseRepository<T>::deleteById(const std::string& id) {
 
 template<typename T>
 bool BaseRepository<T>::softDeleteById(const std::string& id) {
-    REPO_VALIDATE_ID(id)
+    if (!validateId(id)) {
+        return false;
+    }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("softDeleteById", [&]() {
         try {
             std::string query = "UPDATE " + table_name_ + 
                               " SET is_deleted = true, updated_at = CURRENT_TIMESTAMP" +
@@ -143,6 +150,7 @@ bool BaseRepository<T>::softDeleteById(const std::string& id) {
             
             // Remove from cache
             removeCachedEntity(id);
+            notifyRemoved(id);
             
             return true;
             
@@ -159,7 +167,7 @@ QueryResult<T> BaseRepository<T>::createBatch(const std::vector<T>& entities) {
         return QueryResult<T>({});
     }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("createBatch", [&]() {
         try {
             auto transaction = db_manager_.beginTransaction();
             std::vector<T> created_entities;
@@ -174,7 +182,7 @@ QueryResult<T> BaseRepository<T>::createBatch(const std::vector<T>& entities) {
                 auto values = getInsertValues(entity);
                 
                 std::string query = buildInsertQuery(columns) + " RETURNING *";
-                auto result = transaction->getWork().exec_params(query, values);
+                auto result = execParams(transaction->getWork(), query, values);
                 
                 if (!result.empty()) {
                     T created_entity = mapRowToEntity(result[0]);
@@ -184,6 +192,9 @@ QueryResult<T> BaseRepository<T>::createBatch(const std::vector<T>& entities) {
             }
             
             transaction->commit();
+            for (const auto& created_entity : created_entities) {
+                notifyChanged(created_entity);
+            }
             return QueryResult<T>(created_entities);
             
         } catch (const std::exception& e) {
@@ -199,7 +210,7 @@ QueryResult<T> BaseRepository<T>::updateBatch(const std::vector<T>& entities) {
         return QueryResult<T>({});
     }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("updateBatch", [&]() {
         try {
             auto transaction = db_manager_.beginTransaction();
             std::vector<T> updated_entities;
@@ -218,7 +229,7 @@ QueryResult<T> BaseRepository<T>::updateBatch(const std::vector<T>& entities) {
                 
                 values.push_back(entity.getId());
                 
-                auto result = transaction->getWork().exec_params(query, values);
+                auto result = execParams(transaction->getWork(), query, values);
                 
                 if (!result.empty()) {
                     T updated_entity = mapRowToEntity(result[0]);
@@ -228,6 +239,9 @@ QueryResult<T> BaseRepository<T>::updateBatch(const std::vector<T>& entities) {
             }
             
             transaction->commit();
+            for (const auto& updated_entity : updated_entities) {
+                notifyChanged(updated_entity);
+            }
             return QueryResult<T>(updated_entities);
             
         } catch (const std::exception& e) {
@@ -243,7 +257,7 @@ bool BaseRepository<T>::deleteBatch(const std::vector<std::string>& ids) {
         return true;
     }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("deleteBatch", [&]() {
         try {
             std::ostringstream placeholders;
             for (size_t i = 0; i < ids.size(); ++i) {
@@ -257,6 +271,7 @@ bool BaseRepository<T>::deleteBatch(const std::vector<std::string>& ids) {
             // Remove from cache
             for (const auto& id : ids) {
                 removeCachedEntity(id);
+                notifyRemoved(id);
             }
             
             return true;
@@ -270,7 +285,7 @@ bool BaseRepository<T>::deleteBatch(const std::vector<std::string>& ids) {
 
 template<typename T>
 QueryResult<T> BaseRepository<T>::findAll(const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findAll", [&]() {
         try {
             std::string query = buildSelectQuery("", 
                                                pagination.getOrderClause(), 
@@ -288,7 +303,7 @@ QueryResult<T> BaseRepository<T>::findAll(const PaginationParams& pagination) {
             // Get total count
             auto count_result = db_manager_.executeQuery(buildCountQuery());
             if (!count_result.empty()) {
-                query_result.total_count = count_result[0][0].as<int>();
+                query_result.total_count = count_result[0][0].template as<int>();
             }
             
             return query_result;
@@ -303,7 +318,7 @@ QueryResult<T> BaseRepository<T>::findAll(const PaginationParams& pagination) {
 template<typename T>
 QueryResult<T> BaseRepository<T>::findByFilter(const FilterParams& filters, 
                                               const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByFilter", [&]() {
         try {
             std::string where_clause = filters.buildWhereClause();
             std::string query = buildSelectQuery(where_clause,
@@ -323,7 +338,7 @@ QueryResult<T> BaseRepository<T>::findByFilter(const FilterParams& filters,
             // Get total count with filters
             auto count_result = db_manager_.executeQuery(buildCountQuery(where_clause), params);
             if (!count_result.empty()) {
-                query_result.total_count = count_result[0][0].as<int>();
+                query_result.total_count = count_result[0][0].template as<int>();
             }
             
             return query_result;
@@ -338,7 +353,7 @@ QueryResult<T> BaseRepository<T>::findByFilter(const FilterParams& filters,
 template<typename T>
 QueryResult<T> BaseRepository<T>::findByQuery(const std::string& custom_query, 
                                              const std::vector<std::string>& params) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByQuery", [&]() {
         try {
             auto result = db_manager_.executeQuery(custom_query, params);
             
@@ -358,10 +373,10 @@ QueryResult<T> BaseRepository<T>::findByQuery(const std::string& custom_query,
 
 template<typename T>
 int BaseRepository<T>::countAll() {
-    return executeWithTiming([&]() {
+    return executeWithTiming("countAll", [&]() {
         try {
             auto result = db_manager_.executeQuery(buildCountQuery());
-            return result.empty() ? 0 : result[0][0].as<int>();
+            return result.empty() ? 0 : result[0][0].template as<int>();
         } catch (const std::exception& e) {
             logError("countAll", e.what());
             return 0;
@@ -371,13 +386,13 @@ int BaseRepository<T>::countAll() {
 
 template<typename T>
 int BaseRepository<T>::countByFilter(const FilterParams& filters) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("countByFilter", [&]() {
         try {
             std::string where_clause = filters.buildWhereClause();
             auto params = filters.getParameterValues();
             
             auto result = db_manager_.executeQuery(buildCountQuery(where_clause), params);
-            return result.empty() ? 0 : result[0][0].as<int>();
+            return result.empty() ? 0 : result[0][0].template as<int>();
         } catch (const std::exception& e) {
             logError("countByFilter", e.what());
             return 0;
@@ -388,10 +403,10 @@ int BaseRepository<T>::countByFilter(const FilterParams& filters) {
 template<typename T>
 int BaseRepository<T>::countByQuery(const std::string& custom_query, 
                                    const std::vector<std::string>& params) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("countByQuery", [&]() {
         try {
             auto result = db_manager_.executeQuery(custom_query, params);
-            return result.empty() ? 0 : result[0][0].as<int>();
+            return result.empty() ? 0 : result[0][0].template as<int>();
         } catch (const std::exception& e) {
             logError("countByQuery", e.what());
             return 0;
@@ -401,14 +416,16 @@ int BaseRepository<T>::countByQuery(const std::string& custom_query,
 
 template<typename T>
 bool BaseRepository<T>::exists(const std::string& id) {
-    REPO_VALIDATE_ID(id)
+    if (!validateId(id)) {
+        return false;
+    }
     
     // Check cache first
-    if (existsCache(generateCacheKey(id))) {
+    if (db_manager_.existsCache(generateCacheKey(id))) {
         return true;
     }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("exists", [&]() {
         try {
             std::string query = "SELECT EXISTS(SELECT 1 FROM " + table_name_ + 
                               " WHERE " + getIdColumn() + " = $1 AND is_deleted = false)";
@@ -424,7 +441,7 @@ bool BaseRepository<T>::exists(const std::string& id) {
 
 template<typename T>
 bool BaseRepository<T>::existsByFilter(const FilterParams& filters) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("existsByFilter", [&]() {
         try {
             std::string where_clause = filters.buildWhereClause();
             if (!where_clause.empty()) {
@@ -455,7 +472,7 @@ QueryResult<T> BaseRepository<T>::search(const std::string& search_term,
         return QueryResult<T>({});
     }
     
-    return executeWithTiming([&]() {
+    return executeWithTiming("search", [&]() {
         try {
             FilterParams filters;
             filters.search_term = search_term;
@@ -481,7 +498,7 @@ QueryResult<T> BaseRepository<T>::createInTransaction(const T& entity,
         
         std::string query = buildInsertQuery(columns) + " RETURNING *";
         
-        auto result = transaction.getWork().exec_params(query, values);
+        auto result = execParams(transaction.getWork(), query, values);
         
         if (result.empty()) {
             return QueryResult<T>("Failed to create entity in transaction");
@@ -496,6 +513,44 @@ QueryResult<T> BaseRepository<T>::createInTransaction(const T& entity,
     }
 }
 
+template<typename T>
+QueryResult<T> BaseRepository<T>::createBatchInTransaction(const std::vector<T>& entities,
+                                                          DatabaseManager::Transaction& transaction) {
+    if (entities.empty()) {
+        return QueryResult<T>(std::vector<T>{});
+    }
+    
+    try {
+        auto columns = getColumnNames();
+        std::vector<std::string> values;
+        values.reserve(columns.size() * entities.size());
+        
+        for (const auto& entity : entities) {
+            if (!validateEntity(entity)) {
+                return QueryResult<T>("Invalid entity in batch");
+            }
+            auto entity_values = getInsertValues(entity);
+            values.insert(values.end(), entity_values.begin(), entity_values.end());
+        }
+        
+        // One multi-row INSERT. RETURNING rows are not guaranteed to follow VALUES order;
+        // callers that need the pairing match rows back on their own keys
+        std::string query = buildMultiRowInsertQuery(columns, entities.size()) + " RETURNING *";
+        auto result = execParams(transaction.getWork(), query, values);
+        
+        std::vector<T> created_entities;
+        created_entities.reserve(result.size());
+        for (const auto& row : result) {
+            created_entities.push_back(mapRowToEntity(row));
+        }
+        return QueryResult<T>(created_entities);
+        
+    } catch (const std::exception& e) {
+        logError("createBatchInTransaction", e.what());
+        return QueryResult<T>(std::string("Batch create in transaction failed: ") + e.what());
+    }
+}
+
 template<typename T>
 QueryResult<T> BaseRepository<T>::updateInTransaction(const T& entity, 
                                                      DatabaseManager::Transaction& transaction) {
@@ -510,7 +565,7 @@ QueryResult<T> BaseRepository<T>::updateInTransaction(const T& entity,
         
         values.push_back(entity.getId());
         
-        auto result = transaction.getWork().exec_params(query, values);
+        auto result = execParams(transaction.getWork(), query, values);
         
         if (result.empty()) {
             return QueryResult<T>("Failed to update entity in transaction");
@@ -528,11 +583,13 @@ QueryResult<T> BaseRepository<T>::updateInTransaction(const T& entity,
 template<typename T>
 bool BaseRepository<T>::deleteInTransaction(const std::string& id, 
                                            DatabaseManager::Transaction& transaction) {
-    REPO_VALIDATE_ID(id)
+    if (!validateId(id)) {
+        return false;
+    }
     
     try {
         std::string query = buildDeleteQuery(getIdColumn() + " = $1");
-        transaction.getWork().exec_params(query, {id});
+        execParams(transaction.getWork(), query, {id});
         return true;
     } catch (const std::exception& e) {
         logError("deleteInTransaction", e.what());
@@ -610,16 +667,22 @@ std::string BaseRepository<T>::getDeleteQuery() const {
     return buildDeleteQuery(getIdColumn() + " = $1");
 }
 
+// FilterParams::buildWhereClause already carries the keyword; bare conditions get it added
+template<typename T>
+std::string BaseRepository<T>::whereKeyword(const std::string& where_clause) {
+    size_t first = where_clause.find_first_not_of(' ');
+    if (first == std::string::npos) {
+        return "";
+    }
+    return where_clause.compare(first, 6, "WHERE ") == 0 ? " " : " WHERE ";
+}
+
 template<typename T>
 std::string BaseRepository<T>::buildSelectQuery(const std::string& where_clause,
                                                const std::string& order_clause,
                                                const std::string& limit_clause) const {
     std::ostringstream query;
-    query << "SELECT * FROM " << table_name_;
-    
-    if (!where_clause.empty()) {
-        query << " " << where_clause;
-    }
+    query << "SELECT * FROM " << table_name_ << whereKeyword(where_clause) << where_clause;
     
     if (!order_clause.empty()) {
         query << " " << order_clause;
@@ -649,6 +712,26 @@ std::string BaseRepository<T>::buildInsertQuery(const std::vector<std::string>&
     return query.str();
 }
 
+template<typename T>
+std::string BaseRepository<T>::buildMultiRowInsertQuery(const std::vector<std::string>& columns,
+                                                        size_t row_count) const {
+    std::ostringstream query;
+    query << "INSERT INTO " << table_name_ << " (";
+    
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (i > 0) query << ", ";
+        query << escapeIdentifier(columns[i]);
+    }
+    
+    query << ") VALUES ";
+    for (size_t row = 0; row < row_count; ++row) {
+        if (row > 0) query << ", ";
+        query << "(" << buildPlaceholders(columns.size(), static_cast<int>(row * columns.size()) + 1) << ")";
+    }
+    
+    return query.str();
+}
+
 template<typename T>
 std::string BaseRepository<T>::buildUpdateQuery(const std::vector<std::string>& columns,
                                                const std::string& where_clause) const {
@@ -682,11 +765,7 @@ std::string BaseRepository<T>::buildDeleteQuery(const std::string& where_clause)
 template<typename T>
 std::string BaseRepository<T>::buildCountQuery(const std::string& where_clause) const {
     std::ostringstream query;
-    query << "SELECT COUNT(*) FROM " << table_name_;
-    
-    if (!where_clause.empty()) {
-        query << " " << where_clause;
-    }
+    query << "SELECT COUNT(*) FROM " << table_name_ << whereKeyword(where_clause) << where_clause;
     
     return query.str();
 }
@@ -713,6 +792,27 @@ void BaseRepository<T>::logQuery(const std::string& query, double duration_ms, b
               table_name_, query.substr(0, 100), duration_ms, success ? "SUCCESS" : "FAILED");
 }
 
+template<typename T>
+pqxx::result BaseRepository<T>::execParams(pqxx::work& work, const std::string& query,
+                                          const std::vector<std::string>& params) const {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    try {
+        auto result = work.exec_params(query, params);
+        
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        db_manager_.logQuery(query, duration.count() / 1000.0, true);
+        return result;
+        
+    } catch (const std::exception&) {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+        db_manager_.logQuery(query, duration.count() / 1000.0, false);
+        throw;
+    }
+}
+
 template<typename T>
 void BaseRepository<T>::logError(const std::string& operation, const std::string& error) const {
     LOG_ERROR("Repository[{}] Operation '{}' failed: {}", table_name_, operation, error);
@@ -736,6 +836,28 @@ void BaseRepository<T>::updateStats(bool success, double duration_ms) const {
     stats_.last_query_time = std::chrono::system_clock::now();
 }
 
+template<typename T>
+void BaseRepository<T>::notifyChanged(const T& entity) {
+    for (const auto& listener : changeListeners()) {
+        try {
+            listener(entity);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Change listener for {} failed: {}", entity.getId(), e.what());
+        }
+    }
+}
+
+template<typename T>
+void BaseRepository<T>::notifyRemoved(const std::string& id) {
+    for (const auto& listener : removeListeners()) {
+        try {
+            listener(id);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Remove listener for {} failed: {}", id, e.what());
+        }
+    }
+}
+
 template<typename T>
 std::string BaseRepository<T>::generateCacheKey(const std::string& id) const {
     return "entity:" + table_name_ + ":" + id;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <queue>
@@ -174,7 +175,7 @@ public:
     bool optimizeDatabase();
     
     // Event logging
-    void logQuery(const std::string& query, double duration_ms, bool success = true);
+    void logQuery(std::string_view query, double duration_ms, bool success = true);
     void logConnection(bool success = true);
     void logError(const std::string& operation, const std::string& error);
 
@@ -11,6 +11,7 @@ public:
     ~DoctorRepository() = default;
     
     // Custom queries
+    QueryResult<models::Doctor> findByIds(const std::vector<std::string>& doctor_ids);  // One round trip, any order
     QueryResult<models::Doctor> findByUserId(const std::string& user_id);
     QueryResult<models::Doctor> findBySpecialization(const std::string& specialization);
     QueryResult<models::Doctor> findByClinic(const std::string& clinic_id);
@@ -38,6 +39,14 @@ protected:
     std::vector<std::string> getUpdateValues(const models::Doctor& entity) const override;
     std::vector<std::string> getColumnNames() const override;
     std::vector<std::string> getSearchableColumns() const override;
+
+private:
+    // Runs a select over live rows; operation labels the latency histogram, so pass a literal
+    QueryResult<models::Doctor> findWhere(std::string_view operation, const std::string& where_clause,
+                                          const std::vector<std::string>& params,
+                                          const std::string& order_clause = "rating DESC");
+    int countWhere(std::string_view operation, const std::string& where_clause,
+                   const std::vector<std::string>& params);
 };
 
 } // namespace healthcare::database
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <pqxx/pqxx>
+#include <nlohmann/json.hpp>
+#include "../utils/Metrics.h"
+
+namespace healthcare::database {
+
+struct SlowQueryConfig {
+    bool enabled = true;
+    double threshold_ms = 100.0;        // A fingerprint's first query at least this slow gets EXPLAINed
+    size_t max_fingerprints = 512;      // Later fingerprints are folded into one "(other)" entry
+    bool explain = true;
+    int explain_timeout_ms = 5000;      // statement_timeout on the side connection
+    size_t max_pending_explains = 32;   // Further requests are skipped, not queued
+    size_t max_sql_length = 4096;       // Longer statements are fingerprinted but not EXPLAINed
+};
+
+enum class ExplainState {
+    NONE,       // Never crossed the threshold
+    PENDING,
+    CAPTURED,
+    FAILED,
+    SKIPPED     // Not explainable (EXECUTE, DDL, $n parameters, too long) or the queue was full
+};
+
+struct SlowQueryEntry {
+    std::string fingerprint;
+    std::uint64_t count = 0;
+    std::uint64_t slow_count = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+    std::uint64_t p50_us = 0;
+    std::uint64_t p99_us = 0;
+    ExplainState explain_state = ExplainState::NONE;
+    std::string plan;  // EXPLAIN (FORMAT JSON) output with condition literals masked, or the error when FAILED
+    std::chrono::system_clock::time_point first_slow_at;
+};
+
+struct SlowQueryStats {
+    long long recorded = 0;
+    long long slow = 0;
+    long long fingerprints = 0;
+    long long explains_run = 0;
+    long long explains_failed = 0;
+    long long explains_skipped = 0;
+};
+
+enum class SlowQuerySort {
+    TOTAL_TIME,
+    MAX_TIME,
+    P99,
+    COUNT
+};
+
+// Aggregates every executed statement by fingerprint: the SQL with literals
+// replaced by ?, comments dropped, whitespace collapsed and keywords lower
+// cased, so "WHERE id = 'a1'" and "WHERE id = 'b2'" share one entry. Each
+// entry keeps count, total, max and a log-linear latency histogram for p99.
+//
+// The first time a fingerprint runs slower than threshold_ms, its statement
+// is queued for a background worker that runs EXPLAIN (ANALYZE false,
+// FORMAT JSON) on its own connection, so the plan is captured without
+// touching the pool or executing the statement again. Statements carry
+// patient data in their literals, so the raw text lives only in the EXPLAIN
+// queue; entries keep the fingerprint, and literals the planner echoes into
+// plan conditions are fingerprinted too.
+class SlowQueryLog {
+public:
+    static SlowQueryLog& getInstance();
+
+    void configure(const SlowQueryConfig& config);
+    bool start(const std::string& connection_string);
+    void stop();
+
+    void record(std::string_view sql, double duration_ms);
+
+    std::vector<SlowQueryEntry> topQueries(size_t limit, SlowQuerySort sort = SlowQuerySort::TOTAL_TIME) const;
+    SlowQueryStats getStats() const;
+    nlohmann::json toJson(size_t limit, SlowQuerySort sort = SlowQuerySort::TOTAL_TIME) const;
+    void reset();
+
+    // Appends the fingerprint of `sql` to `out`; exposed for tooling
+    static void fingerprint(std::string_view sql, std::string& out);
+
+private:
+    SlowQueryLog() = default;
+    ~SlowQueryLog();
+    SlowQueryLog(const SlowQueryLog&) = delete;
+    SlowQueryLog& operator=(const SlowQueryLog&) = delete;
+
+    struct Entry {
+        std::string fingerprint;
+        std::uint64_t count = 0;
+        std::uint64_t slow_count = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+        utils::LatencyHistogram::Snapshot latency;  // Guarded by mutex_ like the rest of the entry
+        ExplainState explain_state = ExplainState::NONE;
+        std::string plan;
+        std::chrono::system_clock::time_point first_slow_at;
+    };
+
+    struct ExplainRequest {
+        std::uint64_t key;
+        std::string sql;
+    };
+
+    Entry& findOrInsert(std::uint64_t key, const std::string& fingerprint);
+    void explainLoop();
+    void runExplain(std::unique_ptr<pqxx::connection>& connection, const ExplainRequest& request);
+    void finishExplain(std::uint64_t key, ExplainState state, std::string plan);
+
+    SlowQueryConfig config_;
+    std::string connection_string_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::atomic<long long> recorded_{0};
+    std::atomic<long long> slow_{0};
+    std::atomic<long long> explains_run_{0};
+    std::atomic<long long> explains_failed_{0};
+    std::atomic<long long> explains_skipped_{0};
+
+    std::thread explain_thread_;
+    std::atomic<bool> running_{false};
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<ExplainRequest> queue_;
+};
+
+std::string explainStateToString(ExplainState state);
+std::string slowQuerySortToString(SlowQuerySort sort);
+SlowQuerySort stringToSlowQuerySort(const std::string& sort_str);
+
+} // namespace healthcare::database
\ No newline at end of file
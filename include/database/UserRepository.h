@@ -6,6 +6,7 @@
 #include <vector>
 #include <optional>
 #include <chrono>
+#include <map>
 
 namespace healthcare::database {
 
@@ -21,6 +22,8 @@ public:
     QueryResult<models::User> findByVerificationStatus(bool verified, const PaginationParams& pagination = {});
     QueryResult<models::User> findByCity(const std::string& city, const PaginationParams& pagination = {});
     QueryResult<models::User> findByState(const std::string& state, const PaginationParams& pagination = {});
+    QueryResult<models::User> findVerifiedUsers(const PaginationParams& pagination = {});
+    QueryResult<models::User> findUnverifiedUsers(const PaginationParams& pagination = {});
     
     // Authentication queries
     QueryResult<models::User> findByEmailAndPassword(const std::string& email, const std::string& password_hash);
@@ -44,6 +47,7 @@ public:
     // Existence checks
     bool emailExists(const std::string& email);
     bool phoneExists(const std::string& phone);
+    bool phoneNumberExists(const std::string& phone_number);
     bool verificationTokenExists(const std::string& token);
     
     // Statistics
@@ -69,6 +73,9 @@ public:
     std::map<std::string, int> getUserCountByState();
     std::map<models::UserRole, int> getUserCountByRole();
     std::map<std::string, int> getRegistrationCountByMonth(int year);
+    std::map<std::string, int> getUserStatsByCity();
+    std::map<std::string, int> getRegistrationTrends(int days);
+    std::vector<std::string> getFcmTokensByRole(models::UserRole role);
     
     // Bulk operations
     QueryResult<models::User> createUsers(const std::vector<models::User>& users);
@@ -83,6 +90,7 @@ public:
     
     // Session management
     bool updateLastLoginTime(const std::string& user_id);
+    bool updateLastLogin(const std::string& user_id);
     QueryResult<models::User> findUsersWithRecentActivity(int days = 30, 
                                                           const PaginationParams& pagination = {});
     
@@ -109,6 +117,7 @@ private:
     bool validateEmail(const std::string& email) const;
     bool validatePhoneNumber(const std::string& phone) const;
     bool validateUserData(const models::User& user) const;
+    std::chrono::system_clock::time_point parseTimestamp(const std::string& timestamp) const;
     
     // Cache operations specific to User
     void cacheUserByEmail(const models::User& user) const;
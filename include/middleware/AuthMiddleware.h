@@ -47,11 +47,16 @@ public:
     void setTokenExpiryHours(int hours) { token_expiry_hours_ = hours; }
     void setRefreshThresholdHours(int hours) { refresh_threshold_hours_ = hours; }
     
+    // Shared secret for node-to-node calls; empty rejects every internal endpoint
+    static constexpr const char* kInternalTokenHeader = "X-Internal-Token";
+    void setInternalSecret(const std::string& secret) { internal_secret_ = secret; }
+    
     // Endpoint configuration
     void addPublicEndpoint(const std::string& endpoint);
     void addAdminEndpoint(const std::string& endpoint);
     void addDoctorEndpoint(const std::string& endpoint);
     void addUserEndpoint(const std::string& endpoint);
+    void addInternalEndpoint(const std::string& endpoint);
     void addEndpointPermission(const std::string& endpoint, const std::string& permission);
     
     // Role-based access control
@@ -113,6 +118,7 @@ private:
     // Configuration
     std::string jwt_secret_;
     std::string jwt_issuer_;
+    std::string internal_secret_;
     int token_expiry_hours_;
     int refresh_threshold_hours_;
     
@@ -121,6 +127,7 @@ private:
     std::set<std::string> admin_endpoints_;
     std::set<std::string> doctor_endpoints_;
     std::set<std::string> user_endpoints_;
+    std::set<std::string> internal_endpoints_;
     std::map<std::string, std::vector<std::string>> endpoint_permissions_;
     
     // Role permissions
@@ -159,6 +166,7 @@ private:
     bool isAdminEndpoint(const std::string& path) const;
     bool isDoctorEndpoint(const std::string& path) const;
     bool isUserEndpoint(const std::string& path) const;
+    bool isInternalEndpoint(const std::string& path) const;
     
     std::string extractToken(const crow::request& req) const;
     AuthContext createAuthContext(const utils::JwtPayload& payload) const;
@@ -2,8 +2,18 @@
 
 #include <string>
 #include <chrono>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include <crow.h>
 #include "../utils/Logger.h"
+#include "../utils/RouteNormalizer.h"
+#include "../utils/AllocationTracker.h"
+#include "../utils/RequestArena.h"
 
 namespace healthcare::middleware {
 
@@ -45,6 +55,10 @@ public:
         RequestInfo request_info;
         ResponseInfo response_info;
         std::string request_id;
+        utils::RouteNormalizer::EndpointId endpoint_id = utils::RouteNormalizer::kOtherEndpoint;
+        utils::AllocationCounters allocations_at_start;  // Thread totals when the request began
+        std::pmr::memory_resource* arena = nullptr;      // utils::RequestArena, released after after_handle
+        std::thread::id thread;                          // Ran before_handle and owns the arena, trace and capture
         nlohmann::json custom_data;
         bool should_log = true;
     };
@@ -53,6 +67,10 @@ public:
     void before_handle(crow::request& req, crow::response& res, context& ctx);
     void after_handle(crow::request& req, crow::response& res, context& ctx);
 
+    // For handlers that end the response on another thread, where after_handle then
+    // runs: closes the arena, trace and log capture on the worker before it returns
+    void releaseThread(context& ctx);
+
     // Configuration
     void setLogLevel(LogLevel level) { log_level_ = level; }
     void setLogRequests(bool log_requests) { log_requests_ = log_requests; }
@@ -66,6 +84,11 @@ public:
     void setLogSlowRequests(bool log_slow) { log_slow_requests_ = log_slow; }
     void setSlowRequestThreshold(double threshold_ms) { slow_request_threshold_ms_ = threshold_ms; }
     
+    // Sampling. Every line a request logs is held until after_handle; errors and
+    // slow requests are always kept, successful ones up to a per-endpoint rate
+    void setSamplingEnabled(bool enabled) { sampling_enabled_ = enabled; }
+    void setSampledRequestsPerSecond(double rate) { sampled_requests_per_second_ = rate; }
+    
     // Filtering
     void addIgnoredPath(const std::string& path);
     void removeIgnoredPath(const std::string& path);
@@ -93,11 +116,17 @@ public:
         std::map<int, int> status_code_counts;
         std::map<std::string, int> endpoint_counts;
         std::map<std::string, double> endpoint_avg_times;
+        long long sampled_kept_requests = 0;
+        long long sampled_dropped_requests = 0;
+        std::map<std::string, double> endpoint_sample_rates;  // Fraction of requests whose lines were kept
+        // Heap use per request while handled (only with allocation tracking on)
+        std::map<std::string, double> endpoint_avg_allocations;
+        std::map<std::string, double> endpoint_avg_allocated_bytes;
         std::chrono::system_clock::time_point last_request_time;
     };
     
-    LogStats getStats() const { return stats_; }
-    void resetStats() { stats_ = LogStats{}; }
+    LogStats getStats() const;
+    void resetStats();
     
     // Health monitoring
     bool isHealthy() const;
@@ -114,19 +143,35 @@ private:
     bool log_slow_requests_;
     double performance_threshold_ms_;
     double slow_request_threshold_ms_;
+    bool sampling_enabled_;
+    double sampled_requests_per_second_;
     std::string log_format_;
     std::string timestamp_format_;
     bool include_request_id_;
     
     // Filtering
     std::set<std::string> ignored_paths_;
-    std::set<std::string> sensitive_headers_;
-    std::set<std::string> sensitive_params_;
+    std::set<std::string, std::less<>> sensitive_headers_;  // Lower case; looked up by string_view
+    std::set<std::string, std::less<>> sensitive_params_;
     
     // Statistics
     mutable LogStats stats_;
     mutable std::mutex stats_mutex_;
     
+    // Per-endpoint counters and sampler token bucket, indexed by
+    // RouteNormalizer::EndpointId; guarded by stats_mutex_
+    struct EndpointState {
+        long long requests = 0;
+        double avg_time_ms = 0.0;
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point last_refill;
+        long long seen = 0;
+        long long kept = 0;
+        long long allocations = 0;
+        long long allocated_bytes = 0;
+    };
+    mutable std::vector<EndpointState> endpoint_state_;
+    
     // Helper methods
     std::string generateRequestId() const;
     std::string extractClientIp(const crow::request& req) const;
@@ -135,14 +180,21 @@ private:
     bool shouldIgnorePath(const std::string& path) const;
     bool shouldLogLevel(LogLevel level) const;
     
-    void logRequest(const RequestInfo& request_info, const std::string& request_id);
+    using EndpointId = utils::RouteNormalizer::EndpointId;
+    EndpointId normalizeEndpoint(std::string_view path) const;  // Stats key: IDs collapsed to :id
+    EndpointId lookupEndpoint(std::string_view path) const;     // Same key, but never interns a new one
+    
+    // Request and response lines are structured records (utils::LogFormat), so
+    // the worker thread only copies the fields; JSON is rendered by the log writer
+    void logRequest(const crow::request& req, const RequestInfo& request_info, const std::string& request_id);
     void logResponse(const RequestInfo& request_info, const ResponseInfo& response_info, const std::string& request_id);
     void logSlowRequest(const RequestInfo& request_info, const ResponseInfo& response_info, const std::string& request_id);
-    void logPerformanceMetrics(const RequestInfo& request_info, const ResponseInfo& response_info);
+    void logPerformanceMetrics(const RequestInfo& request_info, const ResponseInfo& response_info, EndpointId endpoint,
+                               const utils::AllocationCounters& allocations);
     
-    // Sanitization
-    std::string sanitizeHeaders(const crow::ci_map& headers) const;
-    std::string sanitizeQueryString(const std::string& query_string) const;
+    // Sanitization; headers and query strings are built in the request arena
+    std::pmr::string sanitizeHeaders(const crow::ci_map& headers) const;
+    std::pmr::string sanitizeQueryString(std::string_view query_string) const;
     std::string sanitizeBody(const std::string& body, const std::string& content_type) const;
     std::string maskSensitiveData(const std::string& data) const;
     
@@ -159,8 +211,10 @@ private:
                                  const std::string& request_id) const;
     
     // Statistics updates
-    void updateStats(const ResponseInfo& response_info, const std::string& endpoint) const;
-    void updateEndpointStats(const std::string& endpoint, double duration_ms) const;
+    void updateStats(const ResponseInfo& response_info, EndpointId endpoint,
+                     const utils::AllocationCounters& allocations) const;
+    bool sampleRequest(EndpointId endpoint, bool must_keep) const;
+    void updateEndpointStats(EndpointId endpoint, double duration_ms, const utils::AllocationCounters& allocations) const;
     
     // Health checks
     bool isResponseTimeHealthy() const;
@@ -78,9 +78,12 @@ public:
     ~Appointment() override = default;
 
     // Core appointment details
-    const std::string& getUserId() const { return user_id_; }
-    const std::string& getDoctorId() const { return doctor_id_; }
-    const std::string& getClinicId() const { return clinic_id_; }
+    std::string getUserId() const { return idToString(user_id_); }
+    std::string getDoctorId() const { return idToString(doctor_id_); }
+    std::string getClinicId() const { return idToString(clinic_id_); }
+    const utils::Uuid& getUserUuid() const { return user_id_; }
+    const utils::Uuid& getDoctorUuid() const { return doctor_id_; }
+    const utils::Uuid& getClinicUuid() const { return clinic_id_; }
     const std::chrono::system_clock::time_point& getAppointmentDate() const { return appointment_date_; }
     const std::chrono::system_clock::time_point& getStartTime() const { return start_time_; }
     const std::chrono::system_clock::time_point& getEndTime() const { return end_time_; }
@@ -113,9 +116,9 @@ public:
     const std::string& getFollowUpNotes() const { return follow_up_notes_; }
 
     // Setters
-    void setUserId(const std::string& user_id) { user_id_ = user_id; }
-    void setDoctorId(const std::string& doctor_id) { doctor_id_ = doctor_id; }
-    void setClinicId(const std::string& clinic_id) { clinic_id_ = clinic_id; }
+    void setUserId(const std::string& user_id) { user_id_ = idFromString(user_id); }
+    void setDoctorId(const std::string& doctor_id) { doctor_id_ = idFromString(doctor_id); }
+    void setClinicId(const std::string& clinic_id) { clinic_id_ = idFromString(clinic_id); }
     void setAppointmentDate(const std::chrono::system_clock::time_point& date) { appointment_date_ = date; }
     void setStartTime(const std::chrono::system_clock::time_point& start_time) { start_time_ = start_time; }
     void setEndTime(const std::chrono::system_clock::time_point& end_time) { end_time_ = end_time; }
@@ -181,13 +184,14 @@ public:
 
     // Serialization
     nlohmann::json toJson() const override;
+    void writeJson(utils::JsonWriter& writer) const;  // Same bytes as toJson().dump(), without the DOM
     void fromJson(const nlohmann::json& json) override;
 
 private:
     // Core details
-    std::string user_id_;
-    std::string doctor_id_;
-    std::string clinic_id_;
+    utils::Uuid user_id_;
+    utils::Uuid doctor_id_;
+    utils::Uuid clinic_id_;
     std::chrono::system_clock::time_point appointment_date_;
     std::chrono::system_clock::time_point start_time_;
     std::chrono::system_clock::time_point end_time_;
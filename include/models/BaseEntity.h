@@ -3,6 +3,8 @@
 #include <string>
 #include <chrono>
 #include <nlohmann/json.hpp>
+#include "../utils/JsonWriter.h"
+#include "../utils/Uuid.h"
 
 namespace healthcare::models {
 
@@ -12,13 +14,15 @@ public:
     virtual ~BaseEntity() = default;
 
     // Getters
-    const std::string& getId() const { return id_; }
+    std::string getId() const { return idToString(id_); }
+    const utils::Uuid& getUuid() const { return id_; }
     const std::chrono::system_clock::time_point& getCreatedAt() const { return created_at_; }
     const std::chrono::system_clock::time_point& getUpdatedAt() const { return updated_at_; }
     bool isDeleted() const { return is_deleted_; }
 
     // Setters
-    void setId(const std::string& id) { id_ = id; }
+    void setId(const std::string& id) { id_ = idFromString(id); }
+    void setId(const utils::Uuid& id) { id_ = id; }
     void setCreatedAt(const std::chrono::system_clock::time_point& created_at) { created_at_ = created_at; }
     void setUpdatedAt(const std::chrono::system_clock::time_point& updated_at) { updated_at_ = updated_at; }
     void setDeleted(bool deleted) { is_deleted_ = deleted; }
@@ -27,6 +31,10 @@ public:
     void updateTimestamp() { updated_at_ = std::chrono::system_clock::now(); }
     void markAsDeleted() { is_deleted_ = true; updateTimestamp(); }
 
+    // ID text form at the JSON/SQL boundary; "" is the nil UUID, malformed ids throw
+    static std::string idToString(const utils::Uuid& id) { return id.isNil() ? std::string() : id.toString(); }
+    static utils::Uuid idFromString(const std::string& id) { return id.empty() ? utils::Uuid() : utils::Uuid::fromString(id); }
+
     // Pure virtual methods for serialization
     virtual nlohmann::json toJson() const = 0;
     virtual void fromJson(const nlohmann::json& json) = 0;
@@ -35,7 +43,7 @@ protected:
     std::string generateUUID();
 
 private:
-    std::string id_;
+    utils::Uuid id_;
     std::chrono::system_clock::time_point created_at_;
     std::chrono::system_clock::time_point updated_at_;
     bool is_deleted_;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "BaseEntity.h"
+#include "ClinicSchedule.h"
+#include "../utils/CivilTime.h"
 #include <string>
 #include <vector>
 #include <chrono>
@@ -36,9 +38,17 @@ struct WorkingHours {
     std::string day_of_week;  // MONDAY, TUESDAY, etc.
     std::string start_time;   // HH:MM format
     std::string end_time;     // HH:MM format
-    bool is_closed;
+    bool is_closed = false;
     std::string break_start;  // Optional lunch break
     std::string break_end;
+
+    // Integer mirrors of the fields above, filled by compileMinutes()
+    int day_index = -1;  // SUNDAY = 0
+    utils::civil::MinuteRange open_range;
+    utils::civil::MinuteRange break_range;
+
+    void compileMinutes();
+    bool isOpenAtMinute(int minute_of_day) const;
 };
 
 struct Facility {
@@ -63,7 +73,9 @@ public:
     const Address& getAddress() const { return address_; }
     
     // Operational details
+    const std::string& getTimezone() const { return timezone_; }
     const std::vector<WorkingHours>& getWorkingHours() const { return working_hours_; }
+    const ClinicSchedule& getSchedule() const { return schedule_; }
     const std::vector<Facility>& getFacilities() const { return facilities_; }
     const std::vector<std::string>& getServices() const { return services_; }
     
@@ -90,7 +102,8 @@ public:
     void setStatus(ClinicStatus status) { status_ = status; }
     void setContactInfo(const ContactInfo& contact_info) { contact_info_ = contact_info; }
     void setAddress(const Address& address) { address_ = address; }
-    void setWorkingHours(const std::vector<WorkingHours>& working_hours) { working_hours_ = working_hours; }
+    void setTimezone(const std::string& timezone);
+    void setWorkingHours(const std::vector<WorkingHours>& working_hours);
     void setFacilities(const std::vector<Facility>& facilities) { facilities_ = facilities; }
     void setServices(const std::vector<std::string>& services) { services_ = services; }
     void setLogoUrl(const std::string& logo_url) { logo_url_ = logo_url; }
@@ -127,6 +140,7 @@ public:
 
     // Serialization
     nlohmann::json toJson() const override;
+    void writeJson(utils::JsonWriter& writer) const;  // Same bytes as toJson().dump(), without the DOM
     void fromJson(const nlohmann::json& json) override;
 
 private:
@@ -141,7 +155,9 @@ private:
     Address address_;
     
     // Operational details
+    std::string timezone_;  // IANA zone name, resolved through civil::TimeZoneRegistry
     std::vector<WorkingHours> working_hours_;
+    ClinicSchedule schedule_;  // Compiled from working_hours_ and timezone_ by compileSchedule()
     std::vector<Facility> facilities_;
     std::vector<std::string> services_;
     
@@ -160,6 +176,8 @@ private:
     // Emergency details
     bool has_emergency_services_;
     std::string emergency_contact_;
+
+    void compileSchedule();
 };
 
 // Utility functions
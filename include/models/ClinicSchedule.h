@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../utils/CivilTime.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace healthcare::models {
+
+struct WorkingHours;
+
+// Weekly opening hours compiled into a fixed 7-day interval table.
+// Built once when working hours are loaded; lookups never touch strings.
+struct ClinicSchedule {
+    static constexpr int kMaxIntervalsPerDay = 8;
+
+    // Half-open [start, end) minutes of the day; start == end marks an unused entry
+    struct Interval {
+        std::uint16_t start = 0;
+        std::uint16_t end = 0;
+    };
+
+    std::array<std::array<Interval, kMaxIntervalsPerDay>, utils::civil::kDaysPerWeek> days{};
+    std::uint8_t open_days = 0;  // Bit d set when weekday d (SUNDAY = 0) has any open interval
+    std::uint8_t truncated_days = 0;  // Bit d set when weekday d had more than kMaxIntervalsPerDay intervals
+    const utils::civil::TimeZone* zone = nullptr;
+
+    static ClinicSchedule compile(const std::vector<WorkingHours>& working_hours,
+                                  const utils::civil::TimeZone& zone);
+
+    bool isOpenOn(int day_of_week) const { return (open_days >> day_of_week) & 1u; }
+    bool isOpenAt(int day_of_week, int minute_of_day) const;
+    bool isOpenThroughout(int day_of_week, int start_minute, int end_minute) const;
+    bool isOpenAt(const std::chrono::system_clock::time_point& time) const;
+    std::vector<utils::civil::MinuteRange> getOpenRanges(int day_of_week) const;
+};
+
+inline bool ClinicSchedule::isOpenAt(int day_of_week, int minute_of_day) const {
+    if (!isOpenOn(day_of_week)) {
+        return false;
+    }
+
+    // Branch-free scan of the day's fixed interval slots
+    bool open = false;
+    for (const auto& interval : days[day_of_week]) {
+        open |= static_cast<unsigned>(minute_of_day - interval.start) <
+                static_cast<unsigned>(interval.end - interval.start);
+    }
+    return open;
+}
+
+// Batch evaluation over a contiguous run of schedules: out[i] = 1 when schedules[i] is open at time.
+// Local time is recomputed only when the zone changes between neighbouring schedules.
+void evaluateOpenAt(const ClinicSchedule* schedules, size_t count,
+                    const std::chrono::system_clock::time_point& time, std::uint8_t* out);
+
+// Compiled schedules for many clinics, stored contiguously for listing-sized batch queries
+class ClinicScheduleTable {
+public:
+    ClinicScheduleTable() = default;
+
+    void upsert(const std::string& clinic_id, const ClinicSchedule& schedule);
+    bool remove(const std::string& clinic_id);
+    void clear();
+
+    std::optional<ClinicSchedule> find(const std::string& clinic_id) const;
+    size_t size() const;
+
+    // Open flags for every clinic in table order, plus the matching ids
+    std::vector<std::uint8_t> evaluateOpenAt(const std::chrono::system_clock::time_point& time,
+                                             std::vector<std::string>* clinic_ids = nullptr) const;
+    // Open flags for the given clinics; unknown ids are reported closed
+    std::vector<std::uint8_t> evaluateOpenAt(const std::vector<std::string>& clinic_ids,
+                                             const std::chrono::system_clock::time_point& time) const;
+    std::vector<std::string> getOpenClinicIds(const std::chrono::system_clock::time_point& time) const;
+
+private:
+    std::vector<ClinicSchedule> schedules_;
+    std::vector<std::string> clinic_ids_;
+    std::unordered_map<std::string, size_t> index_;
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace healthcare::models
\ No newline at end of file
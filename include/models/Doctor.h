@@ -2,6 +2,8 @@
 
 #include "BaseEntity.h"
 #include "User.h"
+#include "../utils/CivilTime.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -44,13 +46,17 @@ struct TimeSlot {
     ConsultationType consultation_type;
 };
 
+// Working ranges per weekday (SUNDAY = 0) compiled from an availability pattern
+using WeeklyAvailability = std::array<std::vector<utils::civil::MinuteRange>, utils::civil::kDaysPerWeek>;
+
 class Doctor : public BaseEntity {
 public:
     Doctor();
     ~Doctor() override = default;
 
     // Basic info
-    const std::string& getUserId() const { return user_id_; }
+    std::string getUserId() const { return idToString(user_id_); }
+    const utils::Uuid& getUserUuid() const { return user_id_; }
     const std::string& getMedicalLicenseNumber() const { return medical_license_number_; }
     const std::string& getQualification() const { return qualification_; }
     int getYearsOfExperience() const { return years_of_experience_; }
@@ -67,17 +73,19 @@ public:
     
     // Availability
     const std::string& getAvailabilityPattern() const { return availability_pattern_; }
+    const WeeklyAvailability& getWeeklyAvailability() const { return weekly_availability_; }
     bool isAvailableToday() const { return is_available_today_; }
     
     // Professional details
     const std::string& getBio() const { return bio_; }
     const std::string& getLanguages() const { return languages_; }
     const std::vector<Specialization>& getSpecializations() const { return specializations_; }
-    const std::vector<std::string>& getClinicIds() const { return clinic_ids_; }
+    std::vector<std::string> getClinicIds() const;
+    const std::vector<utils::Uuid>& getClinicUuids() const { return clinic_ids_; }
     const std::vector<DoctorDocument>& getDocuments() const { return documents_; }
 
     // Setters
-    void setUserId(const std::string& user_id) { user_id_ = user_id; }
+    void setUserId(const std::string& user_id) { user_id_ = idFromString(user_id); }
     void setMedicalLicenseNumber(const std::string& license) { medical_license_number_ = license; }
     void setQualification(const std::string& qualification) { qualification_ = qualification; }
     void setYearsOfExperience(int years) { years_of_experience_ = years; }
@@ -87,12 +95,12 @@ public:
     void setConsultationTypes(const std::vector<ConsultationType>& types) { consultation_types_ = types; }
     void setRating(double rating) { rating_ = rating; }
     void setTotalReviews(int count) { total_reviews_ = count; }
-    void setAvailabilityPattern(const std::string& pattern) { availability_pattern_ = pattern; }
+    void setAvailabilityPattern(const std::string& pattern);
     void setAvailableToday(bool available) { is_available_today_ = available; }
     void setBio(const std::string& bio) { bio_ = bio; }
     void setLanguages(const std::string& languages) { languages_ = languages; }
     void setSpecializations(const std::vector<Specialization>& specializations) { specializations_ = specializations; }
-    void setClinicIds(const std::vector<std::string>& clinic_ids) { clinic_ids_ = clinic_ids; }
+    void setClinicIds(const std::vector<std::string>& clinic_ids);
     void setDocuments(const std::vector<DoctorDocument>& documents) { documents_ = documents; }
 
     // Utility methods
@@ -115,13 +123,17 @@ public:
     ) const;
     
     bool isAvailableAt(const std::chrono::system_clock::time_point& time, ConsultationType type) const;
+    // True when [start_time, end_time) lies inside working ranges, including ones that run past midnight
+    bool isWorkingThroughout(const std::chrono::system_clock::time_point& start_time,
+                             const std::chrono::system_clock::time_point& end_time) const;
 
     // Serialization
     nlohmann::json toJson() const override;
+    void writeJson(utils::JsonWriter& writer) const;  // Same bytes as toJson().dump(), without the DOM
     void fromJson(const nlohmann::json& json) override;
 
 private:
-    std::string user_id_;  // Reference to User table
+    utils::Uuid user_id_;  // Reference to User table
     std::string medical_license_number_;
     std::string qualification_;
     int years_of_experience_;
@@ -138,17 +150,20 @@ private:
     
     // Availability
     std::string availability_pattern_;  // JSON string for complex patterns
+    WeeklyAvailability weekly_availability_;  // availability_pattern_ compiled once when it is set
     bool is_available_today_;
     
     // Professional details
     std::string bio_;
     std::string languages_;  // Comma-separated language codes
     std::vector<Specialization> specializations_;
-    std::vector<std::string> clinic_ids_;
+    std::vector<utils::Uuid> clinic_ids_;
     std::vector<DoctorDocument> documents_;
 };
 
 // Utility functions
+// Ranges ending at or before their start run past midnight and are split across two weekdays
+WeeklyAvailability parseWeeklyAvailability(const std::string& availability_pattern);
 std::string doctorStatusToString(DoctorStatus status);
 DoctorStatus stringToDoctorStatus(const std::string& status_str);
 std::string consultationTypeToString(ConsultationType type);
@@ -84,6 +84,8 @@ struct FollowUpInstruction {
 
 class Prescription : public BaseEntity {
 public:
+    using Days = std::chrono::duration<int, std::ratio<86400>>;  // std::chrono::days is C++20
+
     Prescription();
     ~Prescription() override = default;
 
@@ -166,8 +168,8 @@ public:
     
     int getTotalMedicines() const { return medicines_.size(); }
     int getActiveMedicines() const;
-    std::chrono::days getValidityDays() const;
-    std::chrono::days getDaysUntilExpiry() const;
+    Days getValidityDays() const;
+    Days getDaysUntilExpiry() const;
     
     // Validation
     bool isValidPrescription() const;
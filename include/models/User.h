@@ -76,6 +76,7 @@ public:
 
     // Serialization
     nlohmann::json toJson() const override;
+    void writeJson(utils::JsonWriter& writer) const;  // Same bytes as toJson().dump(), without the DOM
     void fromJson(const nlohmann::json& json) override;
 
     // Authentication helpers
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../utils/PrefixTrie.h"
+
+namespace healthcare::services {
+
+enum class Vocabulary {
+    SPECIALIZATION = 0,
+    CITY = 1,
+    MEDICINE = 2
+};
+
+struct AutocompleteConfig {
+    int refresh_interval_seconds = 300;
+    size_t max_suggestions = 20;
+};
+
+struct AutocompleteStats {
+    std::array<size_t, 3> terms{};
+    std::uint64_t refreshes = 0;
+    std::uint64_t failed_refreshes = 0;
+    std::chrono::system_clock::time_point last_refresh;
+};
+
+// Popularity-weighted prefix completion for specializations, cities and
+// medicine names. Weights are usage counts aggregated from Postgres at startup
+// and re-synced on a background thread; only changed terms are touched. The
+// keystroke path reads the in-memory tries and never queries the database.
+class AutocompleteService {
+public:
+    static AutocompleteService& getInstance();
+
+    void configure(const AutocompleteConfig& config);
+    bool start();   // Initial load, then periodic refresh
+    void stop();
+
+    std::vector<utils::Suggestion> suggest(Vocabulary vocabulary, const std::string& prefix,
+                                           size_t limit = 10) const;
+
+    bool refresh();
+    AutocompleteStats getStats() const;
+
+    static std::optional<Vocabulary> vocabularyFromString(const std::string& name);
+    static std::string vocabularyToString(Vocabulary vocabulary);
+
+private:
+    AutocompleteService() = default;
+    ~AutocompleteService();
+    AutocompleteService(const AutocompleteService&) = delete;
+    AutocompleteService& operator=(const AutocompleteService&) = delete;
+
+    using TermCounts = std::unordered_map<std::string, std::pair<std::string, std::int64_t>>;
+
+    static constexpr size_t kVocabularyCount = 3;
+
+    TermCounts loadCounts(Vocabulary vocabulary) const;
+    void applyCounts(Vocabulary vocabulary, const TermCounts& counts);
+    void refreshLoop();
+
+    AutocompleteConfig config_;
+    std::array<utils::PrefixTrie, kVocabularyCount> tries_;
+    // Folded terms present in the last DB sync, so later syncs can drop the ones that disappear
+    std::array<std::unordered_set<std::string>, kVocabularyCount> synced_;
+    mutable std::shared_mutex mutex_;
+
+    std::atomic<bool> running_{false};
+    std::thread refresh_thread_;
+    std::mutex refresh_mutex_;
+    std::condition_variable refresh_cv_;
+
+    mutable std::mutex stats_mutex_;
+    AutocompleteStats stats_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
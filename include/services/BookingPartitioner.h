@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../utils/ConsistentHashRing.h"
+
+namespace healthcare::services {
+
+struct PartitionConfig {
+    bool enabled = false;
+    std::string node_id;
+    std::string advertise_url;  // Base URL peers use to reach this node, e.g. http://10.0.0.5:8080
+    int virtual_nodes = utils::ConsistentHashRing::kDefaultVirtualNodes;
+    int heartbeat_interval_seconds = 5;
+    int member_ttl_seconds = 15;
+    int forward_timeout_ms = 2000;
+    int schedule_max_age_seconds = 60;  // Owned schedules are re-read from Postgres once older than this
+    std::string membership_key = "healthcare:partition:members";
+    std::string internal_secret;  // Sent on forwards; peers' AuthMiddleware checks it on internal routes
+};
+
+struct PartitionMember {
+    std::string node_id;
+    std::string url;
+    std::int64_t last_heartbeat = 0;  // Unix seconds
+};
+
+struct ForwardResponse {
+    bool success = false;
+    int status_code = 0;
+    std::string body;
+    std::string error;
+};
+
+// Body of a slot check forwarded to the owning node; times are Unix seconds on the wire
+struct SlotCheckRequest {
+    std::string doctor_id;
+    std::chrono::system_clock::time_point start_time;
+    std::chrono::system_clock::time_point end_time;
+};
+
+// Body of a write notice sent to the owning node so it drops its cached schedule
+struct ScheduleInvalidateRequest {
+    std::string doctor_id;
+};
+
+struct PartitionStats {
+    size_t members = 0;
+    size_t owned_doctors = 0;  // Doctors with a loaded schedule on this node
+    uint64_t forwarded_requests = 0;
+    uint64_t forward_failures = 0;
+    uint64_t membership_refreshes = 0;
+    uint64_t membership_changes = 0;
+};
+
+// Booked intervals for the doctors this node owns, read from Postgres and kept
+// current by local writes and peers' invalidations. Postgres stays authoritative:
+// a schedule older than the max age counts as not loaded and is read again.
+class DoctorScheduleBook {
+public:
+    struct BookedInterval {
+        std::string appointment_id;
+        std::chrono::system_clock::time_point start_time;
+        std::chrono::system_clock::time_point end_time;
+    };
+
+    void setMaxAge(std::chrono::seconds max_age);
+    bool isLoaded(const std::string& doctor_id) const;
+    void load(const std::string& doctor_id, std::vector<BookedInterval> intervals);
+    // Empty when the doctor's schedule is not loaded, so callers cannot mistake "unknown" for free
+    std::optional<bool> isFree(const std::string& doctor_id,
+                               const std::chrono::system_clock::time_point& start_time,
+                               const std::chrono::system_clock::time_point& end_time,
+                               const std::string& exclude_appointment_id = "") const;
+    bool reserve(const std::string& doctor_id, const BookedInterval& interval);  // False on overlap or when not loaded
+    bool release(const std::string& doctor_id, const std::string& appointment_id);
+    bool releaseAppointment(const std::string& appointment_id);  // Searches every loaded doctor
+    void evict(const std::string& doctor_id);
+    template <typename Predicate>
+    void retainIf(Predicate&& keep);
+    size_t size() const;
+
+private:
+    struct Schedule {
+        std::vector<BookedInterval> intervals;  // Sorted by start
+        std::chrono::steady_clock::time_point loaded_at;
+    };
+
+    // Null when the doctor is absent or the schedule has aged out
+    const Schedule* findFresh(const std::string& doctor_id) const;
+    bool overlaps(const std::vector<BookedInterval>& intervals,
+                  const std::chrono::system_clock::time_point& start_time,
+                  const std::chrono::system_clock::time_point& end_time,
+                  const std::string& exclude_appointment_id) const;
+
+    std::unordered_map<std::string, Schedule> schedules_;
+    std::chrono::seconds max_age_{60};
+    mutable std::mutex mutex_;
+};
+
+template <typename Predicate>
+void DoctorScheduleBook::retainIf(Predicate&& keep) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = schedules_.begin(); it != schedules_.end();) {
+        it = keep(it->first) ? std::next(it) : schedules_.erase(it);
+    }
+}
+
+// Routes booking state by doctor_id across instances. Members heartbeat into a
+// Redis hash; a consistent hash ring over live members picks each doctor's owner.
+// The owner keeps the doctor's schedule in memory, other nodes forward to it.
+class BookingPartitioner {
+public:
+    static BookingPartitioner& getInstance();
+
+    void configure(const PartitionConfig& config);
+    bool start();
+    void stop();
+    bool isEnabled() const { return config_.enabled; }
+    const std::string& getNodeId() const { return config_.node_id; }
+
+    // Ownership
+    bool isLocalOwner(const std::string& doctor_id) const;
+    PartitionMember getOwner(const std::string& doctor_id) const;
+    std::vector<PartitionMember> getMembers() const;
+    bool refreshMembership();
+
+    // Forwarding to the owning node
+    ForwardResponse forward(const PartitionMember& owner, const std::string& method,
+                            const std::string& path, const std::string& body,
+                            const std::string& request_id = "") const;
+    // Tells the owner of a doctor written on this node to drop its cached schedule
+    void invalidateRemoteSchedule(const std::string& doctor_id) const;
+
+    DoctorScheduleBook& getScheduleBook() { return schedule_book_; }
+    PartitionStats getStats() const;
+    nlohmann::json getStatus() const;
+
+    static constexpr const char* kForwardedHeader = "X-Partition-Forwarded-By";
+    static constexpr const char* kInternalTokenHeader = "X-Internal-Token";  // Must match AuthMiddleware's
+    static constexpr const char* kSlotCheckPath = "/internal/partition/slot-check";
+    static constexpr const char* kBookPath = "/internal/partition/book";
+    static constexpr const char* kScheduleInvalidatePath = "/internal/partition/schedule-invalidate";
+
+private:
+    BookingPartitioner() = default;
+    ~BookingPartitioner();
+    BookingPartitioner(const BookingPartitioner&) = delete;
+    BookingPartitioner& operator=(const BookingPartitioner&) = delete;
+
+    void heartbeatLoop();
+    bool publishHeartbeat(std::int64_t now_seconds);
+
+    PartitionConfig config_;
+    utils::ConsistentHashRing ring_;
+    std::unordered_map<std::string, PartitionMember> members_;
+    mutable std::shared_mutex ring_mutex_;
+
+    DoctorScheduleBook schedule_book_;
+
+    std::thread heartbeat_thread_;
+    std::mutex heartbeat_mutex_;
+    std::condition_variable heartbeat_cv_;
+    std::atomic<bool> running_{false};
+
+    mutable std::atomic<uint64_t> forwarded_requests_{0};
+    mutable std::atomic<uint64_t> forward_failures_{0};
+    std::atomic<uint64_t> membership_refreshes_{0};
+    std::atomic<uint64_t> membership_changes_{0};
+};
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -12,6 +12,9 @@
 #include "../database/UserRepository.h"
 #include "PaymentService.h"
 #include "NotificationService.h"
+#include "EmergencyDispatchIndex.h"
+#include "BookingPartitioner.h"
+#include "ClinicRegistry.h"
 
 namespace healthcare {
 namespace services {
@@ -28,6 +31,9 @@ struct BookingRequest {
     bool is_emergency = false;
     bool is_follow_up = false;
     std::string parent_appointment_id;  // For follow-ups
+    std::string city;                   // Patient location, used for emergency dispatch
+    double latitude = 0.0;
+    double longitude = 0.0;
 };
 
 struct RescheduleRequest {
@@ -66,6 +72,12 @@ enum class BookingError {
     DATABASE_ERROR = 19
 };
 
+struct BookingConfig {
+    int advance_booking_days = 30;  // Latest start a patient may book, counted from now
+    int max_batch_items = 50;
+    int max_recurring_occurrences = 26;  // Longer plans are cut to this many visits
+};
+
 struct BookingResult {
     BookingError error;
     std::string message;
@@ -73,6 +85,41 @@ struct BookingResult {
     std::string payment_url;  // For payment gateway
 };
 
+// One appointment within a batch booking
+struct BatchBookingItem {
+    std::string doctor_id;
+    std::string clinic_id;
+    std::chrono::system_clock::time_point start_time;
+    models::AppointmentType type = models::AppointmentType::OFFLINE;
+    std::string symptoms;
+    std::string notes;
+};
+
+struct BatchBookingRequest {
+    std::string user_id;
+    std::vector<BatchBookingItem> items;
+    bool all_or_nothing = false;  // Reject the whole batch if any item fails
+    PaymentMethod payment_method = PaymentMethod::RAZORPAY;
+    std::string description;
+};
+
+struct BatchItemResult {
+    BookingError error = BookingError::SUCCESS;
+    std::string message;
+    std::unique_ptr<models::Appointment> appointment;
+};
+
+struct BatchBookingResult {
+    BookingError error = BookingError::SUCCESS;
+    std::string message;
+    std::vector<BatchItemResult> items;  // Same order as the request items
+    size_t booked_count = 0;
+    double total_amount = 0.0;
+    std::string payment_order_id;  // Single aggregated order for every booked item
+    std::string payment_batch_id;  // Receipt of that order
+    std::string payment_url;
+};
+
 struct AvailabilitySlot {
     std::chrono::system_clock::time_point start_time;
     std::chrono::system_clock::time_point end_time;
@@ -80,10 +127,16 @@ struct AvailabilitySlot {
     double consultation_fee;
     std::string doctor_id;
     std::string clinic_id;
+
+    void writeJson(utils::JsonWriter& writer) const;
 };
 
+// Wire form of a BookingResult, returned by the partition owner for forwarded bookings
+nlohmann::json bookingResultToJson(const BookingResult& result);
+
 class BookingService {
 private:
+    BookingConfig config_;
     std::unique_ptr<database::AppointmentRepository> appointment_repository_;
     std::unique_ptr<database::DoctorRepository> doctor_repository_;
     std::unique_ptr<database::UserRepository> user_repository_;
@@ -91,15 +144,24 @@ private:
     std::unique_ptr<NotificationService> notification_service_;
 
 public:
-    BookingService();
+    explicit BookingService(const BookingConfig& config = BookingConfig());
     ~BookingService() = default;
 
     // Core Booking Operations
-    BookingResult bookAppointment(const BookingRequest& request);
+    // Books through the node that owns the doctor's partition; falls back to booking here
+    // when the owner cannot be reached, since the Postgres conflict check is authoritative
+    BookingResult bookAppointment(const BookingRequest& request, const std::string& request_id = "");
+    // Entry point for bookings a peer forwarded to this node; never forwards again
+    BookingResult bookAppointmentAsOwner(const BookingRequest& request);
     BookingResult rescheduleAppointment(const RescheduleRequest& request);
     BookingResult cancelAppointment(const CancellationRequest& request);
     BookingResult confirmAppointment(const std::string& appointment_id);
 
+    // Batch Booking (recurring plans, follow-up series, clinic day imports)
+    BatchBookingResult bookAppointments(const BatchBookingRequest& request);
+    BatchBookingResult bookRecurringAppointments(const BatchBookingItem& first_visit, const std::string& user_id,
+                                                 int occurrences, std::chrono::hours interval);
+
     // Appointment Management
     std::optional<std::unique_ptr<models::Appointment>> getAppointmentById(const std::string& appointment_id);
     std::vector<std::unique_ptr<models::Appointment>> getUserAppointments(const std::string& user_id, 
@@ -118,9 +180,13 @@ public:
     bool isDoctorAvailable(const std::string& doctor_id,
                           const std::chrono::system_clock::time_point& start_time,
                           const std::chrono::system_clock::time_point& end_time);
+    // Asks the owning node; false when no one can say for sure
     bool isTimeSlotAvailable(const std::string& doctor_id,
                            const std::chrono::system_clock::time_point& start_time,
-                           const std::chrono::system_clock::time_point& end_time);
+                           const std::chrono::system_clock::time_point& end_time,
+                           const std::string& request_id = "");
+    // Loads a doctor this node owns into the partition's schedule book; false if Postgres failed
+    static bool loadOwnedDoctorSchedule(const std::string& doctor_id);
 
     // Search and Discovery
     std::vector<std::unique_ptr<models::Doctor>> searchAvailableDoctors(const std::string& specialization,
@@ -144,6 +210,10 @@ public:
     bool markAppointmentCompleted(const std::string& appointment_id);
     bool markAppointmentNoShow(const std::string& appointment_id);
     bool startAppointment(const std::string& appointment_id);  // For online consultations
+    // Keep dispatch occupancy and the owned schedule book current; registered as
+    // AppointmentRepository change and remove listeners
+    static void onAppointmentStatusChanged(const models::Appointment& appointment);
+    static void onAppointmentRemoved(const std::string& appointment_id);
 
     // Payment Integration
     BookingResult processPayment(const std::string& appointment_id, const std::string& payment_method);
@@ -178,6 +248,18 @@ public:
 
 private:
     // Helper methods
+    BookingResult bookLocally(const BookingRequest& request);
+    // Doctors in the order of doctor_ids, fetched in one query; unknown ids are skipped
+    std::vector<std::unique_ptr<models::Doctor>> loadDoctors(const std::vector<std::string>& doctor_ids);
+    BookingResult forwardBooking(const BookingRequest& request, const std::string& request_id, bool& delivered);
+    // Doctor, clinic, working-hours and booking-window rules shared by single and batch bookings
+    BookingError checkBookable(const models::Doctor& doctor, const std::string& clinic_id,
+                               const std::chrono::system_clock::time_point& start_time,
+                               const std::chrono::system_clock::time_point& end_time,
+                               models::AppointmentType type, std::string& message) const;
+    PaymentResponse createPaymentOrder(const PaymentRequest& request);  // Traced and timed gateway call
+    // Cancels stored appointments whose payment order could not be created, freeing their slots
+    void cancelUnpaid(const std::vector<models::Appointment>& appointments, const std::string& reason);
     std::chrono::system_clock::time_point calculateEndTime(const std::chrono::system_clock::time_point& start_time,
                                                           const models::Doctor& doctor);
     bool hasTimeConflict(const std::string& doctor_id,
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "CatalogSnapshot.h"
+
+namespace healthcare::services {
+
+struct CatalogConfig {
+    int refresh_interval_seconds = 60;
+};
+
+struct CatalogStats {
+    std::uint64_t version = 0;
+    size_t doctors = 0;
+    size_t clinics = 0;
+    size_t string_pool_bytes = 0;
+    std::uint64_t rebuilds = 0;
+    std::uint64_t failed_rebuilds = 0;
+    double last_build_ms = 0.0;
+    std::chrono::system_clock::time_point last_rebuild;
+};
+
+// Owns the current CatalogSnapshot. A background thread reloads the catalog
+// from Postgres into a fresh snapshot and publishes it with an atomic pointer
+// swap; readers keep whatever snapshot they loaded until they drop it, so a
+// rebuild never blocks or invalidates an in-flight scan.
+class CatalogService {
+public:
+    static CatalogService& getInstance();
+
+    void configure(const CatalogConfig& config);
+    bool start();   // Initial build, then periodic rebuilds
+    void stop();
+
+    // Never null once start() has run; an empty snapshot before the first successful build
+    std::shared_ptr<const CatalogSnapshot> snapshot() const;
+
+    bool rebuild();
+    void publish(std::shared_ptr<const CatalogSnapshot> snapshot);
+    CatalogStats getStats() const;
+
+private:
+    CatalogService();
+    ~CatalogService();
+    CatalogService(const CatalogService&) = delete;
+    CatalogService& operator=(const CatalogService&) = delete;
+
+    void loadClinics(CatalogSnapshot::Builder& builder) const;
+    void loadDoctors(CatalogSnapshot::Builder& builder) const;
+    void rebuildLoop();
+
+    CatalogConfig config_;
+
+    // Accessed only through std::atomic_load / std::atomic_store
+    std::shared_ptr<const CatalogSnapshot> current_;
+    std::atomic<std::uint64_t> version_{0};
+
+    std::atomic<bool> running_{false};
+    std::thread rebuild_thread_;
+    std::mutex rebuild_mutex_;
+    std::condition_variable rebuild_cv_;
+
+    mutable std::mutex stats_mutex_;
+    CatalogStats stats_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../models/Clinic.h"
+#include "../models/Doctor.h"
+#include "../utils/GeoDistance.h"
+#include "../utils/StringPool.h"
+
+namespace healthcare::services {
+
+// Loader-side view of one doctor; only what catalog scans need
+struct CatalogDoctorRecord {
+    std::string id;
+    std::string name;
+    std::vector<std::string> specializations;
+    std::vector<std::string> clinic_ids;
+    std::vector<models::ConsultationType> consultation_types;
+    models::DoctorStatus status = models::DoctorStatus::PENDING_VERIFICATION;
+    double consultation_fee = 0.0;
+    double rating = 0.0;
+    int total_reviews = 0;
+    bool is_available_today = false;
+};
+
+struct CatalogClinicRecord {
+    std::string id;
+    std::string name;
+    std::string city;
+    models::ClinicStatus status = models::ClinicStatus::PENDING_VERIFICATION;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double rating = 0.0;
+    bool has_emergency_services = false;
+};
+
+// Contiguous run of ids inside one of the snapshot's flattened list columns
+class CatalogIdRange {
+public:
+    CatalogIdRange(const std::uint32_t* begin, const std::uint32_t* end) : begin_(begin), end_(end) {}
+
+    const std::uint32_t* begin() const { return begin_; }
+    const std::uint32_t* end() const { return end_; }
+    size_t size() const { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+
+private:
+    const std::uint32_t* begin_;
+    const std::uint32_t* end_;
+};
+
+// Immutable, columnar copy of the doctor and clinic catalog. Rows are dense
+// indexes; each attribute is its own contiguous array, strings are ids into a
+// shared pool, and per-row lists are CSR ranges (offsets into one flat array).
+// Nothing is mutated after build(), so any number of threads may read a
+// snapshot without locking.
+class CatalogSnapshot {
+public:
+    static constexpr std::uint32_t kNoRow = UINT32_MAX;
+
+    // Bits of consultationMasks()
+    static constexpr std::uint8_t kOnline = 1;
+    static constexpr std::uint8_t kOffline = 2;
+
+    class Builder {
+    public:
+        Builder();
+
+        void reserve(size_t doctors, size_t clinics);
+        void addClinic(const CatalogClinicRecord& clinic);
+        void addDoctor(const CatalogDoctorRecord& doctor);
+
+        // Clinic references resolve here, so clinics and doctors may be added in any order
+        std::shared_ptr<const CatalogSnapshot> build(std::uint64_t version);
+
+    private:
+        std::unique_ptr<CatalogSnapshot> snapshot_;
+        std::vector<std::uint32_t> pending_clinic_refs_;  // Pool ids, resolved to rows in build()
+    };
+
+    std::uint64_t version() const { return version_; }
+    std::chrono::system_clock::time_point builtAt() const { return built_at_; }
+
+    size_t doctorCount() const { return doctor_ids_.size(); }
+    size_t clinicCount() const { return clinic_ids_.size(); }
+
+    std::uint32_t findDoctor(std::string_view doctor_id) const;
+    std::uint32_t findClinic(std::string_view clinic_id) const;
+
+    // Interned strings; filters can resolve a value once and compare ids while scanning
+    std::optional<std::uint32_t> findString(std::string_view value) const { return strings_.find(value); }
+    std::string_view string(std::uint32_t id) const { return strings_.view(id); }
+
+    // Doctor columns
+    std::string_view doctorId(std::uint32_t row) const { return strings_.view(doctor_ids_[row]); }
+    std::string_view doctorName(std::uint32_t row) const { return strings_.view(doctor_names_[row]); }
+    CatalogIdRange doctorSpecializations(std::uint32_t row) const;
+    CatalogIdRange doctorClinics(std::uint32_t row) const;  // Clinic rows
+
+    const std::vector<float>& doctorFees() const { return doctor_fees_; }
+    const std::vector<float>& doctorRatings() const { return doctor_ratings_; }
+    const std::vector<std::uint32_t>& doctorReviewCounts() const { return doctor_review_counts_; }
+    const std::vector<models::DoctorStatus>& doctorStatuses() const { return doctor_statuses_; }
+    const std::vector<std::uint8_t>& consultationMasks() const { return consultation_masks_; }
+    const std::vector<std::uint8_t>& availableToday() const { return available_today_; }
+
+    // Clinic columns
+    std::string_view clinicId(std::uint32_t row) const { return strings_.view(clinic_ids_[row]); }
+    std::string_view clinicName(std::uint32_t row) const { return strings_.view(clinic_names_[row]); }
+    std::uint32_t clinicCityId(std::uint32_t row) const { return clinic_cities_[row]; }
+
+    const utils::geo::CoordinateStore& clinicCoordinates() const { return clinic_coordinates_; }  // Indexed by clinic row
+    const std::vector<float>& clinicRatings() const { return clinic_ratings_; }
+    const std::vector<models::ClinicStatus>& clinicStatuses() const { return clinic_statuses_; }
+    const std::vector<std::uint8_t>& emergencyServices() const { return emergency_services_; }
+
+    size_t stringPoolBytes() const { return strings_.bytes(); }
+
+private:
+    CatalogSnapshot() = default;
+
+    std::uint64_t version_ = 0;
+    std::chrono::system_clock::time_point built_at_;
+
+    utils::StringPool strings_;
+
+    std::vector<std::uint32_t> doctor_ids_;
+    std::vector<std::uint32_t> doctor_names_;
+    std::vector<float> doctor_fees_;
+    std::vector<float> doctor_ratings_;
+    std::vector<std::uint32_t> doctor_review_counts_;
+    std::vector<models::DoctorStatus> doctor_statuses_;
+    std::vector<std::uint8_t> consultation_masks_;
+    std::vector<std::uint8_t> available_today_;
+    std::vector<std::uint32_t> specialization_offsets_;  // doctorCount() + 1 entries
+    std::vector<std::uint32_t> specializations_;
+    std::vector<std::uint32_t> clinic_offsets_;          // doctorCount() + 1 entries
+    std::vector<std::uint32_t> doctor_clinics_;
+
+    std::vector<std::uint32_t> clinic_ids_;
+    std::vector<std::uint32_t> clinic_names_;
+    std::vector<std::uint32_t> clinic_cities_;
+    utils::geo::CoordinateStore clinic_coordinates_;
+    std::vector<float> clinic_ratings_;
+    std::vector<models::ClinicStatus> clinic_statuses_;
+    std::vector<std::uint8_t> emergency_services_;
+
+    // Indexed by pool id; kNoRow for strings that are not doctor (clinic) ids
+    std::vector<std::uint32_t> doctor_rows_;
+    std::vector<std::uint32_t> clinic_rows_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../models/Clinic.h"
+#include "../models/ClinicSchedule.h"
+#include "../utils/GeoIndex.h"
+#include "../utils/Uuid.h"
+
+namespace healthcare::services {
+
+struct ClinicRegistryConfig {
+    int refresh_interval_seconds = 300;  // Clinics have no repository, so edits arrive with the next reload
+};
+
+// Compiled working hours, locations and doctor lists of operational clinics,
+// kept in memory for open-now checks and nearby listings. Loaded from Postgres
+// at start and reloaded in the background; every clinic registered here is
+// also indexed for doctor search.
+class ClinicRegistry {
+public:
+    static ClinicRegistry& getInstance();
+
+    void configure(const ClinicRegistryConfig& config);
+    bool start();   // Initial load, then periodic reloads
+    void stop();
+
+    bool reload();  // Upserts every clinic and drops the ones gone from Postgres
+    void registerClinic(const models::Clinic& clinic);
+    void removeClinic(const std::string& clinic_id);
+
+    std::optional<models::ClinicSchedule> findSchedule(const std::string& clinic_id) const;
+    std::vector<std::uint8_t> getClinicsOpenAt(const std::vector<std::string>& clinic_ids,
+                                               const std::chrono::system_clock::time_point& time) const;
+    std::vector<std::string> getOpenClinicIds(const std::chrono::system_clock::time_point& time) const;
+    // Doctors practising within the radius, listed at their nearest clinic first
+    std::vector<utils::Uuid> getDoctorsNear(double latitude, double longitude, double radius_km) const;
+    size_t size() const;
+
+private:
+    ClinicRegistry() = default;
+    ~ClinicRegistry();
+    ClinicRegistry(const ClinicRegistry&) = delete;
+    ClinicRegistry& operator=(const ClinicRegistry&) = delete;
+
+    static std::vector<models::Clinic> loadClinics();
+    void refreshLoop();
+
+    ClinicRegistryConfig config_;
+
+    models::ClinicScheduleTable schedules_;
+    utils::geo::GeoIndex locations_;
+    std::unordered_map<utils::Uuid, std::vector<utils::Uuid>> doctor_ids_;
+    mutable std::shared_mutex doctors_mutex_;
+
+    std::atomic<bool> running_{false};
+    std::thread refresh_thread_;
+    std::mutex refresh_mutex_;
+    std::condition_variable refresh_cv_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../models/Doctor.h"
+#include "../utils/RoaringBitmap.h"
+#include "../utils/Uuid.h"
+
+namespace healthcare::services {
+
+enum class Facet {
+    SPECIALIZATION = 0,
+    CITY = 1,
+    CONSULTATION_TYPE = 2,
+    FEE_BAND = 3
+};
+
+struct FacetCount {
+    std::string value;
+    std::uint64_t count = 0;
+};
+
+struct FacetQuery {
+    // Values are ORed within a facet and ANDed across facets; an empty list leaves the facet open
+    std::array<std::vector<std::string>, 4> selected;
+    // Restricts results to these doctors, e.g. the hits of a text search
+    std::optional<std::vector<std::string>> candidates;
+    size_t offset = 0;
+    size_t limit = 20;
+};
+
+struct FacetResult {
+    std::vector<std::string> doctor_ids;
+    std::uint64_t total = 0;
+    // Per facet, each value's count with every other facet's selection applied
+    std::array<std::vector<FacetCount>, 4> counts;
+};
+
+struct DoctorFacetStats {
+    size_t indexed_doctors = 0;
+    std::array<size_t, 4> distinct_values{};
+};
+
+// Faceted filtering over specialization, city, consultation type and fee band.
+// Each facet value owns a roaring bitmap of doctor ordinals, so a query is a
+// handful of bitmap intersections and every facet count is one intersection
+// cardinality, with no aggregate queries against Postgres. Doctors are
+// re-posted individually when they change.
+class DoctorFacetIndex {
+public:
+    static DoctorFacetIndex& getInstance();
+
+    // Index maintenance
+    void upsertDoctor(const models::Doctor& doctor, const std::vector<std::string>& cities);
+    bool updateCities(const std::string& doctor_id, const std::vector<std::string>& cities);
+    bool removeDoctor(const std::string& doctor_id);
+    void clear();
+
+    FacetResult query(const FacetQuery& query) const;
+
+    // Doctors per value of one facet; replaces the GROUP BY statistics queries
+    std::vector<FacetCount> countsFor(Facet facet) const;
+    std::uint64_t countFor(Facet facet, const std::string& value) const;
+
+    DoctorFacetStats getStats() const;
+
+    static std::string feeBand(double fee);
+    static std::optional<Facet> facetFromString(const std::string& name);
+    static std::string facetToString(Facet facet);
+
+    static constexpr size_t kFacetCount = 4;
+
+private:
+    DoctorFacetIndex() = default;
+    DoctorFacetIndex(const DoctorFacetIndex&) = delete;
+    DoctorFacetIndex& operator=(const DoctorFacetIndex&) = delete;
+
+    using FacetValues = std::array<std::vector<std::string>, kFacetCount>;
+
+    struct Posting {
+        std::uint32_t ordinal = 0;
+        FacetValues values;
+    };
+
+    void post(std::uint32_t ordinal, const FacetValues& values);
+    void unpost(std::uint32_t ordinal, const FacetValues& values);
+    std::vector<FacetCount> countValues(size_t facet, const utils::RoaringBitmap& within) const;
+
+    std::array<std::unordered_map<std::string, utils::RoaringBitmap>, kFacetCount> facets_;
+    utils::RoaringBitmap all_;
+
+    // Dense ordinals keep the bitmaps compact; freed ordinals are reused
+    std::unordered_map<utils::Uuid, Posting> postings_;
+    std::vector<utils::Uuid> ordinal_ids_;
+    std::vector<std::uint32_t> free_ordinals_;
+
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
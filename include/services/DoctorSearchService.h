@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../models/Clinic.h"
+#include "../models/Doctor.h"
+#include "../models/User.h"
+#include "../utils/TextSearchIndex.h"
+
+namespace healthcare::services {
+
+struct DoctorSearchResult {
+    std::string doctor_id;
+    std::string name;
+    std::vector<std::string> specializations;
+    float score = 0.0f;
+};
+
+struct DoctorSearchConfig {
+    int refresh_interval_seconds = 300;  // Picks up profile edits that no doctor write reports
+};
+
+struct DoctorSearchStats {
+    size_t indexed_doctors = 0;
+    size_t indexed_clinics = 0;
+    size_t distinct_tokens = 0;
+    std::uint64_t skipped_rows = 0;  // Doctor rows that failed to parse, across every load
+};
+
+// Search-as-you-type over doctor name, specialization, clinic name and city.
+// Doctors are bulk-loaded at start, reloaded in the background and re-read on
+// every doctor write; clinics arrive from ClinicRegistry. Renaming a clinic
+// reindexes only the doctors practising there. Queries never touch the DB.
+// Doctor changes are forwarded to DoctorFacetIndex so facet filters stay in step.
+class DoctorSearchService {
+public:
+    static DoctorSearchService& getInstance();
+
+    void configure(const DoctorSearchConfig& config);
+    bool start();   // Initial load, then periodic reloads
+    void stop();
+
+    // Index maintenance
+    bool reload();  // Reindexes every active doctor and drops the rest
+    void refreshDoctor(const std::string& doctor_id);  // Re-reads one doctor after a write
+    void indexDoctor(const models::Doctor& doctor, const models::User& profile);
+    bool removeDoctor(const std::string& doctor_id);
+    void indexClinic(const models::Clinic& clinic);
+    bool removeClinic(const std::string& clinic_id);
+    void clear();
+
+    std::vector<DoctorSearchResult> search(const std::string& query, size_t limit = kDefaultLimit) const;
+    // Display fields for ids produced elsewhere, e.g. facet filtering; unknown ids are skipped
+    std::vector<DoctorSearchResult> lookup(const std::vector<std::string>& doctor_ids) const;
+    DoctorSearchStats getStats() const;
+
+    static constexpr size_t kDefaultLimit = 20;
+    static constexpr size_t kMaxCandidates = 500;  // Text hits handed to facet filtering
+
+    // Field weights: a name hit outranks a specialization, which outranks location
+    static constexpr float kNameWeight = 1.0f;
+    static constexpr float kSpecializationWeight = 0.85f;
+    static constexpr float kClinicWeight = 0.6f;
+    static constexpr float kCityWeight = 0.5f;
+
+private:
+    DoctorSearchService() = default;
+    ~DoctorSearchService();
+    DoctorSearchService(const DoctorSearchService&) = delete;
+    DoctorSearchService& operator=(const DoctorSearchService&) = delete;
+
+    struct DoctorEntry {
+        std::string name;
+        std::string city;
+        std::vector<std::string> specializations;
+        std::vector<std::string> clinic_ids;
+    };
+
+    struct ClinicEntry {
+        std::string name;
+        std::string city;
+    };
+
+    std::vector<utils::SearchField> buildFields(const DoctorEntry& doctor) const;
+    std::vector<std::string> citiesOf(const DoctorEntry& doctor) const;
+    void reindexClinicDoctors(const std::string& clinic_id);
+
+    struct LoadedDoctor {
+        models::Doctor doctor;
+        models::User profile;
+    };
+    // Rows that fail to parse are logged, counted and their ids added to `skipped`
+    std::vector<LoadedDoctor> loadDoctors(std::unordered_set<std::string>& skipped,
+                                          const std::string& doctor_id = "");
+    void refreshLoop();
+
+    DoctorSearchConfig config_;
+
+    utils::TextSearchIndex index_;
+    std::unordered_map<std::string, DoctorEntry> doctors_;
+    std::unordered_map<std::string, ClinicEntry> clinics_;
+    mutable std::shared_mutex mutex_;
+    std::atomic<std::uint64_t> skipped_rows_{0};
+
+    std::atomic<bool> running_{false};
+    std::thread refresh_thread_;
+    std::mutex refresh_mutex_;
+    std::condition_variable refresh_cv_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
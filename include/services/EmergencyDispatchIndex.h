@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../models/Appointment.h"
+#include "../utils/GeoIndex.h"
+
+namespace healthcare::services {
+
+enum class DutyState : std::uint8_t {
+    OFF_DUTY = 0,
+    FREE = 1,
+    CLAIMED = 2,   // Reserved by an emergency dispatch, appointment not yet started
+    BUSY = 3       // Consultation in progress
+};
+
+struct EmergencyCandidate {
+    std::string doctor_id;
+    std::string clinic_id;
+    double distance_km = 0.0;
+    std::int64_t claim_stamp = 0;  // Set by claimNearest; bindClaim and release act only on this claim
+};
+
+struct EmergencyDispatchConfig {
+    int roster_refresh_interval_seconds = 60;  // Catches roster edits made through other instances
+    int claim_ttl_seconds = 120;  // A claim never bound to a stored appointment is dropped after this
+};
+
+// Appointment that keeps a doctor occupied, as read back from Postgres on a roster load
+struct OccupancyEntry {
+    std::string doctor_id;
+    std::string appointment_id;
+    bool in_progress = false;  // Otherwise an emergency appointment not yet finished, i.e. a bound claim
+};
+
+struct EmergencyDispatchStats {
+    size_t registered_doctors = 0;
+    size_t free_doctors = 0;
+    uint64_t claims_succeeded = 0;
+    uint64_t claims_contended = 0;  // CAS lost to a concurrent dispatch
+    uint64_t claims_failed = 0;     // No free doctor within radius
+    uint64_t claims_expired = 0;    // Unbound claims dropped after claim_ttl_seconds
+};
+
+// In-memory index of emergency-capable doctors (verified, attached to a clinic
+// with emergency services) with a geo index per city. The roster is loaded
+// from Postgres at start, refreshed in the background and patched on every
+// doctor write; each load also rebuilds occupancy from the appointments
+// in progress and the open emergency appointments. Lookups and claims take
+// only the shared roster lock: a claim CASes the doctor's claim stamp from 0,
+// then the duty state from FREE to CLAIMED, so two dispatches can never grab
+// the same doctor and neither waits on the other. A claim is tied to the
+// emergency appointment it books, and the doctor is only freed once that
+// appointment and every consultation in progress have finished; a claim that
+// is never bound expires after claim_ttl_seconds.
+class EmergencyDispatchIndex {
+public:
+    static EmergencyDispatchIndex& getInstance();
+
+    void configure(const EmergencyDispatchConfig& config);
+    bool start();   // Initial roster load, then periodic refresh
+    void stop();
+
+    // Roster maintenance
+    bool reloadRoster();
+    void refreshDoctor(const std::string& doctor_id);  // Re-reads one doctor after a write
+    void registerDoctor(const std::string& doctor_id, const std::string& clinic_id,
+                        const std::string& city, double latitude, double longitude, bool on_duty = true);
+    bool removeDoctor(const std::string& doctor_id);
+    bool setOnDuty(const std::string& doctor_id, bool on_duty);
+
+    // Occupancy updates driven by appointment state changes
+    void onAppointmentStatusChanged(const models::Appointment& appointment);
+    void onAppointmentRemoved(const std::string& appointment_id);
+    void restoreOccupancy(const std::vector<OccupancyEntry>& entries);  // Replaces what memory holds
+    size_t expireClaims(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    // Dispatch
+    std::optional<EmergencyCandidate> findNearestFree(const std::string& city, double latitude, double longitude,
+                                                      double max_radius_km = kDefaultRadiusKm) const;
+    std::optional<EmergencyCandidate> claimNearest(const std::string& city, double latitude, double longitude,
+                                                   double max_radius_km = kDefaultRadiusKm);
+    // False once the claim has expired, even if another dispatch has since claimed the doctor
+    bool bindClaim(const EmergencyCandidate& claim, const std::string& appointment_id);  // Before the appointment is stored
+    bool release(const EmergencyCandidate& claim);  // Drops the claim, e.g. when booking fails
+
+    std::vector<std::string> getFreeDoctorIds(const std::string& city) const;
+    std::optional<DutyState> getDutyState(const std::string& doctor_id) const;
+    EmergencyDispatchStats getStats() const;
+    void clear();
+
+    static constexpr double kDefaultRadiusKm = 25.0;
+    static constexpr double kCellSizeDegrees = 0.05;  // ~5.5 km of latitude
+    static constexpr size_t kNearestBatch = 8;        // Candidates fetched per nearest() round
+
+private:
+    EmergencyDispatchIndex() = default;
+    ~EmergencyDispatchIndex();
+    EmergencyDispatchIndex(const EmergencyDispatchIndex&) = delete;
+    EmergencyDispatchIndex& operator=(const EmergencyDispatchIndex&) = delete;
+
+    struct DutySlot {
+        std::string doctor_id;
+        std::string clinic_id;
+        std::string city;
+        std::atomic<DutyState> state{DutyState::FREE};
+        // steady_clock ticks when the current claim was taken, 0 when unclaimed. Claims set it
+        // with a CAS from 0; everything else changes it under occupancy_mutex
+        std::atomic<std::int64_t> claimed_at{0};
+
+        // Guarded by occupancy_mutex; state is derived from these and claimed_at unless the doctor is off duty
+        std::mutex occupancy_mutex;
+        std::string claim_appointment_id;                // Empty until bindClaim
+        std::unordered_set<std::string> in_progress;     // Appointment ids
+    };
+
+    struct RosterEntry {
+        std::string doctor_id;
+        std::string clinic_id;
+        std::string city;
+        double latitude;
+        double longitude;
+        bool on_duty;
+    };
+
+    template <typename Visitor>
+    void visitNearest(const std::string& city, double latitude, double longitude,
+                      double max_radius_km, Visitor&& visitor) const;
+
+    static std::vector<RosterEntry> loadRoster(const std::string& doctor_id = "");
+    static std::vector<OccupancyEntry> loadOccupancy();
+    static void dropClaim(DutySlot& slot);    // Caller holds occupancy_mutex
+    static std::string normalizeCity(const std::string& city);
+    static void settleState(DutySlot& slot);  // Caller holds occupancy_mutex
+    void detachSlot(const DutySlot& slot);
+    void refreshLoop();
+
+    EmergencyDispatchConfig config_;
+
+    std::unordered_map<std::string, std::unique_ptr<DutySlot>> slots_;
+    std::unordered_map<std::string, std::unique_ptr<utils::geo::GeoIndex>> cities_;
+    mutable std::shared_mutex mutex_;
+
+    std::atomic<bool> running_{false};
+    std::thread refresh_thread_;
+    std::mutex refresh_mutex_;
+    std::condition_variable refresh_cv_;
+
+    std::atomic<uint64_t> claims_succeeded_{0};
+    std::atomic<uint64_t> claims_contended_{0};
+    std::atomic<uint64_t> claims_failed_{0};
+    std::atomic<uint64_t> claims_expired_{0};
+};
+
+} // namespace healthcare::services
\ No newline at end of file
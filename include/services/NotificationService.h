@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../models/User.h"
 
 namespace healthcare::services {
@@ -17,6 +18,7 @@ public:
     bool sendPasswordChangeNotification(const models::User& user);
     bool sendAppointmentConfirmation(const std::string& user_id, const std::string& appointment_id);
     bool sendAppointmentReminder(const std::string& user_id, const std::string& appointment_id);
+    bool sendAppointmentDigest(const std::string& user_id, const std::vector<std::string>& appointment_ids);
     bool sendPushNotification(const std::string& fcm_token, const std::string& title, const std::string& body);
 };
 
@@ -3,6 +3,9 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <map>
+#include <optional>
+#include <chrono>
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 #include "../models/Appointment.h"
@@ -38,6 +41,7 @@ enum class PaymentError {
 
 struct PaymentRequest {
     std::string appointment_id;
+    std::string batch_id;  // Aggregated orders: the receipt names the batch instead of one appointment
     double amount;
     std::string currency = "INR";
     PaymentMethod method;
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "CatalogSnapshot.h"
+#include "../utils/Uuid.h"
+
+namespace healthcare::services {
+
+struct RankingConfig {
+    int rescore_interval_seconds = 30;         // Realign scores with the latest catalog snapshot
+    int stats_refresh_interval_seconds = 300;  // Re-aggregate booking volume from Postgres
+    int booking_window_days = 30;
+
+    // Static score blend
+    double rating_prior_reviews = 10.0;  // Bayesian prior: reviews' worth of the catalog mean
+    double rating_weight = 0.6;
+    double volume_weight = 0.4;
+
+    // Request-time blend
+    double static_weight = 0.6;
+    double distance_weight = 0.25;
+    double availability_weight = 0.15;
+    double distance_decay_km = 5.0;  // Distance score halves at this distance
+};
+
+struct RankingQuery {
+    std::optional<double> latitude;
+    std::optional<double> longitude;
+    double radius_km = 25.0;
+    std::string specialization;
+    std::optional<models::ConsultationType> consultation_type;
+    size_t limit = 20;
+};
+
+struct RankedDoctor {
+    std::string doctor_id;
+    std::string name;
+    float score = 0.0f;
+    float static_score = 0.0f;
+    std::optional<double> distance_km;
+    bool available_today = false;
+};
+
+struct RankingStats {
+    std::uint64_t catalog_version = 0;
+    size_t scored_doctors = 0;
+    std::uint64_t rescores = 0;
+    std::uint64_t stats_refreshes = 0;
+    std::uint64_t failed_stats_refreshes = 0;
+    std::chrono::system_clock::time_point last_stats_refresh;
+};
+
+// Doctor ranking split into a periodic and a per-request half. A background job
+// turns ratings and recent booking volume into a static score per catalog row;
+// a request then makes one pass over the catalog columns, folds in distance and
+// availability, and keeps the best `limit` rows in a bounded min-heap.
+class RankingService {
+public:
+    static RankingService& getInstance();
+
+    void configure(const RankingConfig& config);
+    bool start();
+    void stop();
+
+    std::vector<RankedDoctor> rank(const RankingQuery& query) const;
+
+    bool refreshBookingStats();
+    void rescore();
+    RankingStats getStats() const;
+
+private:
+    RankingService() = default;
+    ~RankingService();
+    RankingService(const RankingService&) = delete;
+    RankingService& operator=(const RankingService&) = delete;
+
+    // Scores are only meaningful against the snapshot they were computed from
+    struct ScoreTable {
+        std::shared_ptr<const CatalogSnapshot> catalog;
+        std::vector<float> static_scores;  // Indexed by catalog doctor row
+    };
+
+    void rankingLoop();
+
+    RankingConfig config_;
+
+    // Accessed only through std::atomic_load / std::atomic_store
+    std::shared_ptr<const ScoreTable> scores_;
+
+    mutable std::mutex bookings_mutex_;
+    std::unordered_map<utils::Uuid, std::uint32_t> recent_bookings_;
+
+    std::atomic<bool> running_{false};
+    std::thread ranking_thread_;
+    std::mutex ranking_mutex_;
+    std::condition_variable ranking_cv_;
+
+    mutable std::mutex stats_mutex_;
+    RankingStats stats_;
+};
+
+} // namespace healthcare::services
\ No newline at end of file
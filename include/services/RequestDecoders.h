@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+#include "BookingPartitioner.h"
+#include "BookingService.h"
+#include "PaymentService.h"
+#include "../utils/RequestSchema.h"
+
+namespace healthcare::services {
+
+// Schema-directed decoders for the request bodies on the booking routes and
+// the partition's node-to-node calls. Each parses the body once, validating
+// fields as they are read, and never builds a JSON DOM. On failure the errors
+// carry field paths and go straight to ResponseHelper::validationError.
+//
+// Identity fields (BookingRequest::user_id, BatchBookingRequest::user_id) are
+// not read from the body; callers fill them from the authenticated token. The
+// forwarded booking is the exception: it comes from a peer that already did so.
+utils::DecodeResult<BookingRequest> decodeBookingRequest(std::string_view body);
+utils::DecodeResult<BatchBookingRequest> decodeBatchBookingRequest(std::string_view body);
+utils::DecodeResult<SlotCheckRequest> decodeSlotCheckRequest(std::string_view body);
+utils::DecodeResult<BookingRequest> decodeForwardedBookingRequest(std::string_view body);
+utils::DecodeResult<ScheduleInvalidateRequest> decodeScheduleInvalidateRequest(std::string_view body);
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "RouteNormalizer.h"
+
+namespace healthcare::utils {
+
+struct AllocationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;  // Requested sizes, not allocator overhead
+
+    AllocationCounters operator-(const AllocationCounters& other) const {
+        return {allocations - other.allocations, bytes - other.bytes};
+    }
+};
+
+// Heap allocation accounting by endpoint. When built with
+// ENABLE_ALLOCATION_TRACKING, AllocationTracker.cpp replaces the global
+// operator new/delete; every allocation bumps counters in the calling
+// thread's shard under the endpoint the thread is currently serving
+// (LoggingMiddleware sets it for the length of a request). Shards are
+// single-writer, so the hot path is a thread-local load and two relaxed
+// load/store pairs; they are only summed when reported.
+//
+// Without the build option nothing is replaced and every count reads zero.
+// With it, counting still waits for setEnabled(true).
+class AllocationTracker {
+public:
+    using EndpointId = RouteNormalizer::EndpointId;
+
+    static constexpr EndpointId kNoEndpoint = RouteNormalizer::kMaxEndpoints;  // Outside any request
+    static constexpr size_t kMaxThreads = 256;  // Later threads share one contended shard
+
+    static bool isCompiledIn();
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Attributes this thread's allocations until reset to kNoEndpoint
+    static void setCurrentEndpoint(EndpointId endpoint);
+
+    // This thread's running totals; diff two reads to account one request
+    static AllocationCounters threadTotals();
+
+    static AllocationCounters endpointTotals(EndpointId endpoint);
+    static std::uint64_t totalFrees();
+
+    // process_heap_allocations_total / process_heap_allocated_bytes_total by endpoint
+    static void renderPrometheus(std::string& out);
+
+    // Called by the operator new/delete replacements
+    static void recordAllocation(std::size_t bytes) noexcept;
+    static void recordFree() noexcept;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <spdlog/sinks/sink.h>
+
+namespace healthcare::utils {
+
+// What a producer does when its ring has no room for a record
+enum class LogOverflowPolicy {
+    BLOCK,        // Wait for the writer thread; nothing is lost
+    DROP_OLDEST,  // Evict the oldest queued records to make room
+    SAMPLE        // Past the high-water mark keep one record in sample_every; drop when full
+};
+
+struct AsyncLogConfig {
+    size_t ring_bytes = 256 * 1024;  // Per producer thread, rounded up to a power of two
+    LogOverflowPolicy overflow = LogOverflowPolicy::DROP_OLDEST;
+    double sample_high_water = 0.75;  // Ring fill fraction where SAMPLE starts thinning
+    std::uint32_t sample_every = 8;
+    int drain_interval_ms = 20;  // Writer wakes at least this often
+};
+
+struct AsyncLogStats {
+    std::uint64_t enqueued = 0;
+    std::uint64_t written = 0;
+    std::uint64_t dropped = 0;      // Evicted by DROP_OLDEST or rejected by a full ring
+    std::uint64_t sampled_out = 0;  // Skipped by SAMPLE above the high-water mark
+    std::uint64_t truncated = 0;    // Payloads cut to fit half a ring
+    std::uint64_t blocked = 0;      // Producer waits under BLOCK
+    std::uint64_t batches = 0;
+    std::uint64_t tail_discarded = 0;     // Held by a request capture, then discarded
+    std::uint64_t capture_overflows = 0;  // Captures released early for size
+    size_t producer_threads = 0;
+};
+
+LogOverflowPolicy stringToLogOverflowPolicy(const std::string& policy);
+
+// spdlog sink that moves formatting and I/O off the calling thread. Each
+// producer thread owns a single-producer ring of pre-encoded binary records
+// (level, timestamp, thread id, then either a formatted payload or the typed
+// values of a structured record); logging is a bounds check and a memcpy.
+// One writer thread drains every ring, renders the records through the
+// wrapped sinks' patterns and flushes once per batch, so the request path
+// never waits on write() or fsync.
+//
+// Wrapped sinks are only touched by the writer thread (and set_pattern under
+// the same lock), so single-threaded `_st` sinks are sufficient.
+class AsyncLogSink final : public spdlog::sinks::sink {
+public:
+    AsyncLogSink(std::string logger_name, std::vector<spdlog::sink_ptr> sinks,
+                 const AsyncLogConfig& config = AsyncLogConfig());
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+
+    // Queues a LogRecordEncoder buffer as-is; the writer renders it to JSON.
+    // Unlike text payloads, oversized records are dropped rather than cut.
+    void logRecord(spdlog::level::level_enum level, std::string_view record);
+    void flush() override;  // Blocks until everything queued so far is written and flushed
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    // Tail-based retention for the calling thread: between the two calls its
+    // records are held back instead of queued. endCapture(true) queues them in
+    // order; endCapture(false) discards them unless one was logged at error or
+    // above. A capture that outgrows its buffer is released early and kept.
+    void beginCapture();
+    void endCapture(bool keep);
+
+    AsyncLogStats getStats() const;
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    struct RecordHeader;
+    class Ring;
+
+private:
+    Ring& threadRing();
+    void enqueue(Ring& ring, spdlog::level::level_enum level, std::uint16_t kind, std::int64_t time_ns,
+                 size_t thread_id, const char* payload, size_t payload_size);
+    void push(Ring& ring, const RecordHeader& header, const char* payload);
+    void notifyWriter();
+    void writerLoop();
+    bool drainOnce();  // True if any record was written
+
+    const std::string logger_name_;
+    const AsyncLogConfig config_;
+    const std::uint64_t sink_id_;
+
+    mutable std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::mutex sinks_mutex_;  // Wrapped sinks; held by the writer for a whole batch
+    std::vector<spdlog::sink_ptr> sinks_;
+    std::string scratch_;     // Writer-owned copy of the record being rendered
+    std::string rendered_;    // Writer-owned text of the last structured record
+
+    std::atomic<bool> running_{false};
+    std::thread writer_thread_;
+    std::mutex writer_mutex_;
+    std::condition_variable writer_cv_;
+    std::condition_variable flushed_cv_;
+    bool wake_requested_ = false;
+    std::uint64_t flush_requested_ = 0;  // Guarded by writer_mutex_
+    std::uint64_t flush_completed_ = 0;
+
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> batches_{0};
+    std::atomic<std::uint64_t> tail_discarded_{0};
+    std::atomic<std::uint64_t> capture_overflows_{0};
+    std::atomic<std::uint64_t> retired_enqueued_{0};  // Counters of rings whose threads exited
+    std::atomic<std::uint64_t> retired_dropped_{0};
+    std::atomic<std::uint64_t> retired_sampled_out_{0};
+    std::atomic<std::uint64_t> retired_truncated_{0};
+    std::atomic<std::uint64_t> retired_blocked_{0};
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
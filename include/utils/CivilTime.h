@@ -0,0 +1,138 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <chrono>
+#include <cstdint>
+
+namespace healthcare::utils::civil {
+
+// Calendar constants (all calendar math is done in whole minutes)
+constexpr int kMinutesPerHour = 60;
+constexpr int kMinutesPerDay = 24 * kMinutesPerHour;
+constexpr int kDaysPerWeek = 7;
+constexpr int kMinutesPerWeek = kDaysPerWeek * kMinutesPerDay;
+constexpr int kSecondsPerMinute = 60;
+constexpr std::int64_t kSecondsPerDay = 86400;
+constexpr int kInvalidMinute = -1;
+
+constexpr const char* kDefaultTimeZone = "Asia/Kolkata";
+
+// Day indices follow std::tm::tm_wday (SUNDAY = 0)
+enum DayIndex {
+    SUNDAY = 0,
+    MONDAY,
+    TUESDAY,
+    WEDNESDAY,
+    THURSDAY,
+    FRIDAY,
+    SATURDAY
+};
+
+struct CivilDate {
+    int year;
+    unsigned month;  // 1-12
+    unsigned day;    // 1-31
+};
+
+// Half-open range of minutes within a day: [start, end)
+struct MinuteRange {
+    int start = kInvalidMinute;
+    int end = kInvalidMinute;
+
+    bool isValid() const { return start >= 0 && end > start && end <= kMinutesPerDay; }
+    bool contains(int minute) const {
+        return static_cast<unsigned>(minute - start) < static_cast<unsigned>(end - start);
+    }
+};
+
+// Broken-down local time produced by toLocal()
+struct LocalTime {
+    std::int64_t local_days;  // Days since 1970-01-01 in the zone's local calendar
+    int minute_of_day;        // 0 - 1439
+    int day_of_week;          // SUNDAY = 0
+    int offset_minutes;       // UTC offset applied
+
+    int minuteOfWeek() const { return day_of_week * kMinutesPerDay + minute_of_day; }
+};
+
+// Time zone backed by a precomputed table of UTC offset transitions.
+// Fixed-offset zones (IST and most of Asia) carry a single entry and never search.
+class TimeZone {
+public:
+    struct Transition {
+        std::int64_t utc_seconds;  // First UTC second this offset applies
+        int offset_minutes;
+    };
+
+    TimeZone(const std::string& name, int offset_minutes);
+    TimeZone(const std::string& name, std::vector<Transition> transitions);
+
+    const std::string& getName() const { return name_; }
+    bool isFixedOffset() const { return transitions_.size() <= 1; }
+    int getFixedOffsetMinutes() const { return fixed_offset_minutes_; }
+    int offsetMinutesAt(std::int64_t utc_seconds) const;
+
+private:
+    std::string name_;
+    std::vector<Transition> transitions_;
+    int fixed_offset_minutes_;
+};
+
+// Process-wide registry of known zones. Zones are immutable once registered,
+// so references handed out stay valid for the lifetime of the process.
+class TimeZoneRegistry {
+public:
+    static TimeZoneRegistry& getInstance();
+
+    const TimeZone& get(const std::string& name) const;  // Falls back to the default zone
+    const TimeZone* find(const std::string& name) const;
+    const TimeZone& getDefault() const { return get(kDefaultTimeZone); }
+    bool registerZone(const TimeZone& zone);
+    std::vector<std::string> getZoneNames() const;
+
+private:
+    TimeZoneRegistry();
+    TimeZoneRegistry(const TimeZoneRegistry&) = delete;
+    TimeZoneRegistry& operator=(const TimeZoneRegistry&) = delete;
+
+    void registerBuiltinZones();
+
+    std::map<std::string, TimeZone, std::less<>> zones_;
+    mutable std::shared_mutex mutex_;
+};
+
+// Rule-based zone builders; transitions are precomputed for [first_year, last_year]
+TimeZone makeEuropeanZone(const std::string& name, int standard_offset_minutes,
+                          int first_year = 2000, int last_year = 2100);
+TimeZone makeNorthAmericanZone(const std::string& name, int standard_offset_minutes,
+                               int first_year = 2000, int last_year = 2100);
+
+// Day arithmetic (proleptic Gregorian calendar)
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor);
+std::int64_t daysFromCivil(int year, unsigned month, unsigned day);
+CivilDate civilFromDays(std::int64_t days);
+int weekdayFromDays(std::int64_t days);
+
+// Conversions between system_clock and local calendar time
+std::int64_t toUnixSeconds(const std::chrono::system_clock::time_point& time);
+LocalTime toLocal(const std::chrono::system_clock::time_point& time, const TimeZone& zone);
+std::chrono::system_clock::time_point fromLocal(std::int64_t local_days, int minute_of_day,
+                                                const TimeZone& zone);
+int minuteOfWeek(const std::chrono::system_clock::time_point& time, const TimeZone& zone);
+
+// Batch conversion: out[i] = minute of week of times[i]
+void minutesOfWeek(const std::chrono::system_clock::time_point* times, size_t count,
+                   const TimeZone& zone, int* out);
+
+// Parsing and formatting helpers
+int parseHHMM(std::string_view text);  // kInvalidMinute on malformed input; "24:00" is accepted
+std::string formatHHMM(int minute_of_day);
+int dayIndexFromName(std::string_view day_name);  // -1 when unknown
+const char* dayName(int day_index);
+
+} // namespace healthcare::utils::civil
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace healthcare::utils {
+
+// Consistent hash ring with virtual nodes. Adding or removing a node only
+// moves the keys adjacent to that node's points on the ring.
+class ConsistentHashRing {
+public:
+    static constexpr int kDefaultVirtualNodes = 128;
+
+    explicit ConsistentHashRing(int virtual_nodes = kDefaultVirtualNodes);
+
+    void addNode(const std::string& node_id);
+    bool removeNode(const std::string& node_id);
+    void setNodes(const std::vector<std::string>& node_ids);
+    void clear();
+
+    // Empty string when the ring has no nodes
+    const std::string& getOwner(std::string_view key) const;
+    bool hasNode(const std::string& node_id) const;
+    const std::vector<std::string>& getNodes() const { return nodes_; }
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+
+    static std::uint64_t hash(std::string_view key);
+
+private:
+    void rebuild();
+
+    int virtual_nodes_;
+    std::vector<std::string> nodes_;                        // Sorted node ids
+    std::vector<std::pair<std::uint64_t, size_t>> points_;  // (hash, index into nodes_), sorted by hash
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace healthcare::utils {
+
+struct ProfilerConfig {
+    bool enabled = false;      // Opt-in; capture() refuses while disabled
+    int default_hz = 100;
+    int max_hz = 1000;
+    int max_seconds = 60;
+    size_t buffer_mb = 16;     // Sample storage for one capture; samples past it are dropped
+    int max_stack_depth = 64;
+};
+
+enum class ProfileFormat {
+    FOLDED,  // "outer;...;leaf count" lines, for flamegraph.pl / speedscope
+    PPROF    // Legacy gperftools CPU profile, readable by `pprof`
+};
+
+struct CpuProfile {
+    bool success = false;
+    std::string error;
+
+    int frequency_hz = 0;
+    int duration_seconds = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t dropped = 0;
+
+    // Identical stacks merged; program counters leaf first, as captured
+    struct Stack {
+        std::vector<std::uintptr_t> frames;
+        std::uint64_t count = 0;
+    };
+    std::vector<Stack> stacks;
+
+    std::string toFolded() const;
+    std::string toPprof() const;
+};
+
+// Sampling CPU profiler. A process CPU-time timer (timer_create) raises
+// SIGPROF every 1/hz of CPU consumed, so busy threads are sampled in
+// proportion to the CPU they use. The handler walks the interrupted
+// thread's frame pointers and appends the stack to a preallocated buffer
+// with one atomic fetch_add; no locks or allocation in signal context.
+//
+// Stacks are only as good as the frame pointers: build with
+// ENABLE_FRAME_POINTERS (the default) and symbolization needs the
+// executable's symbols exported (ENABLE_EXPORTS in CMake). The walk never
+// leaves the sampled thread's own stack, whose bounds registerThread()
+// caches; threads that never registered contribute only their leaf frame.
+class CpuProfiler {
+public:
+    static CpuProfiler& getInstance();
+
+    void configure(const ProfilerConfig& config);
+    const ProfilerConfig& getConfig() const { return config_; }
+    bool isSupported() const;
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Blocks the caller for `seconds`, or until stop(); one capture at a time
+    CpuProfile capture(int seconds, int frequency_hz);
+    // Ends a running capture early with what it has sampled and refuses new ones
+    void stop();
+
+    // Caches the calling thread's stack bounds for the signal handler; cheap after the first call
+    static void registerThread();
+
+private:
+    CpuProfiler() = default;
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+    ProfilerConfig config_;
+    std::atomic<bool> running_{false};
+    std::mutex capture_mutex_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopped_ = false;
+};
+
+std::string profileFormatToString(ProfileFormat format);
+ProfileFormat stringToProfileFormat(const std::string& format_str);
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace healthcare::utils::geo {
+
+enum class DistanceKernel {
+    SCALAR,
+    AVX2
+};
+
+// Kernel picked once from the running CPU; AVX2 needs FMA as well
+DistanceKernel activeDistanceKernel();
+bool isDistanceKernelSupported(DistanceKernel kernel);
+const char* distanceKernelName(DistanceKernel kernel);
+
+// Great-circle distances in km from one query point to `count` coordinates given
+// as contiguous columns of latitude/longitude radians and cos(latitude).
+void batchDistanceKm(const double* latitude_radians, const double* longitude_radians,
+                     const double* cos_latitude, size_t count,
+                     double latitude, double longitude, double* out);
+void batchDistanceKm(DistanceKernel kernel,
+                     const double* latitude_radians, const double* longitude_radians,
+                     const double* cos_latitude, size_t count,
+                     double latitude, double longitude, double* out);
+
+// Structure-of-arrays coordinate columns with the trig terms precomputed at insert
+// time, so batch distance queries touch only contiguous doubles. Slots are dense:
+// removal moves the last coordinate into the freed slot. Not synchronized.
+class CoordinateStore {
+public:
+    void reserve(size_t capacity);
+    size_t add(double latitude, double longitude);
+    void set(size_t index, double latitude, double longitude);
+    void swapRemove(size_t index);
+    void clear();
+
+    size_t size() const { return latitude_.size(); }
+    bool empty() const { return latitude_.empty(); }
+    double latitude(size_t index) const { return latitude_[index]; }
+    double longitude(size_t index) const { return longitude_[index]; }
+
+    // `out` must hold size() doubles
+    void distancesFrom(double latitude, double longitude, double* out) const;
+    void distancesFrom(DistanceKernel kernel, double latitude, double longitude, double* out) const;
+
+private:
+    std::vector<double> latitude_;
+    std::vector<double> longitude_;
+    std::vector<double> latitude_radians_;
+    std::vector<double> longitude_radians_;
+    std::vector<double> cos_latitude_;
+};
+
+} // namespace healthcare::utils::geo
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "GeoDistance.h"
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace healthcare::utils::geo {
+
+constexpr double kEarthRadiusKm = 6371.0;
+constexpr double kKmPerDegreeLatitude = 111.195;  // Great-circle km per degree on the mean sphere
+
+// Latitude/longitude box in degrees. Boxes are clamped to the poles and to
+// [-180, 180] longitude; callers near the antimeridian get a conservative box.
+struct BoundingBox {
+    double min_latitude;
+    double max_latitude;
+    double min_longitude;
+    double max_longitude;
+
+    bool contains(double latitude, double longitude) const {
+        return latitude >= min_latitude && latitude <= max_latitude &&
+               longitude >= min_longitude && longitude <= max_longitude;
+    }
+};
+
+BoundingBox boundingBox(double latitude, double longitude, double radius_km);
+double haversineKm(double lat1, double lon1, double lat2, double lon2);
+
+struct GeoHit {
+    std::string id;
+    double distance_km;
+};
+
+// Uniform lat/lon cell grid over point entries (clinics). Each cell keeps its
+// coordinates as contiguous columns, so radius queries run the batch distance
+// kernel over only the cells under the bounding box.
+// Nearest-k queries expand rings of cells and stop once no closer point can exist.
+class GeoIndex {
+public:
+    static constexpr double kDefaultCellSizeDegrees = 0.1;  // ~11 km of latitude
+
+    explicit GeoIndex(double cell_size_degrees = kDefaultCellSizeDegrees);
+
+    // Incremental maintenance
+    void upsert(const std::string& id, double latitude, double longitude);
+    bool remove(const std::string& id);
+    void clear();
+    size_t size() const;
+
+    // Results are sorted by distance, nearest first
+    std::vector<GeoHit> queryRadius(double latitude, double longitude, double radius_km) const;
+    std::vector<GeoHit> nearest(double latitude, double longitude, size_t k, double max_radius_km) const;
+
+private:
+    struct Cell {
+        std::vector<std::string> ids;
+        CoordinateStore coordinates;
+    };
+
+    struct Location {
+        std::uint64_t cell;
+        size_t slot;
+    };
+
+    int cellIndex(double degrees) const;
+    static std::uint64_t cellKey(int lat_cell, int lon_cell);
+    void detach(const Location& location);
+
+    double cell_size_degrees_;
+    std::unordered_map<std::string, Location> index_;
+    std::unordered_map<std::uint64_t, Cell> cells_;
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace healthcare::utils::geo
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace healthcare::utils {
+
+// Pull parser over a JSON document held in memory. Callers walk the document
+// in order (peek at the next value, then read or skip it) so request bodies
+// can be decoded straight into typed structs without an intermediate DOM.
+// Keys without escapes are returned as views into the input. Accepts exactly
+// the RFC 8259 grammar nlohmann::json::parse accepts, including the UTF-8
+// check on strings.
+class JsonReader {
+public:
+    enum class ValueType {
+        OBJECT,
+        ARRAY,
+        STRING,
+        NUMBER,
+        BOOLEAN,
+        NULL_VALUE,
+        INVALID  // End of input or a character that cannot start a value
+    };
+
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    ValueType peek();
+
+    // Objects: beginObject(), then nextMember() until it returns false
+    bool beginObject();
+    bool nextMember(std::string_view& key);
+
+    // Arrays: beginArray(), then nextElement() until it returns false
+    bool beginArray();
+    bool nextElement();
+
+    bool readString(std::string& out);
+    bool readNumber(double& out);
+    bool readBool(bool& out);
+    bool skipValue();
+    bool readRaw(std::string_view& out);  // Skips the next value and returns its source text
+
+    // Succeeds if only whitespace follows the value read last
+    bool finish();
+
+    bool failed() const { return !error_.empty(); }
+    const std::string& error() const { return error_; }  // Includes the byte offset
+    size_t offset() const { return pos_; }
+
+    static constexpr int kMaxDepth = 64;
+
+private:
+    bool fail(const char* message);
+    void skipWhitespace();
+    bool parseString(std::string* out);  // Validates only when out is null
+    bool parseLiteral(std::string_view literal);
+    bool scanNumber(size_t& end);
+    bool skipValue(int depth);
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    bool first_member_ = false;  // Between beginObject() and its first member
+    bool first_element_ = false; // Between beginArray() and its first element
+    std::string key_buffer_;     // Unescaped keys that cannot be returned as views
+    std::string error_;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Uuid.h"
+
+namespace healthcare::utils {
+
+// Streaming JSON writer that appends straight into a caller-owned buffer, for
+// responses that would otherwise be built as an nlohmann::json DOM only to be
+// dumped. Output matches nlohmann's compact dump() byte for byte: same string
+// escaping, same shortest round-trip doubles, no whitespace. Object keys are
+// written in call order, so callers mirroring a DOM must emit keys in the
+// DOM's sorted order.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view name);
+
+    void value(std::string_view text);
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(const std::string& text) { value(std::string_view(text)); }
+    void value(bool flag);
+    void value(int number) { writeSigned(number); }
+    void value(long number) { writeSigned(number); }
+    void value(long long number) { writeSigned(number); }
+    void value(unsigned int number) { writeUnsigned(number); }
+    void value(unsigned long number) { writeUnsigned(number); }
+    void value(unsigned long long number) { writeUnsigned(number); }
+    void value(double number);  // Non-finite values are written as null, as nlohmann does
+    void value(float number) { value(static_cast<double>(number)); }
+    void value(const Uuid& id);  // The nil UUID is written as "", matching BaseEntity::idToString
+    void value(const std::chrono::system_clock::time_point& time);  // Seconds since epoch
+    void value(const std::vector<std::string>& strings);
+    void null();
+
+    template<typename T>
+    void field(std::string_view name, const T& field_value) {
+        key(name);
+        value(field_value);
+    }
+
+    // Lets a caller drop a value it has already written, e.g. an empty "data"
+    struct Checkpoint {
+        size_t size = 0;
+        std::uint64_t first_flags = 0;
+        int depth = 0;
+        bool after_key = false;
+    };
+    Checkpoint checkpoint() const { return {out_.size(), first_flags_, depth_, after_key_}; }
+    void rollback(const Checkpoint& checkpoint);
+
+    std::string& buffer() { return out_; }
+
+    static constexpr int kMaxDepth = 64;
+
+private:
+    void separate();
+    void open(char bracket);
+    void close(char bracket);
+    void writeSigned(long long number);
+    void writeUnsigned(unsigned long long number);
+    void writeEscaped(std::string_view text);
+
+    std::string& out_;
+    // Bit d is set while the container at depth d has no elements yet
+    std::uint64_t first_flags_ = 0;
+    int depth_ = 0;
+    bool after_key_ = false;
+};
+
+// Length of the well-formed UTF-8 sequence starting at `text`, or 0 if it is
+// malformed; shared by JsonWriter and JsonReader so both accept the same input
+size_t utf8SequenceLength(const unsigned char* text, size_t available);
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace healthcare::utils {
+
+// Static description of a structured log record: the event name and the
+// names of the values that follow, in order. Records only carry a pointer to
+// their format, so formats must have static storage duration.
+struct LogFormat {
+    LogFormat(std::string_view event_name, std::initializer_list<std::string_view> field_names)
+        : event(event_name), fields(field_names) {}
+
+    std::string_view event;
+    std::vector<std::string_view> fields;
+};
+
+// Packs a record's values as raw typed bytes: a one-byte tag, then an 8-byte
+// integer/double, a byte for bools, or a 32-bit length and the string bytes.
+// Nothing is formatted here; renderLogRecord() turns the bytes into JSON on
+// the log writer thread.
+class LogRecordEncoder {
+public:
+    enum Tag : std::uint8_t {
+        NULL_VALUE,
+        BOOLEAN,
+        SIGNED,
+        UNSIGNED,
+        DOUBLE,
+        STRING
+    };
+
+    void begin(const LogFormat& format);
+
+    void add(std::string_view text);
+    void add(const char* text) { add(std::string_view(text ? text : "")); }
+    void add(const std::string& text) { add(std::string_view(text)); }
+    void add(bool flag);
+    void add(int number) { addSigned(number); }
+    void add(long number) { addSigned(number); }
+    void add(long long number) { addSigned(number); }
+    void add(unsigned number) { addUnsigned(number); }
+    void add(unsigned long number) { addUnsigned(number); }
+    void add(unsigned long long number) { addUnsigned(number); }
+    void add(double number);
+    void add(std::nullptr_t);
+
+    std::string_view bytes() const { return buffer_; }
+
+private:
+    void addSigned(long long number);
+    void addUnsigned(unsigned long long number);
+
+    std::string buffer_;  // Capacity is reused across records on the same thread
+};
+
+// Appends the record as a single-line JSON object, {"event":...} followed by
+// the fields in format order. Invalid UTF-8 in strings is replaced with
+// U+FFFD. False if the bytes are not a well-formed record.
+bool renderLogRecord(std::string_view bytes, std::string& out);
+
+} // namespace healthcare::utils
\ No newline at end of file
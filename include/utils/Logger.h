@@ -3,9 +3,9 @@
 #include <string>
 #include <memory>
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/file_sinks.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
 #include <nlohmann/json.hpp>
+#include "AsyncLogSink.h"
+#include "LogRecord.h"
 
 namespace healthcare::utils {
 
@@ -20,13 +20,18 @@ enum class LogLevel {
 
 class Logger {
 public:
+    static constexpr const char* kDefaultPattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v";
+
     static Logger& getInstance();
     
-    // Configuration
+    // Configuration. Console and file output go through an AsyncLogSink, so
+    // callers only enqueue; formatting to the pattern and I/O happen on its
+    // writer thread.
     void configure(const std::string& level = "INFO", 
                   const std::string& log_file = "healthcare.log",
                   bool enable_console = true,
-                  const std::string& pattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v");
+                  const std::string& pattern = kDefaultPattern,
+                  const AsyncLogConfig& async_config = AsyncLogConfig());
     
     // Basic logging methods
     void trace(const std::string& message);
@@ -67,6 +72,18 @@ public:
         if (logger_) logger_->critical(format, std::forward<Args>(args)...);
     }
     
+    // Structured record with deferred formatting: the values are copied into
+    // the log ring as typed bytes and rendered to JSON on the writer thread.
+    // `format` must be a static; pass one value per format field, in order.
+    template<typename... Args>
+    void record(LogLevel level, const LogFormat& format, const Args&... args) {
+        if (!isLevelEnabled(level)) return;
+        static thread_local LogRecordEncoder encoder;
+        encoder.begin(format);
+        (encoder.add(args), ...);
+        submitRecord(level, encoder);
+    }
+
     // Structured logging with context
     void logWithContext(LogLevel level, const std::string& message, 
                        const nlohmann::json& context = {});
@@ -107,6 +124,11 @@ public:
                            const std::string& user_id, const std::string& doctor_id,
                            const nlohmann::json& details = {});
     
+    // Tail-based retention: lines logged on this thread in between are held
+    // back until the caller knows whether the request is worth keeping
+    void beginRequestCapture();
+    void endRequestCapture(bool keep);
+    
     // Utility methods
     void setLogLevel(LogLevel level);
     LogLevel getLogLevel() const;
@@ -124,11 +146,14 @@ private:
     Logger& operator=(const Logger&) = delete;
     
     std::shared_ptr<spdlog::logger> logger_;
+    std::shared_ptr<AsyncLogSink> async_sink_;
+    AsyncLogConfig async_config_;
     LogLevel current_level_ = LogLevel::INFO;
     std::string log_file_path_;
     bool console_enabled_ = true;
     
     // Helper methods
+    void submitRecord(LogLevel level, const LogRecordEncoder& encoder);
     std::string logLevelToString(LogLevel level) const;
     LogLevel stringToLogLevel(const std::string& level) const;
     nlohmann::json createLogContext(const std::string& event_type) const;
@@ -141,6 +166,8 @@ private:
 #define LOG_WARN(...) healthcare::utils::Logger::getInstance().warn(__VA_ARGS__)
 #define LOG_ERROR(...) healthcare::utils::Logger::getInstance().error(__VA_ARGS__)
 #define LOG_CRITICAL(...) healthcare::utils::Logger::getInstance().critical(__VA_ARGS__)
+#define LOG_RECORD(level, format, ...) \
+    healthcare::utils::Logger::getInstance().record(healthcare::utils::LogLevel::level, format, __VA_ARGS__)
 
 // Context logging macros
 #define LOG_REQUEST(method, endpoint, user_id) \
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace healthcare::utils {
+
+// Log-linear (HDR-style) latency histogram in microseconds: every power of
+// two is split into 16 linear sub-buckets, so any recorded value is known to
+// within 1/16 (6.25%) from 1us up to ~19 hours.
+//
+// Each thread records into its own shard, so record() is a few relaxed loads
+// and stores with no locks or read-modify-write contention. Shards are only
+// merged when a snapshot is taken. Histograms must outlive every thread that
+// records into them; the ones owned by MetricsRegistry live for the program.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+    static constexpr int kMaxExponent = 35;
+    static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+    static constexpr std::uint64_t kMaxTrackableMicros = (std::uint64_t{1} << (kMaxExponent + 1)) - 1;
+
+    struct Snapshot {
+        std::vector<std::uint64_t> buckets;
+        std::uint64_t count = 0;
+        std::uint64_t sum_ns = 0;
+        std::uint64_t max_us = 0;
+
+        // Upper edge of the bucket holding the q-th value, capped at the max seen
+        std::uint64_t quantileMicros(double q) const;
+    };
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::chrono::nanoseconds duration);
+    void recordMillis(double duration_ms);
+
+    Snapshot snapshot() const;
+
+    static size_t bucketIndex(std::uint64_t micros);
+    static std::uint64_t bucketUpperBound(size_t index);
+
+private:
+    struct Shard {
+        std::array<std::atomic<std::uint64_t>, kBucketCount> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> sum_ns{0};
+        std::atomic<std::uint64_t> max_us{0};
+    };
+
+    Shard& localShard();
+    Shard& attachShard(std::vector<Shard*>& thread_shards);
+
+    const size_t index_;  // Position in each thread's shard table
+    mutable std::mutex shards_mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;  // One per thread that has recorded
+};
+
+// Records the time from construction to destruction
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() { histogram_.record(std::chrono::steady_clock::now() - start_); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// One metric name with up to two labels, e.g. db_query_duration_seconds
+// {table, query}. Finding an existing series is lock-free; a new label
+// combination takes a mutex once. Past kMaxSeries combinations, new ones
+// share a single "(other)" series.
+class LatencyFamily {
+public:
+    static constexpr size_t kMaxSeries = 512;
+
+    LatencyFamily(std::string name, std::string help, std::vector<std::string> label_names);
+    LatencyFamily(const LatencyFamily&) = delete;
+    LatencyFamily& operator=(const LatencyFamily&) = delete;
+
+    LatencyHistogram& series(std::string_view first = {}, std::string_view second = {});
+
+    const std::string& name() const { return name_; }
+
+    // Prometheus text exposition, as a summary with p50/p90/p99/p99.9
+    void render(std::string& out) const;
+
+private:
+    static constexpr size_t kTableSize = kMaxSeries * 2;
+
+    struct Series {
+        std::string first;
+        std::string second;
+        LatencyHistogram histogram;
+    };
+
+    Series* find(std::string_view first, std::string_view second, std::uint64_t hash) const;
+    Series& insert(std::string_view first, std::string_view second, std::uint64_t hash);
+
+    std::string name_;
+    std::string help_;
+    std::vector<std::string> label_names_;
+
+    std::array<std::atomic<Series*>, kTableSize> slots_;
+    mutable std::mutex insert_mutex_;
+    std::vector<std::unique_ptr<Series>> series_;  // Registration order; guarded by insert_mutex_
+    std::unique_ptr<Series> other_;
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& getInstance();
+
+    // Returns the existing family when the name is already registered
+    LatencyFamily& latencyFamily(const std::string& name, const std::string& help,
+                                 std::vector<std::string> label_names = {});
+
+    // Appends metrics owned elsewhere (counters kept by other subsystems) to each scrape
+    void addCollector(std::function<void(std::string&)> collector);
+
+    std::string renderPrometheus() const;
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<LatencyFamily>> families_;
+    std::vector<std::function<void(std::string&)>> collectors_;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
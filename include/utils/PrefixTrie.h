@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace healthcare::utils {
+
+struct Suggestion {
+    std::string term;
+    std::int64_t weight;
+};
+
+// Compressed (radix) trie mapping case-folded terms to a display form and a
+// popularity weight. Every node caches the heaviest weight in its subtree, so
+// top-N completion is a best-first walk that visits only nodes that can still
+// contribute, independent of how many terms share the prefix.
+// Not synchronized; callers own locking.
+class PrefixTrie {
+public:
+    PrefixTrie();
+
+    // Inserts the term or replaces its weight and display form
+    void set(const std::string& term, std::int64_t weight);
+    // Adds to the weight, inserting the term at `delta` if it is new
+    void add(const std::string& term, std::int64_t delta);
+    bool remove(const std::string& term);
+    void clear();
+
+    std::optional<std::int64_t> weightOf(const std::string& term) const;
+    size_t size() const { return size_; }
+
+    std::vector<Suggestion> complete(const std::string& prefix, size_t limit) const;
+
+    static std::string foldKey(const std::string& term);
+
+private:
+    static constexpr std::int64_t kNoWeight = INT64_MIN;
+
+    struct Node {
+        std::string label;                  // Edge label from the parent
+        std::vector<std::uint32_t> children; // Sorted by first label byte
+        std::string display;
+        std::int64_t weight = kNoWeight;    // kNoWeight when no term ends here
+        std::int64_t best = kNoWeight;      // Heaviest weight in this subtree
+    };
+
+    std::uint32_t newNode(std::string label);
+    std::uint32_t findChild(std::uint32_t node, char first) const;
+    void insertChild(std::uint32_t parent, std::uint32_t child);
+    // Walks to the node for `key`, splitting edges and creating nodes as needed
+    std::uint32_t descendOrCreate(const std::string& key, std::vector<std::uint32_t>& path);
+    std::uint32_t descend(const std::string& key, std::vector<std::uint32_t>* path) const;
+    void refreshBest(const std::vector<std::uint32_t>& path);
+
+    std::vector<Node> nodes_;
+    size_t size_ = 0;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
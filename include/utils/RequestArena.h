@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace healthcare::utils {
+
+// Per-thread monotonic arena for scratch that dies with the request; today
+// that is the parameterized SQL in DatabaseManager::executeQuery and the
+// sanitized headers and query strings LoggingMiddleware logs. Allocation is
+// a pointer bump and nothing is freed piecemeal; LoggingMiddleware opens the
+// arena in before_handle and releases all of it at once at the end of
+// after_handle, the last hook to run before the response is written.
+//
+// Each thread keeps a 64 KB first buffer plus an unsynchronized pool for
+// overflow chunks, both reused by every request on that thread, so a warm
+// thread serves requests without touching malloc for this scratch.
+//
+// Memory from resource() must not outlive the request or leave its thread.
+// Outside a request resource() is the default heap resource, so code that
+// also runs on background threads can use it unconditionally.
+class RequestArena {
+public:
+    static constexpr size_t kInitialBufferSize = 64 * 1024;
+
+    // Resets any arena a previous request left open on this thread
+    static std::pmr::memory_resource* begin();
+    static void end();
+
+    static bool active();
+    static std::pmr::memory_resource* resource();
+
+    static std::pmr::string string() { return std::pmr::string(resource()); }
+    static std::pmr::string string(std::string_view text) { return std::pmr::string(text, resource()); }
+
+    // Per-thread counters, for sizing kInitialBufferSize
+    struct ThreadStats {
+        long long requests = 0;
+        long long overflowed_requests = 0;  // Needed chunks beyond the first buffer
+        size_t peak_overflow_bytes = 0;
+    };
+    static ThreadStats threadStats();
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
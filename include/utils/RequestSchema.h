@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "JsonReader.h"
+
+namespace healthcare::utils {
+
+enum class FieldType {
+    STRING,
+    NUMBER,
+    BOOLEAN,
+    OBJECT_ARRAY  // Array of objects, handed over as raw text for a nested schema to decode
+};
+
+struct FieldValue {
+    std::string text;
+    double number = 0.0;
+    bool flag = false;
+    std::vector<std::string_view> elements;  // Views into the request body
+};
+
+template<typename T>
+struct DecodeResult {
+    std::optional<T> value;
+    std::vector<std::string> errors;  // "<path>: <message>", ready for ResponseHelper::validationError
+
+    bool ok() const { return value.has_value(); }
+};
+
+// Decodes a JSON request body straight into T in one pass. Each declared field
+// is type-checked as it is read and handed to its setter, which stores it and
+// returns an error message (or "" to accept). Unknown members are skipped and
+// null counts as absent. Field errors accumulate; a syntax error stops decoding
+// and is reported against "body".
+template<typename T>
+class RequestSchema {
+public:
+    using Setter = std::function<std::string(T& target, FieldValue& value)>;
+    using Finisher = std::function<void(T& target, std::vector<std::string>& errors)>;
+
+    RequestSchema& field(std::string name, FieldType type, bool required, Setter setter) {
+        fields_.push_back({std::move(name), type, required, std::move(setter)});
+        return *this;
+    }
+
+    // Cross-field checks, run once every field decoded cleanly
+    RequestSchema& finish(Finisher finisher) {
+        finisher_ = std::move(finisher);
+        return *this;
+    }
+
+    DecodeResult<T> decode(std::string_view body, T target = T()) const {
+        DecodeResult<T> result;
+        JsonReader reader(body);
+        std::vector<bool> seen(fields_.size(), false);
+        FieldValue value;
+
+        if (reader.peek() != JsonReader::ValueType::OBJECT) {
+            result.errors.push_back("body: expected a JSON object");
+            return result;
+        }
+        reader.beginObject();
+
+        std::string_view key;
+        while (reader.nextMember(key)) {
+            const Field* field = find(key);
+            JsonReader::ValueType type = reader.peek();
+            if (field == nullptr || type == JsonReader::ValueType::NULL_VALUE) {
+                if (!reader.skipValue()) break;
+                continue;
+            }
+
+            if (type != expectedType(field->type)) {
+                result.errors.push_back(field->name + ": must be " + typeName(field->type));
+                if (!reader.skipValue()) break;
+                continue;
+            }
+            if (!read(reader, field, value, result.errors)) break;
+
+            seen[field - fields_.data()] = true;
+            std::string error = field->setter(target, value);
+            if (!error.empty()) {
+                result.errors.push_back(field->name + ": " + error);
+            }
+        }
+
+        if (!reader.finish()) {
+            result.errors.assign(1, "body: " + reader.error());
+            return result;
+        }
+
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            if (fields_[i].required && !seen[i]) {
+                result.errors.push_back(fields_[i].name + ": is required");
+            }
+        }
+        if (result.errors.empty() && finisher_) {
+            finisher_(target, result.errors);
+        }
+        if (result.errors.empty()) {
+            result.value = std::move(target);
+        }
+        return result;
+    }
+
+private:
+    struct Field {
+        std::string name;
+        FieldType type;
+        bool required;
+        Setter setter;
+    };
+
+    const Field* find(std::string_view name) const {
+        for (const auto& field : fields_) {
+            if (field.name == name) return &field;
+        }
+        return nullptr;
+    }
+
+    static JsonReader::ValueType expectedType(FieldType type) {
+        switch (type) {
+            case FieldType::STRING: return JsonReader::ValueType::STRING;
+            case FieldType::NUMBER: return JsonReader::ValueType::NUMBER;
+            case FieldType::BOOLEAN: return JsonReader::ValueType::BOOLEAN;
+            case FieldType::OBJECT_ARRAY: return JsonReader::ValueType::ARRAY;
+        }
+        return JsonReader::ValueType::INVALID;
+    }
+
+    static const char* typeName(FieldType type) {
+        switch (type) {
+            case FieldType::STRING: return "a string";
+            case FieldType::NUMBER: return "a number";
+            case FieldType::BOOLEAN: return "a boolean";
+            case FieldType::OBJECT_ARRAY: return "an array of objects";
+        }
+        return "a value";
+    }
+
+    // False only on a syntax error; member type errors are recorded and skipped
+    static bool read(JsonReader& reader, const Field* field, FieldValue& value, std::vector<std::string>& errors) {
+        switch (field->type) {
+            case FieldType::STRING: return reader.readString(value.text);
+            case FieldType::NUMBER: return reader.readNumber(value.number);
+            case FieldType::BOOLEAN: return reader.readBool(value.flag);
+            case FieldType::OBJECT_ARRAY: {
+                value.elements.clear();
+                reader.beginArray();
+                std::string_view element;
+                while (reader.nextElement()) {
+                    if (reader.peek() != JsonReader::ValueType::OBJECT) {
+                        errors.push_back(field->name + "[" + std::to_string(value.elements.size()) + "]: must be an object");
+                    }
+                    if (!reader.readRaw(element)) return false;
+                    value.elements.push_back(element);
+                }
+                return !reader.failed();
+            }
+        }
+        return false;
+    }
+
+    std::vector<Field> fields_;
+    Finisher finisher_;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
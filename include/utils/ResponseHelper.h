@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <nlohmann/json.hpp>
 #include <crow/http_response.h>
 #include <chrono>
+#include "JsonWriter.h"
 
 namespace healthcare::utils {
 
@@ -148,6 +150,15 @@ public:
                                                const std::string& message = "Data retrieved successfully",
                                                const std::string& request_id = "");
     
+    // Streamed success: `write_data` writes the data value straight into the body,
+    // giving the same bytes as success()/successWithPagination() without a DOM
+    static crow::response streamSuccess(const std::function<void(JsonWriter&)>& write_data,
+                                        const std::string& message = "Operation successful");
+
+    static crow::response streamSuccessWithPagination(const std::function<void(JsonWriter&)>& write_data,
+                                                      const PaginationInfo& pagination,
+                                                      const std::string& message = "Data retrieved successfully");
+    
     // Error responses
     static crow::response error(ErrorCode error_code,
                                const std::string& message,
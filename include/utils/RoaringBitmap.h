@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace healthcare::utils {
+
+// Compressed set of 32-bit ids in the roaring layout: ids are grouped by their
+// high 16 bits, and each group is a sorted array of low halves while sparse
+// (<= 4096 entries) or a 65536-bit bitmap once dense. Intersections work
+// container by container and pick the cheapest algorithm for each pair.
+class RoaringBitmap {
+public:
+    void add(std::uint32_t value);
+    bool remove(std::uint32_t value);
+    bool contains(std::uint32_t value) const;
+    void clear() { containers_.clear(); }
+
+    bool empty() const { return containers_.empty(); }
+    std::uint64_t cardinality() const;
+
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+
+    // |this & other| without materializing the intersection
+    std::uint64_t andCardinality(const RoaringBitmap& other) const;
+
+    std::vector<std::uint32_t> toVector() const;
+
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& container : containers_) {
+            std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+            if (container.is_bitmap) {
+                for (size_t word = 0; word < kBitmapWords; ++word) {
+                    std::uint64_t bits = container.bitmap[word];
+                    while (bits != 0) {
+                        func(high | static_cast<std::uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                        bits &= bits - 1;
+                    }
+                }
+            } else {
+                for (std::uint16_t low : container.array) {
+                    func(high | low);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kArrayLimit = 4096;
+    static constexpr size_t kBitmapWords = 1024;
+
+    struct Container {
+        std::uint16_t key = 0;
+        bool is_bitmap = false;
+        std::uint32_t count = 0;
+        std::vector<std::uint16_t> array;   // Sorted, when !is_bitmap
+        std::vector<std::uint64_t> bitmap;  // kBitmapWords words, when is_bitmap
+
+        bool contains(std::uint16_t low) const;
+    };
+
+    Container* find(std::uint16_t key);
+    const Container* find(std::uint16_t key) const;
+
+    static void toBitmap(Container& container);
+    static void toArray(Container& container);
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static std::uint64_t intersectCount(const Container& a, const Container& b);
+
+    std::vector<Container> containers_;  // Sorted by key
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
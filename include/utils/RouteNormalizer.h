@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace healthcare::utils {
+
+// Maps request paths to interned endpoint templates ("/api/v1/doctors/:id")
+// in one pass over the path. Segments that are a UUID or all digits become
+// ":id"; the query string is ignored. Endpoint ids are dense and small, so
+// per-endpoint stats can live in plain arrays of kMaxEndpoints.
+//
+// Lookups of known endpoints are lock-free and never allocate. A new
+// endpoint takes a mutex once to be published; after kMaxEndpoints distinct
+// templates (or for paths longer than kMaxPathLength) everything maps to
+// kOtherEndpoint. Callers intern a path only once a route has answered it
+// (lookup() first, normalize() after the handler), so scanners probing
+// random URLs cannot fill the table.
+class RouteNormalizer {
+public:
+    using EndpointId = std::uint32_t;
+
+    static constexpr EndpointId kOtherEndpoint = 0;
+    static constexpr size_t kMaxEndpoints = 512;
+    static constexpr size_t kMaxPathLength = 128;
+
+    static RouteNormalizer& getInstance();
+
+    EndpointId normalize(std::string_view path);     // Interns the template if it is new
+    EndpointId lookup(std::string_view path) const;  // kOtherEndpoint if not yet interned
+    std::string_view name(EndpointId id) const;  // Stable for the life of the process
+
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+    std::uint64_t overflowCount() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    RouteNormalizer();
+    RouteNormalizer(const RouteNormalizer&) = delete;
+    RouteNormalizer& operator=(const RouteNormalizer&) = delete;
+
+    static constexpr size_t kTableSize = kMaxEndpoints * 2;  // Power of two, at most half full
+
+    struct Entry {
+        char name[kMaxPathLength];
+        std::uint8_t length = 0;
+
+        std::string_view view() const { return std::string_view(name, length); }
+    };
+
+    // Writes the template into buffer; false if it does not fit in kMaxPathLength
+    bool buildKey(std::string_view path, char* buffer, size_t& length) const;
+    EndpointId find(std::string_view key, std::uint64_t hash) const;
+    EndpointId insert(std::string_view key, std::uint64_t hash);
+
+    std::unique_ptr<Entry[]> entries_;                    // Indexed by EndpointId
+    std::array<std::atomic<EndpointId>, kTableSize> slots_;  // 0 is empty; kOtherEndpoint is never stored
+    std::atomic<size_t> count_{1};
+    std::atomic<std::uint64_t> overflows_{0};
+    std::mutex insert_mutex_;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace healthcare::utils {
+
+// Append-only interning pool. Every distinct string is stored once in a single
+// character buffer and named by a dense 32-bit id, so columns can hold ids
+// instead of std::string and compare them with integer equality. Lookups probe
+// an open-addressing table of ids and never allocate.
+class StringPool {
+public:
+    StringPool();
+
+    std::uint32_t intern(std::string_view value);
+    std::optional<std::uint32_t> find(std::string_view value) const;
+    std::string_view view(std::uint32_t id) const;
+
+    size_t size() const { return offsets_.size() - 1; }
+    size_t bytes() const { return chars_.size(); }
+
+    // Drops build-time slack once the pool will no longer grow
+    void shrinkToFit();
+
+private:
+    static constexpr std::uint32_t kEmptySlot = UINT32_MAX;
+
+    static std::uint64_t hash(std::string_view value);
+    size_t slotFor(std::string_view value, std::uint64_t hash_value) const;
+    void grow();
+
+    std::string chars_;
+    std::vector<std::uint32_t> offsets_;  // offsets_[id] .. offsets_[id + 1]
+    std::vector<std::uint32_t> slots_;    // Power-of-two table of ids
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
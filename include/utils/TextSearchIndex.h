@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace healthcare::utils {
+
+struct SearchField {
+    std::string text;
+    float weight = 1.0f;
+};
+
+struct SearchHit {
+    std::string id;
+    float score;
+};
+
+struct SearchOptions {
+    size_t limit = 10;
+    float min_similarity = 0.35f;  // Trigram similarity a misspelled token needs to count as a match
+    bool prefix_last_token = true; // Treat the last query token as still being typed
+};
+
+// In-memory inverted index for search-as-you-type. Text is lowercased and split
+// into tokens; each distinct token is indexed once by its padded trigrams
+// (pg_trgm style) and points at the documents and fields that contain it.
+//
+// A query token matches an indexed token exactly, as a prefix, or by trigram
+// similarity (typo tolerance). Every query token must match; a document's score
+// is the sum of its best field-weighted match per query token, and only the top
+// `limit` documents are materialized.
+class TextSearchIndex {
+public:
+    void upsert(const std::string& id, const std::vector<SearchField>& fields);
+    bool remove(const std::string& id);
+    void clear();
+
+    size_t size() const;
+    size_t tokenCount() const;
+
+    std::vector<SearchHit> search(const std::string& query, const SearchOptions& options = {}) const;
+
+    static std::vector<std::string> tokenize(const std::string& text);
+
+private:
+    struct Posting {
+        std::uint32_t document;
+        float weight;
+    };
+
+    struct Token {
+        std::string text;
+        std::vector<std::uint32_t> trigrams;
+        std::vector<Posting> postings;
+    };
+
+    struct Document {
+        std::string id;
+        std::vector<std::uint32_t> tokens;
+    };
+
+    static std::vector<std::uint32_t> trigramsOf(const std::string& token, bool include_suffix);
+    std::uint32_t internToken(const std::string& text);
+    void releaseToken(std::uint32_t token_id, std::uint32_t document);
+    void detach(std::uint32_t document);
+
+    std::vector<Document> documents_;
+    std::vector<std::uint32_t> free_documents_;
+    std::unordered_map<std::string, std::uint32_t> document_ids_;
+
+    std::vector<Token> tokens_;
+    std::vector<std::uint32_t> free_tokens_;
+    std::unordered_map<std::string, std::uint32_t> token_ids_;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> trigram_postings_;
+
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace healthcare::utils {
+
+struct TracingConfig {
+    bool enabled = false;
+    double sample_rate = 0.1;          // Fraction of requests whose spans are recorded
+    double slow_threshold_ms = 500.0;  // Recorded traces at least this slow (or 5xx) are exported
+    size_t max_spans = 256;            // Per request; later spans are counted as dropped
+    size_t max_queued_traces = 256;    // Exporter backlog; further traces are dropped
+    std::string service_name = "healthcare-booking";
+    std::string export_file;           // OTLP JSON, one ExportTraceServiceRequest per line
+    std::string collector_url;         // OTLP/HTTP JSON endpoint, e.g. http://localhost:4318/v1/traces
+    int collector_timeout_ms = 2000;
+};
+
+struct TracingStats {
+    long long requests = 0;
+    long long sampled = 0;
+    long long exported = 0;
+    long long dropped_spans = 0;
+    long long dropped_traces = 0;
+    long long export_failures = 0;
+};
+
+enum class SpanKind : std::uint8_t {
+    INTERNAL = 1,
+    SERVER = 2,
+    CLIENT = 3
+};
+
+// One timed operation. Names and attribute keys must be string literals;
+// values are copied (ASCII only, truncated) so nothing dangles when the trace
+// is exported after the request.
+struct SpanRecord {
+    static constexpr size_t kMaxAttributes = 3;
+    static constexpr size_t kMaxValueLength = 47;
+    static constexpr std::uint32_t kNoParent = 0xffffffff;
+
+    struct Attribute {
+        const char* key = nullptr;
+        std::uint8_t length = 0;
+        char value[kMaxValueLength];
+    };
+
+    const char* name = nullptr;
+    std::uint64_t span_id = 0;
+    std::uint32_t parent = kNoParent;  // Index into the trace's spans
+    SpanKind kind = SpanKind::INTERNAL;
+    bool error = false;
+    std::uint8_t attribute_count = 0;
+    std::int64_t start_ns = 0;  // steady_clock
+    std::int64_t end_ns = 0;
+    std::array<Attribute, kMaxAttributes> attributes;
+};
+
+// Request-scoped tracing. LoggingMiddleware opens a trace per request; spans
+// opened anywhere on the same thread until the trace ends nest under it via a
+// thread-local cursor. Spans are written into a per-thread buffer reserved
+// once and reused by every request on that thread. When head sampling skips
+// a request, opening a span is a single thread-local load.
+//
+// Traces that turn out slow (or fail with 5xx) are handed to a background
+// exporter that writes OTLP JSON to a file and/or POSTs it to a collector.
+class Tracer {
+public:
+    static Tracer& getInstance();
+
+    void configure(const TracingConfig& config);
+    bool start();
+    void stop();
+
+    // Trace id is derived from request_id so traces join up with the log lines
+    void beginTrace(std::string_view request_id, std::string_view method, std::string_view route);
+    void endTrace(int status_code);
+
+    TracingStats getStats() const;
+
+private:
+    Tracer() = default;
+    ~Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    struct FinishedTrace {
+        std::array<std::uint8_t, 16> trace_id;
+        std::int64_t unix_offset_ns = 0;  // Added to steady_clock stamps
+        std::vector<SpanRecord> spans;
+    };
+
+    void exportLoop();
+    void exportTrace(const FinishedTrace& trace);
+    void renderTrace(const FinishedTrace& trace, std::string& out) const;
+
+    TracingConfig config_;
+    std::atomic<bool> enabled_{false};
+
+    std::thread exporter_thread_;
+    std::atomic<bool> running_{false};
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<FinishedTrace> queue_;
+
+    std::atomic<long long> requests_{0};
+    std::atomic<long long> sampled_{0};
+    std::atomic<long long> exported_{0};
+    std::atomic<long long> dropped_spans_{0};
+    std::atomic<long long> dropped_traces_{0};
+    std::atomic<long long> export_failures_{0};
+
+    friend class TraceSpan;
+};
+
+// Times a scope as a child of the current span; does nothing when the
+// thread has no sampled trace
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, SpanKind kind = SpanKind::INTERNAL);
+    TraceSpan(const char* name, SpanKind kind, const char* key, std::string_view value);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void setAttribute(const char* key, std::string_view value);
+    void setError();
+    bool recording() const;  // False when unsampled; skip building attributes then
+
+private:
+    std::uint32_t index_ = SpanRecord::kNoParent;
+};
+
+} // namespace healthcare::utils
\ No newline at end of file
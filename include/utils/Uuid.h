@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace healthcare::utils {
+
+// 128-bit identifier stored as 16 raw bytes in RFC 4122 order, so comparisons
+// are two 64-bit compares and ordering matches Postgres' uuid ordering. Text
+// form is only produced at the JSON/SQL boundary; parse and format decode all
+// 32 hex digits with SSE2 where available.
+class Uuid {
+public:
+    static constexpr size_t kStringLength = 36;
+
+    constexpr Uuid() = default;
+    explicit Uuid(const std::array<std::uint8_t, 16>& bytes);
+
+    static Uuid generate();  // Random (version 4)
+
+    // Accepts the canonical 8-4-4-4-12 form in either case
+    static std::optional<Uuid> parse(std::string_view text);
+    // As parse(), but throws std::invalid_argument for malformed input
+    static Uuid fromString(std::string_view text);
+
+    std::string toString() const;
+    void format(char* out) const;  // Writes exactly kStringLength characters, lowercase
+
+    bool isNil() const { return high_ == 0 && low_ == 0; }
+    std::array<std::uint8_t, 16> bytes() const;
+    size_t hash() const;
+
+    bool operator==(const Uuid& other) const { return high_ == other.high_ && low_ == other.low_; }
+    bool operator!=(const Uuid& other) const { return !(*this == other); }
+    bool operator<(const Uuid& other) const {
+        return high_ != other.high_ ? high_ < other.high_ : low_ < other.low_;
+    }
+
+private:
+    // Big-endian halves: high_ holds bytes 0..7, low_ bytes 8..15
+    std::uint64_t high_ = 0;
+    std::uint64_t low_ = 0;
+};
+
+struct UuidHash {
+    size_t operator()(const Uuid& uuid) const { return uuid.hash(); }
+};
+
+} // namespace healthcare::utils
+
+namespace std {
+
+template<>
+struct hash<healthcare::utils::Uuid> {
+    size_t operator()(const healthcare::utils::Uuid& uuid) const { return uuid.hash(); }
+};
+
+} // namespace std
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "../../include/database/AppointmentRepository.h"
+#include "../../include/utils/CivilTime.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace healthcare::database {
+
+namespace {
+
+// TIMESTAMP columns hold UTC wall time
+std::string formatSqlTimestamp(const std::chrono::system_clock::time_point& time) {
+    std::int64_t seconds = utils::civil::toUnixSeconds(time);
+    std::int64_t days = utils::civil::floorDiv(seconds, utils::civil::kSecondsPerDay);
+    int second_of_day = static_cast<int>(seconds - days * utils::civil::kSecondsPerDay);
+    auto date = utils::civil::civilFromDays(days);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02d:%02d:%02d",
+                  date.year, date.month, date.day,
+                  second_of_day / 3600, (second_of_day / 60) % 60, second_of_day % 60);
+    return buffer;
+}
+
+// Postgres array literal with every element double-quoted
+template <typename Range, typename Format>
+std::string buildArrayLiteral(const Range& items, Format&& format) {
+    std::ostringstream literal;
+    literal << "{";
+    bool first = true;
+    for (const auto& item : items) {
+        if (!first) literal << ",";
+        literal << "\"" << format(item) << "\"";
+        first = false;
+    }
+    literal << "}";
+    return literal.str();
+}
+
+// Inverse of formatSqlTimestamp; fractional seconds are dropped
+std::chrono::system_clock::time_point parseSqlTimestamp(const std::string& text) {
+    int year = 1970;
+    unsigned month = 1, day = 1;
+    int hour = 0, minute = 0, second = 0;
+    std::sscanf(text.c_str(), "%d-%u-%u %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+
+    std::int64_t seconds = utils::civil::daysFromCivil(year, month, day) * utils::civil::kSecondsPerDay +
+                           hour * 3600 + minute * 60 + second;
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+const std::vector<const char*> kTimestampColumns = {
+    "created_at", "updated_at", "appointment_date", "start_time", "end_time",
+    "booked_at", "confirmed_at", "follow_up_date"
+};
+
+const std::vector<const char*> kTextColumns = {
+    "id", "user_id", "doctor_id", "clinic_id", "type", "status", "symptoms", "notes",
+    "patient_age", "patient_gender", "confirmation_code", "prescription_id", "follow_up_notes"
+};
+
+const std::vector<const char*> kJsonColumns = {"payment_info", "consultation_info", "cancellation_info"};
+
+} // namespace
+
+// Custom queries
+
+QueryResult<models::Appointment> AppointmentRepository::findByUserId(const std::string& user_id) {
+    return findWhere("findByUserId", "user_id = $1", {user_id}, "start_time DESC");
+}
+
+QueryResult<models::Appointment> AppointmentRepository::findByDoctorId(const std::string& doctor_id) {
+    return findWhere("findByDoctorId", "doctor_id = $1", {doctor_id});
+}
+
+QueryResult<models::Appointment> AppointmentRepository::findByClinicId(const std::string& clinic_id) {
+    return findWhere("findByClinicId", "clinic_id = $1", {clinic_id});
+}
+
+QueryResult<models::Appointment> AppointmentRepository::findByDateRange(const std::chrono::system_clock::time_point& start,
+                                                                        const std::chrono::system_clock::time_point& end) {
+    return findWhere("findByDateRange", "start_time >= $1 AND start_time < $2",
+                     {formatSqlTimestamp(start), formatSqlTimestamp(end)});
+}
+
+QueryResult<models::Appointment> AppointmentRepository::findUpcomingAppointments(const std::string& user_id) {
+    return findWhere("findUpcomingAppointments",
+                     "user_id = $1 AND start_time > $2 AND status IN ('PENDING', 'CONFIRMED')",
+                     {user_id, formatSqlTimestamp(std::chrono::system_clock::now())});
+}
+
+QueryResult<models::Appointment> AppointmentRepository::findByStatus(models::AppointmentStatus status) {
+    return findWhere("findByStatus", "status = $1", {models::appointmentStatusToString(status)});
+}
+
+// Check availability
+
+bool AppointmentRepository::isTimeSlotAvailable(const std::string& doctor_id,
+                                                const std::chrono::system_clock::time_point& start_time,
+                                                const std::chrono::system_clock::time_point& end_time) {
+    // Same overlap rule as findConflictingSlots; a failed query reports the slot as taken
+    auto overlapping = countWhere("isTimeSlotAvailable",
+                                  "doctor_id = $1 AND status IN ('PENDING', 'CONFIRMED', 'IN_PROGRESS') "
+                                  "AND start_time < $3 AND end_time > $2",
+                                  {doctor_id, formatSqlTimestamp(start_time), formatSqlTimestamp(end_time)});
+    return overlapping.has_value() && *overlapping == 0;
+}
+
+std::vector<size_t> AppointmentRepository::findConflictingSlots(const std::vector<SlotRange>& slots,
+                                                                DatabaseManager::Transaction& transaction) {
+    std::vector<size_t> conflicts;
+    if (slots.empty()) {
+        return conflicts;
+    }
+
+    return executeWithTiming("findConflictingSlots", [&]() {
+        try {
+            auto& work = transaction.getWork();
+
+            // Serialize concurrent batches per doctor; locks are taken in sorted order to avoid deadlocks
+            std::vector<std::string> doctor_ids;
+            for (const auto& slot : slots) {
+                doctor_ids.push_back(slot.doctor_id);
+            }
+            std::sort(doctor_ids.begin(), doctor_ids.end());
+            doctor_ids.erase(std::unique(doctor_ids.begin(), doctor_ids.end()), doctor_ids.end());
+
+            auto identity = [](const std::string& value) { return value; };
+            execParams(work,
+                       "SELECT pg_advisory_xact_lock(hashtext(d)) FROM unnest($1::text[]) AS d ORDER BY d",
+                       {buildArrayLiteral(doctor_ids, identity)});
+
+            // One round trip checks every requested range against the doctors' active appointments
+            std::string query = R"(
+                SELECT r.slot_index - 1
+                FROM unnest($1::uuid[], $2::timestamp[], $3::timestamp[])
+                     WITH ORDINALITY AS r(doctor_id, start_time, end_time, slot_index)
+                WHERE EXISTS (
+                    SELECT 1 FROM appointments a
+                    WHERE a.doctor_id = r.doctor_id
+                      AND a.is_deleted = FALSE
+                      AND a.status IN ('PENDING', 'CONFIRMED', 'IN_PROGRESS')
+                      AND a.start_time < r.end_time
+                      AND a.end_time > r.start_time
+                )
+                ORDER BY 1
+            )";
+
+            std::vector<std::string> params = {
+                buildArrayLiteral(slots, [](const SlotRange& slot) { return slot.doctor_id; }),
+                buildArrayLiteral(slots, [](const SlotRange& slot) { return formatSqlTimestamp(slot.start_time); }),
+                buildArrayLiteral(slots, [](const SlotRange& slot) { return formatSqlTimestamp(slot.end_time); })
+            };
+
+            auto result = execParams(work, query, params);
+            for (const auto& row : result) {
+                conflicts.push_back(row[0].as<size_t>());
+            }
+            return conflicts;
+
+        } catch (const std::exception& e) {
+            logError("findConflictingSlots", e.what());
+            throw QueryException(std::string("Conflict check failed: ") + e.what());
+        }
+    });
+}
+
+// Statistics
+
+int AppointmentRepository::countByDoctor(const std::string& doctor_id) {
+    return countWhere("countByDoctor", "doctor_id = $1", {doctor_id}).value_or(0);
+}
+
+int AppointmentRepository::countByClinic(const std::string& clinic_id) {
+    return countWhere("countByClinic", "clinic_id = $1", {clinic_id}).value_or(0);
+}
+
+std::map<std::string, int> AppointmentRepository::getAppointmentStatsByStatus() {
+    return executeWithTiming("getAppointmentStatsByStatus", [&]() {
+        std::map<std::string, int> stats;
+
+        try {
+            std::string query = "SELECT status, COUNT(*) as count FROM appointments "
+                              "WHERE is_deleted = false GROUP BY status";
+
+            auto result = db_manager_.executeQuery(query);
+
+            for (const auto& row : result) {
+                stats[row["status"].as<std::string>()] = row["count"].as<int>();
+            }
+
+            return stats;
+
+        } catch (const std::exception& e) {
+            logError("getAppointmentStatsByStatus", e.what());
+            return stats;
+        }
+    });
+}
+
+// Entity mapping goes through the model's JSON form so nested columns stay in one format
+
+models::Appointment AppointmentRepository::mapRowToEntity(const pqxx::row& row) const {
+    nlohmann::json json;
+
+    for (const char* column : kTextColumns) {
+        if (!row[column].is_null()) {
+            json[column] = row[column].as<std::string>();
+        }
+    }
+    for (const char* column : kTimestampColumns) {
+        if (!row[column].is_null()) {
+            json[column] = utils::civil::toUnixSeconds(parseSqlTimestamp(row[column].as<std::string>()));
+        }
+    }
+    for (const char* column : kJsonColumns) {
+        if (!row[column].is_null()) {
+            json[column] = nlohmann::json::parse(row[column].as<std::string>());
+        }
+    }
+
+    json["is_emergency"] = row["is_emergency"].as<bool>();
+    json["is_deleted"] = row["is_deleted"].as<bool>();
+    json["consultation_fee"] = row["consultation_fee"].is_null() ? 0.0 : row["consultation_fee"].as<double>();
+
+    models::Appointment appointment;
+    appointment.fromJson(json);
+    return appointment;
+}
+
+std::vector<std::string> AppointmentRepository::getInsertValues(const models::Appointment& entity) const {
+    nlohmann::json json = entity.toJson();
+    std::vector<std::string> values;
+
+    values.push_back(entity.getId());
+    values.push_back(entity.getUserId());
+    values.push_back(entity.getDoctorId());
+    values.push_back(entity.getClinicId());
+    values.push_back(formatSqlTimestamp(entity.getAppointmentDate()));
+    values.push_back(formatSqlTimestamp(entity.getStartTime()));
+    values.push_back(formatSqlTimestamp(entity.getEndTime()));
+    values.push_back(models::appointmentTypeToString(entity.getType()));
+    values.push_back(models::appointmentStatusToString(entity.getStatus()));
+    values.push_back(entity.getSymptoms());
+    values.push_back(entity.getNotes());
+    values.push_back(entity.isEmergency() ? "true" : "false");
+    values.push_back(entity.getPatientAge());
+    values.push_back(entity.getPatientGender());
+    values.push_back(std::to_string(entity.getConsultationFee()));
+    values.push_back(json["payment_info"].dump());
+    values.push_back(entity.getConfirmationCode());
+    values.push_back(formatSqlTimestamp(entity.getBookedAt()));
+    values.push_back(formatSqlTimestamp(entity.getConfirmedAt()));
+    values.push_back(json["consultation_info"].dump());
+    values.push_back(json.value("cancellation_info", nlohmann::json::object()).dump());
+    values.push_back(entity.getPrescriptionId());
+    values.push_back(formatSqlTimestamp(entity.getFollowUpDate()));
+    values.push_back(entity.getFollowUpNotes());
+    values.push_back(formatSqlTimestamp(entity.getCreatedAt()));
+    values.push_back(formatSqlTimestamp(entity.getUpdatedAt()));
+    values.push_back(entity.isDeleted() ? "true" : "false");
+
+    return values;
+}
+
+// update() sets every column in getColumnNames(), so id and created_at are written back unchanged
+std::vector<std::string> AppointmentRepository::getUpdateValues(const models::Appointment& entity) const {
+    return getInsertValues(entity);
+}
+
+std::vector<std::string> AppointmentRepository::getColumnNames() const {
+    return {
+        "id", "user_id", "doctor_id", "clinic_id", "appointment_date", "start_time", "end_time",
+        "type", "status", "symptoms", "notes", "is_emergency", "patient_age", "patient_gender",
+        "consultation_fee", "payment_info", "confirmation_code", "booked_at", "confirmed_at",
+        "consultation_info", "cancellation_info", "prescription_id", "follow_up_date",
+        "follow_up_notes", "created_at", "updated_at", "is_deleted"
+    };
+}
+
+std::vector<std::string> AppointmentRepository::getSearchableColumns() const {
+    return {"confirmation_code", "symptoms", "notes"};
+}
+
+// Helpers
+
+QueryResult<models::Appointment> AppointmentRepository::findWhere(std::string_view operation,
+                                                                  const std::string& where_clause,
+                                                                  const std::vector<std::string>& params,
+                                                                  const std::string& order_clause) {
+    return executeWithTiming(operation, [&]() {
+        try {
+            std::string query = buildSelectQuery(where_clause + " AND is_deleted = false",
+                                               "ORDER BY " + order_clause);
+            auto result = db_manager_.executeQuery(query, params);
+
+            std::vector<models::Appointment> appointments;
+            for (const auto& row : result) {
+                appointments.push_back(mapRowToEntity(row));
+            }
+
+            return QueryResult<models::Appointment>(appointments);
+
+        } catch (const std::exception& e) {
+            logError(std::string(operation), e.what());
+            return QueryResult<models::Appointment>(std::string(operation) + " failed: " + e.what());
+        }
+    });
+}
+
+std::optional<int> AppointmentRepository::countWhere(std::string_view operation, const std::string& where_clause,
+                                                     const std::vector<std::string>& params) {
+    return executeWithTiming(operation, [&]() -> std::optional<int> {
+        try {
+            auto result = db_manager_.executeQuery(buildCountQuery(where_clause + " AND is_deleted = false"), params);
+            return result.empty() ? 0 : result[0][0].as<int>();
+
+        } catch (const std::exception& e) {
+            logError(std::string(operation), e.what());
+            return std::nullopt;
+        }
+    });
+}
+
+} // namespace healthcare::database
\ No newline at end of file
@@ -32,12 +32,16 @@ std::string FilterParams::buildWhereClause() const {
     
     // Search term
     if (!search_term.empty() && !search_fields.empty()) {
-        std::vector<std::string> search_conditions;
-        for (const auto& field : search_fields) {
-            search_conditions.push_back(field + " ILIKE $" + std::to_string(param_index));
+        // Each field is served by a pg_trgm GIN index, so the infix ILIKE avoids a sequential scan
+        std::ostringstream search_condition;
+        search_condition << "(";
+        for (size_t i = 0; i < search_fields.size(); ++i) {
+            if (i > 0) search_condition << " OR ";
+            search_condition << search_fields[i] << " ILIKE $" << param_index;
         }
+        search_condition << ")";
         param_index++;
-        conditions.push_back("(" + std::string(search_conditions.begin(), search_conditions.end()) + ")");
+        conditions.push_back(search_condition.str());
     }
     
     if (conditions.empty()) {
@@ -54,6 +58,19 @@ std::string FilterParams::buildWhereClause() const {
     return where_clause.str();
 }
 
+// User input is matched literally, not as a LIKE pattern
+std::string FilterParams::escapeLikePattern(const std::string& term) {
+    std::string escaped;
+    escaped.reserve(term.size());
+    for (char c : term) {
+        if (c == '%' || c == '_' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
 std::vector<std::string> FilterParams::getParameterValues() const {
     std::vector<std::string> params;
     
@@ -85,7 +102,7 @@ std::vector<std::string> FilterParams::getParameterValues() const {
     
     // Search term
     if (!search_term.empty() && !search_fields.empty()) {
-        params.push_back("%" + search_term + "%");
+        params.push_back("%" + FilterParams::escapeLikePattern(search_term) + "%");
     }
     
     return params;
@@ -1,11 +1,41 @@
 #include "../../include/database/DatabaseManager.h"
+#include "../../include/database/SlowQueryLog.h"
 #include "../../include/utils/Logger.h"
+#include "../../include/utils/Metrics.h"
+#include "../../include/utils/Tracing.h"
+#include "../../include/utils/RequestArena.h"
 #include <sstream>
 #include <fstream>
 #include <filesystem>
 
 namespace healthcare::database {
 
+namespace {
+
+utils::LatencyHistogram& poolWaitLatency() {
+    static utils::LatencyHistogram& histogram = utils::MetricsRegistry::getInstance().latencyFamily(
+        "db_pool_wait_seconds", "Time spent waiting for a pooled database connection").series();
+    return histogram;
+}
+
+utils::LatencyHistogram& redisLatency(std::string_view command) {
+    static utils::LatencyFamily& family = utils::MetricsRegistry::getInstance().latencyFamily(
+        "redis_command_duration_seconds", "Redis call latency", {"command"});
+    return family.series(command);
+}
+
+// Exported spans carry the fingerprint only; the literals are patient data
+void setStatement(utils::TraceSpan& span, std::string_view sql) {
+    if (!span.recording()) {
+        return;
+    }
+    std::string statement;
+    SlowQueryLog::fingerprint(sql, statement);
+    span.setAttribute("db.statement", statement);
+}
+
+} // namespace
+
 // ConnectionPool implementation
 ConnectionPool::ConnectionPool(const DatabaseConfig& config) : config_(config) {
     initializePool();
@@ -16,12 +46,15 @@ ConnectionPool::~ConnectionPool() {
 }
 
 std::unique_ptr<pqxx::connection> ConnectionPool::getConnection() {
+    utils::TraceSpan span("db.pool_wait");
+    auto wait_start = std::chrono::steady_clock::now();
     std::unique_lock<std::mutex> lock(mutex_);
     
     // Wait for available connection
     condition_.wait(lock, [this] {
         return !available_connections_.empty() || is_shutdown_;
     });
+    poolWaitLatency().record(std::chrono::steady_clock::now() - wait_start);
     
     if (is_shutdown_) {
         throw ConnectionException("Connection pool is shut down");
@@ -206,6 +239,9 @@ bool DatabaseManager::connect() {
             LOG_WARN("Redis connection failed, caching will be disabled");
         }
         
+        // Plans for slow statements are fetched on a connection of its own
+        SlowQueryLog::getInstance().start(buildConnectionString());
+        
         logConnection(true);
         LOG_INFO("Database manager connected successfully");
         return true;
@@ -218,6 +254,8 @@ bool DatabaseManager::connect() {
 }
 
 void DatabaseManager::disconnect() {
+    SlowQueryLog::getInstance().stop();
+    
     if (connection_pool_) {
         connection_pool_->closeAllConnections();
         connection_pool_.reset();
@@ -445,6 +483,8 @@ std::unique_ptr<DatabaseManager::Transaction> DatabaseManager::beginTransaction(
 
 pqxx::result DatabaseManager::executeQuery(const std::string& query) {
     auto start = std::chrono::high_resolution_clock::now();
+    utils::TraceSpan span("db.execute", utils::SpanKind::CLIENT);
+    setStatement(span, query);
     
     try {
         auto conn = getConnection();
@@ -469,6 +509,7 @@ pqxx::result DatabaseManager::executeQuery(const std::string& query) {
         
         logQuery(query, duration_ms, false);
         updateStats(false, duration_ms);
+        span.setError();
         handleDatabaseError(e, "executeQuery");
         throw;
     }
@@ -476,13 +517,15 @@ pqxx::result DatabaseManager::executeQuery(const std::string& query) {
 
 pqxx::result DatabaseManager::executeQuery(const std::string& query, const std::vector<std::string>& params) {
     auto start = std::chrono::high_resolution_clock::now();
+    utils::TraceSpan span("db.execute", utils::SpanKind::CLIENT);
+    setStatement(span, query);
     
     try {
         auto conn = getConnection();
         pqxx::work txn(*conn);
         
-        // Build parameterized query
-        std::string parameterized_query = query;
+        // Build parameterized query; request-scoped scratch, so it lives in the arena
+        std::pmr::string parameterized_query = utils::RequestArena::string(query);
         for (size_t i = 0; i < params.size(); ++i) {
             std::string placeholder = "$" + std::to_string(i + 1);
             size_t pos = parameterized_query.find(placeholder);
@@ -491,7 +534,7 @@ pqxx::result DatabaseManager::executeQuery(const std::string& query, const std::
             }
         }
         
-        auto result = txn.exec(parameterized_query);
+        auto result = txn.exec(std::string_view(parameterized_query));
         txn.commit();
         returnConnection(std::move(conn));
         
@@ -511,6 +554,7 @@ pqxx::result DatabaseManager::executeQuery(const std::string& query, const std::
         
         logQuery(query, duration_ms, false);
         updateStats(false, duration_ms);
+        span.setError();
         handleDatabaseError(e, "executeQuery");
         throw;
     }
@@ -547,6 +591,8 @@ void DatabaseManager::prepareStatement(const std::string& name, const std::strin
 
 pqxx::result DatabaseManager::executePrepared(const std::string& name, const std::vector<std::string>& params) {
     auto start = std::chrono::high_resolution_clock::now();
+    utils::TraceSpan span("db.execute", utils::SpanKind::CLIENT);
+    setStatement(span, name);
     
     try {
         auto conn = getConnection();
@@ -583,6 +629,7 @@ pqxx::result DatabaseManager::executePrepared(const std::string& name, const std
         
         logQuery("EXECUTE " + name, duration_ms, false);
         updateStats(false, duration_ms);
+        span.setError();
         handleDatabaseError(e, "executePrepared");
         throw;
     }
@@ -618,6 +665,11 @@ nlohmann::json DatabaseManager::getHealthStatus() const {
     status["stats"]["failed_queries"] = stats.failed_queries;
     status["stats"]["average_query_time_ms"] = stats.average_query_time_ms;
     
+    auto slow_stats = SlowQueryLog::getInstance().getStats();
+    status["slow_queries"]["slow"] = slow_stats.slow;
+    status["slow_queries"]["fingerprints"] = slow_stats.fingerprints;
+    status["slow_queries"]["explains_run"] = slow_stats.explains_run;
+    
     return status;
 }
 
@@ -625,6 +677,8 @@ bool DatabaseManager::setCache(const std::string& key, const std::string& value,
     if (!redis_client_) return false;
     
     try {
+        utils::TraceSpan span("redis.set", utils::SpanKind::CLIENT);
+        utils::ScopedLatency timer(redisLatency("set"));
         if (ttl_seconds > 0) {
             redis_client_->setex(key, ttl_seconds, value);
         } else {
@@ -641,6 +695,8 @@ std::string DatabaseManager::getCache(const std::string& key) {
     if (!redis_client_) return "";
     
     try {
+        utils::TraceSpan span("redis.get", utils::SpanKind::CLIENT);
+        utils::ScopedLatency timer(redisLatency("get"));
         auto val = redis_client_->get(key);
         return val.value_or("");
     } catch (const std::exception& e) {
@@ -653,6 +709,8 @@ bool DatabaseManager::deleteCache(const std::string& key) {
     if (!redis_client_) return false;
     
     try {
+        utils::TraceSpan span("redis.del", utils::SpanKind::CLIENT);
+        utils::ScopedLatency timer(redisLatency("del"));
         redis_client_->del(key);
         return true;
     } catch (const std::exception& e) {
@@ -665,6 +723,8 @@ bool DatabaseManager::existsCache(const std::string& key) {
     if (!redis_client_) return false;
     
     try {
+        utils::TraceSpan span("redis.exists", utils::SpanKind::CLIENT);
+        utils::ScopedLatency timer(redisLatency("exists"));
         return redis_client_->exists(key) > 0;
     } catch (const std::exception& e) {
         handleRedisError(e, "existsCache");
@@ -676,6 +736,8 @@ void DatabaseManager::clearCache(const std::string& pattern) {
     if (!redis_client_) return;
     
     try {
+        utils::TraceSpan span("redis.clear", utils::SpanKind::CLIENT);
+        utils::ScopedLatency timer(redisLatency("clear"));
         std::vector<std::string> keys;
         redis_client_->keys(pattern, std::back_inserter(keys));
         
@@ -817,8 +879,9 @@ bool DatabaseManager::optimizeDatabase() {
     return success;
 }
 
-void DatabaseManager::logQuery(const std::string& query, double duration_ms, bool success) {
+void DatabaseManager::logQuery(std::string_view query, double duration_ms, bool success) {
     LOG_DEBUG("Query: {} ({}ms) - {}", query.substr(0, 100), duration_ms, success ? "SUCCESS" : "FAILED");
+    SlowQueryLog::getInstance().record(query, duration_ms);
 }
 
 void DatabaseManager::logConnection(bool success) {
@@ -928,6 +991,30 @@ std::vector<std::string> DatabaseManager::getMigrationScripts() const {
         );
     )");
     
+    // Base tables; every later script indexes them, so a fresh database needs them first.
+    // The script is idempotent and is also what createTables() runs
+    scripts.push_back(getCreateTablesScript());
+    
+    // Trigram search. Index expressions must stay identical to the search
+    // documents built in UserRepository/DoctorRepository or the planner skips them.
+    scripts.push_back(R"(
+        CREATE EXTENSION IF NOT EXISTS pg_trgm;
+        CREATE INDEX IF NOT EXISTS idx_users_search_trgm ON users USING GIN (
+            (lower(first_name || ' ' || last_name || ' ' || email || ' ' || coalesce(city, ''))) gin_trgm_ops);
+        CREATE INDEX IF NOT EXISTS idx_users_first_name_trgm ON users USING GIN (first_name gin_trgm_ops);
+        CREATE INDEX IF NOT EXISTS idx_users_last_name_trgm ON users USING GIN (last_name gin_trgm_ops);
+        CREATE INDEX IF NOT EXISTS idx_users_email_trgm ON users USING GIN (email gin_trgm_ops);
+        CREATE INDEX IF NOT EXISTS idx_users_phone_trgm ON users USING GIN (phone_number gin_trgm_ops);
+        CREATE INDEX IF NOT EXISTS idx_doctors_specializations_trgm ON doctors USING GIN (
+            (lower(specializations::text)) gin_trgm_ops);
+    )");
+
+    // Bounding-box prefilter for nearby clinic lookups
+    scripts.push_back(R"(
+        CREATE INDEX IF NOT EXISTS idx_clinics_location ON clinics(
+            ((address->>'latitude')::double precision), ((address->>'longitude')::double precision));
+    )");
+
     // Add more migration scripts here
     
     return scripts;
@@ -1071,16 +1158,16 @@ std::string DatabaseManager::getCreateTablesScript() const {
         );
 
         -- Create indexes
-        CREATE INDEX idx_users_email ON users(email);
-        CREATE INDEX idx_users_phone ON users(phone_number);
-        CREATE INDEX idx_doctors_user_id ON doctors(user_id);
-        CREATE INDEX idx_doctors_status ON doctors(status);
-        CREATE INDEX idx_appointments_user_id ON appointments(user_id);
-        CREATE INDEX idx_appointments_doctor_id ON appointments(doctor_id);
-        CREATE INDEX idx_appointments_date ON appointments(appointment_date);
-        CREATE INDEX idx_appointments_status ON appointments(status);
-        CREATE INDEX idx_prescriptions_appointment_id ON prescriptions(appointment_id);
-        CREATE INDEX idx_prescriptions_patient_id ON prescriptions(patient_id);
+        CREATE INDEX IF NOT EXISTS idx_users_email ON users(email);
+        CREATE INDEX IF NOT EXISTS idx_users_phone ON users(phone_number);
+        CREATE INDEX IF NOT EXISTS idx_doctors_user_id ON doctors(user_id);
+        CREATE INDEX IF NOT EXISTS idx_doctors_status ON doctors(status);
+        CREATE INDEX IF NOT EXISTS idx_appointments_user_id ON appointments(user_id);
+        CREATE INDEX IF NOT EXISTS idx_appointments_doctor_id ON appointments(doctor_id);
+        CREATE INDEX IF NOT EXISTS idx_appointments_date ON appointments(appointment_date);
+        CREATE INDEX IF NOT EXISTS idx_appointments_status ON appointments(status);
+        CREATE INDEX IF NOT EXISTS idx_prescriptions_appointment_id ON prescriptions(appointment_id);
+        CREATE INDEX IF NOT EXISTS idx_prescriptions_patient_id ON prescriptions(patient_id);
     )";
 }
 
@@ -0,0 +1,367 @@
+#include "../../include/database/DoctorRepository.h"
+#include "../../include/utils/GeoIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+namespace healthcare::database {
+
+namespace {
+
+// Postgres array literal with every element double-quoted
+std::string toArrayLiteral(const std::vector<std::string>& items) {
+    std::string literal = "{";
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i > 0) literal += ",";
+        literal += "\"" + items[i] + "\"";
+    }
+    return literal + "}";
+}
+
+// Both documents are backed by pg_trgm GIN expression indexes; see the migration scripts
+const char* kDoctorProfileDocument =
+    "lower(u.first_name || ' ' || u.last_name || ' ' || u.email || ' ' || coalesce(u.city, ''))";
+const char* kDoctorSpecializationDocument = "lower(d.specializations::text)";
+
+// Shorter terms carry no full trigram, so only the substring match applies
+constexpr size_t kMinTrigramTermLength = 3;
+
+// Elements of uuid[] and enum-valued text[] columns never need quoting or escapes
+std::vector<std::string> parseArrayLiteral(const std::string& literal) {
+    std::vector<std::string> items;
+    std::string item;
+    for (char c : literal) {
+        if (c == '{' || c == '}' || c == '"') continue;
+        if (c == ',') {
+            items.push_back(item);
+            item.clear();
+        } else {
+            item.push_back(c);
+        }
+    }
+    if (!item.empty()) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+} // namespace
+
+// Custom queries
+
+QueryResult<models::Doctor> DoctorRepository::findByIds(const std::vector<std::string>& doctor_ids) {
+    if (doctor_ids.empty()) {
+        return QueryResult<models::Doctor>(std::vector<models::Doctor>{});
+    }
+    return findWhere("findByIds", "id = ANY($1::uuid[])", {toArrayLiteral(doctor_ids)});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findByUserId(const std::string& user_id) {
+    return findWhere("findByUserId", "user_id = $1", {user_id});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findBySpecialization(const std::string& specialization) {
+    return findWhere("findBySpecialization",
+                     "EXISTS (SELECT 1 FROM jsonb_array_elements(specializations) s "
+                     "WHERE lower(s->>'name') = lower($1))",
+                     {specialization});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findByClinic(const std::string& clinic_id) {
+    return findWhere("findByClinic", "$1::uuid = ANY(clinic_ids)", {clinic_id});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findByCity(const std::string& city) {
+    return findWhere("findByCity", "user_id IN (SELECT id FROM users WHERE city = $1 AND is_deleted = false)", {city});
+}
+
+// Verified doctors marked available today with no active appointment covering date_time
+QueryResult<models::Doctor> DoctorRepository::findAvailableDoctors(const std::chrono::system_clock::time_point& date_time) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(date_time.time_since_epoch()).count();
+    return findWhere("findAvailableDoctors",
+                     "status = 'VERIFIED' AND is_available_today = true AND NOT EXISTS ("
+                     "SELECT 1 FROM appointments a WHERE a.doctor_id = doctors.id AND a.is_deleted = false "
+                     "AND a.status IN ('PENDING', 'CONFIRMED', 'IN_PROGRESS') "
+                     "AND (to_timestamp($1) AT TIME ZONE 'UTC') >= a.start_time "
+                     "AND (to_timestamp($1) AT TIME ZONE 'UTC') < a.end_time)",
+                     {std::to_string(seconds)});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findByConsultationType(models::ConsultationType type) {
+    return findWhere("findByConsultationType", "$1 = ANY(consultation_types)",
+                     {models::consultationTypeToString(type)});
+}
+
+QueryResult<models::Doctor> DoctorRepository::findVerifiedDoctors() {
+    return findWhere("findVerifiedDoctors", "status = 'VERIFIED'", {});
+}
+
+QueryResult<models::Doctor> DoctorRepository::searchDoctors(const std::string& query) {
+    std::string term;
+    for (unsigned char c : query) {
+        term.push_back(static_cast<char>(std::tolower(c)));
+    }
+    if (term.empty()) {
+        return QueryResult<models::Doctor>(std::vector<models::Doctor>{});
+    }
+
+    return executeWithTiming("searchDoctors", [&]() -> QueryResult<models::Doctor> {
+        try {
+            std::string profile = kDoctorProfileDocument;
+            std::string specializations = kDoctorSpecializationDocument;
+            std::string match = profile + " LIKE $2 OR " + specializations + " LIKE $2";
+            if (term.size() >= kMinTrigramTermLength) {
+                match = "$1 <% " + profile + " OR $1 <% " + specializations + " OR " + match;
+            }
+
+            std::string sql =
+                "SELECT d.* FROM doctors d JOIN users u ON u.id = d.user_id"
+                " WHERE d.is_deleted = FALSE AND u.is_deleted = FALSE AND (" + match + ")"
+                " ORDER BY GREATEST(word_similarity($1, " + profile + "), word_similarity($1, " + specializations + ")) DESC,"
+                " d.rating DESC LIMIT 50";
+
+            auto result = db_manager_.executeQuery(sql, {term, "%" + FilterParams::escapeLikePattern(term) + "%"});
+
+            std::vector<models::Doctor> doctors;
+            for (const auto& row : result) {
+                doctors.push_back(mapRowToEntity(row));
+            }
+            return QueryResult<models::Doctor>(doctors);
+
+        } catch (const std::exception& e) {
+            logError("searchDoctors", e.what());
+            return QueryResult<models::Doctor>(std::string("Doctor search failed: ") + e.what());
+        }
+    });
+}
+
+QueryResult<models::Doctor> DoctorRepository::findNearby(double latitude, double longitude, double radius_km) {
+    return executeWithTiming("findNearby", [&]() -> QueryResult<models::Doctor> {
+        try {
+            // Box prefilter runs on the clinics location index; haversine refines below
+            auto box = utils::geo::boundingBox(latitude, longitude, radius_km);
+            std::string query = R"(
+                SELECT d.*,
+                       (c.address->>'latitude')::double precision AS clinic_latitude,
+                       (c.address->>'longitude')::double precision AS clinic_longitude
+                FROM clinics c
+                JOIN doctors d ON c.id = ANY(d.clinic_ids)
+                WHERE c.is_deleted = FALSE
+                  AND d.is_deleted = FALSE
+                  AND (c.address->>'latitude')::double precision BETWEEN $1 AND $2
+                  AND (c.address->>'longitude')::double precision BETWEEN $3 AND $4
+            )";
+
+            auto result = db_manager_.executeQuery(query, {
+                std::to_string(box.min_latitude), std::to_string(box.max_latitude),
+                std::to_string(box.min_longitude), std::to_string(box.max_longitude)
+            });
+
+            // A doctor practising at several clinics is ranked by the closest one
+            std::vector<models::Doctor> doctors;
+            std::vector<double> distances;
+            std::unordered_map<std::string, size_t> positions;
+
+            for (const auto& row : result) {
+                double distance = utils::geo::haversineKm(latitude, longitude,
+                                                          row["clinic_latitude"].as<double>(),
+                                                          row["clinic_longitude"].as<double>());
+                if (distance > radius_km) continue;
+
+                std::string doctor_id = row["id"].as<std::string>();
+                auto it = positions.find(doctor_id);
+                if (it == positions.end()) {
+                    positions.emplace(doctor_id, doctors.size());
+                    doctors.push_back(mapRowToEntity(row));
+                    distances.push_back(distance);
+                } else if (distance < distances[it->second]) {
+                    distances[it->second] = distance;
+                }
+            }
+
+            std::vector<size_t> order(doctors.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return distances[a] < distances[b]; });
+
+            std::vector<models::Doctor> sorted;
+            sorted.reserve(order.size());
+            for (size_t index : order) {
+                sorted.push_back(std::move(doctors[index]));
+            }
+            return QueryResult<models::Doctor>(sorted);
+
+        } catch (const std::exception& e) {
+            logError("findNearby", e.what());
+            return QueryResult<models::Doctor>(std::string("Nearby search failed: ") + e.what());
+        }
+    });
+}
+
+// Validation
+
+bool DoctorRepository::licenseNumberExists(const std::string& license_number) {
+    return countWhere("licenseNumberExists", "medical_license_number = $1", {license_number}) > 0;
+}
+
+// Statistics
+
+int DoctorRepository::countBySpecialization(const std::string& specialization) {
+    return countWhere("countBySpecialization",
+                      "EXISTS (SELECT 1 FROM jsonb_array_elements(specializations) s "
+                      "WHERE lower(s->>'name') = lower($1))",
+                      {specialization});
+}
+
+int DoctorRepository::countVerifiedDoctors() {
+    return countWhere("countVerifiedDoctors", "status = 'VERIFIED'", {});
+}
+
+std::map<std::string, int> DoctorRepository::getDoctorStatsByCity() {
+    return executeWithTiming("getDoctorStatsByCity", [&]() {
+        std::map<std::string, int> stats;
+
+        try {
+            std::string query = "SELECT u.city, COUNT(*) as count FROM doctors d "
+                              "JOIN users u ON u.id = d.user_id "
+                              "WHERE d.is_deleted = false AND u.city IS NOT NULL AND u.city != '' "
+                              "GROUP BY u.city ORDER BY count DESC";
+
+            auto result = db_manager_.executeQuery(query);
+
+            for (const auto& row : result) {
+                stats[row["city"].as<std::string>()] = row["count"].as<int>();
+            }
+
+            return stats;
+
+        } catch (const std::exception& e) {
+            logError("getDoctorStatsByCity", e.what());
+            return stats;
+        }
+    });
+}
+
+// Entity mapping goes through the model's JSON form so nested columns stay in one format
+
+models::Doctor DoctorRepository::mapRowToEntity(const pqxx::row& row) const {
+    nlohmann::json json;
+
+    for (const char* column : {"id", "user_id", "medical_license_number", "qualification", "status",
+                               "availability_pattern", "bio", "languages"}) {
+        if (!row[column].is_null()) {
+            json[column] = row[column].as<std::string>();
+        }
+    }
+    for (const char* column : {"specializations", "documents"}) {
+        if (!row[column].is_null()) {
+            json[column] = nlohmann::json::parse(row[column].as<std::string>());
+        }
+    }
+    for (const char* column : {"clinic_ids", "consultation_types"}) {
+        json[column] = row[column].is_null() ? std::vector<std::string>{}
+                                             : parseArrayLiteral(row[column].as<std::string>());
+    }
+
+    json["created_at"] = std::chrono::system_clock::to_time_t(parseTimestamp(row["created_at"].as<std::string>()));
+    json["updated_at"] = std::chrono::system_clock::to_time_t(parseTimestamp(row["updated_at"].as<std::string>()));
+    json["is_deleted"] = row["is_deleted"].as<bool>();
+    json["years_of_experience"] = row["years_of_experience"].as<int>(0);
+    json["consultation_fee"] = row["consultation_fee"].as<double>(0.0);
+    json["consultation_duration_minutes"] = row["consultation_duration_minutes"].as<int>(0);
+    json["rating"] = row["rating"].as<double>(0.0);
+    json["total_reviews"] = row["total_reviews"].as<int>(0);
+    json["is_available_today"] = row["is_available_today"].as<bool>(false);
+
+    models::Doctor doctor;
+    doctor.fromJson(json);
+    return doctor;
+}
+
+std::vector<std::string> DoctorRepository::getInsertValues(const models::Doctor& entity) const {
+    nlohmann::json json = entity.toJson();
+    std::vector<std::string> values;
+
+    values.push_back(entity.getId());
+    values.push_back(entity.getUserId());
+    values.push_back(entity.getMedicalLicenseNumber());
+    values.push_back(entity.getQualification());
+    values.push_back(std::to_string(entity.getYearsOfExperience()));
+    values.push_back(models::doctorStatusToString(entity.getStatus()));
+    values.push_back(std::to_string(entity.getConsultationFee()));
+    values.push_back(std::to_string(entity.getConsultationDuration()));
+    values.push_back(toArrayLiteral(json["consultation_types"].get<std::vector<std::string>>()));
+    values.push_back(std::to_string(entity.getRating()));
+    values.push_back(std::to_string(entity.getTotalReviews()));
+    values.push_back(entity.getAvailabilityPattern());
+    values.push_back(json["is_available_today"].get<bool>() ? "true" : "false");
+    values.push_back(entity.getBio());
+    values.push_back(entity.getLanguages());
+    values.push_back(json["specializations"].dump());
+    values.push_back(toArrayLiteral(entity.getClinicIds()));
+    values.push_back(json["documents"].dump());
+    values.push_back(formatTimestamp(entity.getCreatedAt()));
+    values.push_back(formatTimestamp(entity.getUpdatedAt()));
+    values.push_back(entity.isDeleted() ? "true" : "false");
+
+    return values;
+}
+
+// update() sets every column in getColumnNames(), so id and created_at are written back unchanged
+std::vector<std::string> DoctorRepository::getUpdateValues(const models::Doctor& entity) const {
+    return getInsertValues(entity);
+}
+
+std::vector<std::string> DoctorRepository::getColumnNames() const {
+    return {
+        "id", "user_id", "medical_license_number", "qualification", "years_of_experience",
+        "status", "consultation_fee", "consultation_duration_minutes", "consultation_types",
+        "rating", "total_reviews", "availability_pattern", "is_available_today", "bio",
+        "languages", "specializations", "clinic_ids", "documents", "created_at", "updated_at",
+        "is_deleted"
+    };
+}
+
+std::vector<std::string> DoctorRepository::getSearchableColumns() const {
+    return {"medical_license_number", "qualification", "bio", "languages"};
+}
+
+// Helpers
+
+QueryResult<models::Doctor> DoctorRepository::findWhere(std::string_view operation, const std::string& where_clause,
+                                                        const std::vector<std::string>& params,
+                                                        const std::string& order_clause) {
+    return executeWithTiming(operation, [&]() {
+        try {
+            std::string query = buildSelectQuery(where_clause + " AND is_deleted = false",
+                                               "ORDER BY " + order_clause);
+            auto result = db_manager_.executeQuery(query, params);
+
+            std::vector<models::Doctor> doctors;
+            for (const auto& row : result) {
+                doctors.push_back(mapRowToEntity(row));
+            }
+
+            return QueryResult<models::Doctor>(doctors);
+
+        } catch (const std::exception& e) {
+            logError(std::string(operation), e.what());
+            return QueryResult<models::Doctor>(std::string(operation) + " failed: " + e.what());
+        }
+    });
+}
+
+int DoctorRepository::countWhere(std::string_view operation, const std::string& where_clause,
+                                 const std::vector<std::string>& params) {
+    return executeWithTiming(operation, [&]() {
+        try {
+            auto result = db_manager_.executeQuery(buildCountQuery(where_clause + " AND is_deleted = false"), params);
+            return result.empty() ? 0 : result[0][0].as<int>();
+
+        } catch (const std::exception& e) {
+            logError(std::string(operation), e.what());
+            return 0;
+        }
+    });
+}
+
+} // namespace healthcare::database
\ No newline at end of file
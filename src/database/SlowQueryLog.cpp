@@ -0,0 +1,531 @@
+#include "../../include/database/SlowQueryLog.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+
+namespace healthcare::database {
+
+namespace {
+
+constexpr std::uint64_t kOtherKey = 0;  // Overflow entry; hashFingerprint never returns it
+constexpr const char* kOtherFingerprint = "(other)";
+
+std::uint64_t hashFingerprint(std::string_view text) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash == kOtherKey ? 1 : hash;
+}
+
+bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Statements EXPLAIN accepts; everything else (EXECUTE, DDL, VACUUM) is skipped
+bool isExplainable(std::string_view fingerprint) {
+    for (std::string_view verb : {"select", "insert", "update", "delete", "with", "values", "("}) {
+        if (fingerprint.substr(0, verb.size()) == verb &&
+            (verb == "(" || fingerprint.size() == verb.size() || !isWordChar(fingerprint[verb.size()]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// $1-style placeholders only bind through exec_params; a bare EXPLAIN cannot plan them
+bool hasPlaceholders(std::string_view sql) {
+    for (size_t i = 0; i + 1 < sql.size(); ++i) {
+        if (sql[i] == '$' && std::isdigit(static_cast<unsigned char>(sql[i + 1])) &&
+            (i == 0 || !isWordChar(sql[i - 1]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Plan keys whose values are SQL expressions, e.g. "Index Cond", "Join Filter", "Sort Key"
+bool isExpressionKey(std::string_view key) {
+    auto endsWith = [key](std::string_view suffix) {
+        return key.size() >= suffix.size() && key.substr(key.size() - suffix.size()) == suffix;
+    };
+    return endsWith("Cond") || endsWith("Filter") || endsWith("Key") || key == "Output";
+}
+
+void maskExpressions(nlohmann::json& value) {
+    if (value.is_string()) {
+        std::string masked;
+        SlowQueryLog::fingerprint(value.get_ref<const std::string&>(), masked);
+        value = std::move(masked);
+    } else if (value.is_array()) {
+        for (auto& item : value) maskExpressions(item);
+    }
+}
+
+// The planner echoes literals into conditions ("(id = 'a1'::uuid)"); fingerprint them in place
+void maskPlanLiterals(nlohmann::json& node) {
+    if (node.is_array()) {
+        for (auto& child : node) maskPlanLiterals(child);
+    } else if (node.is_object()) {
+        for (auto it = node.begin(); it != node.end(); ++it) {
+            if (isExpressionKey(it.key())) {
+                maskExpressions(it.value());
+            } else {
+                maskPlanLiterals(it.value());
+            }
+        }
+    }
+}
+
+double microsToMillis(std::uint64_t micros) {
+    return static_cast<double>(micros) / 1000.0;
+}
+
+} // namespace
+
+SlowQueryLog& SlowQueryLog::getInstance() {
+    static SlowQueryLog instance;
+    return instance;
+}
+
+SlowQueryLog::~SlowQueryLog() {
+    stop();
+}
+
+void SlowQueryLog::configure(const SlowQueryConfig& config) {
+    config_ = config;
+    config_.max_fingerprints = std::max<size_t>(config_.max_fingerprints, 1);
+}
+
+bool SlowQueryLog::start(const std::string& connection_string) {
+    if (!config_.enabled || !config_.explain || running_.exchange(true)) {
+        return true;
+    }
+    connection_string_ = connection_string;
+    explain_thread_ = std::thread(&SlowQueryLog::explainLoop, this);
+    LOG_INFO("Slow query log started: threshold_ms={}", config_.threshold_ms);
+    return true;
+}
+
+void SlowQueryLog::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    queue_cv_.notify_all();
+    if (explain_thread_.joinable()) {
+        explain_thread_.join();
+    }
+}
+
+// Fingerprinting
+
+// One pass: literals become ?, comments and whitespace runs collapse to one
+// space (or none next to punctuation), identifiers and keywords are lower
+// cased ("quoted" names are kept), and lists of literals such as
+// IN (1, 2, 3) fold to a single ?
+void SlowQueryLog::fingerprint(std::string_view sql, std::string& out) {
+    size_t base = out.size();
+    bool pending_space = false;
+
+    // Whitespace only survives between two word-like tokens, so "id = ?" and "id=?" agree
+    auto wordLike = [](char c) { return isWordChar(c) || c == '?' || c == '"' || c == '*'; };
+    auto emit = [&](char c) {
+        if (pending_space && out.size() > base && (wordLike(out.back()) || out.back() == ')') && wordLike(c)) {
+            out += ' ';
+        }
+        pending_space = false;
+        out += c;
+    };
+    auto emitLiteral = [&]() {
+        // "?, ?" -> "?": drop the separator and the second literal
+        size_t end = out.size();
+        if (end >= base + 2 && out[end - 1] == ',' && out[end - 2] == '?') {
+            out.pop_back();
+            pending_space = false;
+            return;
+        }
+        emit('?');
+    };
+
+    size_t i = 0;
+    while (i < sql.size()) {
+        char c = sql[i];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = true;
+            ++i;
+        } else if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+            while (i < sql.size() && sql[i] != '\n') ++i;
+            pending_space = true;
+        } else if (c == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+            size_t close = sql.find("*/", i + 2);
+            i = close == std::string_view::npos ? sql.size() : close + 2;
+            pending_space = true;
+        } else if (c == '\'') {
+            // E'...' strings honour backslash escapes; drop the prefix we already copied
+            bool escaped_string = out.size() > base && out.back() == 'e' &&
+                                  (out.size() == base + 1 || !isWordChar(out[out.size() - 2]));
+            if (escaped_string) out.pop_back();
+            ++i;
+            while (i < sql.size()) {
+                if (escaped_string && sql[i] == '\\') {
+                    i += 2;
+                } else if (sql[i] == '\'') {
+                    if (i + 1 < sql.size() && sql[i + 1] == '\'') {
+                        i += 2;
+                    } else {
+                        ++i;
+                        break;
+                    }
+                } else {
+                    ++i;
+                }
+            }
+            emitLiteral();
+        } else if (c == '"') {
+            size_t close = sql.find('"', i + 1);
+            size_t end = close == std::string_view::npos ? sql.size() : close + 1;
+            emit('"');
+            out.append(sql.data() + i + 1, end - i - 1);
+            i = end;
+        } else if (c == '$') {
+            size_t j = i + 1;
+            while (j < sql.size() && std::isdigit(static_cast<unsigned char>(sql[j]))) ++j;
+            if (j > i + 1) {
+                i = j;  // $1 placeholder
+                emitLiteral();
+                continue;
+            }
+            while (j < sql.size() && isWordChar(sql[j])) ++j;
+            if (j < sql.size() && sql[j] == '$') {
+                // $tag$ ... $tag$ string
+                std::string_view tag = sql.substr(i, j - i + 1);
+                size_t close = sql.find(tag, j + 1);
+                i = close == std::string_view::npos ? sql.size() : close + tag.size();
+                emitLiteral();
+            } else {
+                emit(c);
+                ++i;
+            }
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            // Identifiers swallow their own digits below, so this starts a number
+            ++i;
+            while (i < sql.size()) {
+                char d = sql[i];
+                if (std::isdigit(static_cast<unsigned char>(d)) || d == '.') {
+                    ++i;
+                } else if ((d == 'e' || d == 'E') && i + 1 < sql.size() &&
+                           (std::isdigit(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '-' || sql[i + 1] == '+')) {
+                    i += 2;
+                } else {
+                    break;
+                }
+            }
+            emitLiteral();
+        } else if (isWordChar(c)) {
+            emit(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            ++i;
+            while (i < sql.size() && isWordChar(sql[i])) {
+                out += static_cast<char>(std::tolower(static_cast<unsigned char>(sql[i])));
+                ++i;
+            }
+        } else {
+            if (c == ';' && i + 1 == sql.size()) break;  // Trailing terminator is optional
+            emit(c);
+            ++i;
+        }
+    }
+}
+
+// Recording
+
+void SlowQueryLog::record(std::string_view sql, double duration_ms) {
+    if (!config_.enabled) {
+        return;
+    }
+
+    thread_local std::string print;
+    print.clear();
+    fingerprint(sql, print);
+    std::uint64_t key = hashFingerprint(print);
+
+    bool slow = duration_ms >= config_.threshold_ms;
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+    if (slow) {
+        slow_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto micros = static_cast<std::uint64_t>(std::max(duration_ms, 0.0) * 1000.0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = findOrInsert(key, print);
+    entry.count++;
+    entry.total_ms += duration_ms;
+    entry.max_ms = std::max(entry.max_ms, duration_ms);
+    entry.latency.buckets[utils::LatencyHistogram::bucketIndex(micros)]++;
+    entry.latency.count++;
+    entry.latency.sum_ns += micros * 1000;
+    entry.latency.max_us = std::max(entry.latency.max_us, micros);
+
+    if (!slow) {
+        return;
+    }
+    entry.slow_count++;
+    if (entry.explain_state != ExplainState::NONE) {
+        return;
+    }
+
+    entry.first_slow_at = std::chrono::system_clock::now();
+
+    bool explainable = entry.fingerprint != kOtherFingerprint &&
+                       sql.size() <= config_.max_sql_length && isExplainable(entry.fingerprint) &&
+                       !hasPlaceholders(sql);
+    if (!explainable || !running_.load(std::memory_order_relaxed)) {
+        entry.explain_state = ExplainState::SKIPPED;
+        explains_skipped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+        if (queue_.size() >= config_.max_pending_explains) {
+            entry.explain_state = ExplainState::SKIPPED;
+            explains_skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue_.push_back(ExplainRequest{key, std::string(sql)});
+    }
+    entry.explain_state = ExplainState::PENDING;
+    queue_cv_.notify_one();
+}
+
+// Caller holds mutex_. Past max_fingerprints new shapes share one entry, so
+// a stream of ad-hoc SQL cannot grow the table without bound
+SlowQueryLog::Entry& SlowQueryLog::findOrInsert(std::uint64_t key, const std::string& fingerprint) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    bool full = entries_.size() >= config_.max_fingerprints;
+    std::uint64_t slot = full ? kOtherKey : key;
+    auto [inserted, created] = entries_.try_emplace(slot);
+    if (created) {
+        inserted->second.fingerprint = full ? kOtherFingerprint : fingerprint;
+        inserted->second.latency.buckets.assign(utils::LatencyHistogram::kBucketCount, 0);
+    }
+    return inserted->second;
+}
+
+// EXPLAIN worker
+
+void SlowQueryLog::explainLoop() {
+    std::unique_ptr<pqxx::connection> connection;
+    while (true) {
+        ExplainRequest request;
+        std::deque<ExplainRequest> abandoned;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return !queue_.empty() || !running_.load(); });
+            if (!running_.load()) {
+                abandoned.swap(queue_);
+            } else {
+                request = std::move(queue_.front());
+                queue_.pop_front();
+            }
+        }
+
+        // record() nests queue_mutex_ inside mutex_, so entries are updated outside the queue lock
+        if (!running_.load()) {
+            for (const auto& skipped : abandoned) {
+                finishExplain(skipped.key, ExplainState::SKIPPED, "");
+            }
+            return;
+        }
+        runExplain(connection, request);
+    }
+}
+
+// Plain EXPLAIN plans without executing, so even INSERT ... RETURNING is safe
+// to run here; the read-only transaction and statement_timeout are belts and braces
+void SlowQueryLog::runExplain(std::unique_ptr<pqxx::connection>& connection, const ExplainRequest& request) {
+    try {
+        if (!connection || !connection->is_open()) {
+            connection = std::make_unique<pqxx::connection>(connection_string_);
+        }
+
+        pqxx::read_transaction txn(*connection);
+        txn.exec("SET LOCAL statement_timeout = " + std::to_string(config_.explain_timeout_ms));
+        auto result = txn.exec("EXPLAIN (ANALYZE false, FORMAT JSON) " + request.sql);
+        txn.commit();
+
+        std::string text;
+        for (const auto& row : result) {
+            text += row[0].c_str();
+        }
+        auto plan = nlohmann::json::parse(text, nullptr, false);
+        if (plan.is_discarded()) {
+            explains_failed_.fetch_add(1, std::memory_order_relaxed);
+            finishExplain(request.key, ExplainState::FAILED, "EXPLAIN output was not valid JSON");
+            return;
+        }
+        maskPlanLiterals(plan);
+        explains_run_.fetch_add(1, std::memory_order_relaxed);
+        finishExplain(request.key, ExplainState::CAPTURED, plan.dump());
+
+    } catch (const pqxx::broken_connection& e) {
+        connection.reset();
+        explains_failed_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("EXPLAIN connection lost: {}", e.what());
+        finishExplain(request.key, ExplainState::FAILED, e.what());
+    } catch (const std::exception& e) {
+        explains_failed_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("EXPLAIN failed for slow query: {}", e.what());
+        finishExplain(request.key, ExplainState::FAILED, e.what());
+    }
+}
+
+void SlowQueryLog::finishExplain(std::uint64_t key, ExplainState state, std::string plan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;  // reset() ran while the EXPLAIN was in flight
+    }
+    it->second.explain_state = state;
+    it->second.plan = std::move(plan);
+    if (state == ExplainState::CAPTURED) {
+        LOG_INFO("Captured plan for slow query: {}", it->second.fingerprint.substr(0, 200));
+    }
+}
+
+// Reporting
+
+std::vector<SlowQueryEntry> SlowQueryLog::topQueries(size_t limit, SlowQuerySort sort) const {
+    std::vector<SlowQueryEntry> top;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        top.reserve(entries_.size());
+        for (const auto& [key, entry] : entries_) {
+            SlowQueryEntry view;
+            view.fingerprint = entry.fingerprint;
+            view.count = entry.count;
+            view.slow_count = entry.slow_count;
+            view.total_ms = entry.total_ms;
+            view.max_ms = entry.max_ms;
+            view.p50_us = entry.latency.quantileMicros(0.5);
+            view.p99_us = entry.latency.quantileMicros(0.99);
+            view.explain_state = entry.explain_state;
+            view.plan = entry.plan;
+            view.first_slow_at = entry.first_slow_at;
+            top.push_back(std::move(view));
+        }
+    }
+
+    auto rank = [sort](const SlowQueryEntry& entry) -> double {
+        switch (sort) {
+            case SlowQuerySort::MAX_TIME: return entry.max_ms;
+            case SlowQuerySort::P99: return static_cast<double>(entry.p99_us);
+            case SlowQuerySort::COUNT: return static_cast<double>(entry.count);
+            case SlowQuerySort::TOTAL_TIME: break;
+        }
+        return entry.total_ms;
+    };
+    limit = std::min(limit, top.size());
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(limit), top.end(),
+                      [&rank](const SlowQueryEntry& a, const SlowQueryEntry& b) { return rank(a) > rank(b); });
+    top.resize(limit);
+    return top;
+}
+
+SlowQueryStats SlowQueryLog::getStats() const {
+    SlowQueryStats stats;
+    stats.recorded = recorded_.load(std::memory_order_relaxed);
+    stats.slow = slow_.load(std::memory_order_relaxed);
+    stats.explains_run = explains_run_.load(std::memory_order_relaxed);
+    stats.explains_failed = explains_failed_.load(std::memory_order_relaxed);
+    stats.explains_skipped = explains_skipped_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.fingerprints = static_cast<long long>(entries_.size());
+    return stats;
+}
+
+nlohmann::json SlowQueryLog::toJson(size_t limit, SlowQuerySort sort) const {
+    nlohmann::json json;
+    auto stats = getStats();
+    json["threshold_ms"] = config_.threshold_ms;
+    json["sort"] = slowQuerySortToString(sort);
+    json["stats"]["recorded"] = stats.recorded;
+    json["stats"]["slow"] = stats.slow;
+    json["stats"]["fingerprints"] = stats.fingerprints;
+    json["stats"]["explains_run"] = stats.explains_run;
+    json["stats"]["explains_failed"] = stats.explains_failed;
+    json["stats"]["explains_skipped"] = stats.explains_skipped;
+
+    json["queries"] = nlohmann::json::array();
+    for (const auto& entry : topQueries(limit, sort)) {
+        nlohmann::json item;
+        item["fingerprint"] = entry.fingerprint;
+        item["count"] = entry.count;
+        item["slow_count"] = entry.slow_count;
+        item["total_ms"] = entry.total_ms;
+        item["avg_ms"] = entry.count > 0 ? entry.total_ms / static_cast<double>(entry.count) : 0.0;
+        item["max_ms"] = entry.max_ms;
+        item["p50_ms"] = microsToMillis(entry.p50_us);
+        item["p99_ms"] = microsToMillis(entry.p99_us);
+        item["explain"]["state"] = explainStateToString(entry.explain_state);
+        if (entry.slow_count > 0) {
+            item["first_slow_at"] = std::chrono::duration_cast<std::chrono::seconds>(
+                entry.first_slow_at.time_since_epoch()).count();
+        }
+        if (entry.explain_state == ExplainState::CAPTURED) {
+            item["explain"]["plan"] = nlohmann::json::parse(entry.plan, nullptr, false);
+        } else if (entry.explain_state == ExplainState::FAILED) {
+            item["explain"]["error"] = entry.plan;
+        }
+        json["queries"].push_back(std::move(item));
+    }
+    return json;
+}
+
+void SlowQueryLog::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    recorded_.store(0, std::memory_order_relaxed);
+    slow_.store(0, std::memory_order_relaxed);
+    explains_run_.store(0, std::memory_order_relaxed);
+    explains_failed_.store(0, std::memory_order_relaxed);
+    explains_skipped_.store(0, std::memory_order_relaxed);
+}
+
+// Utility functions
+
+std::string explainStateToString(ExplainState state) {
+    switch (state) {
+        case ExplainState::NONE: return "none";
+        case ExplainState::PENDING: return "pending";
+        case ExplainState::CAPTURED: return "captured";
+        case ExplainState::FAILED: return "failed";
+        case ExplainState::SKIPPED: return "skipped";
+    }
+    return "none";
+}
+
+std::string slowQuerySortToString(SlowQuerySort sort) {
+    switch (sort) {
+        case SlowQuerySort::TOTAL_TIME: return "total";
+        case SlowQuerySort::MAX_TIME: return "max";
+        case SlowQuerySort::P99: return "p99";
+        case SlowQuerySort::COUNT: return "count";
+    }
+    return "total";
+}
+
+SlowQuerySort stringToSlowQuerySort(const std::string& sort_str) {
+    if (sort_str == "max") return SlowQuerySort::MAX_TIME;
+    if (sort_str == "p99") return SlowQuerySort::P99;
+    if (sort_str == "count") return SlowQuerySort::COUNT;
+    return SlowQuerySort::TOTAL_TIME;
+}
+
+} // namespace healthcare::database
\ No newline at end of file
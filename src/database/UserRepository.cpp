@@ -1,5 +1,6 @@
 #include "../../include/database/UserRepository.h"
 #include "../../include/utils/Logger.h"
+#include <cctype>
 #include <sstream>
 
 namespace healthcare::database {
@@ -8,7 +9,7 @@ UserRepository::UserRepository() : BaseRepository<models::User>("users") {
 }
 
 QueryResult<models::User> UserRepository::findByEmail(const std::string& email) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByEmail", [&]() {
         try {
             std::string query = buildSelectQuery("email = $1 AND is_deleted = false");
             auto result = db_manager_.executeQuery(query, {email});
@@ -30,7 +31,7 @@ QueryResult<models::User> UserRepository::findByEmail(const std::string& email)
 }
 
 QueryResult<models::User> UserRepository::findByPhoneNumber(const std::string& phone_number) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByPhoneNumber", [&]() {
         try {
             std::string query = buildSelectQuery("phone_number = $1 AND is_deleted = false");
             auto result = db_manager_.executeQuery(query, {phone_number});
@@ -52,7 +53,7 @@ QueryResult<models::User> UserRepository::findByPhoneNumber(const std::string& p
 }
 
 QueryResult<models::User> UserRepository::findByRole(models::UserRole role, const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByRole", [&]() {
         try {
             std::string role_str = models::userRoleToString(role);
             std::string query = buildSelectQuery("role = $1 AND is_deleted = false",
@@ -86,7 +87,7 @@ QueryResult<models::User> UserRepository::findByRole(models::UserRole role, cons
 }
 
 QueryResult<models::User> UserRepository::findByCity(const std::string& city, const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByCity", [&]() {
         try {
             std::string query = buildSelectQuery("city = $1 AND is_deleted = false",
                                                pagination.getOrderClause(),
@@ -119,7 +120,7 @@ QueryResult<models::User> UserRepository::findByCity(const std::string& city, co
 }
 
 QueryResult<models::User> UserRepository::findVerifiedUsers(const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findVerifiedUsers", [&]() {
         try {
             std::string query = buildSelectQuery("is_verified = true AND is_deleted = false",
                                                pagination.getOrderClause(),
@@ -152,7 +153,7 @@ QueryResult<models::User> UserRepository::findVerifiedUsers(const PaginationPara
 }
 
 QueryResult<models::User> UserRepository::findUnverifiedUsers(const PaginationParams& pagination) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findUnverifiedUsers", [&]() {
         try {
             std::string query = buildSelectQuery("is_verified = false AND is_deleted = false",
                                                pagination.getOrderClause(),
@@ -185,7 +186,7 @@ QueryResult<models::User> UserRepository::findUnverifiedUsers(const PaginationPa
 }
 
 QueryResult<models::User> UserRepository::findByVerificationToken(const std::string& token) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("findByVerificationToken", [&]() {
         try {
             std::string query = buildSelectQuery("verification_token = $1 AND is_deleted = false");
             auto result = db_manager_.executeQuery(query, {token});
@@ -207,7 +208,7 @@ QueryResult<models::User> UserRepository::findByVerificationToken(const std::str
 }
 
 bool UserRepository::emailExists(const std::string& email) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("emailExists", [&]() {
         try {
             std::string query = "SELECT EXISTS(SELECT 1 FROM users WHERE email = $1 AND is_deleted = false)";
             auto result = db_manager_.executeQuery(query, {email});
@@ -222,7 +223,7 @@ bool UserRepository::emailExists(const std::string& email) {
 }
 
 bool UserRepository::phoneNumberExists(const std::string& phone_number) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("phoneNumberExists", [&]() {
         try {
             std::string query = "SELECT EXISTS(SELECT 1 FROM users WHERE phone_number = $1 AND is_deleted = false)";
             auto result = db_manager_.executeQuery(query, {phone_number});
@@ -237,7 +238,7 @@ bool UserRepository::phoneNumberExists(const std::string& phone_number) {
 }
 
 bool UserRepository::updateLastLogin(const std::string& user_id) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("updateLastLogin", [&]() {
         try {
             std::string query = "UPDATE users SET updated_at = CURRENT_TIMESTAMP WHERE id = $1";
             db_manager_.executeQuery(query, {user_id});
@@ -255,7 +256,7 @@ bool UserRepository::updateLastLogin(const std::string& user_id) {
 }
 
 bool UserRepository::updateVerificationStatus(const std::string& user_id, bool is_verified) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("updateVerificationStatus", [&]() {
         try {
             std::string query = "UPDATE users SET is_verified = $1, verification_token = NULL, "
                               "updated_at = CURRENT_TIMESTAMP WHERE id = $2";
@@ -275,7 +276,7 @@ bool UserRepository::updateVerificationStatus(const std::string& user_id, bool i
 }
 
 bool UserRepository::updateFcmToken(const std::string& user_id, const std::string& fcm_token) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("updateFcmToken", [&]() {
         try {
             std::string query = "UPDATE users SET fcm_token = $1, updated_at = CURRENT_TIMESTAMP WHERE id = $2";
             db_manager_.executeQuery(query, {fcm_token, user_id});
@@ -293,7 +294,7 @@ bool UserRepository::updateFcmToken(const std::string& user_id, const std::strin
 }
 
 bool UserRepository::updatePassword(const std::string& user_id, const std::string& password_hash, const std::string& salt) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("updatePassword", [&]() {
         try {
             std::string query = "UPDATE users SET password_hash = $1, salt = $2, "
                               "updated_at = CURRENT_TIMESTAMP WHERE id = $3";
@@ -313,7 +314,7 @@ bool UserRepository::updatePassword(const std::string& user_id, const std::strin
 }
 
 std::vector<std::string> UserRepository::getFcmTokensByRole(models::UserRole role) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("getFcmTokensByRole", [&]() {
         std::vector<std::string> tokens;
         
         try {
@@ -337,7 +338,7 @@ std::vector<std::string> UserRepository::getFcmTokensByRole(models::UserRole rol
 }
 
 int UserRepository::countByRole(models::UserRole role) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("countByRole", [&]() {
         try {
             std::string role_str = models::userRoleToString(role);
             std::string query = "SELECT COUNT(*) FROM users WHERE role = $1 AND is_deleted = false";
@@ -353,7 +354,7 @@ int UserRepository::countByRole(models::UserRole role) {
 }
 
 int UserRepository::countVerifiedUsers() {
-    return executeWithTiming([&]() {
+    return executeWithTiming("countVerifiedUsers", [&]() {
         try {
             std::string query = "SELECT COUNT(*) FROM users WHERE is_verified = true AND is_deleted = false";
             auto result = db_manager_.executeQuery(query);
@@ -368,7 +369,7 @@ int UserRepository::countVerifiedUsers() {
 }
 
 std::map<std::string, int> UserRepository::getUserStatsByCity() {
-    return executeWithTiming([&]() {
+    return executeWithTiming("getUserStatsByCity", [&]() {
         std::map<std::string, int> stats;
         
         try {
@@ -392,7 +393,7 @@ std::map<std::string, int> UserRepository::getUserStatsByCity() {
 }
 
 std::map<std::string, int> UserRepository::getRegistrationTrends(int days) {
-    return executeWithTiming([&]() {
+    return executeWithTiming("getRegistrationTrends", [&]() {
         std::map<std::string, int> trends;
         
         try {
@@ -416,6 +417,97 @@ std::map<std::string, int> UserRepository::getRegistrationTrends(int days) {
     });
 }
 
+// Search operations
+
+namespace {
+
+// Must match idx_users_search_trgm in the migration scripts
+const char* kUserSearchDocument =
+    "lower(first_name || ' ' || last_name || ' ' || email || ' ' || coalesce(city, ''))";
+
+// Shorter terms carry no full trigram, so only the substring match applies
+constexpr size_t kMinTrigramTermLength = 3;
+
+std::string normalizeSearchTerm(const std::string& search_term) {
+    std::string term;
+    for (unsigned char c : search_term) {
+        term.push_back(static_cast<char>(std::tolower(c)));
+    }
+    return term;
+}
+
+// $1 is the lowercased term, $2 the escaped substring pattern. Matches are ranked
+// by word similarity so typos and partially typed words still surface.
+std::string buildRankedSearchQuery(const std::string& search_term, const std::string& extra_conditions) {
+    std::string document = kUserSearchDocument;
+    std::string match = search_term.size() >= kMinTrigramTermLength
+        ? "($1 <% " + document + " OR " + document + " LIKE $2)"
+        : document + " LIKE $2";
+
+    return "SELECT * FROM users WHERE is_deleted = false AND " + extra_conditions + match +
+           " ORDER BY word_similarity($1, " + document + ") DESC, created_at DESC";
+}
+
+} // namespace
+
+QueryResult<models::User> UserRepository::searchUsers(const std::string& search_term,
+                                                      const PaginationParams& pagination) {
+    std::string term = normalizeSearchTerm(search_term);
+    if (term.empty()) {
+        return QueryResult<models::User>(std::vector<models::User>{});
+    }
+
+    return executeWithTiming("searchUsers", [&]() {
+        try {
+            std::string query = buildUserSearchQuery(term) + " " + pagination.getLimitClause();
+            auto result = db_manager_.executeQuery(query, {term, "%" + FilterParams::escapeLikePattern(term) + "%"});
+
+            std::vector<models::User> users;
+            for (const auto& row : result) {
+                users.push_back(mapRowToEntity(row));
+            }
+            return QueryResult<models::User>(users);
+
+        } catch (const std::exception& e) {
+            logError("searchUsers", e.what());
+            return QueryResult<models::User>(std::string("User search failed: ") + e.what());
+        }
+    });
+}
+
+QueryResult<models::User> UserRepository::searchDoctors(const std::string& search_term,
+                                                        const PaginationParams& pagination) {
+    std::string term = normalizeSearchTerm(search_term);
+    if (term.empty()) {
+        return QueryResult<models::User>(std::vector<models::User>{});
+    }
+
+    return executeWithTiming("searchDoctors", [&]() {
+        try {
+            std::string query = buildDoctorSearchQuery(term) + " " + pagination.getLimitClause();
+            auto result = db_manager_.executeQuery(query, {term, "%" + FilterParams::escapeLikePattern(term) + "%"});
+
+            std::vector<models::User> users;
+            for (const auto& row : result) {
+                users.push_back(mapRowToEntity(row));
+            }
+            return QueryResult<models::User>(users);
+
+        } catch (const std::exception& e) {
+            logError("searchDoctors", e.what());
+            return QueryResult<models::User>(std::string("Doctor search failed: ") + e.what());
+        }
+    });
+}
+
+std::string UserRepository::buildUserSearchQuery(const std::string& search_term) const {
+    return buildRankedSearchQuery(search_term, "");
+}
+
+std::string UserRepository::buildDoctorSearchQuery(const std::string& search_term) const {
+    return buildRankedSearchQuery(search_term, "role = 'DOCTOR' AND ");
+}
+
 models::User UserRepository::mapRowToEntity(const pqxx::row& row) const {
     models::User user;
     
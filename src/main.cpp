@@ -1,7 +1,13 @@
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <signal.h>
 #include <csignal>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
 #include <crow.h>
 #include <nlohmann/json.hpp>
 
@@ -9,17 +15,67 @@
 #include "../include/utils/Logger.h"
 #include "../include/utils/ConfigManager.h"
 #include "../include/utils/ResponseHelper.h"
+#include "../include/utils/Metrics.h"
+#include "../include/utils/Tracing.h"
+#include "../include/utils/CpuProfiler.h"
+#include "../include/utils/AllocationTracker.h"
 
 // Database
 #include "../include/database/DatabaseManager.h"
+#include "../include/database/SlowQueryLog.h"
 
 // Middleware
 #include "../include/middleware/AuthMiddleware.h"
 #include "../include/middleware/LoggingMiddleware.h"
 #include "../include/middleware/CorsMiddleware.h"
 
+// Services
+#include "../include/services/BookingService.h"
+#include "../include/services/BookingPartitioner.h"
+#include "../include/services/EmergencyDispatchIndex.h"
+#include "../include/services/DoctorSearchService.h"
+#include "../include/services/DoctorFacetIndex.h"
+#include "../include/services/AutocompleteService.h"
+#include "../include/services/CatalogService.h"
+#include "../include/services/ClinicRegistry.h"
+#include "../include/services/RankingService.h"
+#include "../include/services/RequestDecoders.h"
+
 using namespace healthcare;
 
+namespace {
+
+crow::response bookingErrorResponse(services::BookingError error, const std::string& message,
+                                    const std::string& request_id) {
+    using services::BookingError;
+    using utils::ErrorCode;
+    using utils::ResponseHelper;
+
+    switch (error) {
+        case BookingError::USER_NOT_FOUND:
+            return ResponseHelper::userNotFound("", request_id);
+        case BookingError::DOCTOR_NOT_FOUND:
+            return ResponseHelper::doctorNotFound("", request_id);
+        case BookingError::CLINIC_NOT_FOUND:
+            return ResponseHelper::customError(ErrorCode::CLINIC_NOT_FOUND, 404, message, {}, request_id);
+        case BookingError::TIME_SLOT_OCCUPIED:
+        case BookingError::BOOKING_CONFLICT:
+            return ResponseHelper::appointmentConflict(message, request_id);
+        case BookingError::DOCTOR_NOT_AVAILABLE:
+        case BookingError::DOCTOR_NOT_VERIFIED:
+        case BookingError::CLINIC_CLOSED:
+            return ResponseHelper::customError(ErrorCode::DOCTOR_NOT_AVAILABLE, 422, message, {}, request_id);
+        case BookingError::PAYMENT_FAILED:
+            return ResponseHelper::paymentFailed("", message, request_id);
+        case BookingError::DATABASE_ERROR:
+            return ResponseHelper::internalServerError("Booking could not be completed", request_id);
+        default:
+            return ResponseHelper::badRequest(message, {}, request_id);
+    }
+}
+
+} // namespace
+
 // Application singleton
 class HealthcareApplication {
 public:
@@ -38,17 +94,61 @@ public:
 
             auto& config = utils::GlobalConfig::getInstance();
             
-            // Initialize logger
+            // Initialize logger; request threads only enqueue, a writer thread does the I/O
+            utils::AsyncLogConfig async_log_config;
+            async_log_config.ring_bytes = static_cast<size_t>(config.getInt("logging.async.ring_kb", 256)) * 1024;
+            async_log_config.overflow = utils::stringToLogOverflowPolicy(
+                config.getString("logging.async.overflow_policy", "DROP_OLDEST"));
+            async_log_config.sample_every = static_cast<std::uint32_t>(config.getInt("logging.async.sample_every", 8));
+            async_log_config.drain_interval_ms = config.getInt("logging.async.drain_interval_ms", 20);
+
             utils::Logger::getInstance().configure(
                 config.getString("logging.level", "INFO"),
                 config.getString("logging.file", "healthcare.log"),
-                config.getBool("logging.console", true)
+                config.getBool("logging.console", true),
+                utils::Logger::kDefaultPattern,
+                async_log_config
             );
 
             LOG_INFO("========================================");
             LOG_INFO("Healthcare Booking System Starting...");
             LOG_INFO("========================================");
 
+            // Request tracing; only sampled requests record spans, only slow ones are exported
+            utils::TracingConfig tracing_config;
+            tracing_config.enabled = config.getBool("tracing.enabled", false);
+            tracing_config.sample_rate = config.getDouble("tracing.sample_rate", 0.1);
+            tracing_config.slow_threshold_ms = config.getDouble("tracing.slow_threshold_ms", 500.0);
+            tracing_config.max_spans = static_cast<size_t>(config.getInt("tracing.max_spans", 256));
+            tracing_config.service_name = config.getString("tracing.service_name", "healthcare-booking");
+            tracing_config.export_file = config.getString("tracing.export_file", "");
+            tracing_config.collector_url = config.getString("tracing.collector_url", "");
+
+            auto& tracer = utils::Tracer::getInstance();
+            tracer.configure(tracing_config);
+            tracer.start();
+
+            // On-demand CPU profiling through the admin API; off unless enabled
+            utils::ProfilerConfig profiler_config;
+            profiler_config.enabled = config.getBool("profiling.enabled", false);
+            profiler_config.default_hz = config.getInt("profiling.default_hz", 100);
+            profiler_config.max_hz = config.getInt("profiling.max_hz", 1000);
+            profiler_config.max_seconds = config.getInt("profiling.max_seconds", 60);
+            profiler_config.buffer_mb = static_cast<size_t>(config.getInt("profiling.buffer_mb", 16));
+            profiler_config.max_stack_depth = config.getInt("profiling.max_stack_depth", 64);
+            utils::CpuProfiler::getInstance().configure(profiler_config);
+            utils::CpuProfiler::registerThread();
+
+            // Per-endpoint heap accounting; needs a build with ENABLE_ALLOCATION_TRACKING
+            if (config.getBool("metrics.track_allocations", false)) {
+                if (utils::AllocationTracker::isCompiledIn()) {
+                    utils::AllocationTracker::setEnabled(true);
+                    utils::MetricsRegistry::getInstance().addCollector(utils::AllocationTracker::renderPrometheus);
+                } else {
+                    LOG_WARN("metrics.track_allocations is set but this build has no allocation tracking");
+                }
+            }
+
             // Initialize database
             database::DatabaseConfig db_config;
             db_config.host = config.getString("database.host", "localhost");
@@ -59,6 +159,15 @@ public:
             db_config.max_connections = config.getInt("database.max_connections", 10);
             db_config.connection_timeout_seconds = config.getInt("database.timeout", 30);
 
+            // Per-fingerprint query stats; the first slow run of each gets an EXPLAIN
+            database::SlowQueryConfig slow_query_config;
+            slow_query_config.enabled = config.getBool("database.slow_query.enabled", true);
+            slow_query_config.threshold_ms = config.getDouble("database.slow_query.threshold_ms", 100.0);
+            slow_query_config.max_fingerprints = static_cast<size_t>(config.getInt("database.slow_query.max_fingerprints", 512));
+            slow_query_config.explain = config.getBool("database.slow_query.explain", true);
+            slow_query_config.explain_timeout_ms = config.getInt("database.slow_query.explain_timeout_ms", 5000);
+            database::SlowQueryLog::getInstance().configure(slow_query_config);
+
             database::RedisConfig redis_config;
             redis_config.host = config.getString("redis.host", "localhost");
             redis_config.port = config.getInt("redis.port", 6379);
@@ -84,6 +193,94 @@ public:
                 LOG_INFO("Database migration completed");
             }
 
+            // Join the booking partition ring
+            services::PartitionConfig partition_config;
+            partition_config.enabled = config.getBool("partitioning.enabled", false);
+            partition_config.node_id = config.getString("partitioning.node_id", "");
+            partition_config.advertise_url = config.getString("partitioning.advertise_url", "");
+            partition_config.virtual_nodes = config.getInt("partitioning.virtual_nodes", 128);
+            partition_config.heartbeat_interval_seconds = config.getInt("partitioning.heartbeat_interval_seconds", 5);
+            partition_config.member_ttl_seconds = config.getInt("partitioning.member_ttl_seconds", 15);
+            partition_config.forward_timeout_ms = config.getInt("partitioning.forward_timeout_ms", 2000);
+            partition_config.internal_secret = config.getString("partitioning.internal_secret", "");
+            partition_config.schedule_max_age_seconds = config.getInt("partitioning.schedule_max_age_seconds", 60);
+
+            auto& partitioner = services::BookingPartitioner::getInstance();
+            partitioner.configure(partition_config);
+            if (!partitioner.start()) {
+                LOG_ERROR("Failed to start booking partitioner");
+                return false;
+            }
+
+            // Clinic hours, locations and doctor lists for open-now checks and nearby listings
+            services::ClinicRegistryConfig clinic_config;
+            clinic_config.refresh_interval_seconds = config.getInt("clinics.refresh_interval_seconds", 300);
+
+            auto& clinics = services::ClinicRegistry::getInstance();
+            clinics.configure(clinic_config);
+            clinics.start();
+
+            // Doctor search and facets, on top of the clinics just loaded; doctor writes re-read the doctor
+            services::DoctorSearchConfig search_config;
+            search_config.refresh_interval_seconds = config.getInt("doctor_search.refresh_interval_seconds", 300);
+
+            auto& doctor_search = services::DoctorSearchService::getInstance();
+            doctor_search.configure(search_config);
+            doctor_search.start();
+
+            // Emergency roster of on-duty doctors; doctor and appointment writes patch it as they commit
+            database::DoctorRepository::addChangeListener([](const models::Doctor& doctor) {
+                services::EmergencyDispatchIndex::getInstance().refreshDoctor(doctor.getId());
+                services::DoctorSearchService::getInstance().refreshDoctor(doctor.getId());
+            });
+            database::DoctorRepository::addRemoveListener([](const std::string& doctor_id) {
+                services::EmergencyDispatchIndex::getInstance().removeDoctor(doctor_id);
+                services::DoctorSearchService::getInstance().removeDoctor(doctor_id);
+            });
+            database::AppointmentRepository::addChangeListener(services::BookingService::onAppointmentStatusChanged);
+            database::AppointmentRepository::addRemoveListener(services::BookingService::onAppointmentRemoved);
+
+            services::EmergencyDispatchConfig dispatch_config;
+            dispatch_config.roster_refresh_interval_seconds = config.getInt("emergency.roster_refresh_interval_seconds", 60);
+            dispatch_config.claim_ttl_seconds = config.getInt("emergency.claim_ttl_seconds", 120);
+
+            auto& dispatch = services::EmergencyDispatchIndex::getInstance();
+            dispatch.configure(dispatch_config);
+            dispatch.start();
+
+            // Load autocomplete vocabularies; refreshed in the background from here on
+            services::AutocompleteConfig autocomplete_config;
+            autocomplete_config.refresh_interval_seconds = config.getInt("autocomplete.refresh_interval_seconds", 300);
+            autocomplete_config.max_suggestions = config.getInt("autocomplete.max_suggestions", 20);
+
+            auto& autocomplete = services::AutocompleteService::getInstance();
+            autocomplete.configure(autocomplete_config);
+            autocomplete.start();
+
+            // Columnar doctor/clinic snapshot for catalog scans; rebuilt and swapped in the background
+            services::CatalogConfig catalog_config;
+            catalog_config.refresh_interval_seconds = config.getInt("catalog.refresh_interval_seconds", 60);
+
+            auto& catalog = services::CatalogService::getInstance();
+            catalog.configure(catalog_config);
+            catalog.start();
+
+            // Static doctor scores from ratings and booking volume; requests only blend in distance
+            services::RankingConfig ranking_config;
+            ranking_config.rescore_interval_seconds = config.getInt("ranking.rescore_interval_seconds", 30);
+            ranking_config.stats_refresh_interval_seconds = config.getInt("ranking.stats_refresh_interval_seconds", 300);
+            ranking_config.booking_window_days = config.getInt("ranking.booking_window_days", 30);
+
+            auto& ranking = services::RankingService::getInstance();
+            ranking.configure(ranking_config);
+            ranking.start();
+
+            services::BookingConfig booking_config;
+            booking_config.advance_booking_days = config.getInt("appointment.booking.advance_booking_days", 30);
+            booking_config.max_batch_items = config.getInt("appointment.booking.max_batch_items", 50);
+            booking_config.max_recurring_occurrences = config.getInt("appointment.booking.max_recurring_occurrences", 26);
+            booking_service_ = std::make_unique<services::BookingService>(booking_config);
+
             // Create Crow application with middleware
             app_ = std::make_unique<crow::App<
                 middleware::LoggingMiddleware,
@@ -131,7 +328,7 @@ public:
         try {
             app_->port(port)
                 .bindaddr(host)
-                .multithreaded(threads)
+                .concurrency(threads)
                 .run();
         } catch (const std::exception& e) {
             LOG_ERROR("Server error: {}", e.what());
@@ -141,11 +338,31 @@ public:
 
     void shutdown() {
         LOG_INFO("Initiating graceful shutdown...");
+
+        // A running capture answers with what it sampled so far
+        utils::CpuProfiler::getInstance().stop();
+        std::thread profile_thread;
+        {
+            std::lock_guard<std::mutex> lock(profile_mutex_);
+            profile_thread = std::move(profile_thread_);
+        }
+        if (profile_thread.joinable()) {
+            profile_thread.join();
+        }
         
         if (app_) {
             app_->stop();
         }
 
+        services::BookingPartitioner::getInstance().stop();
+        services::EmergencyDispatchIndex::getInstance().stop();
+        services::ClinicRegistry::getInstance().stop();
+        services::DoctorSearchService::getInstance().stop();
+        services::AutocompleteService::getInstance().stop();
+        services::RankingService::getInstance().stop();
+        services::CatalogService::getInstance().stop();
+        utils::Tracer::getInstance().stop();
+
         // Disconnect from database
         try {
             database::DatabaseManager::getInstance().disconnect();
@@ -173,6 +390,12 @@ private:
         middleware::CorsMiddleware,
         middleware::AuthMiddleware
     >> app_;
+    std::unique_ptr<services::BookingService> booking_service_;
+
+    // One CPU profile capture at a time, each on its own thread
+    std::mutex profile_mutex_;
+    std::thread profile_thread_;
+    bool profile_busy_ = false;
 
     void configureMiddleware() {
         auto& config = utils::GlobalConfig::getInstance();
@@ -184,6 +407,9 @@ private:
         logging_middleware.setLogHeaders(config.getBool("logging.headers", false));
         logging_middleware.setLogBody(config.getBool("logging.body", false));
         logging_middleware.setSlowRequestThreshold(config.getDouble("logging.slow_threshold_ms", 1000.0));
+        logging_middleware.setSamplingEnabled(config.getBool("logging.sampling.enabled", true));
+        logging_middleware.setSampledRequestsPerSecond(config.getDouble("logging.sampling.per_endpoint_per_second", 10.0));
+        logging_middleware.addIgnoredPath("/metrics");  // Scrapes would skew the request stats
 
         // Configure CORS middleware
         auto& cors_middleware = app_->get_middleware<middleware::CorsMiddleware>();
@@ -225,13 +451,23 @@ private:
             "/api/v1/admin/users",
             "/api/v1/admin/doctors",
             "/api/v1/admin/statistics",
-            "/api/v1/admin/system"
+            "/api/v1/admin/system",
+            "/api/v1/admin/profile",
+            "/api/v1/admin/slow-queries"
         };
 
         for (const auto& endpoint : admin_endpoints) {
             auth_middleware.addAdminEndpoint(endpoint);
         }
 
+        // Node-to-node endpoints, authenticated by the partition ring's shared secret
+        auth_middleware.setInternalSecret(config.getString("partitioning.internal_secret", ""));
+        auth_middleware.addInternalEndpoint(services::BookingPartitioner::kSlotCheckPath);
+        auth_middleware.addInternalEndpoint(services::BookingPartitioner::kBookPath);
+        auth_middleware.addInternalEndpoint(services::BookingPartitioner::kScheduleInvalidatePath);
+        // Scrapers send the same token; the route and query shapes it exposes are not for clients
+        auth_middleware.addInternalEndpoint("/metrics");
+
         LOG_INFO("Middleware configured successfully");
     }
 
@@ -265,6 +501,419 @@ private:
             }
         });
 
+        // Prometheus scrape: latency summaries merged from the per-thread histograms.
+        // Requires X-Internal-Token like the node-to-node endpoints
+        if (utils::GlobalConfig::getInstance().getBool("metrics.enabled", true)) {
+            CROW_ROUTE((*app_), "/metrics")
+            ([]() {
+                crow::response response(200, utils::MetricsRegistry::getInstance().renderPrometheus());
+                response.add_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+                return response;
+            });
+        }
+
+        // Worst query fingerprints with captured plans, next to pool health.
+        // e.g. /api/v1/admin/slow-queries?limit=20&sort=p99 (total|max|p99|count)
+        CROW_ROUTE((*app_), "/api/v1/admin/slow-queries")
+        ([](const crow::request& req) {
+            size_t limit = 20;
+            if (const char* param = req.url_params.get("limit")) {
+                try {
+                    limit = static_cast<size_t>(std::clamp(std::stoi(param), 1, 500));
+                } catch (const std::exception&) {
+                    return utils::ResponseHelper::badRequest("limit must be an integer");
+                }
+            }
+            const char* sort_param = req.url_params.get("sort");
+            auto sort = database::stringToSlowQuerySort(sort_param ? sort_param : "total");
+
+            nlohmann::json data;
+            data["database"] = database::DatabaseManager::getInstance().getHealthStatus();
+            data["slow_queries"] = database::SlowQueryLog::getInstance().toJson(limit, sort);
+            return utils::ResponseHelper::success(data);
+        });
+
+        // CPU profile of the whole process over `seconds`, returned as folded
+        // stacks (flamegraph.pl) or a legacy pprof profile. The capture runs on
+        // its own thread and completes the response, so no worker waits on it.
+        // e.g. /api/v1/admin/profile?seconds=30&hz=99&format=pprof
+        CROW_ROUTE((*app_), "/api/v1/admin/profile")
+        ([this](const crow::request& req, crow::response& res) {
+            auto reply = [&res](crow::response response) {
+                res = std::move(response);
+                res.end();
+            };
+
+            auto& profiler = utils::CpuProfiler::getInstance();
+            const auto& profiler_config = profiler.getConfig();
+            if (!profiler_config.enabled) {
+                return reply(utils::ResponseHelper::forbidden("CPU profiling is disabled"));
+            }
+            if (!profiler.isSupported()) {
+                return reply(utils::ResponseHelper::serviceUnavailable("CPU profiling is not supported on this platform"));
+            }
+
+            int seconds = 30;
+            int frequency_hz = profiler_config.default_hz;
+            try {
+                if (const char* param = req.url_params.get("seconds")) seconds = std::stoi(param);
+                if (const char* param = req.url_params.get("hz")) frequency_hz = std::stoi(param);
+            } catch (const std::exception&) {
+                return reply(utils::ResponseHelper::badRequest("seconds and hz must be integers"));
+            }
+            const char* format_param = req.url_params.get("format");
+            std::string format_str = format_param ? format_param : "folded";
+            if (format_str != "folded" && format_str != "pprof") {
+                return reply(utils::ResponseHelper::badRequest("format must be folded or pprof"));
+            }
+            if (seconds < 1 || seconds > profiler_config.max_seconds) {
+                return reply(utils::ResponseHelper::badRequest(
+                    "seconds must be between 1 and " + std::to_string(profiler_config.max_seconds)));
+            }
+            if (frequency_hz < 1 || frequency_hz > profiler_config.max_hz) {
+                return reply(utils::ResponseHelper::badRequest(
+                    "hz must be between 1 and " + std::to_string(profiler_config.max_hz)));
+            }
+
+            std::lock_guard<std::mutex> lock(profile_mutex_);
+            if (profile_busy_ || profiler.isRunning()) {
+                return reply(utils::ResponseHelper::conflict("A profile capture is already running"));
+            }
+            if (profile_thread_.joinable()) {
+                profile_thread_.join();  // The previous capture has already answered
+            }
+            profile_busy_ = true;
+
+            // after_handle runs on the capture thread, so this worker's request state closes here
+            app_->get_middleware<middleware::LoggingMiddleware>().releaseThread(
+                app_->get_context<middleware::LoggingMiddleware>(req));
+
+            auto format = utils::stringToProfileFormat(format_str);
+            profile_thread_ = std::thread([this, &res, seconds, frequency_hz, format] {
+                utils::CpuProfile profile = utils::CpuProfiler::getInstance().capture(seconds, frequency_hz);
+
+                // res stays valid until end(), but the client may have hung up during the capture;
+                // end() still runs either way so the connection is released
+                if (!res.is_alive()) {
+                    LOG_WARN("Profile client disconnected during a {}s capture", seconds);
+                } else if (!profile.success) {
+                    res = utils::ResponseHelper::conflict(profile.error);
+                } else {
+                    if (format == utils::ProfileFormat::PPROF) {
+                        res = crow::response(200, profile.toPprof());
+                        res.add_header("Content-Type", "application/octet-stream");
+                        res.add_header("Content-Disposition", "attachment; filename=\"cpu.prof\"");
+                    } else {
+                        res = crow::response(200, profile.toFolded());
+                        res.add_header("Content-Type", "text/plain; charset=utf-8");
+                    }
+                    res.add_header("X-Profile-Samples", std::to_string(profile.samples));
+                    res.add_header("X-Profile-Dropped", std::to_string(profile.dropped));
+                }
+                res.end();
+
+                std::lock_guard<std::mutex> done_lock(profile_mutex_);
+                profile_busy_ = false;
+            });
+        });
+
+        // Slot check forwarded from peers for doctors this node owns
+        CROW_ROUTE((*app_), services::BookingPartitioner::kSlotCheckPath).methods("POST"_method)
+        ([](const crow::request& req) {
+            auto decoded = services::decodeSlotCheckRequest(req.body);
+            if (!decoded.ok()) {
+                return utils::ResponseHelper::validationError(decoded.errors);
+            }
+            const auto& check = *decoded.value;
+
+            // Warm the book on first ask so the peer does not fall back to Postgres again
+            auto& partitioner = services::BookingPartitioner::getInstance();
+            auto& schedule_book = partitioner.getScheduleBook();
+            if (partitioner.isLocalOwner(check.doctor_id) && !schedule_book.isLoaded(check.doctor_id)) {
+                services::BookingService::loadOwnedDoctorSchedule(check.doctor_id);
+            }
+
+            // Not loaded means unknown; the peer then asks Postgres rather than trusting a guess
+            auto free = schedule_book.isFree(check.doctor_id, check.start_time, check.end_time);
+            nlohmann::json result;
+            result["owner"] = partitioner.getNodeId();
+            result["loaded"] = free.has_value();
+            result["available"] = free.value_or(false);
+            return crow::response(200, result.dump());
+        });
+
+        // Booking forwarded from a peer for a doctor this node owns. Business
+        // failures still answer 200 so the peer can tell them from transport errors
+        CROW_ROUTE((*app_), services::BookingPartitioner::kBookPath).methods("POST"_method)
+        ([this](const crow::request& req) {
+            auto decoded = services::decodeForwardedBookingRequest(req.body);
+            if (!decoded.ok()) {
+                return utils::ResponseHelper::validationError(decoded.errors);
+            }
+            auto result = booking_service_->bookAppointmentAsOwner(*decoded.value);
+            return crow::response(200, services::bookingResultToJson(result).dump());
+        });
+
+        // A peer wrote an appointment for a doctor this node owns; re-read the schedule on next use
+        CROW_ROUTE((*app_), services::BookingPartitioner::kScheduleInvalidatePath).methods("POST"_method)
+        ([](const crow::request& req) {
+            auto decoded = services::decodeScheduleInvalidateRequest(req.body);
+            if (!decoded.ok()) {
+                return utils::ResponseHelper::validationError(decoded.errors);
+            }
+            services::BookingPartitioner::getInstance().getScheduleBook().evict(decoded.value->doctor_id);
+            return crow::response(204);
+        });
+
+        // Book an appointment for the signed-in user; served by the node owning the doctor's schedule
+        CROW_ROUTE((*app_), "/api/v1/appointments").methods("POST"_method)
+        ([this](const crow::request& req) {
+            const auto& ctx = app_->get_context<middleware::AuthMiddleware>(req);
+            auto decoded = services::decodeBookingRequest(req.body);
+            if (!decoded.ok()) {
+                return utils::ResponseHelper::validationError(decoded.errors, "Validation failed", ctx.request_id);
+            }
+            auto request = std::move(*decoded.value);
+            request.user_id = ctx.auth_context.user_id;
+
+            auto result = booking_service_->bookAppointment(request, ctx.request_id);
+            if (result.error != services::BookingError::SUCCESS) {
+                return bookingErrorResponse(result.error, result.message, ctx.request_id);
+            }
+
+            nlohmann::json data;
+            data["appointment"] = result.appointment->toJson();
+            if (!result.payment_url.empty()) {
+                data["payment_url"] = result.payment_url;
+            }
+            return utils::ResponseHelper::created(data, result.message, ctx.request_id);
+        });
+
+        // Several appointments in one transaction and one payment order (treatment plans, family visits)
+        CROW_ROUTE((*app_), "/api/v1/appointments/batch").methods("POST"_method)
+        ([this](const crow::request& req) {
+            const auto& ctx = app_->get_context<middleware::AuthMiddleware>(req);
+            auto decoded = services::decodeBatchBookingRequest(req.body);
+            if (!decoded.ok()) {
+                return utils::ResponseHelper::validationError(decoded.errors, "Validation failed", ctx.request_id);
+            }
+            auto request = std::move(*decoded.value);
+            request.user_id = ctx.auth_context.user_id;
+
+            auto result = booking_service_->bookAppointments(request);
+
+            nlohmann::json data;
+            data["items"] = nlohmann::json::array();
+            for (const auto& item : result.items) {
+                nlohmann::json entry;
+                entry["booked"] = item.appointment != nullptr;
+                entry["message"] = item.message;
+                if (item.appointment) {
+                    entry["appointment"] = item.appointment->toJson();
+                }
+                data["items"].push_back(std::move(entry));
+            }
+            data["booked_count"] = result.booked_count;
+            data["total_amount"] = result.total_amount;
+            if (!result.payment_url.empty()) {
+                data["payment_order_id"] = result.payment_order_id;
+                data["payment_batch_id"] = result.payment_batch_id;
+                data["payment_url"] = result.payment_url;
+            }
+
+            switch (result.error) {
+                case services::BookingError::SUCCESS:
+                    return utils::ResponseHelper::created(data, result.message, ctx.request_id);
+                case services::BookingError::BOOKING_CONFLICT:  // Some items booked; the rest say why not
+                    return utils::ResponseHelper::success(data, result.message, ctx.request_id);
+                case services::BookingError::VALIDATION_ERROR:
+                    return utils::ResponseHelper::badRequest(result.message, data, ctx.request_id);
+                default:
+                    return bookingErrorResponse(result.error, result.message, ctx.request_id);
+            }
+        });
+
+        // Search-as-you-type over doctors with facet filters and counts, served from memory.
+        // Facet parameters take comma-separated values, e.g. city=Pune,Nashik&fee_band=0-299
+        CROW_ROUTE((*app_), "/api/v1/search/doctors")
+        ([](const crow::request& req) {
+            const char* query = req.url_params.get("q");
+            bool has_query = query != nullptr && *query != '\0';
+
+            services::FacetQuery facet_query;
+            bool has_filters = false;
+            for (size_t facet = 0; facet < services::DoctorFacetIndex::kFacetCount; ++facet) {
+                std::string name = services::DoctorFacetIndex::facetToString(static_cast<services::Facet>(facet));
+                const char* param = req.url_params.get(name);
+                if (param == nullptr) continue;
+
+                std::string values = param;
+                size_t begin = 0;
+                while (begin <= values.size()) {
+                    size_t end = values.find(',', begin);
+                    if (end == std::string::npos) end = values.size();
+                    if (end > begin) {
+                        facet_query.selected[facet].push_back(values.substr(begin, end - begin));
+                    }
+                    begin = end + 1;
+                }
+                has_filters = has_filters || !facet_query.selected[facet].empty();
+            }
+
+            if (!has_query && !has_filters) {
+                return utils::ResponseHelper::validationError("q", "Search query or facet filter is required");
+            }
+
+            size_t limit = services::DoctorSearchService::kDefaultLimit;
+            if (const char* limit_param = req.url_params.get("limit")) {
+                limit = std::clamp<size_t>(std::strtoul(limit_param, nullptr, 10), 1, 50);
+            }
+            if (const char* offset_param = req.url_params.get("offset")) {
+                facet_query.offset = std::strtoul(offset_param, nullptr, 10);
+            }
+            facet_query.limit = limit;
+
+            auto& search_service = services::DoctorSearchService::getInstance();
+            std::unordered_map<std::string, services::DoctorSearchResult> text_hits;
+            if (has_query) {
+                // Facets narrow the text hits, so fetch a wider candidate set than one page
+                facet_query.candidates.emplace();
+                for (auto& hit : search_service.search(query, services::DoctorSearchService::kMaxCandidates)) {
+                    facet_query.candidates->push_back(hit.doctor_id);
+                    text_hits.emplace(hit.doctor_id, std::move(hit));
+                }
+            }
+
+            auto facet_result = services::DoctorFacetIndex::getInstance().query(facet_query);
+
+            nlohmann::json results = nlohmann::json::array();
+            auto matches = has_query ? std::vector<services::DoctorSearchResult>{}
+                                     : search_service.lookup(facet_result.doctor_ids);
+            if (has_query) {
+                for (const auto& doctor_id : facet_result.doctor_ids) {
+                    matches.push_back(text_hits.at(doctor_id));
+                }
+            }
+            for (const auto& hit : matches) {
+                nlohmann::json item;
+                item["doctor_id"] = hit.doctor_id;
+                item["name"] = hit.name;
+                item["specializations"] = hit.specializations;
+                item["score"] = hit.score;
+                results.push_back(item);
+            }
+
+            nlohmann::json facets;
+            for (size_t facet = 0; facet < services::DoctorFacetIndex::kFacetCount; ++facet) {
+                nlohmann::json counts = nlohmann::json::array();
+                for (const auto& count : facet_result.counts[facet]) {
+                    counts.push_back({{"value", count.value}, {"count", count.count}});
+                }
+                facets[services::DoctorFacetIndex::facetToString(static_cast<services::Facet>(facet))] = counts;
+            }
+
+            nlohmann::json data;
+            data["results"] = results;
+            data["total"] = facet_result.total;
+            data["facets"] = facets;
+            return utils::ResponseHelper::success(data, "Search results retrieved successfully");
+        });
+
+        // Doctors ranked by static score, distance and availability; ?lat=&lon= enables distance
+        CROW_ROUTE((*app_), "/api/v1/doctors/ranked")
+        ([](const crow::request& req) {
+            services::RankingQuery query;
+            const char* latitude = req.url_params.get("lat");
+            const char* longitude = req.url_params.get("lon");
+            if ((latitude == nullptr) != (longitude == nullptr)) {
+                return utils::ResponseHelper::validationError("lat", "lat and lon must be given together");
+            }
+            if (latitude && longitude) {
+                query.latitude = std::strtod(latitude, nullptr);
+                query.longitude = std::strtod(longitude, nullptr);
+                if (std::abs(*query.latitude) > 90.0 || std::abs(*query.longitude) > 180.0) {
+                    return utils::ResponseHelper::validationError("lat", "Coordinates out of range");
+                }
+            }
+            if (const char* radius = req.url_params.get("radius_km")) {
+                query.radius_km = std::clamp(std::strtod(radius, nullptr), 0.5, 200.0);
+            }
+            if (const char* specialization = req.url_params.get("specialization")) {
+                query.specialization = specialization;
+            }
+            if (const char* type = req.url_params.get("consultation_type")) {
+                query.consultation_type = models::stringToConsultationType(type);
+            }
+            if (const char* limit = req.url_params.get("limit")) {
+                query.limit = std::clamp<size_t>(std::strtoul(limit, nullptr, 10), 1, 100);
+            }
+
+            auto ranked = services::RankingService::getInstance().rank(query);
+            return utils::ResponseHelper::streamSuccess([&ranked](utils::JsonWriter& writer) {
+                writer.beginArray();
+                for (const auto& doctor : ranked) {
+                    writer.beginObject();
+                    writer.field("available_today", doctor.available_today);
+                    writer.key("distance_km");
+                    if (doctor.distance_km) writer.value(*doctor.distance_km);
+                    else writer.null();
+                    writer.field("doctor_id", doctor.doctor_id);
+                    writer.field("name", doctor.name);
+                    writer.field("score", doctor.score);
+                    writer.field("static_score", doctor.static_score);
+                    writer.endObject();
+                }
+                writer.endArray();
+            }, "Ranked doctors retrieved successfully");
+        });
+
+        // Doctors per specialization, city, consultation type and fee band
+        CROW_ROUTE((*app_), "/api/v1/doctors/facets")
+        ([]() {
+            auto& facet_index = services::DoctorFacetIndex::getInstance();
+            nlohmann::json data;
+            for (size_t facet = 0; facet < services::DoctorFacetIndex::kFacetCount; ++facet) {
+                auto type = static_cast<services::Facet>(facet);
+                nlohmann::json counts = nlohmann::json::array();
+                for (const auto& count : facet_index.countsFor(type)) {
+                    counts.push_back({{"value", count.value}, {"count", count.count}});
+                }
+                data[services::DoctorFacetIndex::facetToString(type)] = counts;
+            }
+            data["total_doctors"] = facet_index.getStats().indexed_doctors;
+
+            // Behind auth, so only the caller's browser may keep a copy
+            auto response = utils::ResponseHelper::success(data, "Doctor facet counts retrieved successfully");
+            response.set_header("Cache-Control", "private, max-age=60");
+            return response;
+        });
+
+        // Keystroke autocomplete for specializations, cities and medicines; memory only
+        CROW_ROUTE((*app_), "/api/v1/autocomplete/<string>")
+        ([](const crow::request& req, const std::string& vocabulary_name) {
+            auto vocabulary = services::AutocompleteService::vocabularyFromString(vocabulary_name);
+            if (!vocabulary) {
+                return utils::ResponseHelper::notFound("Unknown vocabulary: " + vocabulary_name);
+            }
+
+            const char* prefix = req.url_params.get("q");
+            size_t limit = 10;
+            if (const char* limit_param = req.url_params.get("limit")) {
+                limit = std::max<size_t>(std::strtoul(limit_param, nullptr, 10), 1);
+            }
+
+            nlohmann::json suggestions = nlohmann::json::array();
+            for (const auto& suggestion : services::AutocompleteService::getInstance().suggest(
+                     *vocabulary, prefix ? prefix : "", limit)) {
+                suggestions.push_back({{"term", suggestion.term}, {"weight", suggestion.weight}});
+            }
+
+            // Behind auth, so shared caches must not store it
+            auto response = utils::ResponseHelper::success(suggestions, "Suggestions retrieved successfully");
+            response.set_header("Cache-Control", "private, max-age=60");
+            return response;
+        });
+
         // API documentation endpoint
         CROW_ROUTE((*app_), "/api/v1/docs")
         ([](const crow::request& req) {
@@ -320,7 +969,9 @@ private:
         // Root endpoint redirect
         CROW_ROUTE((*app_), "/")
         ([](const crow::request& req) {
-            return crow::response(302, "", {{"Location", "/api/v1/docs"}});
+            crow::response res(302);
+            res.add_header("Location", "/api/v1/docs");
+            return res;
         });
 
         // API info endpoint
@@ -339,8 +990,8 @@ private:
         // 404 handler
         CROW_CATCHALL_ROUTE((*app_))
         ([](const crow::request& req) {
-            LOG_WARN("404 - Endpoint not found: {} {}", req.method_string(), req.url);
-            return utils::ResponseHelper::notFound("Endpoint not found: " + std::string(req.method_string()) + " " + req.url);
+            LOG_WARN("404 - Endpoint not found: {} {}", crow::method_name(req.method), req.url);
+            return utils::ResponseHelper::notFound("Endpoint not found: " + crow::method_name(req.method) + " " + req.url);
         });
 
         LOG_INFO("Routes registered successfully");
@@ -1,6 +1,7 @@
 #include "../../include/middleware/AuthMiddleware.h"
 #include "../../include/utils/CryptoUtils.h"
 #include "../../include/utils/Logger.h"
+#include "../../include/utils/Tracing.h"
 #include "../../include/database/DatabaseManager.h"
 #include <algorithm>
 #include <sstream>
@@ -12,6 +13,16 @@ AuthMiddleware::AuthMiddleware() {
 }
 
 void AuthMiddleware::before_handle(crow::request& req, crow::response& res, context& ctx) {
+    // Node-to-node calls carry the cluster secret instead of a user token
+    if (isInternalEndpoint(req.url)) {
+        const std::string& token = req.get_header_value(kInternalTokenHeader);
+        if (internal_secret_.empty() || !utils::CryptoUtils::secureCompare(token, internal_secret_)) {
+            handleUnauthorized(res, "Invalid internal token");
+        }
+        ctx.is_authenticated = false;
+        return;
+    }
+    
     // Skip auth for public endpoints
     if (isPublicEndpoint(req.url)) {
         ctx.is_authenticated = false;
@@ -26,7 +37,10 @@ void AuthMiddleware::before_handle(crow::request& req, crow::response& res, cont
     }
     
     // Verify token
-    auto jwt_result = utils::CryptoUtils::verifyJwtToken(token, jwt_secret_);
+    auto jwt_result = [&] {
+        utils::TraceSpan span("auth.verify_jwt");
+        return utils::CryptoUtils::verifyJwtToken(token, jwt_secret_);
+    }();
     if (!jwt_result.valid) {
         handleUnauthorized(res, jwt_result.error);
         return;
@@ -38,9 +52,12 @@ void AuthMiddleware::before_handle(crow::request& req, crow::response& res, cont
     ctx.is_authenticated = true;
     
     // Check session validity
-    if (session_validation_enabled_ && !isSessionValid(ctx.user_id, token)) {
-        handleUnauthorized(res, "Invalid or expired session");
-        return;
+    if (session_validation_enabled_) {
+        utils::TraceSpan span("auth.session");
+        if (!isSessionValid(ctx.user_id, token)) {
+            handleUnauthorized(res, "Invalid or expired session");
+            return;
+        }
     }
     
     // Check role-based access
@@ -50,9 +67,12 @@ void AuthMiddleware::before_handle(crow::request& req, crow::response& res, cont
     }
     
     // Apply rate limiting
-    if (rate_limiting_enabled_ && !checkRateLimit(ctx.user_id, req.remote_ip_address)) {
-        handleTooManyRequests(res);
-        return;
+    if (rate_limiting_enabled_) {
+        utils::TraceSpan span("auth.rate_limit");
+        if (!checkRateLimit(ctx.user_id, req.remote_ip_address)) {
+            handleTooManyRequests(res);
+            return;
+        }
     }
     
     // Update last activity
@@ -76,6 +96,10 @@ void AuthMiddleware::addPublicEndpoint(const std::string& endpoint) {
     public_endpoints_.insert(endpoint);
 }
 
+void AuthMiddleware::addInternalEndpoint(const std::string& endpoint) {
+    internal_endpoints_.insert(endpoint);
+}
+
 void AuthMiddleware::addRoleRequirement(const std::string& endpoint, const std::string& required_role) {
     role_requirements_[endpoint] = required_role;
 }
@@ -246,6 +270,12 @@ bool AuthMiddleware::isPublicEndpoint(const std::string& url) const {
     return false;
 }
 
+bool AuthMiddleware::isInternalEndpoint(const std::string& url) const {
+    size_t query_pos = url.find('?');
+    std::string path = (query_pos != std::string::npos) ? url.substr(0, query_pos) : url;
+    return internal_endpoints_.find(path) != internal_endpoints_.end();
+}
+
 bool AuthMiddleware::hasRequiredRole(const std::string& url, const std::string& user_role) const {
     // Remove query parameters
     size_t query_pos = url.find('?');
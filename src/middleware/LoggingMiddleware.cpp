@@ -1,217 +1,772 @@
 #include "../../include/middleware/LoggingMiddleware.h"
+#include "../../include/utils/CpuProfiler.h"
 #include "../../include/utils/Logger.h"
-#include <chrono>
-#include <sstream>
+#include "../../include/utils/Metrics.h"
+#include "../../include/utils/Tracing.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <thread>
 
 namespace healthcare::middleware {
 
-void LoggingMiddleware::before_handle(crow::request& req, crow::response& res, context& ctx) {
-    ctx.start_time = std::chrono::high_resolution_clock::now();
-    
-    // Generate request ID
-    ctx.request_id = generateRequestId();
-    
-    // Log request details
-    logRequest(req, ctx.request_id);
-    
-    // Add request ID to response headers
-    res.add_header("X-Request-ID", ctx.request_id);
-}
-
-void LoggingMiddleware::after_handle(crow::request& req, crow::response& res, context& ctx) {
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - ctx.start_time);
-    
-    ctx.response_time_ms = duration.count();
-    
-    // Log response details
-    logResponse(req, res, ctx);
-    
-    // Update statistics
-    updateStats(req, res, ctx);
-}
-
-void LoggingMiddleware::logRequest(const crow::request& req, const std::string& request_id) {
-    nlohmann::json log_data;
-    log_data["request_id"] = request_id;
-    log_data["method"] = crow::method_name(req.method);
-    log_data["url"] = req.url;
-    log_data["remote_ip"] = req.remote_ip_address;
-    
-    // Log headers (excluding sensitive ones)
-    nlohmann::json headers;
-    for (const auto& [key, value] : req.headers) {
-        if (shouldLogHeader(key)) {
-            headers[key] = value;
-        }
-    }
-    log_data["headers"] = headers;
-    
-    // Log query parameters
-    if (!req.url_params.keys().empty()) {
-        nlohmann::json params;
-        for (const auto& key : req.url_params.keys()) {
-            params[key] = req.url_params.get(key);
-        }
-        log_data["query_params"] = params;
-    }
-    
-    // Log body for non-GET requests (with size limit)
-    if (req.method != crow::HTTPMethod::Get && !req.body.empty()) {
-        if (req.body.length() <= 1024) { // Log small bodies
-            log_data["body"] = req.body;
-        } else {
-            log_data["body_size"] = req.body.length();
-            log_data["body_truncated"] = true;
-        }
-    }
-    
-    LOG_INFO("Request: {}", log_data.dump());
-}
-
-void LoggingMiddleware::logResponse(const crow::request& req, const crow::response& res, const context& ctx) {
-    nlohmann::json log_data;
-    log_data["request_id"] = ctx.request_id;
-    log_data["method"] = crow::method_name(req.method);
-    log_data["url"] = req.url;
-    log_data["status_code"] = res.code;
-    log_data["response_time_ms"] = ctx.response_time_ms;
-    
-    // Log response headers (excluding sensitive ones)
-    nlohmann::json headers;
-    for (const auto& [key, value] : res.headers) {
-        if (shouldLogHeader(key)) {
-            headers[key] = value;
-        }
-    }
-    log_data["response_headers"] = headers;
-    
-    // Log response size
-    log_data["response_size"] = res.body.length();
-    
-    // Determine log level based on status code
-    if (res.code >= 500) {
-        LOG_ERROR("Response: {}", log_data.dump());
-    } else if (res.code >= 400) {
-        LOG_WARN("Response: {}", log_data.dump());
-    } else {
-        LOG_INFO("Response: {}", log_data.dump());
+namespace {
+
+// Formats are referenced by pointer from queued records, so they live for the program
+const utils::LogFormat kRequestFormat("http_request", {
+    "request_id", "method", "path", "query", "client_ip", "user_id", "user_agent", "content_length"
+});
+const utils::LogFormat kRequestDetailFormat("http_request_detail", {
+    "request_id", "headers", "body"
+});
+const utils::LogFormat kResponseFormat("http_response", {
+    "request_id", "method", "path", "status_code", "duration_ms", "response_size", "user_id"
+});
+const utils::LogFormat kSlowRequestFormat("slow_request", {
+    "request_id", "method", "path", "status_code", "duration_ms", "threshold_ms"
+});
+const utils::LogFormat kPerformanceFormat("request_performance", {
+    "endpoint", "duration_ms", "request_size", "response_size", "allocations", "allocated_bytes"
+});
+
+utils::LatencyHistogram& requestLatency(std::string_view endpoint) {
+    static utils::LatencyFamily& family = utils::MetricsRegistry::getInstance().latencyFamily(
+        "http_request_duration_seconds", "HTTP request latency by normalized endpoint", {"endpoint"});
+    return family.series(endpoint);
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Lower cases into the request arena; the sets hold lower-case names
+bool isSensitiveName(const std::set<std::string, std::less<>>& names, std::string_view name) {
+    std::pmr::string lower = utils::RequestArena::string(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return names.count(std::string_view(lower)) > 0;
+}
+
+constexpr std::string_view kMask = "********";  // Fixed width so the mask does not leak the secret's length
+
+} // namespace
+
+LoggingMiddleware::LoggingMiddleware()
+    : endpoint_state_(utils::RouteNormalizer::kMaxEndpoints) {
+    initializeDefaults();
+}
+
+// Middleware hooks
+
+void LoggingMiddleware::before_handle(crow::request& req, crow::response& /*res*/, context& ctx) {
+    // First hook to run, so everything downstream can use the arena
+    ctx.arena = utils::RequestArena::begin();
+    ctx.thread = std::this_thread::get_id();
+    utils::CpuProfiler::registerThread();  // Lets profiler samples walk past this thread's leaf frame
+
+    auto& request_info = ctx.request_info;
+    request_info.start_time = std::chrono::high_resolution_clock::now();
+    request_info.path = req.url;
+
+    ctx.should_log = !shouldIgnorePath(request_info.path);
+    if (!ctx.should_log) {
+        return;
+    }
+
+    request_info.method = crow::method_name(req.method);
+    size_t query_start = req.raw_url.find('?');
+    if (query_start != std::string::npos) {
+        request_info.query_string = req.raw_url.substr(query_start + 1);
+    }
+    request_info.user_agent = req.get_header_value("User-Agent");
+    request_info.client_ip = extractClientIp(req);
+    request_info.user_id = extractUserId(req);
+    request_info.content_length = req.body.size();
+    request_info.content_type = req.get_header_value("Content-Type");
+
+    // Keep an upstream proxy's ID so one request can be followed across hops
+    const std::string& incoming_id = req.get_header_value("X-Request-ID");
+    ctx.request_id = (incoming_id.empty() || incoming_id.size() > 128) ? generateRequestId() : incoming_id;
+    // Only routes that answered are interned (after_handle), so this is kOtherEndpoint on a first hit
+    ctx.endpoint_id = lookupEndpoint(request_info.path);
+
+    // Heap use on this thread until after_handle is charged to the endpoint
+    if (utils::AllocationTracker::isEnabled()) {
+        utils::AllocationTracker::setCurrentEndpoint(ctx.endpoint_id);
+        ctx.allocations_at_start = utils::AllocationTracker::threadTotals();
+    }
+
+    // Root span for everything this thread does for the request, middleware included
+    utils::Tracer::getInstance().beginTrace(ctx.request_id, request_info.method,
+                                            utils::RouteNormalizer::getInstance().name(ctx.endpoint_id));
+
+    // Hold this request's lines until after_handle knows its status and latency
+    if (sampling_enabled_) {
+        utils::Logger::getInstance().beginRequestCapture();
+    }
+
+    if (log_requests_ && shouldLogLevel(LogLevel::INFO)) {
+        logRequest(req, request_info, ctx.request_id);
     }
 }
 
-bool LoggingMiddleware::shouldLogHeader(const std::string& header_name) {
-    static const std::set<std::string> sensitive_headers = {
-        "authorization",
-        "cookie",
-        "set-cookie",
-        "x-api-key",
-        "x-auth-token"
-    };
-    
-    std::string lower_header = header_name;
-    std::transform(lower_header.begin(), lower_header.end(), lower_header.begin(), ::tolower);
-    
-    return sensitive_headers.find(lower_header) == sensitive_headers.end();
+void LoggingMiddleware::after_handle(crow::request& /*req*/, crow::response& res, context& ctx) {
+    // An async response ends on whichever thread called res.end(); this thread's
+    // arena, trace and capture belong to some other request, if any
+    bool owns_thread = std::this_thread::get_id() == ctx.thread;
+
+    if (!ctx.should_log) {
+        if (owns_thread) utils::RequestArena::end();
+        return;
+    }
+
+    auto& response_info = ctx.response_info;
+    response_info.end_time = std::chrono::high_resolution_clock::now();
+    response_info.duration_ms = std::chrono::duration<double, std::milli>(
+        response_info.end_time - ctx.request_info.start_time).count();
+    response_info.status_code = res.code;
+    response_info.content_length = res.body.size();
+    response_info.content_type = res.get_header_value("Content-Type");
+
+    // Set here rather than in before_handle: handlers replace the whole response
+    if (include_request_id_) {
+        res.add_header("X-Request-ID", ctx.request_id);
+    }
+
+    // Unmatched paths and wrong methods stay in (other) so scanner probes cannot fill the route table
+    EndpointId endpoint = ctx.endpoint_id;
+    if (endpoint == utils::RouteNormalizer::kOtherEndpoint &&
+        response_info.status_code != 404 && response_info.status_code != 405) {
+        endpoint = normalizeEndpoint(ctx.request_info.path);
+    }
+    utils::AllocationCounters allocations;
+    if (owns_thread && utils::AllocationTracker::isEnabled()) {
+        allocations = utils::AllocationTracker::threadTotals() - ctx.allocations_at_start;
+    }
+
+    requestLatency(utils::RouteNormalizer::getInstance().name(endpoint))
+        .record(response_info.end_time - ctx.request_info.start_time);
+    updateStats(response_info, endpoint, allocations);
+
+    bool slow = response_info.duration_ms > slow_request_threshold_ms_;
+    bool keep = true;
+    if (sampling_enabled_) {
+        keep = sampleRequest(endpoint, response_info.status_code >= 400 || slow);
+    }
+
+    if (keep) {
+        if (log_responses_) {
+            logResponse(ctx.request_info, response_info, ctx.request_id);
+        }
+        if (log_slow_requests_ && slow) {
+            logSlowRequest(ctx.request_info, response_info, ctx.request_id);
+        }
+        if (response_info.duration_ms > performance_threshold_ms_) {
+            logPerformanceMetrics(ctx.request_info, response_info, endpoint, allocations);
+        }
+    }
+
+    if (!owns_thread) {
+        return;
+    }
+
+    if (sampling_enabled_) {
+        utils::Logger::getInstance().endRequestCapture(keep);
+    }
+
+    utils::Tracer::getInstance().endTrace(response_info.status_code);
+    utils::AllocationTracker::setCurrentEndpoint(utils::AllocationTracker::kNoEndpoint);
+
+    // Last hook before the response is written; nothing below may use the arena
+    utils::RequestArena::end();
+}
+
+void LoggingMiddleware::releaseThread(context& ctx) {
+    if (std::this_thread::get_id() != ctx.thread) {
+        return;
+    }
+    ctx.thread = std::thread::id();
+    ctx.arena = nullptr;
+
+    if (ctx.should_log) {
+        // The response is still pending; its lines are kept rather than sampled blind
+        if (sampling_enabled_) {
+            utils::Logger::getInstance().endRequestCapture(true);
+        }
+        utils::Tracer::getInstance().endTrace(202);
+        utils::AllocationTracker::setCurrentEndpoint(utils::AllocationTracker::kNoEndpoint);
+    }
+    utils::RequestArena::end();
+}
+
+// Filtering
+
+void LoggingMiddleware::addIgnoredPath(const std::string& path) {
+    ignored_paths_.insert(path);
+}
+
+void LoggingMiddleware::removeIgnoredPath(const std::string& path) {
+    ignored_paths_.erase(path);
+}
+
+void LoggingMiddleware::addSensitiveHeader(const std::string& header) {
+    sensitive_headers_.insert(toLower(header));
+}
+
+void LoggingMiddleware::addSensitiveParam(const std::string& param) {
+    sensitive_params_.insert(toLower(param));
+}
+
+// Custom logging
+
+void LoggingMiddleware::logCustomEvent(const std::string& event, const nlohmann::json& data) {
+    utils::Logger::getInstance().logWithContext(utils::LogLevel::INFO, event, data);
+}
+
+void LoggingMiddleware::logError(const std::string& message, const std::exception& ex) {
+    utils::Logger::getInstance().logError(message, ex);
+}
+
+void LoggingMiddleware::logSecurityEvent(const std::string& event, const std::string& details) {
+    utils::Logger::getInstance().logSecurityEvent(event, "", {{"details", details}});
+}
+
+// Statistics
+
+LoggingMiddleware::LogStats LoggingMiddleware::getStats() const {
+    const auto& routes = utils::RouteNormalizer::getInstance();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    LogStats stats = stats_;
+    for (EndpointId id = 0; id < endpoint_state_.size(); ++id) {
+        const EndpointState& state = endpoint_state_[id];
+        std::string name(routes.name(id));
+        if (state.requests > 0) {
+            stats.endpoint_counts[name] = static_cast<int>(state.requests);
+            stats.endpoint_avg_times[name] = state.avg_time_ms;
+        }
+        if (state.seen > 0) {
+            stats.endpoint_sample_rates[name] = static_cast<double>(state.kept) / state.seen;
+        }
+        if (state.allocations > 0) {
+            stats.endpoint_avg_allocations[name] = static_cast<double>(state.allocations) / state.requests;
+            stats.endpoint_avg_allocated_bytes[name] = static_cast<double>(state.allocated_bytes) / state.requests;
+        }
+    }
+    return stats;
+}
+
+void LoggingMiddleware::resetStats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = LogStats{};
+    std::fill(endpoint_state_.begin(), endpoint_state_.end(), EndpointState{});
+}
+
+// Health monitoring
+
+bool LoggingMiddleware::isHealthy() const {
+    return isResponseTimeHealthy() && isErrorRateHealthy();
 }
 
-std::string LoggingMiddleware::generateRequestId() {
+nlohmann::json LoggingMiddleware::getHealthStatus() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    nlohmann::json status;
+    status["total_requests"] = stats_.total_requests;
+    status["error_requests"] = stats_.error_requests;
+    status["slow_requests"] = stats_.slow_requests;
+    status["average_response_time_ms"] = stats_.average_response_time_ms;
+    status["max_response_time_ms"] = stats_.max_response_time_ms;
+    status["sampled_kept_requests"] = stats_.sampled_kept_requests;
+    status["sampled_dropped_requests"] = stats_.sampled_dropped_requests;
+    status["error_rate"] = stats_.total_requests > 0
+        ? static_cast<double>(stats_.error_requests) / stats_.total_requests : 0.0;
+    status["healthy"] = stats_.average_response_time_ms < slow_request_threshold_ms_ &&
+                        (stats_.total_requests == 0 ||
+                         static_cast<double>(stats_.error_requests) / stats_.total_requests < 0.1);
+    return status;
+}
+
+// Helper methods
+
+std::string LoggingMiddleware::generateRequestId() const {
     static std::atomic<uint64_t> counter{0};
-    
-    auto now = std::chrono::system_clock::now();
+
     auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()
+        std::chrono::system_clock::now().time_since_epoch()
     ).count();
-    
-    std::ostringstream oss;
-    oss << std::hex << timestamp << "-" << counter.fetch_add(1);
-    
-    return oss.str();
+
+    char buffer[40];
+    int length = std::snprintf(buffer, sizeof(buffer), "%llx-%llx",
+                               static_cast<unsigned long long>(timestamp),
+                               static_cast<unsigned long long>(counter.fetch_add(1, std::memory_order_relaxed)));
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+std::string LoggingMiddleware::extractClientIp(const crow::request& req) const {
+    const std::string& forwarded = req.get_header_value("X-Forwarded-For");
+    if (!forwarded.empty()) {
+        // First entry is the original client; later ones are proxies
+        size_t end = forwarded.find(',');
+        std::string client = forwarded.substr(0, end);
+        client.erase(0, client.find_first_not_of(' '));
+        client.erase(client.find_last_not_of(' ') + 1);
+        if (!client.empty()) {
+            return client;
+        }
+    }
+
+    const std::string& real_ip = req.get_header_value("X-Real-IP");
+    return real_ip.empty() ? req.remote_ip_address : real_ip;
+}
+
+std::string LoggingMiddleware::extractUserId(const crow::request& req) const {
+    // Runs ahead of AuthMiddleware, so only an identity set by the gateway is known here
+    return req.get_header_value("X-User-ID");
+}
+
+bool LoggingMiddleware::shouldIgnorePath(const std::string& path) const {
+    return ignored_paths_.find(path) != ignored_paths_.end();
+}
+
+bool LoggingMiddleware::shouldLogLevel(LogLevel level) const {
+    return level != LogLevel::NONE && log_level_ != LogLevel::NONE && level <= log_level_;
+}
+
+LoggingMiddleware::EndpointId LoggingMiddleware::normalizeEndpoint(std::string_view path) const {
+    return utils::RouteNormalizer::getInstance().normalize(path);
 }
 
-void LoggingMiddleware::updateStats(const crow::request& req, const crow::response& res, const context& ctx) {
+LoggingMiddleware::EndpointId LoggingMiddleware::lookupEndpoint(std::string_view path) const {
+    return utils::RouteNormalizer::getInstance().lookup(path);
+}
+
+void LoggingMiddleware::logRequest(const crow::request& req, const RequestInfo& request_info,
+                                   const std::string& request_id) {
+    if (log_format_ != LogFormats::JSON) {
+        LOG_INFO(formatLogMessage(log_format_, request_info, ResponseInfo{}, request_id));
+        return;
+    }
+
+    std::pmr::string query = sanitizeQueryString(request_info.query_string);
+    LOG_RECORD(INFO, kRequestFormat,
+               request_id,
+               request_info.method,
+               request_info.path,
+               query,
+               request_info.client_ip,
+               request_info.user_id,
+               request_info.user_agent,
+               request_info.content_length);
+
+    // Headers and bodies are opt-in and the only part that needs sanitizing
+    if (log_headers_ || log_body_) {
+        std::pmr::string headers = log_headers_ ? sanitizeHeaders(req.headers) : utils::RequestArena::string();
+        LOG_RECORD(DEBUG, kRequestDetailFormat,
+                   request_id,
+                   headers,
+                   log_body_ ? sanitizeBody(req.body, request_info.content_type) : std::string());
+    }
+}
+
+void LoggingMiddleware::logResponse(const RequestInfo& request_info, const ResponseInfo& response_info,
+                                    const std::string& request_id) {
+    LogLevel level = response_info.status_code >= 500 ? LogLevel::ERROR :
+                     response_info.status_code >= 400 ? LogLevel::WARN : LogLevel::INFO;
+    if (!shouldLogLevel(level)) {
+        return;
+    }
+
+    auto& logger = utils::Logger::getInstance();
+    utils::LogLevel logger_level = level == LogLevel::ERROR ? utils::LogLevel::ERROR :
+                                   level == LogLevel::WARN ? utils::LogLevel::WARN : utils::LogLevel::INFO;
+
+    if (log_format_ != LogFormats::JSON) {
+        if (!logger.isLevelEnabled(logger_level)) return;
+        std::string line = formatLogMessage(log_format_, request_info, response_info, request_id);
+        if (level == LogLevel::ERROR) LOG_ERROR(line);
+        else if (level == LogLevel::WARN) LOG_WARN(line);
+        else LOG_INFO(line);
+        return;
+    }
+
+    logger.record(logger_level, kResponseFormat,
+                  request_id,
+                  request_info.method,
+                  request_info.path,
+                  response_info.status_code,
+                  response_info.duration_ms,
+                  response_info.content_length,
+                  request_info.user_id);
+}
+
+void LoggingMiddleware::logSlowRequest(const RequestInfo& request_info, const ResponseInfo& response_info,
+                                       const std::string& request_id) {
+    if (!shouldLogLevel(LogLevel::WARN)) {
+        return;
+    }
+
+    LOG_RECORD(WARN, kSlowRequestFormat,
+               request_id,
+               request_info.method,
+               request_info.path,
+               response_info.status_code,
+               response_info.duration_ms,
+               slow_request_threshold_ms_);
+}
+
+void LoggingMiddleware::logPerformanceMetrics(const RequestInfo& request_info, const ResponseInfo& response_info,
+                                              EndpointId endpoint, const utils::AllocationCounters& allocations) {
+    if (!shouldLogLevel(LogLevel::DEBUG)) {
+        return;
+    }
+
+    LOG_RECORD(DEBUG, kPerformanceFormat,
+               utils::RouteNormalizer::getInstance().name(endpoint),
+               response_info.duration_ms,
+               request_info.content_length,
+               response_info.content_length,
+               allocations.allocations,
+               allocations.bytes);
+}
+
+// Sanitization
+
+std::pmr::string LoggingMiddleware::sanitizeHeaders(const crow::ci_map& headers) const {
+    std::pmr::string result = utils::RequestArena::string();
+    for (const auto& [name, value] : headers) {
+        if (!result.empty()) {
+            result += "; ";
+        }
+        result += name;
+        result += ": ";
+        bool sensitive = !log_sensitive_data_ && isSensitiveName(sensitive_headers_, name);
+        if (sensitive && !value.empty()) {
+            result += kMask;
+        } else {
+            result += value;
+        }
+    }
+    return result;
+}
+
+std::pmr::string LoggingMiddleware::sanitizeQueryString(std::string_view query_string) const {
+    std::pmr::string result = utils::RequestArena::string();
+    if (log_sensitive_data_) {
+        result = query_string;
+        return result;
+    }
+
+    size_t start = 0;
+    while (start < query_string.size()) {
+        size_t end = query_string.find('&', start);
+        if (end == std::string_view::npos) {
+            end = query_string.size();
+        }
+
+        std::string_view pair = query_string.substr(start, end - start);
+        size_t equals = pair.find('=');
+        if (!result.empty()) {
+            result += '&';
+        }
+        if (equals != std::string_view::npos && equals + 1 < pair.size() &&
+            isSensitiveName(sensitive_params_, pair.substr(0, equals))) {
+            result += pair.substr(0, equals + 1);
+            result += kMask;
+        } else {
+            result += pair;
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+std::string LoggingMiddleware::sanitizeBody(const std::string& body, const std::string& content_type) const {
+    constexpr size_t kMaxLoggedBody = 1024;
+    if (body.empty()) {
+        return body;
+    }
+
+    std::string result;
+    if (content_type.find("application/json") != std::string::npos) {
+        auto parsed = nlohmann::json::parse(body, nullptr, false);
+        if (parsed.is_discarded()) {
+            return "[invalid JSON, " + std::to_string(body.size()) + " bytes]";
+        }
+        if (!log_sensitive_data_) {
+            std::function<void(nlohmann::json&)> mask = [&](nlohmann::json& node) {
+                if (node.is_object()) {
+                    for (auto& [key, value] : node.items()) {
+                        if (sensitive_params_.count(toLower(key)) > 0 && value.is_primitive()) {
+                            value = maskSensitiveData(value.dump());
+                        } else {
+                            mask(value);
+                        }
+                    }
+                } else if (node.is_array()) {
+                    for (auto& element : node) mask(element);
+                }
+            };
+            mask(parsed);
+        }
+        result = parsed.dump();
+    } else if (content_type.find("application/x-www-form-urlencoded") != std::string::npos) {
+        result = std::string_view(sanitizeQueryString(body));
+    } else {
+        return "[" + std::to_string(body.size()) + " bytes " + content_type + "]";
+    }
+
+    if (result.size() > kMaxLoggedBody) {
+        result.resize(kMaxLoggedBody);
+        result += "...(truncated)";
+    }
+    return result;
+}
+
+std::string LoggingMiddleware::maskSensitiveData(const std::string& data) const {
+    return data.empty() ? data : std::string(kMask);
+}
+
+// Formatting
+
+std::string LoggingMiddleware::formatLogMessage(const std::string& template_str, const RequestInfo& req_info,
+                                                const ResponseInfo& res_info, const std::string& request_id) const {
+    std::string result;
+    result.reserve(template_str.size() + 64);
+
+    size_t pos = 0;
+    while (pos < template_str.size()) {
+        size_t open = template_str.find('%', pos);
+        size_t close = open == std::string::npos ? std::string::npos : template_str.find('%', open + 1);
+        if (close == std::string::npos) {
+            result.append(template_str, pos, std::string::npos);
+            break;
+        }
+
+        result.append(template_str, pos, open - pos);
+        std::string token = template_str.substr(open + 1, close - open - 1);
+        if (token == "timestamp") result += formatTimestamp(std::chrono::system_clock::now());
+        else if (token == "level") result += res_info.status_code >= 500 ? "ERROR" : res_info.status_code >= 400 ? "WARN" : "INFO";
+        else if (token == "method") result += req_info.method;
+        else if (token == "path") result += req_info.path;
+        else if (token == "status") result += std::to_string(res_info.status_code);
+        else if (token == "duration") result += formatDuration(res_info.duration_ms);
+        else if (token == "user_id") result += req_info.user_id.empty() ? "-" : req_info.user_id;
+        else if (token == "client_ip") result += req_info.client_ip;
+        else if (token == "protocol") result += "HTTP/1.1";
+        else if (token == "content_length") result += std::to_string(res_info.content_length);
+        else if (token == "user_agent") result += req_info.user_agent;
+        else if (token == "request_id") result += request_id;
+        else result.append(template_str, open, close - open + 1);  // Unknown tokens pass through
+        pos = close + 1;
+    }
+    return result;
+}
+
+std::string LoggingMiddleware::formatTimestamp(const std::chrono::system_clock::time_point& time_point) const {
+    std::time_t time = std::chrono::system_clock::to_time_t(time_point);
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+
+    char buffer[64];
+    size_t length = std::strftime(buffer, sizeof(buffer), timestamp_format_.c_str(), &utc);
+    return std::string(buffer, length);
+}
+
+std::string LoggingMiddleware::formatDuration(double duration_ms) const {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.2f", duration_ms);
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+// JSON helpers
+
+nlohmann::json LoggingMiddleware::requestToJson(const RequestInfo& request_info, const std::string& request_id) const {
+    nlohmann::json json;
+    json["request_id"] = request_id;
+    json["method"] = request_info.method;
+    json["path"] = request_info.path;
+    json["query"] = std::string(std::string_view(sanitizeQueryString(request_info.query_string)));
+    json["client_ip"] = request_info.client_ip;
+    json["user_id"] = request_info.user_id;
+    json["user_agent"] = request_info.user_agent;
+    json["content_length"] = request_info.content_length;
+    json["content_type"] = request_info.content_type;
+    return json;
+}
+
+nlohmann::json LoggingMiddleware::responseToJson(const ResponseInfo& response_info) const {
+    nlohmann::json json;
+    json["status_code"] = response_info.status_code;
+    json["content_length"] = response_info.content_length;
+    json["content_type"] = response_info.content_type;
+    json["duration_ms"] = response_info.duration_ms;
+    return json;
+}
+
+nlohmann::json LoggingMiddleware::createLogEntry(const RequestInfo& request_info, const ResponseInfo& response_info,
+                                                 const std::string& request_id) const {
+    nlohmann::json entry;
+    entry["timestamp"] = formatTimestamp(std::chrono::system_clock::now());
+    entry["request"] = requestToJson(request_info, request_id);
+    entry["response"] = responseToJson(response_info);
+    return entry;
+}
+
+// Statistics updates
+
+void LoggingMiddleware::updateStats(const ResponseInfo& response_info, EndpointId endpoint,
+                                    const utils::AllocationCounters& allocations) const {
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    
+
     stats_.total_requests++;
-    stats_.total_response_time_ms += ctx.response_time_ms;
-    
-    // Update method stats
-    stats_.requests_by_method[crow::method_name(req.method)]++;
-    
-    // Update status code stats
-    stats_.requests_by_status[res.code]++;
-    
-    // Update endpoint stats
-    std::string endpoint = extractEndpoint(req.url);
-    stats_.requests_by_endpoint[endpoint]++;
-    
-    // Track slow requests
-    if (ctx.response_time_ms > 1000) { // Requests taking more than 1 second
+    if (response_info.status_code >= 400) {
+        stats_.error_requests++;
+    }
+    if (response_info.duration_ms > slow_request_threshold_ms_) {
         stats_.slow_requests++;
     }
-    
-    // Track errors
-    if (res.code >= 400) {
-        stats_.error_requests++;
+
+    double duration = response_info.duration_ms;
+    stats_.average_response_time_ms += (duration - stats_.average_response_time_ms) / stats_.total_requests;
+    stats_.max_response_time_ms = std::max(stats_.max_response_time_ms, duration);
+    stats_.min_response_time_ms = stats_.total_requests == 1 ? duration
+                                                             : std::min(stats_.min_response_time_ms, duration);
+    stats_.status_code_counts[response_info.status_code]++;
+    stats_.last_request_time = std::chrono::system_clock::now();
+
+    updateEndpointStats(endpoint, duration, allocations);
+}
+
+// Errors and slow requests bypass the bucket without spending its tokens
+bool LoggingMiddleware::sampleRequest(EndpointId endpoint, bool must_keep) const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    double capacity = std::max(sampled_requests_per_second_, 1.0);
+    EndpointState& bucket = endpoint_state_[endpoint];
+    if (bucket.seen == 0) {
+        bucket.tokens = capacity;
+    } else {
+        double elapsed = std::chrono::duration<double>(now - bucket.last_refill).count();
+        bucket.tokens = std::min(capacity, bucket.tokens + elapsed * sampled_requests_per_second_);
+    }
+    bucket.last_refill = now;
+
+    bool keep = must_keep;
+    if (!keep && bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        keep = true;
+    }
+
+    bucket.seen++;
+    if (keep) {
+        bucket.kept++;
+        stats_.sampled_kept_requests++;
+    } else {
+        stats_.sampled_dropped_requests++;
     }
+    return keep;
 }
 
-std::string LoggingMiddleware::extractEndpoint(const std::string& url) {
-    // Remove query parameters
-    size_t query_pos = url.find('?');
-    std::string path = (query_pos != std::string::npos) ? url.substr(0, query_pos) : url;
-    
-    // Replace IDs with placeholders
-    std::regex uuid_regex("[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}");
-    path = std::regex_replace(path, uuid_regex, ":id");
-    
-    std::regex number_regex("/\\d+");
-    path = std::regex_replace(path, number_regex, "/:id");
-    
-    return path;
+// Caller holds stats_mutex_
+void LoggingMiddleware::updateEndpointStats(EndpointId endpoint, double duration_ms,
+                                            const utils::AllocationCounters& allocations) const {
+    EndpointState& state = endpoint_state_[endpoint];
+    state.requests++;
+    state.avg_time_ms += (duration_ms - state.avg_time_ms) / state.requests;
+    state.allocations += static_cast<long long>(allocations.allocations);
+    state.allocated_bytes += static_cast<long long>(allocations.bytes);
 }
 
-nlohmann::json LoggingMiddleware::getStats() const {
+// Health checks
+
+bool LoggingMiddleware::isResponseTimeHealthy() const {
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    
-    nlohmann::json stats_json;
-    stats_json["total_requests"] = stats_.total_requests;
-    stats_json["error_requests"] = stats_.error_requests;
-    stats_json["slow_requests"] = stats_.slow_requests;
-    
-    if (stats_.total_requests > 0) {
-        stats_json["average_response_time_ms"] = 
-            static_cast<double>(stats_.total_response_time_ms) / stats_.total_requests;
-    } else {
-        stats_json["average_response_time_ms"] = 0;
-    }
-    
-    stats_json["requests_by_method"] = stats_.requests_by_method;
-    stats_json["requests_by_status"] = stats_.requests_by_status;
-    
-    // Top 10 endpoints
-    std::vector<std::pair<std::string, int>> endpoint_pairs(
-        stats_.requests_by_endpoint.begin(),
-        stats_.requests_by_endpoint.end()
-    );
-    
-    std::sort(endpoint_pairs.begin(), endpoint_pairs.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    nlohmann::json top_endpoints = nlohmann::json::array();
-    for (size_t i = 0; i < std::min(size_t(10), endpoint_pairs.size()); ++i) {
-        nlohmann::json endpoint;
-        endpoint["path"] = endpoint_pairs[i].first;
-        endpoint["count"] = endpoint_pairs[i].second;
-        top_endpoints.push_back(endpoint);
-    }
-    stats_json["top_endpoints"] = top_endpoints;
-    
-    return stats_json;
+    return stats_.average_response_time_ms < slow_request_threshold_ms_;
 }
 
-void LoggingMiddleware::resetStats() {
+bool LoggingMiddleware::isErrorRateHealthy() const {
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_ = Stats{};
+    if (stats_.total_requests == 0) {
+        return true;
+    }
+    return static_cast<double>(stats_.error_requests) / stats_.total_requests < 0.1;
+}
+
+// Default configurations
+
+void LoggingMiddleware::initializeDefaults() {
+    log_level_ = LogLevel::INFO;
+    log_requests_ = true;
+    log_responses_ = true;
+    log_headers_ = false;
+    log_body_ = false;
+    log_sensitive_data_ = false;
+    log_slow_requests_ = true;
+    performance_threshold_ms_ = 500.0;
+    slow_request_threshold_ms_ = 1000.0;
+    sampling_enabled_ = true;
+    sampled_requests_per_second_ = 10.0;
+    log_format_ = LogFormats::JSON;
+    timestamp_format_ = "%Y-%m-%dT%H:%M:%SZ";
+    include_request_id_ = true;
+
+    setupSensitiveHeaders();
+    setupSensitiveParams();
+}
+
+void LoggingMiddleware::setupSensitiveHeaders() {
+    sensitive_headers_ = {
+        "authorization",
+        "cookie",
+        "set-cookie",
+        "x-api-key",
+        "x-auth-token",
+        "proxy-authorization"
+    };
+}
+
+void LoggingMiddleware::setupSensitiveParams() {
+    sensitive_params_ = {
+        "password",
+        "new_password",
+        "token",
+        "access_token",
+        "refresh_token",
+        "otp",
+        "api_key",
+        "secret",
+        "card_number",
+        "cvv"
+    };
+}
+
+// Utility functions
+
+std::string logLevelToString(LogLevel level) {
+    switch (level) {
+        case LogLevel::NONE: return "NONE";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::TRACE: return "TRACE";
+    }
+    return "INFO";
+}
+
+LogLevel stringToLogLevel(const std::string& level_str) {
+    if (level_str == "NONE") return LogLevel::NONE;
+    if (level_str == "ERROR") return LogLevel::ERROR;
+    if (level_str == "WARN") return LogLevel::WARN;
+    if (level_str == "DEBUG") return LogLevel::DEBUG;
+    if (level_str == "TRACE") return LogLevel::TRACE;
+    return LogLevel::INFO;
 }
 
 } // namespace healthcare::middleware
\ No newline at end of file
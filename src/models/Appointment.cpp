@@ -199,9 +199,9 @@ nlohmann::json Appointment::toJson() const {
     json["is_deleted"] = isDeleted();
     
     // Core appointment fields
-    json["user_id"] = user_id_;
-    json["doctor_id"] = doctor_id_;
-    json["clinic_id"] = clinic_id_;
+    json["user_id"] = getUserId();
+    json["doctor_id"] = getDoctorId();
+    json["clinic_id"] = getClinicId();
     json["appointment_date"] = std::chrono::system_clock::to_time_t(appointment_date_);
     json["start_time"] = std::chrono::system_clock::to_time_t(start_time_);
     json["end_time"] = std::chrono::system_clock::to_time_t(end_time_);
@@ -269,6 +269,77 @@ nlohmann::json Appointment::toJson() const {
     return json;
 }
 
+void Appointment::writeJson(utils::JsonWriter& writer) const {
+    // Keys in the sorted order nlohmann::json objects dump in
+    writer.beginObject();
+    writer.field("appointment_date", appointment_date_);
+    writer.field("booked_at", booked_at_);
+
+    if (status_ == AppointmentStatus::CANCELLED) {
+        writer.key("cancellation_info");
+        writer.beginObject();
+        writer.field("cancelled_at", cancellation_info_.cancelled_at);
+        writer.field("cancelled_by_user_id", cancellation_info_.cancelled_by_user_id);
+        writer.field("description", cancellation_info_.description);
+        writer.field("is_refund_processed", cancellation_info_.is_refund_processed);
+        writer.field("reason", cancellationReasonToString(cancellation_info_.reason));
+        writer.field("refund_amount", cancellation_info_.refund_amount);
+        writer.field("refund_id", cancellation_info_.refund_id);
+        writer.endObject();
+    }
+
+    writer.field("clinic_id", clinic_id_);
+    writer.field("confirmation_code", confirmation_code_);
+    writer.field("confirmed_at", confirmed_at_);
+    writer.field("consultation_fee", consultation_fee_);
+
+    writer.key("consultation_info");
+    writer.beginObject();
+    writer.field("call_ended_at", consultation_info_.call_ended_at);
+    writer.field("call_notes", consultation_info_.call_notes);
+    writer.field("call_started_at", consultation_info_.call_started_at);
+    writer.field("duration_minutes", consultation_info_.duration_minutes);
+    writer.field("meeting_id", consultation_info_.meeting_id);
+    writer.field("recording_url", consultation_info_.recording_url);
+    writer.field("room_password", consultation_info_.room_password);
+    writer.field("video_call_link", consultation_info_.video_call_link);
+    writer.endObject();
+
+    writer.field("created_at", getCreatedAt());
+    writer.field("doctor_id", doctor_id_);
+    writer.field("end_time", end_time_);
+    writer.field("follow_up_date", follow_up_date_);
+    writer.field("follow_up_notes", follow_up_notes_);
+    writer.field("id", getUuid());
+    writer.field("is_deleted", isDeleted());
+    writer.field("is_emergency", is_emergency_);
+    writer.field("notes", notes_);
+    writer.field("patient_age", patient_age_);
+    writer.field("patient_gender", patient_gender_);
+
+    writer.key("payment_info");
+    writer.beginObject();
+    writer.field("amount", payment_info_.amount);
+    writer.field("currency", payment_info_.currency);
+    writer.field("order_id", payment_info_.order_id);
+    writer.field("paid_at", payment_info_.paid_at);
+    writer.field("payment_id", payment_info_.payment_id);
+    writer.field("payment_method", payment_info_.payment_method);
+    writer.field("razorpay_signature", payment_info_.razorpay_signature);
+    writer.field("status", paymentStatusToString(payment_info_.status));
+    writer.field("transaction_id", payment_info_.transaction_id);
+    writer.endObject();
+
+    writer.field("prescription_id", prescription_id_);
+    writer.field("start_time", start_time_);
+    writer.field("status", appointmentStatusToString(status_));
+    writer.field("symptoms", symptoms_);
+    writer.field("type", appointmentTypeToString(type_));
+    writer.field("updated_at", getUpdatedAt());
+    writer.field("user_id", user_id_);
+    writer.endObject();
+}
+
 void Appointment::fromJson(const nlohmann::json& json) {
     // Base entity fields
     if (json.contains("id")) setId(json["id"].get<std::string>());
@@ -283,9 +354,9 @@ void Appointment::fromJson(const nlohmann::json& json) {
     if (json.contains("is_deleted")) setDeleted(json["is_deleted"].get<bool>());
     
     // Core appointment fields
-    if (json.contains("user_id")) user_id_ = json["user_id"].get<std::string>();
-    if (json.contains("doctor_id")) doctor_id_ = json["doctor_id"].get<std::string>();
-    if (json.contains("clinic_id")) clinic_id_ = json["clinic_id"].get<std::string>();
+    if (json.contains("user_id")) setUserId(json["user_id"].get<std::string>());
+    if (json.contains("doctor_id")) setDoctorId(json["doctor_id"].get<std::string>());
+    if (json.contains("clinic_id")) setClinicId(json["clinic_id"].get<std::string>());
     if (json.contains("appointment_date")) {
         appointment_date_ = std::chrono::system_clock::from_time_t(json["appointment_date"].get<std::time_t>());
     }
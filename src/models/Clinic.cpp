@@ -1,18 +1,39 @@
 #include "../../include/models/Clinic.h"
+#include "../../include/utils/GeoIndex.h"
 #include <algorithm>
 #include <cmath>
 #include <ctime>
-#include <iomanip>
 #include <sstream>
 
 namespace healthcare::models {
 
+void WorkingHours::compileMinutes() {
+    day_index = utils::civil::dayIndexFromName(day_of_week);
+    open_range = {utils::civil::parseHHMM(start_time), utils::civil::parseHHMM(end_time)};
+
+    if (!break_start.empty() && !break_end.empty()) {
+        break_range = {utils::civil::parseHHMM(break_start), utils::civil::parseHHMM(break_end)};
+    } else {
+        break_range = {};
+    }
+}
+
+bool WorkingHours::isOpenAtMinute(int minute_of_day) const {
+    if (is_closed || !open_range.isValid()) {
+        return false;
+    }
+    return open_range.contains(minute_of_day) &&
+           !(break_range.isValid() && break_range.contains(minute_of_day));
+}
+
 Clinic::Clinic() 
     : BaseEntity(),
       status_(ClinicStatus::PENDING_VERIFICATION),
+      timezone_(utils::civil::kDefaultTimeZone),
       rating_(0.0),
       total_reviews_(0),
       has_emergency_services_(false) {
+    compileSchedule();
 }
 
 bool Clinic::isOpenNow() const {
@@ -21,30 +42,7 @@ bool Clinic::isOpenNow() const {
 }
 
 bool Clinic::isOpenAt(const std::chrono::system_clock::time_point& time) const {
-    std::time_t time_t = std::chrono::system_clock::to_time_t(time);
-    std::tm* tm = std::localtime(&time_t);
-    
-    std::string day_of_week = getCurrentDayOfWeek();
-    std::ostringstream current_time_stream;
-    current_time_stream << std::setfill('0') << std::setw(2) << tm->tm_hour 
-                       << ":" << std::setw(2) << tm->tm_min;
-    std::string current_time = current_time_stream.str();
-    
-    for (const auto& hours : working_hours_) {
-        if (hours.day_of_week == day_of_week && !hours.is_closed) {
-            if (isTimeInRange(current_time, hours.start_time, hours.end_time)) {
-                // Check if we're in break time
-                if (!hours.break_start.empty() && !hours.break_end.empty()) {
-                    if (isTimeInRange(current_time, hours.break_start, hours.break_end)) {
-                        return false;
-                    }
-                }
-                return true;
-            }
-        }
-    }
-    
-    return false;
+    return schedule_.isOpenAt(time);
 }
 
 std::string Clinic::getFullAddress() const {
@@ -64,21 +62,7 @@ std::string Clinic::getFullAddress() const {
 }
 
 double Clinic::getDistanceFrom(double latitude, double longitude) const {
-    // Haversine formula for calculating distance between two points on Earth
-    const double R = 6371.0; // Earth's radius in kilometers
-    
-    double lat1_rad = address_.latitude * M_PI / 180.0;
-    double lat2_rad = latitude * M_PI / 180.0;
-    double delta_lat = (latitude - address_.latitude) * M_PI / 180.0;
-    double delta_lon = (longitude - address_.longitude) * M_PI / 180.0;
-    
-    double a = sin(delta_lat / 2) * sin(delta_lat / 2) +
-               cos(lat1_rad) * cos(lat2_rad) *
-               sin(delta_lon / 2) * sin(delta_lon / 2);
-    
-    double c = 2 * atan2(sqrt(a), sqrt(1 - a));
-    
-    return R * c; // Distance in kilometers
+    return utils::geo::haversineKm(address_.latitude, address_.longitude, latitude, longitude);
 }
 
 void Clinic::addDoctor(const std::string& doctor_id) {
@@ -131,6 +115,24 @@ void Clinic::removeFacility(const std::string& facility_name) {
     }
 }
 
+void Clinic::setTimezone(const std::string& timezone) {
+    timezone_ = timezone;
+    compileSchedule();
+}
+
+void Clinic::setWorkingHours(const std::vector<WorkingHours>& working_hours) {
+    working_hours_ = working_hours;
+    for (auto& hours : working_hours_) {
+        hours.compileMinutes();
+    }
+    compileSchedule();
+}
+
+void Clinic::compileSchedule() {
+    const auto& zone = utils::civil::TimeZoneRegistry::getInstance().get(timezone_);
+    schedule_ = ClinicSchedule::compile(working_hours_, zone);
+}
+
 void Clinic::updateWorkingHours(const std::string& day, const std::string& start, const std::string& end) {
     auto it = std::find_if(working_hours_.begin(), working_hours_.end(),
         [&day](const WorkingHours& wh) { return wh.day_of_week == day; });
@@ -139,14 +141,17 @@ void Clinic::updateWorkingHours(const std::string& day, const std::string& start
         it->start_time = start;
         it->end_time = end;
         it->is_closed = false;
+        it->compileMinutes();
     } else {
         WorkingHours new_hours;
         new_hours.day_of_week = day;
         new_hours.start_time = start;
         new_hours.end_time = end;
         new_hours.is_closed = false;
+        new_hours.compileMinutes();
         working_hours_.push_back(new_hours);
     }
+    compileSchedule();
     updateTimestamp();
 }
 
@@ -216,6 +221,7 @@ nlohmann::json Clinic::toJson() const {
     json["address"] = address_json;
     
     // Working hours
+    json["timezone"] = timezone_;
     nlohmann::json working_hours_json = nlohmann::json::array();
     for (const auto& hours : working_hours_) {
         nlohmann::json hours_json;
@@ -253,6 +259,78 @@ nlohmann::json Clinic::toJson() const {
     return json;
 }
 
+void Clinic::writeJson(utils::JsonWriter& writer) const {
+    // Keys in the sorted order nlohmann::json objects dump in
+    writer.beginObject();
+
+    writer.key("address");
+    writer.beginObject();
+    writer.field("city", address_.city);
+    writer.field("country", address_.country);
+    writer.field("landmark", address_.landmark);
+    writer.field("latitude", address_.latitude);
+    writer.field("longitude", address_.longitude);
+    writer.field("pincode", address_.pincode);
+    writer.field("state", address_.state);
+    writer.field("street_address", address_.street_address);
+    writer.endObject();
+
+    writer.key("contact_info");
+    writer.beginObject();
+    writer.field("email", contact_info_.email);
+    writer.field("phone_primary", contact_info_.phone_primary);
+    writer.field("phone_secondary", contact_info_.phone_secondary);
+    writer.field("website", contact_info_.website);
+    writer.endObject();
+
+    writer.field("created_at", getCreatedAt());
+    writer.field("description", description_);
+    writer.field("doctor_ids", doctor_ids_);
+    writer.field("emergency_contact", emergency_contact_);
+
+    writer.key("facilities");
+    writer.beginArray();
+    for (const auto& facility : facilities_) {
+        writer.beginObject();
+        writer.field("description", facility.description);
+        writer.field("is_available", facility.is_available);
+        writer.field("name", facility.name);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.field("has_emergency_services", has_emergency_services_);
+    writer.field("id", getUuid());
+    writer.field("image_urls", image_urls_);
+    writer.field("is_deleted", isDeleted());
+    writer.field("logo_url", logo_url_);
+    writer.field("name", name_);
+    writer.field("owner_id", owner_id_);
+    writer.field("rating", rating_);
+    writer.field("registration_number", registration_number_);
+    writer.field("services", services_);
+    writer.field("status", clinicStatusToString(status_));
+    writer.field("timezone", timezone_);
+    writer.field("total_reviews", total_reviews_);
+    writer.field("updated_at", getUpdatedAt());
+
+    writer.key("working_hours");
+    writer.beginArray();
+    for (const auto& hours : working_hours_) {
+        writer.beginObject();
+        writer.field("break_end", hours.break_end);
+        writer.field("break_start", hours.break_start);
+        writer.field("day_of_week", hours.day_of_week);
+        writer.field("end_time", hours.end_time);
+        writer.field("is_closed", hours.is_closed);
+        writer.field("start_time", hours.start_time);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+}
+
 void Clinic::fromJson(const nlohmann::json& json) {
     // Base entity fields
     if (json.contains("id")) setId(json["id"].get<std::string>());
@@ -295,6 +373,7 @@ void Clinic::fromJson(const nlohmann::json& json) {
     }
     
     // Working hours
+    if (json.contains("timezone")) timezone_ = json["timezone"].get<std::string>();
     if (json.contains("working_hours")) {
         working_hours_.clear();
         for (const auto& hours_json : json["working_hours"]) {
@@ -305,9 +384,11 @@ void Clinic::fromJson(const nlohmann::json& json) {
             hours.is_closed = hours_json.value("is_closed", false);
             hours.break_start = hours_json.value("break_start", "");
             hours.break_end = hours_json.value("break_end", "");
+            hours.compileMinutes();
             working_hours_.push_back(hours);
         }
     }
+    compileSchedule();
     
     // Facilities
     if (json.contains("facilities")) {
@@ -351,12 +432,9 @@ ClinicStatus stringToClinicStatus(const std::string& status_str) {
 }
 
 std::string getCurrentDayOfWeek() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm* tm = std::localtime(&time_t);
-    
-    const char* days[] = {"SUNDAY", "MONDAY", "TUESDAY", "WEDNESDAY", "THURSDAY", "FRIDAY", "SATURDAY"};
-    return days[tm->tm_wday];
+    const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+    auto local = utils::civil::toLocal(std::chrono::system_clock::now(), zone);
+    return utils::civil::dayName(local.day_of_week);
 }
 
 bool isTimeInRange(const std::string& current_time, const std::string& start_time, const std::string& end_time) {
@@ -0,0 +1,255 @@
+#include "../../include/models/ClinicSchedule.h"
+#include "../../include/models/Clinic.h"
+#include <algorithm>
+#include <mutex>
+
+namespace healthcare::models {
+
+namespace {
+
+// Resolves local day/minute for a zone, reusing the previous result while the zone is unchanged
+class LocalTimeCache {
+public:
+    explicit LocalTimeCache(const std::chrono::system_clock::time_point& time)
+        : time_(time), utc_seconds_(utils::civil::toUnixSeconds(time)) {}
+
+    const utils::civil::LocalTime& resolve(const utils::civil::TimeZone* zone) {
+        if (zone != zone_ || !valid_) {
+            if (zone && zone->isFixedOffset()) {
+                std::int64_t local_seconds = utc_seconds_ +
+                    static_cast<std::int64_t>(zone->getFixedOffsetMinutes()) * utils::civil::kSecondsPerMinute;
+                local_.local_days = utils::civil::floorDiv(local_seconds, utils::civil::kSecondsPerDay);
+                local_.minute_of_day = static_cast<int>(
+                    (local_seconds - local_.local_days * utils::civil::kSecondsPerDay) / utils::civil::kSecondsPerMinute);
+                local_.day_of_week = utils::civil::weekdayFromDays(local_.local_days);
+                local_.offset_minutes = zone->getFixedOffsetMinutes();
+            } else {
+                const auto& resolved = zone ? *zone : utils::civil::TimeZoneRegistry::getInstance().getDefault();
+                local_ = utils::civil::toLocal(time_, resolved);
+            }
+            zone_ = zone;
+            valid_ = true;
+        }
+        return local_;
+    }
+
+private:
+    std::chrono::system_clock::time_point time_;
+    std::int64_t utc_seconds_;
+    const utils::civil::TimeZone* zone_ = nullptr;
+    utils::civil::LocalTime local_{};
+    bool valid_ = false;
+};
+
+} // namespace
+
+ClinicSchedule ClinicSchedule::compile(const std::vector<WorkingHours>& working_hours,
+                                       const utils::civil::TimeZone& zone) {
+    ClinicSchedule schedule;
+    schedule.zone = &zone;
+
+    std::array<std::vector<utils::civil::MinuteRange>, utils::civil::kDaysPerWeek> ranges;
+
+    for (const auto& hours : working_hours) {
+        if (hours.is_closed || hours.day_index < 0 || !hours.open_range.isValid()) {
+            continue;
+        }
+
+        auto& day_ranges = ranges[hours.day_index];
+        const auto& open = hours.open_range;
+        const auto& lunch = hours.break_range;
+
+        // Split the open range around the break, if the break lies inside it
+        if (lunch.isValid() && lunch.start < open.end && lunch.end > open.start) {
+            if (lunch.start > open.start) day_ranges.push_back({open.start, lunch.start});
+            if (lunch.end < open.end) day_ranges.push_back({lunch.end, open.end});
+        } else {
+            day_ranges.push_back(open);
+        }
+    }
+
+    for (int day = 0; day < utils::civil::kDaysPerWeek; ++day) {
+        auto& day_ranges = ranges[day];
+        if (day_ranges.empty()) continue;
+
+        // Sort and merge overlapping or touching ranges
+        std::sort(day_ranges.begin(), day_ranges.end(),
+            [](const utils::civil::MinuteRange& a, const utils::civil::MinuteRange& b) { return a.start < b.start; });
+
+        std::vector<utils::civil::MinuteRange> merged;
+        for (const auto& range : day_ranges) {
+            if (!merged.empty() && range.start <= merged.back().end) {
+                merged.back().end = std::max(merged.back().end, range.end);
+            } else {
+                merged.push_back(range);
+            }
+        }
+
+        // Surplus ranges are dropped, reporting the clinic closed rather than open across a gap
+        if (merged.size() > static_cast<size_t>(kMaxIntervalsPerDay)) {
+            merged.resize(kMaxIntervalsPerDay);
+            schedule.truncated_days |= static_cast<std::uint8_t>(1u << day);
+        }
+
+        for (size_t i = 0; i < merged.size(); ++i) {
+            schedule.days[day][i] = {static_cast<std::uint16_t>(merged[i].start),
+                                     static_cast<std::uint16_t>(merged[i].end)};
+        }
+        schedule.open_days |= static_cast<std::uint8_t>(1u << day);
+    }
+
+    return schedule;
+}
+
+bool ClinicSchedule::isOpenThroughout(int day_of_week, int start_minute, int end_minute) const {
+    if (!isOpenOn(day_of_week) || end_minute <= start_minute) {
+        return false;
+    }
+
+    for (const auto& interval : days[day_of_week]) {
+        if (interval.start <= start_minute && end_minute <= interval.end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ClinicSchedule::isOpenAt(const std::chrono::system_clock::time_point& time) const {
+    LocalTimeCache cache(time);
+    const auto& local = cache.resolve(zone);
+    return isOpenAt(local.day_of_week, local.minute_of_day);
+}
+
+std::vector<utils::civil::MinuteRange> ClinicSchedule::getOpenRanges(int day_of_week) const {
+    std::vector<utils::civil::MinuteRange> ranges;
+    if (!isOpenOn(day_of_week)) {
+        return ranges;
+    }
+
+    for (const auto& interval : days[day_of_week]) {
+        if (interval.end > interval.start) {
+            ranges.push_back({interval.start, interval.end});
+        }
+    }
+    return ranges;
+}
+
+void evaluateOpenAt(const ClinicSchedule* schedules, size_t count,
+                    const std::chrono::system_clock::time_point& time, std::uint8_t* out) {
+    LocalTimeCache cache(time);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& local = cache.resolve(schedules[i].zone);
+        out[i] = schedules[i].isOpenAt(local.day_of_week, local.minute_of_day) ? 1 : 0;
+    }
+}
+
+// ClinicScheduleTable
+
+void ClinicScheduleTable::upsert(const std::string& clinic_id, const ClinicSchedule& schedule) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = index_.find(clinic_id);
+    if (it != index_.end()) {
+        schedules_[it->second] = schedule;
+        return;
+    }
+
+    index_.emplace(clinic_id, schedules_.size());
+    schedules_.push_back(schedule);
+    clinic_ids_.push_back(clinic_id);
+}
+
+bool ClinicScheduleTable::remove(const std::string& clinic_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = index_.find(clinic_id);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    // Swap with the last entry to keep storage contiguous
+    size_t slot = it->second;
+    size_t last = schedules_.size() - 1;
+    if (slot != last) {
+        schedules_[slot] = schedules_[last];
+        clinic_ids_[slot] = std::move(clinic_ids_[last]);
+        index_[clinic_ids_[slot]] = slot;
+    }
+
+    schedules_.pop_back();
+    clinic_ids_.pop_back();
+    index_.erase(clinic_id);
+    return true;
+}
+
+void ClinicScheduleTable::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    schedules_.clear();
+    clinic_ids_.clear();
+    index_.clear();
+}
+
+std::optional<ClinicSchedule> ClinicScheduleTable::find(const std::string& clinic_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = index_.find(clinic_id);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    return schedules_[it->second];
+}
+
+size_t ClinicScheduleTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return schedules_.size();
+}
+
+std::vector<std::uint8_t> ClinicScheduleTable::evaluateOpenAt(const std::chrono::system_clock::time_point& time,
+                                                              std::vector<std::string>* clinic_ids) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::uint8_t> open_flags(schedules_.size());
+    models::evaluateOpenAt(schedules_.data(), schedules_.size(), time, open_flags.data());
+
+    if (clinic_ids) {
+        *clinic_ids = clinic_ids_;
+    }
+    return open_flags;
+}
+
+std::vector<std::uint8_t> ClinicScheduleTable::evaluateOpenAt(const std::vector<std::string>& clinic_ids,
+                                                              const std::chrono::system_clock::time_point& time) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::uint8_t> open_flags(clinic_ids.size(), 0);
+    LocalTimeCache cache(time);
+
+    for (size_t i = 0; i < clinic_ids.size(); ++i) {
+        auto it = index_.find(clinic_ids[i]);
+        if (it == index_.end()) continue;
+
+        const auto& schedule = schedules_[it->second];
+        const auto& local = cache.resolve(schedule.zone);
+        open_flags[i] = schedule.isOpenAt(local.day_of_week, local.minute_of_day) ? 1 : 0;
+    }
+
+    return open_flags;
+}
+
+std::vector<std::string> ClinicScheduleTable::getOpenClinicIds(const std::chrono::system_clock::time_point& time) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::uint8_t> open_flags(schedules_.size());
+    models::evaluateOpenAt(schedules_.data(), schedules_.size(), time, open_flags.data());
+
+    std::vector<std::string> open_ids;
+    for (size_t i = 0; i < open_flags.size(); ++i) {
+        if (open_flags[i]) {
+            open_ids.push_back(clinic_ids_[i]);
+        }
+    }
+    return open_ids;
+}
+
+} // namespace healthcare::models
\ No newline at end of file
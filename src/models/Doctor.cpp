@@ -1,7 +1,5 @@
 #include "../../include/models/Doctor.h"
 #include <algorithm>
-#include <ctime>
-#include <sstream>
 
 namespace healthcare::models {
 
@@ -46,21 +44,47 @@ void Doctor::removeSpecialization(const std::string& specialization_id) {
     }
 }
 
+std::vector<std::string> Doctor::getClinicIds() const {
+    std::vector<std::string> clinic_ids;
+    clinic_ids.reserve(clinic_ids_.size());
+    for (const auto& clinic_id : clinic_ids_) {
+        clinic_ids.push_back(clinic_id.toString());
+    }
+    return clinic_ids;
+}
+
+void Doctor::setClinicIds(const std::vector<std::string>& clinic_ids) {
+    clinic_ids_.clear();
+    clinic_ids_.reserve(clinic_ids.size());
+    for (const auto& clinic_id : clinic_ids) {
+        clinic_ids_.push_back(utils::Uuid::fromString(clinic_id));
+    }
+}
+
 void Doctor::addClinic(const std::string& clinic_id) {
-    if (std::find(clinic_ids_.begin(), clinic_ids_.end(), clinic_id) == clinic_ids_.end()) {
-        clinic_ids_.push_back(clinic_id);
+    utils::Uuid id = utils::Uuid::fromString(clinic_id);
+    if (std::find(clinic_ids_.begin(), clinic_ids_.end(), id) == clinic_ids_.end()) {
+        clinic_ids_.push_back(id);
         updateTimestamp();
     }
 }
 
 void Doctor::removeClinic(const std::string& clinic_id) {
-    auto it = std::remove(clinic_ids_.begin(), clinic_ids_.end(), clinic_id);
+    auto id = utils::Uuid::parse(clinic_id);
+    if (!id) return;
+
+    auto it = std::remove(clinic_ids_.begin(), clinic_ids_.end(), *id);
     if (it != clinic_ids_.end()) {
         clinic_ids_.erase(it, clinic_ids_.end());
         updateTimestamp();
     }
 }
 
+void Doctor::setAvailabilityPattern(const std::string& pattern) {
+    availability_pattern_ = pattern;
+    weekly_availability_ = parseWeeklyAvailability(pattern);
+}
+
 void Doctor::addDocument(const DoctorDocument& document) {
     documents_.push_back(document);
     updateTimestamp();
@@ -81,43 +105,33 @@ std::vector<TimeSlot> Doctor::getAvailableSlots(
     
     std::vector<TimeSlot> available_slots;
     
-    // Parse availability pattern JSON and generate slots
-    if (!availability_pattern_.empty()) {
-        try {
-            nlohmann::json pattern = nlohmann::json::parse(availability_pattern_);
-            
-            // Iterate through each day between start and end date
-            auto current = start_date;
-            while (current <= end_date) {
-                // Get day of week
-                std::time_t time_t = std::chrono::system_clock::to_time_t(current);
-                std::tm* tm = std::localtime(&time_t);
-                int day_of_week = tm->tm_wday;
-                
-                // Check if doctor works on this day
-                std::string day_key = std::to_string(day_of_week);
-                if (pattern.contains(day_key)) {
-                    auto day_schedule = pattern[day_key];
-                    
-                    // Generate slots for this day
-                    for (const auto& slot : day_schedule) {
-                        TimeSlot ts;
-                        ts.start_time = current; // Would need proper time parsing
-                        ts.end_time = current + std::chrono::minutes(consultation_duration_minutes_);
-                        ts.is_available = true;
-                        ts.consultation_type = type;
-                        
-                        if (supportsConsultationType(type)) {
-                            available_slots.push_back(ts);
-                        }
-                    }
-                }
+    if (availability_pattern_.empty() || !supportsConsultationType(type) || end_date < start_date) {
+        return available_slots;
+    }
+    
+    const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+    const int duration = std::max(consultation_duration_minutes_, 1);
+    
+    // Walk local calendar days and cut each working range into consultation-sized slots
+    std::int64_t first_day = utils::civil::toLocal(start_date, zone).local_days;
+    std::int64_t last_day = utils::civil::toLocal(end_date, zone).local_days;
+    
+    for (std::int64_t day = first_day; day <= last_day; ++day) {
+        const auto& ranges = weekly_availability_[utils::civil::weekdayFromDays(day)];
+        
+        for (const auto& range : ranges) {
+            for (int minute = range.start; minute + duration <= range.end; minute += duration) {
+                auto slot_start = utils::civil::fromLocal(day, minute, zone);
+                if (slot_start < start_date) continue;
+                if (slot_start > end_date) break;
                 
-                // Move to next day
-                current += std::chrono::hours(24);
+                TimeSlot ts;
+                ts.start_time = slot_start;
+                ts.end_time = slot_start + std::chrono::minutes(duration);
+                ts.is_available = true;
+                ts.consultation_type = type;
+                available_slots.push_back(ts);
             }
-        } catch (const std::exception& e) {
-            // Log error parsing availability pattern
         }
     }
     
@@ -125,13 +139,49 @@ std::vector<TimeSlot> Doctor::getAvailableSlots(
 }
 
 bool Doctor::isAvailableAt(const std::chrono::system_clock::time_point& time, ConsultationType type) const {
-    if (!supportsConsultationType(type)) {
+    if (!supportsConsultationType(type) || availability_pattern_.empty()) {
         return false;
     }
     
-    // Check if the time falls within available slots
-    auto slots = getAvailableSlots(time, time, type);
-    return !slots.empty();
+    // Check if the time falls within a working range for that weekday
+    const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+    auto local = utils::civil::toLocal(time, zone);
+    
+    const auto& ranges = weekly_availability_[local.day_of_week];
+    return std::any_of(ranges.begin(), ranges.end(),
+        [&local](const utils::civil::MinuteRange& range) { return range.contains(local.minute_of_day); });
+}
+
+bool Doctor::isWorkingThroughout(const std::chrono::system_clock::time_point& start_time,
+                                 const std::chrono::system_clock::time_point& end_time) const {
+    if (end_time <= start_time) {
+        return false;
+    }
+    
+    const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+    auto local = utils::civil::toLocal(start_time, zone);
+    auto remaining = std::chrono::duration_cast<std::chrono::minutes>(end_time - start_time).count();
+    int day = local.day_of_week;
+    int minute = local.minute_of_day;
+    
+    // Hop from range to range; adjacent ranges and the midnight split are crossed without a gap
+    while (remaining > 0) {
+        const auto& ranges = weekly_availability_[day];
+        auto range = std::find_if(ranges.begin(), ranges.end(),
+            [minute](const utils::civil::MinuteRange& candidate) { return candidate.contains(minute); });
+        if (range == ranges.end()) {
+            return false;
+        }
+        
+        int covered = static_cast<int>(std::min<std::int64_t>(range->end - minute, remaining));
+        remaining -= covered;
+        minute += covered;
+        if (minute == utils::civil::kMinutesPerDay) {
+            minute = 0;
+            day = (day + 1) % utils::civil::kDaysPerWeek;
+        }
+    }
+    return true;
 }
 
 nlohmann::json Doctor::toJson() const {
@@ -144,7 +194,7 @@ nlohmann::json Doctor::toJson() const {
     json["is_deleted"] = isDeleted();
     
     // Doctor fields
-    json["user_id"] = user_id_;
+    json["user_id"] = getUserId();
     json["medical_license_number"] = medical_license_number_;
     json["qualification"] = qualification_;
     json["years_of_experience"] = years_of_experience_;
@@ -178,7 +228,7 @@ nlohmann::json Doctor::toJson() const {
     }
     json["specializations"] = specializations_json;
     
-    json["clinic_ids"] = clinic_ids_;
+    json["clinic_ids"] = getClinicIds();
     
     // Documents
     nlohmann::json documents_json = nlohmann::json::array();
@@ -197,6 +247,73 @@ nlohmann::json Doctor::toJson() const {
     return json;
 }
 
+void Doctor::writeJson(utils::JsonWriter& writer) const {
+    // Keys in the sorted order nlohmann::json objects dump in
+    writer.beginObject();
+    writer.field("availability_pattern", availability_pattern_);
+    writer.field("bio", bio_);
+
+    writer.key("clinic_ids");
+    writer.beginArray();
+    for (const auto& clinic_id : clinic_ids_) {
+        writer.value(clinic_id);
+    }
+    writer.endArray();
+
+    writer.field("consultation_duration_minutes", consultation_duration_minutes_);
+    writer.field("consultation_fee", consultation_fee_);
+
+    writer.key("consultation_types");
+    writer.beginArray();
+    for (const auto& type : consultation_types_) {
+        writer.value(consultationTypeToString(type));
+    }
+    writer.endArray();
+
+    writer.field("created_at", getCreatedAt());
+
+    writer.key("documents");
+    writer.beginArray();
+    for (const auto& doc : documents_) {
+        writer.beginObject();
+        writer.field("id", doc.id);
+        writer.field("is_verified", doc.is_verified);
+        writer.field("type", doc.type);
+        writer.field("uploaded_at", doc.uploaded_at);
+        writer.field("url", doc.url);
+        writer.field("verified_at", doc.verified_at);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.field("id", getUuid());
+    writer.field("is_available_today", is_available_today_);
+    writer.field("is_deleted", isDeleted());
+    writer.field("languages", languages_);
+    writer.field("medical_license_number", medical_license_number_);
+    writer.field("qualification", qualification_);
+    writer.field("rating", rating_);
+
+    writer.key("specializations");
+    writer.beginArray();
+    for (const auto& spec : specializations_) {
+        writer.beginObject();
+        writer.field("category", spec.category);
+        writer.field("description", spec.description);
+        writer.field("id", spec.id);
+        writer.field("name", spec.name);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.field("status", doctorStatusToString(status_));
+    writer.field("total_reviews", total_reviews_);
+    writer.field("updated_at", getUpdatedAt());
+    writer.field("user_id", user_id_);
+    writer.field("years_of_experience", years_of_experience_);
+    writer.endObject();
+}
+
 void Doctor::fromJson(const nlohmann::json& json) {
     // Base entity fields
     if (json.contains("id")) setId(json["id"].get<std::string>());
@@ -211,7 +328,7 @@ void Doctor::fromJson(const nlohmann::json& json) {
     if (json.contains("is_deleted")) setDeleted(json["is_deleted"].get<bool>());
     
     // Doctor fields
-    if (json.contains("user_id")) user_id_ = json["user_id"].get<std::string>();
+    if (json.contains("user_id")) setUserId(json["user_id"].get<std::string>());
     if (json.contains("medical_license_number")) medical_license_number_ = json["medical_license_number"].get<std::string>();
     if (json.contains("qualification")) qualification_ = json["qualification"].get<std::string>();
     if (json.contains("years_of_experience")) years_of_experience_ = json["years_of_experience"].get<int>();
@@ -229,7 +346,7 @@ void Doctor::fromJson(const nlohmann::json& json) {
     
     if (json.contains("rating")) rating_ = json["rating"].get<double>();
     if (json.contains("total_reviews")) total_reviews_ = json["total_reviews"].get<int>();
-    if (json.contains("availability_pattern")) availability_pattern_ = json["availability_pattern"].get<std::string>();
+    if (json.contains("availability_pattern")) setAvailabilityPattern(json["availability_pattern"].get<std::string>());
     if (json.contains("is_available_today")) is_available_today_ = json["is_available_today"].get<bool>();
     if (json.contains("bio")) bio_ = json["bio"].get<std::string>();
     if (json.contains("languages")) languages_ = json["languages"].get<std::string>();
@@ -248,7 +365,7 @@ void Doctor::fromJson(const nlohmann::json& json) {
     }
     
     if (json.contains("clinic_ids")) {
-        clinic_ids_ = json["clinic_ids"].get<std::vector<std::string>>();
+        setClinicIds(json["clinic_ids"].get<std::vector<std::string>>());
     }
     
     // Documents
@@ -268,6 +385,64 @@ void Doctor::fromJson(const nlohmann::json& json) {
 }
 
 // Utility functions
+WeeklyAvailability parseWeeklyAvailability(const std::string& availability_pattern) {
+    // Pattern format: {"<tm_wday>": [{"start": "HH:MM", "end": "HH:MM"}, "HH:MM-HH:MM", ...]}
+    WeeklyAvailability weekly_ranges;
+    
+    try {
+        nlohmann::json pattern = nlohmann::json::parse(availability_pattern);
+        if (!pattern.is_object()) {
+            return weekly_ranges;
+        }
+        
+        for (int day = 0; day < utils::civil::kDaysPerWeek; ++day) {
+            auto it = pattern.find(std::to_string(day));
+            if (it == pattern.end() || !it->is_array()) continue;
+            
+            for (const auto& entry : *it) {
+                int start = utils::civil::kInvalidMinute;
+                int end = utils::civil::kInvalidMinute;
+                
+                if (entry.is_object()) {
+                    start = utils::civil::parseHHMM(entry.value("start", entry.value("start_time", "")));
+                    end = utils::civil::parseHHMM(entry.value("end", entry.value("end_time", "")));
+                } else if (entry.is_string()) {
+                    const auto& text = entry.get_ref<const std::string&>();
+                    auto dash = text.find('-');
+                    if (dash != std::string::npos) {
+                        start = utils::civil::parseHHMM(std::string_view(text).substr(0, dash));
+                        end = utils::civil::parseHHMM(std::string_view(text).substr(dash + 1));
+                    }
+                }
+                if (start == utils::civil::kInvalidMinute || end == utils::civil::kInvalidMinute || start == end) {
+                    continue;
+                }
+                
+                if (end > start) {
+                    weekly_ranges[day].push_back({start, end});
+                } else {
+                    // Overnight shift: the tail belongs to the next weekday
+                    if (start < utils::civil::kMinutesPerDay) {
+                        weekly_ranges[day].push_back({start, utils::civil::kMinutesPerDay});
+                    }
+                    if (end > 0) {
+                        weekly_ranges[(day + 1) % utils::civil::kDaysPerWeek].push_back({0, end});
+                    }
+                }
+            }
+        }
+        
+        for (auto& ranges : weekly_ranges) {
+            std::sort(ranges.begin(), ranges.end(),
+                [](const utils::civil::MinuteRange& a, const utils::civil::MinuteRange& b) { return a.start < b.start; });
+        }
+    } catch (const std::exception&) {
+        // Malformed patterns yield no availability
+    }
+    
+    return weekly_ranges;
+}
+
 std::string doctorStatusToString(DoctorStatus status) {
     switch (status) {
         case DoctorStatus::PENDING_VERIFICATION: return "PENDING_VERIFICATION";
@@ -95,18 +95,18 @@ int Prescription::getActiveMedicines() const {
         [](const Medicine& med) { return true; })); // All medicines are considered active
 }
 
-std::chrono::days Prescription::getValidityDays() const {
+Prescription::Days Prescription::getValidityDays() const {
     auto duration = valid_until_ - issued_date_;
-    return std::chrono::duration_cast<std::chrono::days>(duration);
+    return std::chrono::duration_cast<Days>(duration);
 }
 
-std::chrono::days Prescription::getDaysUntilExpiry() const {
+Prescription::Days Prescription::getDaysUntilExpiry() const {
     auto now = std::chrono::system_clock::now();
     if (now >= valid_until_) {
-        return std::chrono::days(0);
+        return Days(0);
     }
     auto duration = valid_until_ - now;
-    return std::chrono::duration_cast<std::chrono::days>(duration);
+    return std::chrono::duration_cast<Days>(duration);
 }
 
 bool Prescription::isValidPrescription() const {
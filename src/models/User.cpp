@@ -51,6 +51,30 @@ nlohmann::json User::toJson() const {
     return json;
 }
 
+void User::writeJson(utils::JsonWriter& writer) const {
+    // Keys in the sorted order nlohmann::json objects dump in
+    writer.beginObject();
+    writer.field("address", address_);
+    writer.field("city", city_);
+    writer.field("created_at", getCreatedAt());
+    writer.field("date_of_birth", date_of_birth_);
+    writer.field("email", email_);
+    writer.field("fcm_token", fcm_token_);
+    writer.field("first_name", first_name_);
+    writer.field("gender", genderToString(gender_));
+    writer.field("id", getUuid());
+    writer.field("is_deleted", isDeleted());
+    writer.field("is_verified", is_verified_);
+    writer.field("last_name", last_name_);
+    writer.field("phone_number", phone_number_);
+    writer.field("pincode", pincode_);
+    writer.field("profile_image_url", profile_image_url_);
+    writer.field("role", userRoleToString(role_));
+    writer.field("state", state_);
+    writer.field("updated_at", getUpdatedAt());
+    writer.endObject();
+}
+
 void User::fromJson(const nlohmann::json& json) {
     // Base entity fields
     if (json.contains("id")) setId(json["id"].get<std::string>());
@@ -0,0 +1,214 @@
+#include "../../include/services/AutocompleteService.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+
+namespace healthcare::services {
+
+namespace {
+
+// Usage counts per term; each vocabulary is one aggregate over the tables that reference it
+const char* usageQuery(Vocabulary vocabulary) {
+    switch (vocabulary) {
+        case Vocabulary::SPECIALIZATION:
+            return R"(
+                SELECT s->>'name', COUNT(*)
+                FROM doctors d
+                CROSS JOIN LATERAL jsonb_array_elements(COALESCE(d.specializations, '[]'::jsonb)) AS s
+                WHERE d.is_deleted = FALSE AND s->>'name' IS NOT NULL
+                GROUP BY 1
+            )";
+        case Vocabulary::CITY:
+            return R"(
+                SELECT city, SUM(uses) FROM (
+                    SELECT address->>'city' AS city, COUNT(*) AS uses
+                    FROM clinics WHERE is_deleted = FALSE GROUP BY 1
+                    UNION ALL
+                    SELECT city, COUNT(*) FROM users WHERE is_deleted = FALSE GROUP BY city
+                ) AS cities
+                WHERE city IS NOT NULL AND city <> ''
+                GROUP BY city
+            )";
+        case Vocabulary::MEDICINE:
+            return R"(
+                SELECT m->>'name', COUNT(*)
+                FROM prescriptions p
+                CROSS JOIN LATERAL jsonb_array_elements(COALESCE(p.medicines, '[]'::jsonb)) AS m
+                WHERE p.is_deleted = FALSE AND m->>'name' IS NOT NULL
+                GROUP BY 1
+            )";
+    }
+    return "";
+}
+
+} // namespace
+
+AutocompleteService& AutocompleteService::getInstance() {
+    static AutocompleteService instance;
+    return instance;
+}
+
+AutocompleteService::~AutocompleteService() {
+    stop();
+}
+
+void AutocompleteService::configure(const AutocompleteConfig& config) {
+    config_ = config;
+}
+
+bool AutocompleteService::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // A failed initial load is not fatal: suggestions fill in on the next refresh
+    if (!refresh()) {
+        LOG_WARN("Initial autocomplete load failed, retrying in {}s", config_.refresh_interval_seconds);
+    }
+
+    refresh_thread_ = std::thread(&AutocompleteService::refreshLoop, this);
+    LOG_INFO("Autocomplete service started");
+    return true;
+}
+
+void AutocompleteService::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    refresh_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+        refresh_thread_.join();
+    }
+}
+
+// Queries
+
+std::vector<utils::Suggestion> AutocompleteService::suggest(Vocabulary vocabulary, const std::string& prefix,
+                                                            size_t limit) const {
+    limit = std::min(limit, config_.max_suggestions);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return tries_[static_cast<size_t>(vocabulary)].complete(prefix, limit);
+}
+
+// Synchronization with the database
+
+bool AutocompleteService::refresh() {
+    std::array<TermCounts, kVocabularyCount> loaded;
+
+    try {
+        for (size_t i = 0; i < kVocabularyCount; ++i) {
+            loaded[i] = loadCounts(static_cast<Vocabulary>(i));
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Autocomplete refresh failed: {}", e.what());
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.failed_refreshes++;
+        return false;
+    }
+
+    for (size_t i = 0; i < kVocabularyCount; ++i) {
+        applyCounts(static_cast<Vocabulary>(i), loaded[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.refreshes++;
+    stats_.last_refresh = std::chrono::system_clock::now();
+    return true;
+}
+
+AutocompleteService::TermCounts AutocompleteService::loadCounts(Vocabulary vocabulary) const {
+    auto result = database::DatabaseManager::getInstance().executeQuery(usageQuery(vocabulary));
+
+    // Spelling variants ("delhi", "Delhi") share a key; the most used spelling is displayed
+    TermCounts counts;
+    std::unordered_map<std::string, std::int64_t> display_uses;
+    for (const auto& row : result) {
+        if (row[0].is_null()) continue;
+
+        std::string term = row[0].as<std::string>();
+        std::int64_t uses = row[1].as<std::int64_t>();
+        std::string key = utils::PrefixTrie::foldKey(term);
+        if (key.empty()) continue;
+
+        auto& entry = counts[key];
+        entry.second += uses;
+        auto& best_uses = display_uses[key];
+        if (uses > best_uses) {
+            best_uses = uses;
+            entry.first = term;
+        }
+    }
+    return counts;
+}
+
+void AutocompleteService::applyCounts(Vocabulary vocabulary, const TermCounts& counts) {
+    size_t index = static_cast<size_t>(vocabulary);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& trie = tries_[index];
+    auto& synced = synced_[index];
+
+    // Only terms whose count changed are rewritten
+    for (const auto& [key, entry] : counts) {
+        auto current = trie.weightOf(key);
+        if (!current || *current != entry.second) {
+            trie.set(entry.first, entry.second);
+        }
+    }
+
+    // Terms that disappeared from the DB since the last sync
+    for (const auto& key : synced) {
+        if (counts.find(key) == counts.end()) {
+            trie.remove(key);
+        }
+    }
+
+    synced.clear();
+    for (const auto& item : counts) {
+        synced.insert(item.first);
+    }
+
+    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+    stats_.terms[index] = trie.size();
+}
+
+void AutocompleteService::refreshLoop() {
+    std::unique_lock<std::mutex> lock(refresh_mutex_);
+
+    while (running_) {
+        refresh_cv_.wait_for(lock, std::chrono::seconds(config_.refresh_interval_seconds),
+                             [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        refresh();
+        lock.lock();
+    }
+}
+
+AutocompleteStats AutocompleteService::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+// Vocabulary names used in routes
+
+std::optional<Vocabulary> AutocompleteService::vocabularyFromString(const std::string& name) {
+    if (name == "specializations") return Vocabulary::SPECIALIZATION;
+    if (name == "cities") return Vocabulary::CITY;
+    if (name == "medicines") return Vocabulary::MEDICINE;
+    return std::nullopt;
+}
+
+std::string AutocompleteService::vocabularyToString(Vocabulary vocabulary) {
+    switch (vocabulary) {
+        case Vocabulary::SPECIALIZATION: return "specializations";
+        case Vocabulary::CITY: return "cities";
+        case Vocabulary::MEDICINE: return "medicines";
+    }
+    return "unknown";
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,445 @@
+#include "../../include/services/BookingPartitioner.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <iterator>
+#include <curl/curl.h>
+
+namespace healthcare::services {
+
+namespace {
+
+std::int64_t nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+size_t writeResponseBody(char* data, size_t size, size_t count, void* user_data) {
+    auto* body = static_cast<std::string*>(user_data);
+    body->append(data, size * count);
+    return size * count;
+}
+
+} // namespace
+
+// DoctorScheduleBook
+
+void DoctorScheduleBook::setMaxAge(std::chrono::seconds max_age) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_age_ = max_age;
+}
+
+bool DoctorScheduleBook::isLoaded(const std::string& doctor_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return findFresh(doctor_id) != nullptr;
+}
+
+void DoctorScheduleBook::load(const std::string& doctor_id, std::vector<BookedInterval> intervals) {
+    std::sort(intervals.begin(), intervals.end(),
+        [](const BookedInterval& a, const BookedInterval& b) { return a.start_time < b.start_time; });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    schedules_[doctor_id] = {std::move(intervals), std::chrono::steady_clock::now()};
+}
+
+std::optional<bool> DoctorScheduleBook::isFree(const std::string& doctor_id,
+                                               const std::chrono::system_clock::time_point& start_time,
+                                               const std::chrono::system_clock::time_point& end_time,
+                                               const std::string& exclude_appointment_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const Schedule* schedule = findFresh(doctor_id);
+    if (schedule == nullptr) {
+        return std::nullopt;
+    }
+    return !overlaps(schedule->intervals, start_time, end_time, exclude_appointment_id);
+}
+
+bool DoctorScheduleBook::reserve(const std::string& doctor_id, const BookedInterval& interval) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = schedules_.find(doctor_id);
+    if (it == schedules_.end()) {
+        return false;
+    }
+    auto& intervals = it->second.intervals;
+    if (overlaps(intervals, interval.start_time, interval.end_time, interval.appointment_id)) {
+        return false;
+    }
+
+    auto position = std::lower_bound(intervals.begin(), intervals.end(), interval.start_time,
+        [](const BookedInterval& existing, const std::chrono::system_clock::time_point& start) {
+            return existing.start_time < start;
+        });
+    intervals.insert(position, interval);
+    return true;
+}
+
+bool DoctorScheduleBook::release(const std::string& doctor_id, const std::string& appointment_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = schedules_.find(doctor_id);
+    if (it == schedules_.end()) {
+        return false;
+    }
+
+    auto& intervals = it->second.intervals;
+    auto removed = std::remove_if(intervals.begin(), intervals.end(),
+        [&appointment_id](const BookedInterval& interval) { return interval.appointment_id == appointment_id; });
+    bool found = removed != intervals.end();
+    intervals.erase(removed, intervals.end());
+    return found;
+}
+
+bool DoctorScheduleBook::releaseAppointment(const std::string& appointment_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& [doctor_id, schedule] : schedules_) {
+        auto& intervals = schedule.intervals;
+        auto it = std::find_if(intervals.begin(), intervals.end(),
+            [&appointment_id](const BookedInterval& interval) { return interval.appointment_id == appointment_id; });
+        if (it != intervals.end()) {
+            intervals.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void DoctorScheduleBook::evict(const std::string& doctor_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    schedules_.erase(doctor_id);
+}
+
+size_t DoctorScheduleBook::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return schedules_.size();
+}
+
+const DoctorScheduleBook::Schedule* DoctorScheduleBook::findFresh(const std::string& doctor_id) const {
+    auto it = schedules_.find(doctor_id);
+    if (it == schedules_.end() || std::chrono::steady_clock::now() - it->second.loaded_at > max_age_) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool DoctorScheduleBook::overlaps(const std::vector<BookedInterval>& intervals,
+                                  const std::chrono::system_clock::time_point& start_time,
+                                  const std::chrono::system_clock::time_point& end_time,
+                                  const std::string& exclude_appointment_id) const {
+    // Intervals are sorted by start; stop once they begin after the requested end
+    for (const auto& interval : intervals) {
+        if (interval.start_time >= end_time) break;
+        if (interval.end_time > start_time && interval.appointment_id != exclude_appointment_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// BookingPartitioner
+
+BookingPartitioner& BookingPartitioner::getInstance() {
+    static BookingPartitioner instance;
+    return instance;
+}
+
+BookingPartitioner::~BookingPartitioner() {
+    stop();
+}
+
+void BookingPartitioner::configure(const PartitionConfig& config) {
+    std::unique_lock<std::shared_mutex> lock(ring_mutex_);
+    config_ = config;
+    ring_ = utils::ConsistentHashRing(config_.virtual_nodes);
+    schedule_book_.setMaxAge(std::chrono::seconds(std::max(config_.schedule_max_age_seconds, 1)));
+    members_.clear();
+
+    // A node always owns its share of the ring, even before Redis answers
+    if (!config_.node_id.empty()) {
+        members_[config_.node_id] = {config_.node_id, config_.advertise_url, nowSeconds()};
+        ring_.addNode(config_.node_id);
+    }
+}
+
+bool BookingPartitioner::start() {
+    if (!config_.enabled) {
+        LOG_INFO("Booking partitioning disabled, this node owns every doctor");
+        return true;
+    }
+    if (config_.node_id.empty() || config_.advertise_url.empty()) {
+        LOG_ERROR("Booking partitioning requires node_id and advertise_url");
+        return false;
+    }
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    refreshMembership();
+    heartbeat_thread_ = std::thread(&BookingPartitioner::heartbeatLoop, this);
+    LOG_INFO("Booking partitioner started as {} ({})", config_.node_id, config_.advertise_url);
+    return true;
+}
+
+void BookingPartitioner::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    heartbeat_cv_.notify_all();
+    if (heartbeat_thread_.joinable()) {
+        heartbeat_thread_.join();
+    }
+
+    // Leave the ring right away rather than waiting for the TTL to expire
+    try {
+        auto& db_manager = database::DatabaseManager::getInstance();
+        if (db_manager.isRedisConnected()) {
+            db_manager.getRedisClient().hdel(config_.membership_key, config_.node_id);
+        }
+    } catch (const std::exception& e) {
+        LOG_WARN("Failed to deregister partition member {}: {}", config_.node_id, e.what());
+    }
+}
+
+bool BookingPartitioner::isLocalOwner(const std::string& doctor_id) const {
+    if (!config_.enabled) {
+        return true;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(ring_mutex_);
+    const auto& owner = ring_.getOwner(doctor_id);
+    return owner.empty() || owner == config_.node_id;
+}
+
+PartitionMember BookingPartitioner::getOwner(const std::string& doctor_id) const {
+    std::shared_lock<std::shared_mutex> lock(ring_mutex_);
+
+    auto it = members_.find(ring_.getOwner(doctor_id));
+    if (it == members_.end()) {
+        return {config_.node_id, config_.advertise_url, 0};
+    }
+    return it->second;
+}
+
+std::vector<PartitionMember> BookingPartitioner::getMembers() const {
+    std::shared_lock<std::shared_mutex> lock(ring_mutex_);
+
+    std::vector<PartitionMember> members;
+    members.reserve(members_.size());
+    for (const auto& [node_id, member] : members_) {
+        members.push_back(member);
+    }
+    return members;
+}
+
+bool BookingPartitioner::refreshMembership() {
+    std::int64_t now = nowSeconds();
+    if (!publishHeartbeat(now)) {
+        return false;
+    }
+
+    std::unordered_map<std::string, std::string> entries;
+    try {
+        auto& redis = database::DatabaseManager::getInstance().getRedisClient();
+        redis.hgetall(config_.membership_key, std::inserter(entries, entries.begin()));
+    } catch (const std::exception& e) {
+        LOG_WARN("Failed to read partition membership: {}", e.what());
+        return false;
+    }
+
+    std::unordered_map<std::string, PartitionMember> live_members;
+    std::vector<std::string> stale_members;
+
+    for (const auto& [node_id, value] : entries) {
+        try {
+            auto entry = nlohmann::json::parse(value);
+            PartitionMember member{node_id, entry.value("url", ""), entry.value("heartbeat", std::int64_t{0})};
+            if (now - member.last_heartbeat > config_.member_ttl_seconds) {
+                stale_members.push_back(node_id);
+            } else {
+                live_members.emplace(node_id, std::move(member));
+            }
+        } catch (const std::exception&) {
+            stale_members.push_back(node_id);
+        }
+    }
+
+    if (!stale_members.empty()) {
+        try {
+            auto& redis = database::DatabaseManager::getInstance().getRedisClient();
+            redis.hdel(config_.membership_key, stale_members.begin(), stale_members.end());
+        } catch (const std::exception& e) {
+            LOG_WARN("Failed to prune stale partition members: {}", e.what());
+        }
+    }
+
+    bool changed = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(ring_mutex_);
+
+        changed = live_members.size() != members_.size() ||
+                  std::any_of(live_members.begin(), live_members.end(),
+                      [this](const auto& entry) { return members_.count(entry.first) == 0; });
+
+        members_ = std::move(live_members);
+        if (changed) {
+            std::vector<std::string> node_ids;
+            for (const auto& [node_id, member] : members_) {
+                node_ids.push_back(node_id);
+            }
+            ring_.setNodes(node_ids);
+        }
+    }
+
+    membership_refreshes_.fetch_add(1, std::memory_order_relaxed);
+
+    if (changed) {
+        membership_changes_.fetch_add(1, std::memory_order_relaxed);
+        // Drop schedules for doctors that moved to another node; the new owner reloads them
+        schedule_book_.retainIf([this](const std::string& doctor_id) { return isLocalOwner(doctor_id); });
+        LOG_INFO("Partition membership changed, {} live members", getMembers().size());
+    }
+    return true;
+}
+
+ForwardResponse BookingPartitioner::forward(const PartitionMember& owner, const std::string& method,
+                                            const std::string& path, const std::string& body,
+                                            const std::string& request_id) const {
+    ForwardResponse response;
+    forwarded_requests_.fetch_add(1, std::memory_order_relaxed);
+
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        response.error = "Failed to initialize HTTP client";
+        forward_failures_.fetch_add(1, std::memory_order_relaxed);
+        return response;
+    }
+
+    std::string url = owner.url + path;
+    std::string forwarded_header = std::string(kForwardedHeader) + ": " + config_.node_id;
+    std::string token_header = std::string(kInternalTokenHeader) + ": " + config_.internal_secret;
+
+    struct curl_slist* headers = nullptr;
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+    headers = curl_slist_append(headers, forwarded_header.c_str());
+    headers = curl_slist_append(headers, token_header.c_str());
+    if (!request_id.empty()) {
+        std::string request_id_header = "X-Request-ID: " + request_id;
+        headers = curl_slist_append(headers, request_id_header.c_str());
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(config_.forward_timeout_ms));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeResponseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+    if (!body.empty()) {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+    }
+
+    CURLcode code = curl_easy_perform(curl);
+    if (code == CURLE_OK) {
+        long status = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+        response.status_code = static_cast<int>(status);
+        response.success = status >= 200 && status < 300;
+    } else {
+        response.error = curl_easy_strerror(code);
+    }
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(curl);
+
+    if (!response.success) {
+        forward_failures_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("Forward to partition owner {} failed: {} {}", owner.node_id, response.status_code, response.error);
+    }
+    return response;
+}
+
+void BookingPartitioner::invalidateRemoteSchedule(const std::string& doctor_id) const {
+    if (isLocalOwner(doctor_id)) {
+        return;
+    }
+
+    nlohmann::json body;
+    body["doctor_id"] = doctor_id;
+    auto response = forward(getOwner(doctor_id), "POST", kScheduleInvalidatePath, body.dump());
+    if (!response.success) {
+        // The owner's copy ages out after schedule_max_age_seconds
+        LOG_WARN("Owner of doctor {} was not told about a write; its schedule stays cached until it expires",
+                 doctor_id);
+    }
+}
+
+PartitionStats BookingPartitioner::getStats() const {
+    PartitionStats stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(ring_mutex_);
+        stats.members = members_.size();
+    }
+    stats.owned_doctors = schedule_book_.size();
+    stats.forwarded_requests = forwarded_requests_.load(std::memory_order_relaxed);
+    stats.forward_failures = forward_failures_.load(std::memory_order_relaxed);
+    stats.membership_refreshes = membership_refreshes_.load(std::memory_order_relaxed);
+    stats.membership_changes = membership_changes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+nlohmann::json BookingPartitioner::getStatus() const {
+    auto stats = getStats();
+
+    nlohmann::json status;
+    status["enabled"] = config_.enabled;
+    status["node_id"] = config_.node_id;
+    status["members"] = nlohmann::json::array();
+    for (const auto& member : getMembers()) {
+        status["members"].push_back({{"node_id", member.node_id}, {"url", member.url},
+                                     {"last_heartbeat", member.last_heartbeat}});
+    }
+    status["owned_doctors"] = stats.owned_doctors;
+    status["forwarded_requests"] = stats.forwarded_requests;
+    status["forward_failures"] = stats.forward_failures;
+    status["membership_changes"] = stats.membership_changes;
+    return status;
+}
+
+void BookingPartitioner::heartbeatLoop() {
+    std::unique_lock<std::mutex> lock(heartbeat_mutex_);
+
+    while (running_) {
+        heartbeat_cv_.wait_for(lock, std::chrono::seconds(config_.heartbeat_interval_seconds),
+                               [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        refreshMembership();
+        lock.lock();
+    }
+}
+
+bool BookingPartitioner::publishHeartbeat(std::int64_t now_seconds) {
+    try {
+        auto& db_manager = database::DatabaseManager::getInstance();
+        if (!db_manager.isRedisConnected()) {
+            LOG_WARN("Redis unavailable, keeping last known partition membership");
+            return false;
+        }
+
+        nlohmann::json entry;
+        entry["url"] = config_.advertise_url;
+        entry["heartbeat"] = now_seconds;
+        db_manager.getRedisClient().hset(config_.membership_key, config_.node_id, entry.dump());
+        return true;
+    } catch (const std::exception& e) {
+        LOG_WARN("Failed to publish partition heartbeat: {}", e.what());
+        return false;
+    }
+}
+
+} // namespace healthcare::services
\ No newline at end of file
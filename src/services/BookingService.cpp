@@ -0,0 +1,863 @@
+#include "../../include/services/BookingService.h"
+#include "../../include/utils/CivilTime.h"
+#include "../../include/utils/Logger.h"
+#include "../../include/utils/Metrics.h"
+#include "../../include/utils/Tracing.h"
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+namespace healthcare::services {
+
+namespace {
+
+utils::LatencyHistogram& paymentLatency(std::string_view operation) {
+    static utils::LatencyFamily& family = utils::MetricsRegistry::getInstance().latencyFamily(
+        "payment_gateway_duration_seconds", "Payment gateway call latency", {"operation"});
+    return family.series(operation);
+}
+
+// Identifies a booked slot independently of how the id and time were spelled or stored.
+// Unique among the rows of one batch, since overlapping items were already rejected
+using SlotKey = std::pair<std::string, std::int64_t>;
+
+SlotKey slotKey(const std::string& doctor_id, const std::chrono::system_clock::time_point& start_time) {
+    auto id = utils::Uuid::parse(doctor_id);
+    return {id ? id->toString() : doctor_id,
+            std::chrono::duration_cast<std::chrono::seconds>(start_time.time_since_epoch()).count()};
+}
+
+// Statuses that keep a doctor's time slot taken
+bool holdsSlot(models::AppointmentStatus status) {
+    return status == models::AppointmentStatus::PENDING ||
+           status == models::AppointmentStatus::CONFIRMED ||
+           status == models::AppointmentStatus::IN_PROGRESS;
+}
+
+} // namespace
+
+nlohmann::json bookingResultToJson(const BookingResult& result) {
+    nlohmann::json json;
+    json["error"] = static_cast<int>(result.error);
+    json["message"] = result.message;
+    json["payment_url"] = result.payment_url;
+    if (result.appointment) {
+        json["appointment"] = result.appointment->toJson();
+    }
+    return json;
+}
+
+BookingService::BookingService(const BookingConfig& config)
+    : config_(config),
+      appointment_repository_(std::make_unique<database::AppointmentRepository>()),
+      doctor_repository_(std::make_unique<database::DoctorRepository>()),
+      user_repository_(std::make_unique<database::UserRepository>()),
+      payment_service_(std::make_unique<PaymentService>()),
+      notification_service_(std::make_unique<NotificationService>()) {
+}
+
+// Core Booking Operations
+
+BookingResult BookingService::bookAppointment(const BookingRequest& request, const std::string& request_id) {
+    if (request.is_emergency) {
+        return bookEmergencyAppointment(request);
+    }
+
+    if (!BookingPartitioner::getInstance().isLocalOwner(request.doctor_id)) {
+        bool delivered = false;
+        auto result = forwardBooking(request, request_id, delivered);
+        if (delivered) {
+            return result;
+        }
+        // Safe to book here: the transactional conflict check serializes with the owner
+        LOG_WARN("Owner of doctor {} unreachable, booking on this node", request.doctor_id);
+    }
+    return bookLocally(request);
+}
+
+BookingResult BookingService::bookAppointmentAsOwner(const BookingRequest& request) {
+    return bookLocally(request);
+}
+
+BookingResult BookingService::bookLocally(const BookingRequest& request) {
+    BookingResult result;
+    auto reject = [&result](BookingError error, const std::string& message) {
+        result.error = error;
+        result.message = message;
+        return std::move(result);
+    };
+
+    if (!user_repository_->exists(request.user_id)) {
+        return reject(BookingError::USER_NOT_FOUND, "User not found");
+    }
+    auto doctor_result = doctor_repository_->findById(request.doctor_id);
+    if (!doctor_result.hasData()) {
+        return reject(BookingError::DOCTOR_NOT_FOUND, "Doctor not found");
+    }
+    const auto doctor = doctor_result.getFirst();
+
+    auto start_time = request.preferred_start_time;
+    auto end_time = start_time + std::chrono::minutes(std::max(doctor.getConsultationDuration(), 1));
+    std::string message;
+    BookingError error = checkBookable(doctor, request.clinic_id, start_time, end_time, request.type, message);
+    if (error != BookingError::SUCCESS) {
+        return reject(error, message);
+    }
+
+    // The in-memory book turns away most conflicts; Postgres still has the final say below
+    auto& schedule_book = BookingPartitioner::getInstance().getScheduleBook();
+    if (BookingPartitioner::getInstance().isLocalOwner(request.doctor_id) && !schedule_book.isLoaded(request.doctor_id)) {
+        loadOwnedDoctorSchedule(request.doctor_id);
+    }
+    if (schedule_book.isFree(request.doctor_id, start_time, end_time) == false) {
+        return reject(BookingError::TIME_SLOT_OCCUPIED, "Time slot already booked");
+    }
+
+    auto now = std::chrono::system_clock::now();
+    models::Appointment appointment;
+    appointment.setUserId(request.user_id);
+    appointment.setDoctorId(request.doctor_id);
+    appointment.setClinicId(request.clinic_id);
+    appointment.setAppointmentDate(request.preferred_date);
+    appointment.setStartTime(start_time);
+    appointment.setEndTime(end_time);
+    appointment.setType(request.type);
+    appointment.setSymptoms(request.symptoms);
+    appointment.setNotes(request.notes);
+    appointment.setConsultationFee(doctor.getConsultationFee());
+    appointment.setBookedAt(now);
+
+    models::Appointment stored;
+    try {
+        auto transaction = database::DatabaseManager::getInstance().beginTransaction();
+
+        if (!appointment_repository_->findConflictingSlots({{request.doctor_id, start_time, end_time}}, *transaction).empty()) {
+            transaction->rollback();
+            return reject(BookingError::TIME_SLOT_OCCUPIED, "Time slot already booked");
+        }
+
+        auto insert_result = appointment_repository_->createBatchInTransaction({appointment}, *transaction);
+        if (!insert_result.success || insert_result.data.size() != 1) {
+            transaction->rollback();
+            return reject(BookingError::DATABASE_ERROR, insert_result.error_message);
+        }
+        transaction->commit();
+        stored = std::move(insert_result.data.front());
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Booking for user {} failed: {}", request.user_id, e.what());
+        return reject(BookingError::DATABASE_ERROR, "Booking transaction failed");
+    }
+    database::AppointmentRepository::notifyChanged(stored);
+
+    if (stored.getConsultationFee() > 0.0) {
+        PaymentRequest payment_request;
+        payment_request.appointment_id = stored.getId();
+        payment_request.amount = stored.getConsultationFee();
+        payment_request.method = PaymentMethod::RAZORPAY;
+        payment_request.user_id = request.user_id;
+        payment_request.description = "Consultation booking";
+
+        auto payment = createPaymentOrder(payment_request);
+        if (payment.error != PaymentError::SUCCESS) {
+            LOG_WARN("Payment order failed for appointment {}: {}", stored.getId(), payment.message);
+            cancelUnpaid({stored}, "Payment order could not be created");
+            return reject(BookingError::PAYMENT_FAILED, "Payment order could not be created: " + payment.message);
+        }
+        result.payment_url = payment.payment_url;
+    }
+
+    notification_service_->sendAppointmentConfirmation(request.user_id, stored.getId());
+
+    result.error = BookingError::SUCCESS;
+    result.message = "Appointment booked successfully";
+    result.appointment = std::make_unique<models::Appointment>(stored);
+    return result;
+}
+
+// Batch Booking
+
+BatchBookingResult BookingService::bookAppointments(const BatchBookingRequest& request) {
+    BatchBookingResult result;
+    const size_t count = request.items.size();
+    result.items.resize(count);
+
+    if (count == 0) {
+        result.error = BookingError::VALIDATION_ERROR;
+        result.message = "Batch contains no appointments";
+        return result;
+    }
+    if (count > static_cast<size_t>(config_.max_batch_items)) {
+        result.error = BookingError::VALIDATION_ERROR;
+        result.message = "Batch holds at most " + std::to_string(config_.max_batch_items) + " appointments";
+        return result;
+    }
+    if (!user_repository_->exists(request.user_id)) {
+        result.error = BookingError::USER_NOT_FOUND;
+        result.message = "User not found";
+        return result;
+    }
+
+    auto fail = [&result](size_t index, BookingError error, const std::string& message) {
+        result.items[index].error = error;
+        result.items[index].message = message;
+    };
+
+    // Load each distinct doctor once
+    std::map<std::string, std::optional<models::Doctor>> doctors;
+    for (const auto& item : request.items) {
+        if (doctors.count(item.doctor_id)) continue;
+        auto doctor_result = doctor_repository_->findById(item.doctor_id);
+        doctors[item.doctor_id] = doctor_result.getFirstOptional();
+    }
+
+    // Per-item validation
+    auto now = std::chrono::system_clock::now();
+    std::vector<database::SlotRange> ranges(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& item = request.items[i];
+        const auto& doctor = doctors[item.doctor_id];
+
+        if (!doctor) {
+            fail(i, BookingError::DOCTOR_NOT_FOUND, "Doctor not found");
+            continue;
+        }
+
+        ranges[i] = {item.doctor_id, item.start_time,
+                     item.start_time + std::chrono::minutes(std::max(doctor->getConsultationDuration(), 1))};
+
+        // Same rules as a single booking
+        std::string message;
+        BookingError error = checkBookable(*doctor, item.clinic_id, ranges[i].start_time, ranges[i].end_time,
+                                           item.type, message);
+        if (error != BookingError::SUCCESS) {
+            fail(i, error, message);
+        }
+    }
+
+    // Conflicts within the batch itself: sort by (doctor, start) and compare neighbours
+    std::vector<size_t> order;
+    for (size_t i = 0; i < count; ++i) {
+        if (result.items[i].error == BookingError::SUCCESS) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) {
+        return std::tie(ranges[a].doctor_id, ranges[a].start_time) < std::tie(ranges[b].doctor_id, ranges[b].start_time);
+    });
+    for (size_t k = 1, last = order.empty() ? 0 : order[0]; k < order.size(); ++k) {
+        size_t current = order[k];
+        if (ranges[current].doctor_id == ranges[last].doctor_id &&
+            ranges[current].start_time < ranges[last].end_time) {
+            fail(current, BookingError::BOOKING_CONFLICT, "Overlaps another appointment in this batch");
+            continue;
+        }
+        last = current;
+    }
+
+    auto pending_indices = [&result, count]() {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < count; ++i) {
+            if (result.items[i].error == BookingError::SUCCESS && !result.items[i].appointment) indices.push_back(i);
+        }
+        return indices;
+    };
+    auto reject_remaining = [&]() {
+        for (size_t i : pending_indices()) {
+            fail(i, BookingError::VALIDATION_ERROR, "Not booked: another item in the batch failed");
+        }
+        result.error = BookingError::VALIDATION_ERROR;
+        result.message = "Batch rejected";
+    };
+
+    if (request.all_or_nothing && pending_indices().size() != count) {
+        reject_remaining();
+        return result;
+    }
+
+    auto candidates = pending_indices();
+    if (candidates.empty()) {
+        result.error = BookingError::VALIDATION_ERROR;
+        result.message = "No appointment in the batch could be booked";
+        return result;
+    }
+
+    // Reserve everything inside one transaction with a single set-based conflict check
+    std::vector<models::Appointment> created;
+    try {
+        auto transaction = database::DatabaseManager::getInstance().beginTransaction();
+
+        std::vector<database::SlotRange> candidate_ranges;
+        for (size_t i : candidates) candidate_ranges.push_back(ranges[i]);
+
+        for (size_t conflict : appointment_repository_->findConflictingSlots(candidate_ranges, *transaction)) {
+            fail(candidates[conflict], BookingError::TIME_SLOT_OCCUPIED, "Time slot already booked");
+        }
+
+        if (request.all_or_nothing && pending_indices().size() != candidates.size()) {
+            transaction->rollback();
+            reject_remaining();
+            return result;
+        }
+
+        candidates = pending_indices();
+        std::vector<models::Appointment> appointments;
+        appointments.reserve(candidates.size());
+        for (size_t i : candidates) {
+            const auto& item = request.items[i];
+            const auto& doctor = *doctors[item.doctor_id];
+
+            models::Appointment appointment;
+            appointment.setUserId(request.user_id);
+            appointment.setDoctorId(item.doctor_id);
+            appointment.setClinicId(item.clinic_id);
+            appointment.setAppointmentDate(item.start_time);
+            appointment.setStartTime(ranges[i].start_time);
+            appointment.setEndTime(ranges[i].end_time);
+            appointment.setType(item.type);
+            appointment.setSymptoms(item.symptoms);
+            appointment.setNotes(item.notes);
+            appointment.setConsultationFee(doctor.getConsultationFee());
+            appointment.setBookedAt(now);
+            appointments.push_back(std::move(appointment));
+        }
+
+        if (!appointments.empty()) {
+            auto insert_result = appointment_repository_->createBatchInTransaction(appointments, *transaction);
+            if (!insert_result.success || insert_result.data.size() != appointments.size()) {
+                transaction->rollback();
+                for (size_t i : candidates) fail(i, BookingError::DATABASE_ERROR, "Failed to store appointment");
+                result.error = BookingError::DATABASE_ERROR;
+                result.message = insert_result.error_message;
+                return result;
+            }
+            created = std::move(insert_result.data);
+        }
+
+        transaction->commit();
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Batch booking for user {} failed: {}", request.user_id, e.what());
+        for (size_t i : pending_indices()) fail(i, BookingError::DATABASE_ERROR, "Batch transaction failed");
+        result.error = BookingError::DATABASE_ERROR;
+        result.message = e.what();
+        return result;
+    }
+
+    // Record results; the transactional insert reports nothing to listeners on its own.
+    // RETURNING order is not guaranteed to follow VALUES order, so rows are matched back by slot
+    std::map<SlotKey, size_t> candidate_by_slot;
+    for (size_t i : candidates) {
+        candidate_by_slot[slotKey(ranges[i].doctor_id, ranges[i].start_time)] = i;
+    }
+
+    std::vector<std::string> appointment_ids;
+    for (const auto& appointment : created) {
+        database::AppointmentRepository::notifyChanged(appointment);
+
+        auto match = candidate_by_slot.find(slotKey(appointment.getDoctorId(), appointment.getStartTime()));
+        if (match == candidate_by_slot.end()) {
+            LOG_ERROR("Batch booking for user {}: stored appointment {} matches no request item",
+                      request.user_id, appointment.getId());
+            continue;
+        }
+        size_t i = match->second;
+        candidate_by_slot.erase(match);
+
+        appointment_ids.push_back(appointment.getId());
+        result.total_amount += appointment.getConsultationFee();
+        result.items[i].message = "Appointment booked";
+        result.items[i].appointment = std::make_unique<models::Appointment>(appointment);
+    }
+    for (const auto& [slot, i] : candidate_by_slot) {
+        fail(i, BookingError::DATABASE_ERROR, "Stored appointment could not be matched to this item");
+    }
+    result.booked_count = appointment_ids.size();
+
+    // One aggregated payment order for the whole plan
+    if (result.total_amount > 0.0) {
+        // Keyed on the batch, not on any one appointment, so reconciling the order covers every
+        // appointment listed under appointment_ids
+        PaymentRequest payment_request;
+        payment_request.batch_id = utils::Uuid::generate().toString();
+        payment_request.amount = result.total_amount;
+        payment_request.method = request.payment_method;
+        payment_request.user_id = request.user_id;
+        payment_request.description = request.description.empty()
+            ? "Booking for " + std::to_string(appointment_ids.size()) + " appointments" : request.description;
+
+        std::ostringstream ids;
+        for (size_t k = 0; k < appointment_ids.size(); ++k) {
+            if (k > 0) ids << ",";
+            ids << appointment_ids[k];
+        }
+        payment_request.metadata["appointment_ids"] = ids.str();
+        payment_request.metadata["batch_id"] = payment_request.batch_id;
+
+        auto payment = createPaymentOrder(payment_request);
+        if (payment.error != PaymentError::SUCCESS) {
+            // Nothing was paid for, so nothing stays booked
+            LOG_WARN("Aggregated payment order failed for user {}: {}", request.user_id, payment.message);
+            cancelUnpaid(created, "Payment order could not be created");
+            for (auto& item : result.items) {
+                if (!item.appointment) continue;
+                item.appointment.reset();
+                item.error = BookingError::PAYMENT_FAILED;
+                item.message = "Cancelled: payment order could not be created";
+            }
+            result.booked_count = 0;
+            result.total_amount = 0.0;
+            result.error = BookingError::PAYMENT_FAILED;
+            result.message = "Payment order could not be created: " + payment.message;
+            return result;
+        }
+        result.payment_order_id = payment.order_id;
+        result.payment_batch_id = payment_request.batch_id;
+        result.payment_url = payment.payment_url;
+    }
+
+    // One digest notification instead of one message per appointment
+    notification_service_->sendAppointmentDigest(request.user_id, appointment_ids);
+
+    result.error = result.booked_count == count ? BookingError::SUCCESS : BookingError::BOOKING_CONFLICT;
+    result.message = std::to_string(result.booked_count) + " of " + std::to_string(count) + " appointments booked";
+    LOG_INFO("Batch booking for user {}: {}", request.user_id, result.message);
+    return result;
+}
+
+BatchBookingResult BookingService::bookRecurringAppointments(const BatchBookingItem& first_visit,
+                                                             const std::string& user_id,
+                                                             int occurrences, std::chrono::hours interval) {
+    BatchBookingRequest request;
+    request.user_id = user_id;
+    request.all_or_nothing = false;
+
+    if (occurrences > config_.max_recurring_occurrences) {
+        LOG_WARN("Recurring plan for user {} asked for {} visits, booking the first {}",
+                 user_id, occurrences, config_.max_recurring_occurrences);
+        occurrences = config_.max_recurring_occurrences;
+    }
+
+    for (int i = 0; i < occurrences; ++i) {
+        BatchBookingItem item = first_visit;
+        item.start_time = first_visit.start_time + interval * i;
+        request.items.push_back(std::move(item));
+    }
+    return bookAppointments(request);
+}
+
+// Availability Management
+
+std::vector<AvailabilitySlot> BookingService::getClinicAvailability(const std::string& clinic_id,
+                                                                    const std::chrono::system_clock::time_point& date) {
+    std::vector<AvailabilitySlot> slots;
+
+    auto schedule = ClinicRegistry::getInstance().findSchedule(clinic_id);
+    if (!schedule) {
+        LOG_WARN("No compiled schedule for clinic {}", clinic_id);
+        return slots;
+    }
+
+    // Resolve the requested calendar day in the clinic's zone
+    const auto& zone = schedule->zone ? *schedule->zone : utils::civil::TimeZoneRegistry::getInstance().getDefault();
+    auto local = utils::civil::toLocal(date, zone);
+    if (!schedule->isOpenOn(local.day_of_week)) {
+        return slots;
+    }
+
+    auto day_start = utils::civil::fromLocal(local.local_days, 0, zone);
+    auto day_end = utils::civil::fromLocal(local.local_days + 1, 0, zone) - std::chrono::minutes(1);
+
+    auto doctors = doctor_repository_->findByClinic(clinic_id);
+    if (!doctors.success) {
+        LOG_ERROR("Failed to load doctors for clinic {}: {}", clinic_id, doctors.error_message);
+        return slots;
+    }
+
+    for (const auto& doctor : doctors.data) {
+        if (!doctor.isActive()) continue;
+
+        for (const auto& slot : doctor.getAvailableSlots(day_start, day_end)) {
+            // Keep only slots that fit entirely inside one of the clinic's open intervals
+            auto slot_start = utils::civil::toLocal(slot.start_time, zone);
+            int duration = static_cast<int>(
+                std::chrono::duration_cast<std::chrono::minutes>(slot.end_time - slot.start_time).count());
+            if (slot_start.local_days != local.local_days ||
+                !schedule->isOpenThroughout(local.day_of_week, slot_start.minute_of_day,
+                                            slot_start.minute_of_day + duration)) {
+                continue;
+            }
+
+            AvailabilitySlot availability;
+            availability.start_time = slot.start_time;
+            availability.end_time = slot.end_time;
+            availability.is_available = slot.is_available;
+            availability.consultation_fee = doctor.getConsultationFee();
+            availability.doctor_id = doctor.getId();
+            availability.clinic_id = clinic_id;
+            slots.push_back(availability);
+        }
+    }
+
+    std::sort(slots.begin(), slots.end(),
+        [](const AvailabilitySlot& a, const AvailabilitySlot& b) { return a.start_time < b.start_time; });
+
+    return slots;
+}
+
+bool BookingService::isTimeSlotAvailable(const std::string& doctor_id,
+                                         const std::chrono::system_clock::time_point& start_time,
+                                         const std::chrono::system_clock::time_point& end_time,
+                                         const std::string& request_id) {
+    auto& partitioner = BookingPartitioner::getInstance();
+
+    // Another node owns this doctor's schedule; ask it instead of querying Postgres here
+    if (!partitioner.isLocalOwner(doctor_id)) {
+        nlohmann::json body;
+        body["doctor_id"] = doctor_id;
+        body["start_time"] = std::chrono::duration_cast<std::chrono::seconds>(start_time.time_since_epoch()).count();
+        body["end_time"] = std::chrono::duration_cast<std::chrono::seconds>(end_time.time_since_epoch()).count();
+
+        auto response = partitioner.forward(partitioner.getOwner(doctor_id), "POST",
+                                            BookingPartitioner::kSlotCheckPath, body.dump(), request_id);
+        if (response.success) {
+            try {
+                auto result = nlohmann::json::parse(response.body);
+                if (result.value("loaded", false)) {
+                    return result.value("available", false);
+                }
+            } catch (const std::exception& e) {
+                LOG_WARN("Malformed slot-check response from partition owner: {}", e.what());
+            }
+        }
+        // Owner unreachable or unable to load the schedule; Postgres decides and fails closed
+        return appointment_repository_->isTimeSlotAvailable(doctor_id, start_time, end_time);
+    }
+
+    auto& schedule_book = partitioner.getScheduleBook();
+    if (!schedule_book.isLoaded(doctor_id) && !loadOwnedDoctorSchedule(doctor_id)) {
+        return false;
+    }
+    return schedule_book.isFree(doctor_id, start_time, end_time).value_or(false);
+}
+
+void AvailabilitySlot::writeJson(utils::JsonWriter& writer) const {
+    writer.beginObject();
+    writer.field("clinic_id", clinic_id);
+    writer.field("consultation_fee", consultation_fee);
+    writer.field("doctor_id", doctor_id);
+    writer.field("end_time", end_time);
+    writer.field("is_available", is_available);
+    writer.field("start_time", start_time);
+    writer.endObject();
+}
+
+// Search and Discovery
+
+std::vector<std::unique_ptr<models::Doctor>> BookingService::getNearbyDoctors(double latitude, double longitude,
+                                                                              double radius_km) {
+    std::vector<std::unique_ptr<models::Doctor>> doctors;
+
+    std::vector<std::string> doctor_ids;
+    for (const auto& doctor_id : ClinicRegistry::getInstance().getDoctorsNear(latitude, longitude, radius_km)) {
+        doctor_ids.push_back(doctor_id.toString());
+    }
+
+    // Keep the registry's nearest-first order
+    for (auto& doctor : loadDoctors(doctor_ids)) {
+        if (doctor->isActive()) {
+            doctors.push_back(std::move(doctor));
+        }
+    }
+    return doctors;
+}
+
+// Emergency Booking
+
+BookingResult BookingService::bookEmergencyAppointment(const BookingRequest& request) {
+    BookingResult result;
+    auto& dispatch = EmergencyDispatchIndex::getInstance();
+
+    // Reject malformed ids before a doctor is taken off the free list
+    if (!utils::Uuid::parse(request.user_id) ||
+        (!request.clinic_id.empty() && !utils::Uuid::parse(request.clinic_id))) {
+        result.error = BookingError::VALIDATION_ERROR;
+        result.message = "Invalid user or clinic id";
+        return result;
+    }
+
+    // Claim the nearest free doctor up front; the CAS guarantees no other emergency gets them
+    auto candidate = dispatch.claimNearest(request.city, request.latitude, request.longitude);
+    if (!candidate) {
+        result.error = BookingError::EMERGENCY_BOOKING_FAILED;
+        result.message = "No emergency doctor available nearby";
+        LOG_WARN("Emergency dispatch found no free doctor in {}", request.city);
+        return result;
+    }
+
+    // Hands the doctor back on every exit, thrown or returned, until the appointment is stored
+    struct ClaimGuard {
+        EmergencyDispatchIndex& dispatch;
+        const EmergencyCandidate& candidate;
+        bool kept = false;
+        ~ClaimGuard() {
+            if (!kept) dispatch.release(candidate);
+        }
+    } claim{dispatch, *candidate};
+
+    auto doctor_result = doctor_repository_->findById(candidate->doctor_id);
+    if (!doctor_result.hasData()) {
+        result.error = BookingError::DOCTOR_NOT_FOUND;
+        result.message = "Dispatched doctor no longer exists";
+        return result;
+    }
+    const auto doctor = doctor_result.getFirst();
+
+    auto now = std::chrono::system_clock::now();
+    models::Appointment appointment;
+    appointment.setUserId(request.user_id);
+    appointment.setDoctorId(candidate->doctor_id);
+    appointment.setClinicId(request.clinic_id.empty() ? candidate->clinic_id : request.clinic_id);
+    appointment.setAppointmentDate(now);
+    appointment.setStartTime(now);
+    appointment.setEndTime(now + std::chrono::minutes(std::max(doctor.getConsultationDuration(), 1)));
+    appointment.setType(request.type);
+    appointment.setSymptoms(request.symptoms);
+    appointment.setNotes(request.notes);
+    appointment.setEmergency(true);
+    appointment.setConsultationFee(doctor.getConsultationFee());
+    appointment.setBookedAt(now);
+    appointment.confirmAppointment();
+
+    // Tie the claim to this appointment before its status events can arrive. A claim that
+    // expired meanwhile may already belong to another emergency, so the doctor is not ours
+    if (!dispatch.bindClaim(*candidate, appointment.getId())) {
+        result.error = BookingError::EMERGENCY_BOOKING_FAILED;
+        result.message = "Emergency dispatch timed out, please retry";
+        LOG_WARN("Emergency claim on doctor {} expired before the appointment was stored", candidate->doctor_id);
+        return result;
+    }
+
+    auto created = appointment_repository_->create(appointment);
+    if (!created.success) {
+        result.error = BookingError::DATABASE_ERROR;
+        result.message = created.error_message;
+        LOG_ERROR("Failed to store emergency appointment: {}", created.error_message);
+        return result;
+    }
+
+    claim.kept = true;
+    result.error = BookingError::SUCCESS;
+    result.message = "Emergency appointment booked";
+    result.appointment = std::make_unique<models::Appointment>(created.getFirst());
+    LOG_INFO("Emergency appointment dispatched to doctor {} ({:.1f} km)", candidate->doctor_id, candidate->distance_km);
+    return result;
+}
+
+std::vector<std::unique_ptr<models::Doctor>> BookingService::getEmergencyAvailableDoctors(const std::string& city) {
+    return loadDoctors(EmergencyDispatchIndex::getInstance().getFreeDoctorIds(city));
+}
+
+// Appointment Status Management
+
+void BookingService::onAppointmentStatusChanged(const models::Appointment& appointment) {
+    EmergencyDispatchIndex::getInstance().onAppointmentStatusChanged(appointment);
+
+    // Writes made here for a doctor owned elsewhere must reach the owner's book
+    auto& partitioner = BookingPartitioner::getInstance();
+    const std::string& doctor_id = appointment.getDoctorId();
+    if (!partitioner.isLocalOwner(doctor_id)) {
+        partitioner.invalidateRemoteSchedule(doctor_id);
+        return;
+    }
+
+    // Only a loaded schedule is trusted by slot checks; unloaded ones are read fresh on first use
+    auto& schedule_book = partitioner.getScheduleBook();
+    if (!schedule_book.isLoaded(doctor_id)) {
+        return;
+    }
+    schedule_book.release(doctor_id, appointment.getId());  // Drops the old interval on reschedule too
+
+    if (holdsSlot(appointment.getStatus())) {
+        if (!schedule_book.reserve(doctor_id, {appointment.getId(), appointment.getStartTime(), appointment.getEndTime()})) {
+            // Postgres holds an overlap the book did not expect; reload rather than guess
+            LOG_WARN("Appointment {} overlaps the cached schedule for doctor {}; evicting", appointment.getId(), doctor_id);
+            schedule_book.evict(doctor_id);
+        }
+    }
+}
+
+void BookingService::onAppointmentRemoved(const std::string& appointment_id) {
+    EmergencyDispatchIndex::getInstance().onAppointmentRemoved(appointment_id);
+    BookingPartitioner::getInstance().getScheduleBook().releaseAppointment(appointment_id);
+}
+
+// Validation and Business Rules
+
+bool BookingService::isClinicOperational(const std::string& clinic_id,
+                                         const std::chrono::system_clock::time_point& time) {
+    auto schedule = ClinicRegistry::getInstance().findSchedule(clinic_id);
+    return schedule && schedule->isOpenAt(time);
+}
+
+// Helper methods
+
+std::vector<std::unique_ptr<models::Doctor>> BookingService::loadDoctors(const std::vector<std::string>& doctor_ids) {
+    auto result = doctor_repository_->findByIds(doctor_ids);
+
+    std::unordered_map<std::string, models::Doctor*> by_id;
+    for (auto& doctor : result.data) {
+        by_id[doctor.getId()] = &doctor;
+    }
+
+    std::vector<std::unique_ptr<models::Doctor>> doctors;
+    doctors.reserve(result.data.size());
+    for (const auto& doctor_id : doctor_ids) {
+        auto it = by_id.find(doctor_id);
+        if (it != by_id.end()) {
+            doctors.push_back(std::make_unique<models::Doctor>(std::move(*it->second)));
+            by_id.erase(it);  // Listed twice, returned once
+        }
+    }
+    return doctors;
+}
+
+BookingResult BookingService::forwardBooking(const BookingRequest& request, const std::string& request_id,
+                                             bool& delivered) {
+    auto& partitioner = BookingPartitioner::getInstance();
+    delivered = false;
+
+    nlohmann::json body;
+    body["user_id"] = request.user_id;
+    body["doctor_id"] = request.doctor_id;
+    body["clinic_id"] = request.clinic_id;
+    body["appointment_date"] = utils::civil::toUnixSeconds(request.preferred_date);
+    body["start_time"] = utils::civil::toUnixSeconds(request.preferred_start_time);
+    body["type"] = models::appointmentTypeToString(request.type);
+    body["symptoms"] = request.symptoms;
+    body["notes"] = request.notes;
+
+    BookingResult result;
+    auto response = partitioner.forward(partitioner.getOwner(request.doctor_id), "POST",
+                                        BookingPartitioner::kBookPath, body.dump(), request_id);
+    if (!response.success) {
+        return result;
+    }
+
+    try {
+        auto json = nlohmann::json::parse(response.body);
+        result.error = static_cast<BookingError>(json.at("error").get<int>());
+        result.message = json.value("message", "");
+        result.payment_url = json.value("payment_url", "");
+        if (json.contains("appointment")) {
+            result.appointment = std::make_unique<models::Appointment>();
+            result.appointment->fromJson(json["appointment"]);
+        }
+        delivered = true;
+    } catch (const std::exception& e) {
+        LOG_WARN("Malformed booking response from partition owner: {}", e.what());
+    }
+    return result;
+}
+
+BookingError BookingService::checkBookable(const models::Doctor& doctor, const std::string& clinic_id,
+                                           const std::chrono::system_clock::time_point& start_time,
+                                           const std::chrono::system_clock::time_point& end_time,
+                                           models::AppointmentType type, std::string& message) const {
+    if (!doctor.isVerified()) {
+        message = "Doctor is not verified";
+        return BookingError::DOCTOR_NOT_VERIFIED;
+    }
+
+    auto clinic = utils::Uuid::parse(clinic_id);
+    const auto& clinics = doctor.getClinicUuids();
+    if (!clinic || std::find(clinics.begin(), clinics.end(), *clinic) == clinics.end()) {
+        message = "Doctor does not practice at this clinic";
+        return BookingError::CLINIC_NOT_FOUND;
+    }
+
+    auto now = std::chrono::system_clock::now();
+    if (start_time <= now) {
+        message = "Appointment must be in the future";
+        return BookingError::INVALID_TIME_SLOT;
+    }
+    if (start_time > now + std::chrono::hours(24) * config_.advance_booking_days) {
+        message = "Appointments can be booked at most " + std::to_string(config_.advance_booking_days) + " days ahead";
+        return BookingError::INVALID_TIME_SLOT;
+    }
+
+    auto consultation = type == models::AppointmentType::ONLINE ? models::ConsultationType::ONLINE
+                                                                : models::ConsultationType::OFFLINE;
+    if (!doctor.supportsConsultationType(consultation) && !doctor.supportsConsultationType(models::ConsultationType::BOTH)) {
+        message = "Doctor does not offer " + models::consultationTypeToString(consultation) + " consultations";
+        return BookingError::DOCTOR_NOT_AVAILABLE;
+    }
+    if (!doctor.isWorkingThroughout(start_time, end_time)) {
+        message = "Outside the doctor's working hours";
+        return BookingError::DOCTOR_NOT_AVAILABLE;
+    }
+
+    // Online consultations do not need the clinic to be open
+    if (type == models::AppointmentType::OFFLINE) {
+        auto schedule = ClinicRegistry::getInstance().findSchedule(clinic->toString());
+        if (!schedule) {
+            message = "Clinic not found";
+            return BookingError::CLINIC_NOT_FOUND;
+        }
+        const auto& zone = schedule->zone ? *schedule->zone : utils::civil::TimeZoneRegistry::getInstance().getDefault();
+        auto local = utils::civil::toLocal(start_time, zone);
+        int duration = static_cast<int>(std::chrono::duration_cast<std::chrono::minutes>(end_time - start_time).count());
+        if (!schedule->isOpenThroughout(local.day_of_week, local.minute_of_day, local.minute_of_day + duration)) {
+            message = "Clinic is closed at that time";
+            return BookingError::CLINIC_CLOSED;
+        }
+    }
+    return BookingError::SUCCESS;
+}
+
+PaymentResponse BookingService::createPaymentOrder(const PaymentRequest& request) {
+    auto payment_start = std::chrono::steady_clock::now();
+    PaymentResponse payment;
+    {
+        utils::TraceSpan span("payment.create_order", utils::SpanKind::CLIENT);
+        payment = payment_service_->createPaymentOrder(request);
+        if (payment.error != PaymentError::SUCCESS) span.setError();
+    }
+    paymentLatency("create_order").record(std::chrono::steady_clock::now() - payment_start);
+    return payment;
+}
+
+void BookingService::cancelUnpaid(const std::vector<models::Appointment>& appointments, const std::string& reason) {
+    for (auto appointment : appointments) {
+        auto payment_info = appointment.getPaymentInfo();
+        payment_info.status = models::PaymentStatus::FAILED;
+        appointment.setPaymentInfo(payment_info);
+        appointment.cancelAppointment(models::CancellationReason::TECHNICAL_ISSUE, reason, "");
+
+        // update() reports the change, which frees the slot in the schedule book and dispatch index
+        auto updated = appointment_repository_->update(appointment);
+        if (!updated.success) {
+            LOG_ERROR("Failed to cancel unpaid appointment {}: {}", appointment.getId(), updated.error_message);
+        }
+    }
+}
+
+bool BookingService::loadOwnedDoctorSchedule(const std::string& doctor_id) {
+    database::AppointmentRepository repository;
+    auto appointments = repository.findByDoctorId(doctor_id);
+    if (!appointments.success) {
+        LOG_ERROR("Failed to load schedule for doctor {}: {}", doctor_id, appointments.error_message);
+        return false;
+    }
+
+    std::vector<DoctorScheduleBook::BookedInterval> intervals;
+    for (const auto& appointment : appointments.data) {
+        if (holdsSlot(appointment.getStatus())) {
+            intervals.push_back({appointment.getId(), appointment.getStartTime(), appointment.getEndTime()});
+        }
+    }
+
+    BookingPartitioner::getInstance().getScheduleBook().load(doctor_id, std::move(intervals));
+    return true;
+}
+
+} // namespace healthcare::services
\ No newline at end of file
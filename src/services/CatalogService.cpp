@@ -0,0 +1,208 @@
+#include "../../include/services/CatalogService.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <nlohmann/json.hpp>
+
+namespace healthcare::services {
+
+namespace {
+
+std::vector<std::string> parseStringArray(const nlohmann::json& values) {
+    std::vector<std::string> strings;
+    if (!values.is_array()) {
+        return strings;
+    }
+    for (const auto& value : values) {
+        if (value.is_string()) {
+            strings.push_back(value.get<std::string>());
+        }
+    }
+    return strings;
+}
+
+} // namespace
+
+CatalogService& CatalogService::getInstance() {
+    static CatalogService instance;
+    return instance;
+}
+
+CatalogService::CatalogService() {
+    CatalogSnapshot::Builder empty;
+    current_ = empty.build(0);
+}
+
+CatalogService::~CatalogService() {
+    stop();
+}
+
+void CatalogService::configure(const CatalogConfig& config) {
+    config_ = config;
+}
+
+bool CatalogService::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // Readers fall back to the empty snapshot until a build succeeds
+    if (!rebuild()) {
+        LOG_WARN("Initial catalog build failed, retrying in {}s", config_.refresh_interval_seconds);
+    }
+
+    rebuild_thread_ = std::thread(&CatalogService::rebuildLoop, this);
+    LOG_INFO("Catalog service started");
+    return true;
+}
+
+void CatalogService::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    rebuild_cv_.notify_all();
+    if (rebuild_thread_.joinable()) {
+        rebuild_thread_.join();
+    }
+}
+
+// Snapshot access
+
+std::shared_ptr<const CatalogSnapshot> CatalogService::snapshot() const {
+    // Each thread re-loads the shared pointer only when the version moves, so the
+    // steady-state read is one atomic load plus a reference count increment
+    thread_local std::shared_ptr<const CatalogSnapshot> cached;
+    thread_local std::uint64_t cached_version = UINT64_MAX;
+
+    std::uint64_t version = version_.load(std::memory_order_acquire);
+    if (version != cached_version) {
+        cached = std::atomic_load(&current_);
+        cached_version = cached->version();
+    }
+    return cached;
+}
+
+void CatalogService::publish(std::shared_ptr<const CatalogSnapshot> snapshot) {
+    std::uint64_t version = snapshot->version();
+    size_t doctors = snapshot->doctorCount();
+    size_t clinics = snapshot->clinicCount();
+    size_t pool_bytes = snapshot->stringPoolBytes();
+
+    std::atomic_store(&current_, std::move(snapshot));
+    version_.store(version, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.version = version;
+    stats_.doctors = doctors;
+    stats_.clinics = clinics;
+    stats_.string_pool_bytes = pool_bytes;
+}
+
+// Building
+
+bool CatalogService::rebuild() {
+    auto started = std::chrono::steady_clock::now();
+    CatalogSnapshot::Builder builder;
+
+    try {
+        loadClinics(builder);
+        loadDoctors(builder);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Catalog rebuild failed: {}", e.what());
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.failed_rebuilds++;
+        return false;
+    }
+
+    publish(builder.build(version_.load(std::memory_order_relaxed) + 1));
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.rebuilds++;
+    stats_.last_build_ms = elapsed_ms;
+    stats_.last_rebuild = std::chrono::system_clock::now();
+    return true;
+}
+
+void CatalogService::loadClinics(CatalogSnapshot::Builder& builder) const {
+    auto result = database::DatabaseManager::getInstance().executeQuery(R"(
+        SELECT id, name, COALESCE(address->>'city', ''),
+               COALESCE((address->>'latitude')::double precision, 0),
+               COALESCE((address->>'longitude')::double precision, 0),
+               status, COALESCE(rating, 0), COALESCE(has_emergency_services, FALSE)
+        FROM clinics
+        WHERE is_deleted = FALSE
+    )");
+
+    for (const auto& row : result) {
+        CatalogClinicRecord clinic;
+        clinic.id = row[0].as<std::string>();
+        clinic.name = row[1].as<std::string>();
+        clinic.city = row[2].as<std::string>();
+        clinic.latitude = row[3].as<double>();
+        clinic.longitude = row[4].as<double>();
+        clinic.status = models::stringToClinicStatus(row[5].is_null() ? "" : row[5].as<std::string>());
+        clinic.rating = row[6].as<double>();
+        clinic.has_emergency_services = row[7].as<bool>();
+        builder.addClinic(clinic);
+    }
+}
+
+void CatalogService::loadDoctors(CatalogSnapshot::Builder& builder) const {
+    // Arrays come back as JSON text so one parser handles every list column
+    auto result = database::DatabaseManager::getInstance().executeQuery(R"(
+        SELECT d.id, u.first_name || ' ' || u.last_name,
+               COALESCE(d.specializations, '[]'::jsonb)::text,
+               COALESCE(array_to_json(d.clinic_ids), '[]'::json)::text,
+               COALESCE(array_to_json(d.consultation_types), '[]'::json)::text,
+               d.status, COALESCE(d.consultation_fee, 0), COALESCE(d.rating, 0),
+               COALESCE(d.total_reviews, 0), COALESCE(d.is_available_today, FALSE)
+        FROM doctors d
+        JOIN users u ON u.id = d.user_id
+        WHERE d.is_deleted = FALSE AND u.is_deleted = FALSE
+    )");
+
+    for (const auto& row : result) {
+        CatalogDoctorRecord doctor;
+        doctor.id = row[0].as<std::string>();
+        doctor.name = row[1].as<std::string>();
+
+        for (const auto& specialization : nlohmann::json::parse(row[2].as<std::string>())) {
+            if (specialization.is_object() && specialization.contains("name")) {
+                doctor.specializations.push_back(specialization["name"].get<std::string>());
+            }
+        }
+        doctor.clinic_ids = parseStringArray(nlohmann::json::parse(row[3].as<std::string>()));
+        for (const auto& type : parseStringArray(nlohmann::json::parse(row[4].as<std::string>()))) {
+            doctor.consultation_types.push_back(models::stringToConsultationType(type));
+        }
+
+        doctor.status = models::stringToDoctorStatus(row[5].is_null() ? "" : row[5].as<std::string>());
+        doctor.consultation_fee = row[6].as<double>();
+        doctor.rating = row[7].as<double>();
+        doctor.total_reviews = row[8].as<int>();
+        doctor.is_available_today = row[9].as<bool>();
+        builder.addDoctor(doctor);
+    }
+}
+
+void CatalogService::rebuildLoop() {
+    std::unique_lock<std::mutex> lock(rebuild_mutex_);
+
+    while (running_) {
+        rebuild_cv_.wait_for(lock, std::chrono::seconds(config_.refresh_interval_seconds),
+                             [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        rebuild();
+        lock.lock();
+    }
+}
+
+CatalogStats CatalogService::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "../../include/services/CatalogSnapshot.h"
+#include <algorithm>
+
+namespace healthcare::services {
+
+// Builder
+
+CatalogSnapshot::Builder::Builder()
+    : snapshot_(new CatalogSnapshot()) {
+}
+
+void CatalogSnapshot::Builder::reserve(size_t doctors, size_t clinics) {
+    CatalogSnapshot& s = *snapshot_;
+    s.doctor_ids_.reserve(doctors);
+    s.doctor_names_.reserve(doctors);
+    s.doctor_fees_.reserve(doctors);
+    s.doctor_ratings_.reserve(doctors);
+    s.doctor_review_counts_.reserve(doctors);
+    s.doctor_statuses_.reserve(doctors);
+    s.consultation_masks_.reserve(doctors);
+    s.available_today_.reserve(doctors);
+    s.specialization_offsets_.reserve(doctors + 1);
+    s.clinic_offsets_.reserve(doctors + 1);
+
+    s.clinic_ids_.reserve(clinics);
+    s.clinic_names_.reserve(clinics);
+    s.clinic_cities_.reserve(clinics);
+    s.clinic_coordinates_.reserve(clinics);
+    s.clinic_ratings_.reserve(clinics);
+    s.clinic_statuses_.reserve(clinics);
+    s.emergency_services_.reserve(clinics);
+}
+
+void CatalogSnapshot::Builder::addClinic(const CatalogClinicRecord& clinic) {
+    CatalogSnapshot& s = *snapshot_;
+    s.clinic_ids_.push_back(s.strings_.intern(clinic.id));
+    s.clinic_names_.push_back(s.strings_.intern(clinic.name));
+    s.clinic_cities_.push_back(s.strings_.intern(clinic.city));
+    s.clinic_coordinates_.add(clinic.latitude, clinic.longitude);
+    s.clinic_ratings_.push_back(static_cast<float>(clinic.rating));
+    s.clinic_statuses_.push_back(clinic.status);
+    s.emergency_services_.push_back(clinic.has_emergency_services ? 1 : 0);
+}
+
+void CatalogSnapshot::Builder::addDoctor(const CatalogDoctorRecord& doctor) {
+    CatalogSnapshot& s = *snapshot_;
+    if (s.specialization_offsets_.empty()) {
+        s.specialization_offsets_.push_back(0);
+        s.clinic_offsets_.push_back(0);
+    }
+
+    s.doctor_ids_.push_back(s.strings_.intern(doctor.id));
+    s.doctor_names_.push_back(s.strings_.intern(doctor.name));
+    s.doctor_fees_.push_back(static_cast<float>(doctor.consultation_fee));
+    s.doctor_ratings_.push_back(static_cast<float>(doctor.rating));
+    s.doctor_review_counts_.push_back(static_cast<std::uint32_t>(std::max(doctor.total_reviews, 0)));
+    s.doctor_statuses_.push_back(doctor.status);
+    s.available_today_.push_back(doctor.is_available_today ? 1 : 0);
+
+    std::uint8_t mask = 0;
+    for (auto type : doctor.consultation_types) {
+        if (type == models::ConsultationType::ONLINE) mask |= kOnline;
+        else if (type == models::ConsultationType::OFFLINE) mask |= kOffline;
+        else mask |= kOnline | kOffline;
+    }
+    s.consultation_masks_.push_back(mask);
+
+    for (const auto& specialization : doctor.specializations) {
+        s.specializations_.push_back(s.strings_.intern(specialization));
+    }
+    s.specialization_offsets_.push_back(static_cast<std::uint32_t>(s.specializations_.size()));
+
+    for (const auto& clinic_id : doctor.clinic_ids) {
+        pending_clinic_refs_.push_back(s.strings_.intern(clinic_id));
+    }
+    s.clinic_offsets_.push_back(static_cast<std::uint32_t>(pending_clinic_refs_.size()));
+}
+
+std::shared_ptr<const CatalogSnapshot> CatalogSnapshot::Builder::build(std::uint64_t version) {
+    CatalogSnapshot& s = *snapshot_;
+    if (s.specialization_offsets_.empty()) {
+        s.specialization_offsets_.push_back(0);
+        s.clinic_offsets_.push_back(0);
+    }
+
+    s.doctor_rows_.assign(s.strings_.size(), kNoRow);
+    for (std::uint32_t row = 0; row < s.doctor_ids_.size(); ++row) {
+        s.doctor_rows_[s.doctor_ids_[row]] = row;
+    }
+    s.clinic_rows_.assign(s.strings_.size(), kNoRow);
+    for (std::uint32_t row = 0; row < s.clinic_ids_.size(); ++row) {
+        s.clinic_rows_[s.clinic_ids_[row]] = row;
+    }
+
+    // Resolve clinic ids to rows, dropping references to clinics not in the catalog
+    s.doctor_clinics_.reserve(pending_clinic_refs_.size());
+    std::uint32_t begin = 0;
+    for (size_t doctor = 0; doctor < s.doctor_ids_.size(); ++doctor) {
+        std::uint32_t end = s.clinic_offsets_[doctor + 1];
+        for (std::uint32_t ref = begin; ref < end; ++ref) {
+            std::uint32_t row = s.clinic_rows_[pending_clinic_refs_[ref]];
+            if (row != kNoRow) {
+                s.doctor_clinics_.push_back(row);
+            }
+        }
+        begin = end;
+        s.clinic_offsets_[doctor + 1] = static_cast<std::uint32_t>(s.doctor_clinics_.size());
+    }
+    pending_clinic_refs_.clear();
+
+    s.strings_.shrinkToFit();
+    s.version_ = version;
+    s.built_at_ = std::chrono::system_clock::now();
+
+    std::shared_ptr<const CatalogSnapshot> snapshot(snapshot_.release());
+    snapshot_.reset(new CatalogSnapshot());
+    return snapshot;
+}
+
+// Lookups
+
+std::uint32_t CatalogSnapshot::findDoctor(std::string_view doctor_id) const {
+    auto id = strings_.find(doctor_id);
+    return id ? doctor_rows_[*id] : kNoRow;
+}
+
+std::uint32_t CatalogSnapshot::findClinic(std::string_view clinic_id) const {
+    auto id = strings_.find(clinic_id);
+    return id ? clinic_rows_[*id] : kNoRow;
+}
+
+CatalogIdRange CatalogSnapshot::doctorSpecializations(std::uint32_t row) const {
+    return CatalogIdRange(specializations_.data() + specialization_offsets_[row],
+                          specializations_.data() + specialization_offsets_[row + 1]);
+}
+
+CatalogIdRange CatalogSnapshot::doctorClinics(std::uint32_t row) const {
+    return CatalogIdRange(doctor_clinics_.data() + clinic_offsets_[row],
+                          doctor_clinics_.data() + clinic_offsets_[row + 1]);
+}
+
+} // namespace healthcare::services
\ No newline at end of file
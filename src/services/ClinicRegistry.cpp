@@ -0,0 +1,210 @@
+#include "../../include/services/ClinicRegistry.h"
+#include "../../include/services/DoctorSearchService.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <nlohmann/json.hpp>
+#include <unordered_set>
+
+namespace healthcare::services {
+
+namespace {
+
+// Shaped for Clinic::fromJson so working hours compile exactly as they do for API input
+constexpr const char* kClinicQuery = R"(
+    SELECT json_build_object(
+               'id', id, 'name', name, 'status', COALESCE(status, ''),
+               'address', COALESCE(address, '{}'::jsonb),
+               'working_hours', COALESCE(working_hours, '[]'::jsonb),
+               'doctor_ids', COALESCE(array_to_json(doctor_ids), '[]'::json),
+               'has_emergency_services', COALESCE(has_emergency_services, FALSE))::text
+    FROM clinics
+    WHERE is_deleted = FALSE
+)";
+
+} // namespace
+
+ClinicRegistry& ClinicRegistry::getInstance() {
+    static ClinicRegistry instance;
+    return instance;
+}
+
+ClinicRegistry::~ClinicRegistry() {
+    stop();
+}
+
+void ClinicRegistry::configure(const ClinicRegistryConfig& config) {
+    config_ = config;
+}
+
+bool ClinicRegistry::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // Listings come back empty until a load succeeds, so keep retrying in the background
+    if (!reload()) {
+        LOG_WARN("Initial clinic load failed, retrying in {}s", config_.refresh_interval_seconds);
+    }
+
+    refresh_thread_ = std::thread(&ClinicRegistry::refreshLoop, this);
+    LOG_INFO("Clinic registry started with {} clinics", size());
+    return true;
+}
+
+void ClinicRegistry::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    refresh_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+        refresh_thread_.join();
+    }
+}
+
+// Registry maintenance
+
+bool ClinicRegistry::reload() {
+    std::vector<models::Clinic> clinics;
+    try {
+        clinics = loadClinics();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Clinic load failed: {}", e.what());
+        return false;
+    }
+
+    std::unordered_set<std::string> listed;
+    for (const auto& clinic : clinics) {
+        listed.insert(clinic.getId());
+        registerClinic(clinic);
+    }
+
+    std::vector<std::string> stale;
+    {
+        std::shared_lock<std::shared_mutex> lock(doctors_mutex_);
+        for (const auto& [clinic_id, doctors] : doctor_ids_) {
+            std::string id = clinic_id.toString();
+            if (listed.count(id) == 0) {
+                stale.push_back(std::move(id));
+            }
+        }
+    }
+    for (const auto& clinic_id : stale) {
+        removeClinic(clinic_id);
+    }
+    return true;
+}
+
+void ClinicRegistry::registerClinic(const models::Clinic& clinic) {
+    if (!clinic.isOperational()) {
+        removeClinic(clinic.getId());
+        return;
+    }
+
+    if (clinic.getSchedule().truncated_days != 0) {
+        LOG_WARN("Clinic {} has more than {} opening intervals on some days; the later ones are ignored",
+                 clinic.getId(), models::ClinicSchedule::kMaxIntervalsPerDay);
+    }
+    schedules_.upsert(clinic.getId(), clinic.getSchedule());
+    locations_.upsert(clinic.getId(), clinic.getAddress().latitude, clinic.getAddress().longitude);
+    DoctorSearchService::getInstance().indexClinic(clinic);
+
+    std::vector<utils::Uuid> doctor_ids;
+    for (const auto& doctor_id : clinic.getDoctorIds()) {
+        if (auto id = utils::Uuid::parse(doctor_id)) {
+            doctor_ids.push_back(*id);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(doctors_mutex_);
+    doctor_ids_[clinic.getUuid()] = std::move(doctor_ids);
+}
+
+void ClinicRegistry::removeClinic(const std::string& clinic_id) {
+    schedules_.remove(clinic_id);
+    locations_.remove(clinic_id);
+    DoctorSearchService::getInstance().removeClinic(clinic_id);
+
+    if (auto id = utils::Uuid::parse(clinic_id)) {
+        std::unique_lock<std::shared_mutex> lock(doctors_mutex_);
+        doctor_ids_.erase(*id);
+    }
+}
+
+// Queries
+
+std::optional<models::ClinicSchedule> ClinicRegistry::findSchedule(const std::string& clinic_id) const {
+    return schedules_.find(clinic_id);
+}
+
+std::vector<std::uint8_t> ClinicRegistry::getClinicsOpenAt(const std::vector<std::string>& clinic_ids,
+                                                           const std::chrono::system_clock::time_point& time) const {
+    return schedules_.evaluateOpenAt(clinic_ids, time);
+}
+
+std::vector<std::string> ClinicRegistry::getOpenClinicIds(const std::chrono::system_clock::time_point& time) const {
+    return schedules_.getOpenClinicIds(time);
+}
+
+std::vector<utils::Uuid> ClinicRegistry::getDoctorsNear(double latitude, double longitude, double radius_km) const {
+    // Clinics come back nearest first; a doctor is listed at their closest clinic
+    auto hits = locations_.queryRadius(latitude, longitude, radius_km);
+
+    std::vector<utils::Uuid> doctors;
+    std::unordered_set<utils::Uuid> seen;
+    std::shared_lock<std::shared_mutex> lock(doctors_mutex_);
+    for (const auto& hit : hits) {
+        auto clinic_id = utils::Uuid::parse(hit.id);
+        if (!clinic_id) continue;
+
+        auto it = doctor_ids_.find(*clinic_id);
+        if (it == doctor_ids_.end()) continue;
+
+        for (const auto& doctor_id : it->second) {
+            if (seen.insert(doctor_id).second) {
+                doctors.push_back(doctor_id);
+            }
+        }
+    }
+    return doctors;
+}
+
+size_t ClinicRegistry::size() const {
+    return schedules_.size();
+}
+
+// Loading
+
+std::vector<models::Clinic> ClinicRegistry::loadClinics() {
+    auto result = database::DatabaseManager::getInstance().executeQuery(kClinicQuery);
+
+    std::vector<models::Clinic> clinics;
+    clinics.reserve(result.size());
+    for (const auto& row : result) {
+        // One malformed working_hours document should not hide every other clinic
+        try {
+            models::Clinic clinic;
+            clinic.fromJson(nlohmann::json::parse(row[0].as<std::string>()));
+            clinics.push_back(std::move(clinic));
+        } catch (const std::exception& e) {
+            LOG_WARN("Skipping clinic row that failed to parse: {}", e.what());
+        }
+    }
+    return clinics;
+}
+
+void ClinicRegistry::refreshLoop() {
+    std::unique_lock<std::mutex> lock(refresh_mutex_);
+
+    while (running_) {
+        refresh_cv_.wait_for(lock, std::chrono::seconds(config_.refresh_interval_seconds),
+                             [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        reload();
+        lock.lock();
+    }
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "../../include/services/DoctorFacetIndex.h"
+#include <algorithm>
+#include <mutex>
+
+namespace healthcare::services {
+
+namespace {
+
+void normalizeValues(std::vector<std::string>& values) {
+    values.erase(std::remove(values.begin(), values.end(), std::string()), values.end());
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+} // namespace
+
+DoctorFacetIndex& DoctorFacetIndex::getInstance() {
+    static DoctorFacetIndex instance;
+    return instance;
+}
+
+// Index maintenance
+
+void DoctorFacetIndex::upsertDoctor(const models::Doctor& doctor, const std::vector<std::string>& cities) {
+    if (doctor.isDeleted() || !doctor.isActive()) {
+        removeDoctor(doctor.getId());
+        return;
+    }
+
+    FacetValues values;
+    for (const auto& specialization : doctor.getSpecializations()) {
+        values[static_cast<size_t>(Facet::SPECIALIZATION)].push_back(specialization.name);
+    }
+    values[static_cast<size_t>(Facet::CITY)] = cities;
+
+    // BOTH is not a facet value of its own: such doctors match either filter
+    auto& types = values[static_cast<size_t>(Facet::CONSULTATION_TYPE)];
+    for (auto type : doctor.getConsultationTypes()) {
+        if (type == models::ConsultationType::BOTH) {
+            types.push_back(models::consultationTypeToString(models::ConsultationType::ONLINE));
+            types.push_back(models::consultationTypeToString(models::ConsultationType::OFFLINE));
+        } else {
+            types.push_back(models::consultationTypeToString(type));
+        }
+    }
+    values[static_cast<size_t>(Facet::FEE_BAND)].push_back(feeBand(doctor.getConsultationFee()));
+
+    for (auto& facet_values : values) {
+        normalizeValues(facet_values);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = postings_.find(doctor.getUuid());
+    if (it != postings_.end()) {
+        if (it->second.values == values) {
+            return;
+        }
+        unpost(it->second.ordinal, it->second.values);
+        it->second.values = std::move(values);
+        post(it->second.ordinal, it->second.values);
+        return;
+    }
+
+    std::uint32_t ordinal;
+    if (!free_ordinals_.empty()) {
+        ordinal = free_ordinals_.back();
+        free_ordinals_.pop_back();
+        ordinal_ids_[ordinal] = doctor.getUuid();
+    } else {
+        ordinal = static_cast<std::uint32_t>(ordinal_ids_.size());
+        ordinal_ids_.push_back(doctor.getUuid());
+    }
+
+    Posting& posting = postings_[doctor.getUuid()];
+    posting.ordinal = ordinal;
+    posting.values = std::move(values);
+    post(ordinal, posting.values);
+    all_.add(ordinal);
+}
+
+bool DoctorFacetIndex::updateCities(const std::string& doctor_id, const std::vector<std::string>& cities) {
+    std::vector<std::string> normalized = cities;
+    normalizeValues(normalized);
+
+    auto id = utils::Uuid::parse(doctor_id);
+    if (!id) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = postings_.find(*id);
+    if (it == postings_.end()) {
+        return false;
+    }
+
+    auto& current = it->second.values[static_cast<size_t>(Facet::CITY)];
+    if (current == normalized) {
+        return true;
+    }
+
+    auto& city_bitmaps = facets_[static_cast<size_t>(Facet::CITY)];
+    for (const auto& city : current) {
+        auto bitmap = city_bitmaps.find(city);
+        if (bitmap != city_bitmaps.end() && bitmap->second.remove(it->second.ordinal) && bitmap->second.empty()) {
+            city_bitmaps.erase(bitmap);
+        }
+    }
+    for (const auto& city : normalized) {
+        city_bitmaps[city].add(it->second.ordinal);
+    }
+    current = std::move(normalized);
+    return true;
+}
+
+bool DoctorFacetIndex::removeDoctor(const std::string& doctor_id) {
+    auto id = utils::Uuid::parse(doctor_id);
+    if (!id) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = postings_.find(*id);
+    if (it == postings_.end()) {
+        return false;
+    }
+
+    std::uint32_t ordinal = it->second.ordinal;
+    unpost(ordinal, it->second.values);
+    all_.remove(ordinal);
+    ordinal_ids_[ordinal] = utils::Uuid();
+    free_ordinals_.push_back(ordinal);
+    postings_.erase(it);
+    return true;
+}
+
+void DoctorFacetIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto& facet : facets_) {
+        facet.clear();
+    }
+    all_.clear();
+    postings_.clear();
+    ordinal_ids_.clear();
+    free_ordinals_.clear();
+}
+
+// Queries
+
+FacetResult DoctorFacetIndex::query(const FacetQuery& query) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // Candidate ids are parsed once; they are reused below to keep relevance order
+    std::vector<std::uint32_t> candidate_ordinals;
+    utils::RoaringBitmap base;
+    if (query.candidates) {
+        candidate_ordinals.reserve(query.candidates->size());
+        for (const auto& doctor_id : *query.candidates) {
+            auto id = utils::Uuid::parse(doctor_id);
+            if (!id) continue;
+
+            auto it = postings_.find(*id);
+            if (it != postings_.end()) {
+                candidate_ordinals.push_back(it->second.ordinal);
+                base.add(it->second.ordinal);
+            }
+        }
+    } else {
+        base = all_;
+    }
+
+    // Union of the selected values per facet
+    std::array<std::optional<utils::RoaringBitmap>, kFacetCount> selections;
+    for (size_t facet = 0; facet < kFacetCount; ++facet) {
+        if (query.selected[facet].empty()) continue;
+
+        utils::RoaringBitmap selection;
+        for (const auto& value : query.selected[facet]) {
+            auto it = facets_[facet].find(value);
+            if (it != facets_[facet].end()) {
+                selection |= it->second;
+            }
+        }
+        selections[facet] = std::move(selection);
+    }
+
+    utils::RoaringBitmap matched = base;
+    for (const auto& selection : selections) {
+        if (selection) {
+            matched &= *selection;
+        }
+    }
+
+    FacetResult result;
+    result.total = matched.cardinality();
+
+    // Disjunctive counts: a facet's own selection is left out so its other values stay visible
+    for (size_t facet = 0; facet < kFacetCount; ++facet) {
+        if (!selections[facet]) {
+            result.counts[facet] = countValues(facet, matched);
+            continue;
+        }
+
+        utils::RoaringBitmap others = base;
+        for (size_t other = 0; other < kFacetCount; ++other) {
+            if (other != facet && selections[other]) {
+                others &= *selections[other];
+            }
+        }
+        result.counts[facet] = countValues(facet, others);
+    }
+
+    // Candidates keep their relevance order; otherwise results come in ordinal order
+    size_t skipped = 0;
+    auto collect = [&](std::uint32_t ordinal) {
+        if (result.doctor_ids.size() >= query.limit) return;
+        if (skipped++ < query.offset) return;
+        result.doctor_ids.push_back(ordinal_ids_[ordinal].toString());
+    };
+
+    if (query.candidates) {
+        for (std::uint32_t ordinal : candidate_ordinals) {
+            if (matched.contains(ordinal)) {
+                collect(ordinal);
+            }
+        }
+    } else {
+        matched.forEach(collect);
+    }
+    return result;
+}
+
+std::vector<FacetCount> DoctorFacetIndex::countsFor(Facet facet) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<FacetCount> counts;
+    for (const auto& [value, bitmap] : facets_[static_cast<size_t>(facet)]) {
+        counts.push_back({value, bitmap.cardinality()});
+    }
+    std::sort(counts.begin(), counts.end(), [](const FacetCount& a, const FacetCount& b) {
+        return a.count != b.count ? a.count > b.count : a.value < b.value;
+    });
+    return counts;
+}
+
+std::uint64_t DoctorFacetIndex::countFor(Facet facet, const std::string& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const auto& bitmaps = facets_[static_cast<size_t>(facet)];
+    auto it = bitmaps.find(value);
+    return it != bitmaps.end() ? it->second.cardinality() : 0;
+}
+
+DoctorFacetStats DoctorFacetIndex::getStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    DoctorFacetStats stats;
+    stats.indexed_doctors = postings_.size();
+    for (size_t facet = 0; facet < kFacetCount; ++facet) {
+        stats.distinct_values[facet] = facets_[facet].size();
+    }
+    return stats;
+}
+
+// Facet names and fee bands used in routes
+
+std::string DoctorFacetIndex::feeBand(double fee) {
+    if (fee < 300.0) return "0-299";
+    if (fee < 500.0) return "300-499";
+    if (fee < 1000.0) return "500-999";
+    return "1000-plus";
+}
+
+std::optional<Facet> DoctorFacetIndex::facetFromString(const std::string& name) {
+    if (name == "specialization") return Facet::SPECIALIZATION;
+    if (name == "city") return Facet::CITY;
+    if (name == "consultation_type") return Facet::CONSULTATION_TYPE;
+    if (name == "fee_band") return Facet::FEE_BAND;
+    return std::nullopt;
+}
+
+std::string DoctorFacetIndex::facetToString(Facet facet) {
+    switch (facet) {
+        case Facet::SPECIALIZATION: return "specialization";
+        case Facet::CITY: return "city";
+        case Facet::CONSULTATION_TYPE: return "consultation_type";
+        case Facet::FEE_BAND: return "fee_band";
+    }
+    return "unknown";
+}
+
+// Helpers
+
+void DoctorFacetIndex::post(std::uint32_t ordinal, const FacetValues& values) {
+    for (size_t facet = 0; facet < kFacetCount; ++facet) {
+        for (const auto& value : values[facet]) {
+            facets_[facet][value].add(ordinal);
+        }
+    }
+}
+
+void DoctorFacetIndex::unpost(std::uint32_t ordinal, const FacetValues& values) {
+    for (size_t facet = 0; facet < kFacetCount; ++facet) {
+        for (const auto& value : values[facet]) {
+            auto it = facets_[facet].find(value);
+            if (it == facets_[facet].end()) continue;
+
+            it->second.remove(ordinal);
+            if (it->second.empty()) {
+                facets_[facet].erase(it);
+            }
+        }
+    }
+}
+
+std::vector<FacetCount> DoctorFacetIndex::countValues(size_t facet, const utils::RoaringBitmap& within) const {
+    std::vector<FacetCount> counts;
+    if (within.empty()) {
+        return counts;
+    }
+
+    for (const auto& [value, bitmap] : facets_[facet]) {
+        std::uint64_t count = bitmap.andCardinality(within);
+        if (count > 0) {
+            counts.push_back({value, count});
+        }
+    }
+    std::sort(counts.begin(), counts.end(), [](const FacetCount& a, const FacetCount& b) {
+        return a.count != b.count ? a.count > b.count : a.value < b.value;
+    });
+    return counts;
+}
+
+} // namespace healthcare::services
\ No newline at end of file
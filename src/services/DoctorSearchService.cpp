@@ -0,0 +1,326 @@
+#include "../../include/services/DoctorSearchService.h"
+#include "../../include/services/DoctorFacetIndex.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+namespace healthcare::services {
+
+namespace {
+
+// Arrays come back as JSON text so one parser handles every list column
+constexpr const char* kDoctorQuery = R"(
+    SELECT d.id, u.first_name, u.last_name, COALESCE(u.city, ''),
+           COALESCE(d.specializations, '[]'::jsonb)::text,
+           COALESCE(array_to_json(d.clinic_ids), '[]'::json)::text,
+           d.status,
+           COALESCE(array_to_json(d.consultation_types), '[]'::json)::text,
+           COALESCE(d.consultation_fee, 0)
+    FROM doctors d
+    JOIN users u ON u.id = d.user_id
+    WHERE d.is_deleted = FALSE AND u.is_deleted = FALSE
+)";
+
+} // namespace
+
+DoctorSearchService& DoctorSearchService::getInstance() {
+    static DoctorSearchService instance;
+    return instance;
+}
+
+DoctorSearchService::~DoctorSearchService() {
+    stop();
+}
+
+void DoctorSearchService::configure(const DoctorSearchConfig& config) {
+    config_ = config;
+}
+
+bool DoctorSearchService::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // Search answers from whatever is indexed, so an empty start only narrows results until the next reload
+    if (!reload()) {
+        LOG_WARN("Initial doctor search load failed, retrying in {}s", config_.refresh_interval_seconds);
+    }
+
+    refresh_thread_ = std::thread(&DoctorSearchService::refreshLoop, this);
+    auto stats = getStats();
+    LOG_INFO("Doctor search started with {} doctors ({} rows skipped)", stats.indexed_doctors, stats.skipped_rows);
+    return true;
+}
+
+void DoctorSearchService::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    refresh_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+        refresh_thread_.join();
+    }
+}
+
+// Index maintenance
+
+bool DoctorSearchService::reload() {
+    std::vector<LoadedDoctor> loaded;
+    std::unordered_set<std::string> skipped;
+    try {
+        loaded = loadDoctors(skipped);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Doctor search load failed: {}", e.what());
+        return false;
+    }
+
+    std::unordered_set<std::string> listed;
+    for (const auto& entry : loaded) {
+        if (entry.doctor.isActive()) {
+            listed.insert(entry.doctor.getId());
+            indexDoctor(entry.doctor, entry.profile);
+        }
+    }
+
+    std::vector<std::string> stale;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [doctor_id, doctor] : doctors_) {
+            // A doctor whose row no longer parses keeps the entry from the last good load
+            if (listed.count(doctor_id) == 0 && skipped.count(doctor_id) == 0) {
+                stale.push_back(doctor_id);
+            }
+        }
+    }
+    for (const auto& doctor_id : stale) {
+        removeDoctor(doctor_id);
+    }
+    return true;
+}
+
+void DoctorSearchService::refreshDoctor(const std::string& doctor_id) {
+    std::vector<LoadedDoctor> loaded;
+    std::unordered_set<std::string> skipped;
+    try {
+        loaded = loadDoctors(skipped, doctor_id);
+    } catch (const std::exception& e) {
+        LOG_WARN("Failed to refresh search entry for doctor {}: {}", doctor_id, e.what());
+        return;
+    }
+    if (!skipped.empty()) {
+        return;  // Keep the current entry rather than drop the doctor over a bad row
+    }
+
+    if (loaded.empty() || !loaded.front().doctor.isActive()) {
+        removeDoctor(doctor_id);
+        return;
+    }
+    indexDoctor(loaded.front().doctor, loaded.front().profile);
+}
+
+void DoctorSearchService::indexDoctor(const models::Doctor& doctor, const models::User& profile) {
+    DoctorEntry entry;
+    entry.name = profile.getFullName();
+    entry.city = profile.getCity();
+    entry.clinic_ids = doctor.getClinicIds();
+    for (const auto& specialization : doctor.getSpecializations()) {
+        entry.specializations.push_back(specialization.name);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.upsert(doctor.getId(), buildFields(entry));
+    DoctorFacetIndex::getInstance().upsertDoctor(doctor, citiesOf(entry));
+    doctors_[doctor.getId()] = std::move(entry);
+}
+
+bool DoctorSearchService::removeDoctor(const std::string& doctor_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    doctors_.erase(doctor_id);
+    DoctorFacetIndex::getInstance().removeDoctor(doctor_id);
+    return index_.remove(doctor_id);
+}
+
+void DoctorSearchService::indexClinic(const models::Clinic& clinic) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    ClinicEntry entry{clinic.getName(), clinic.getAddress().city};
+    auto it = clinics_.find(clinic.getId());
+    if (it != clinics_.end() && it->second.name == entry.name && it->second.city == entry.city) {
+        return;
+    }
+
+    clinics_[clinic.getId()] = std::move(entry);
+    reindexClinicDoctors(clinic.getId());
+}
+
+bool DoctorSearchService::removeClinic(const std::string& clinic_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (clinics_.erase(clinic_id) == 0) {
+        return false;
+    }
+    reindexClinicDoctors(clinic_id);
+    return true;
+}
+
+void DoctorSearchService::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear();
+    DoctorFacetIndex::getInstance().clear();
+    doctors_.clear();
+    clinics_.clear();
+}
+
+// Queries
+
+std::vector<DoctorSearchResult> DoctorSearchService::search(const std::string& query, size_t limit) const {
+    utils::SearchOptions options;
+    options.limit = limit;
+
+    auto hits = index_.search(query, options);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<DoctorSearchResult> results;
+    results.reserve(hits.size());
+    for (auto& hit : hits) {
+        auto doctor = doctors_.find(hit.id);
+        if (doctor == doctors_.end()) continue;  // Removed since the index was read
+
+        results.push_back({std::move(hit.id), doctor->second.name, doctor->second.specializations, hit.score});
+    }
+    return results;
+}
+
+std::vector<DoctorSearchResult> DoctorSearchService::lookup(const std::vector<std::string>& doctor_ids) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<DoctorSearchResult> results;
+    results.reserve(doctor_ids.size());
+    for (const auto& doctor_id : doctor_ids) {
+        auto doctor = doctors_.find(doctor_id);
+        if (doctor == doctors_.end()) continue;
+
+        results.push_back({doctor_id, doctor->second.name, doctor->second.specializations, 0.0f});
+    }
+    return results;
+}
+
+DoctorSearchStats DoctorSearchService::getStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    DoctorSearchStats stats;
+    stats.indexed_doctors = index_.size();
+    stats.indexed_clinics = clinics_.size();
+    stats.distinct_tokens = index_.tokenCount();
+    stats.skipped_rows = skipped_rows_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Helpers
+
+std::vector<utils::SearchField> DoctorSearchService::buildFields(const DoctorEntry& doctor) const {
+    std::vector<utils::SearchField> fields;
+    fields.push_back({doctor.name, kNameWeight});
+    for (const auto& specialization : doctor.specializations) {
+        fields.push_back({specialization, kSpecializationWeight});
+    }
+    fields.push_back({doctor.city, kCityWeight});
+
+    for (const auto& clinic_id : doctor.clinic_ids) {
+        auto clinic = clinics_.find(clinic_id);
+        if (clinic == clinics_.end()) continue;
+
+        fields.push_back({clinic->second.name, kClinicWeight});
+        fields.push_back({clinic->second.city, kCityWeight});
+    }
+    return fields;
+}
+
+std::vector<std::string> DoctorSearchService::citiesOf(const DoctorEntry& doctor) const {
+    std::vector<std::string> cities{doctor.city};
+    for (const auto& clinic_id : doctor.clinic_ids) {
+        auto clinic = clinics_.find(clinic_id);
+        if (clinic != clinics_.end()) {
+            cities.push_back(clinic->second.city);
+        }
+    }
+    return cities;
+}
+
+void DoctorSearchService::reindexClinicDoctors(const std::string& clinic_id) {
+    for (const auto& [doctor_id, doctor] : doctors_) {
+        if (std::find(doctor.clinic_ids.begin(), doctor.clinic_ids.end(), clinic_id) != doctor.clinic_ids.end()) {
+            index_.upsert(doctor_id, buildFields(doctor));
+            DoctorFacetIndex::getInstance().updateCities(doctor_id, citiesOf(doctor));
+        }
+    }
+}
+
+// Loading
+
+std::vector<DoctorSearchService::LoadedDoctor> DoctorSearchService::loadDoctors(
+    std::unordered_set<std::string>& skipped, const std::string& doctor_id) {
+    auto& db_manager = database::DatabaseManager::getInstance();
+    auto result = doctor_id.empty()
+        ? db_manager.executeQuery(kDoctorQuery)
+        : db_manager.executeQuery(std::string(kDoctorQuery) + " AND d.id = $1", {doctor_id});
+
+    std::vector<LoadedDoctor> loaded;
+    loaded.reserve(result.size());
+    for (const auto& row : result) {
+        std::string id = row[0].as<std::string>();
+
+        // One malformed JSON column should not abort the load for every other doctor
+        try {
+            LoadedDoctor entry;
+            entry.doctor.setId(id);
+            entry.profile.setFirstName(row[1].as<std::string>());
+            entry.profile.setLastName(row[2].as<std::string>());
+            entry.profile.setCity(row[3].as<std::string>());
+
+            std::vector<models::Specialization> specializations;
+            for (const auto& specialization : nlohmann::json::parse(row[4].as<std::string>())) {
+                if (specialization.is_object() && specialization.contains("name")) {
+                    specializations.push_back({"", specialization["name"].get<std::string>(), "", ""});
+                }
+            }
+            entry.doctor.setSpecializations(specializations);
+            entry.doctor.setClinicIds(nlohmann::json::parse(row[5].as<std::string>()).get<std::vector<std::string>>());
+            entry.doctor.setStatus(models::stringToDoctorStatus(row[6].is_null() ? "" : row[6].as<std::string>()));
+
+            // Facet-only fields; indexDoctor hands the doctor on to DoctorFacetIndex
+            std::vector<models::ConsultationType> consultation_types;
+            for (const auto& type : nlohmann::json::parse(row[7].as<std::string>())) {
+                if (type.is_string()) {
+                    consultation_types.push_back(models::stringToConsultationType(type.get<std::string>()));
+                }
+            }
+            entry.doctor.setConsultationTypes(consultation_types);
+            entry.doctor.setConsultationFee(row[8].as<double>());
+            loaded.push_back(std::move(entry));
+        } catch (const std::exception& e) {
+            LOG_WARN("Skipping doctor {} whose search row failed to parse: {}", id, e.what());
+            skipped.insert(std::move(id));
+            skipped_rows_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return loaded;
+}
+
+void DoctorSearchService::refreshLoop() {
+    std::unique_lock<std::mutex> lock(refresh_mutex_);
+
+    while (running_) {
+        refresh_cv_.wait_for(lock, std::chrono::seconds(config_.refresh_interval_seconds),
+                             [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        reload();
+        lock.lock();
+    }
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,567 @@
+#include "../../include/services/EmergencyDispatchIndex.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+namespace healthcare::services {
+
+namespace {
+
+// One row per emergency-capable doctor, placed at the first of their clinics that has emergency services
+constexpr const char* kRosterQuery = R"(
+    SELECT DISTINCT ON (d.id)
+           d.id, c.id, COALESCE(c.address->>'city', ''),
+           (c.address->>'latitude')::double precision,
+           (c.address->>'longitude')::double precision,
+           COALESCE(d.is_available_today, FALSE)
+    FROM doctors d
+    JOIN clinics c ON c.id = ANY(d.clinic_ids)
+    WHERE d.is_deleted = FALSE AND d.status = 'VERIFIED'
+      AND c.is_deleted = FALSE AND c.has_emergency_services = TRUE
+      AND c.address->>'latitude' IS NOT NULL AND c.address->>'longitude' IS NOT NULL
+)";
+
+// Consultations running now, plus emergency appointments that still hold their doctor's claim
+constexpr const char* kOccupancyQuery = R"(
+    SELECT doctor_id, id, status = 'IN_PROGRESS'
+    FROM appointments
+    WHERE is_deleted = FALSE
+      AND (status = 'IN_PROGRESS' OR (is_emergency = TRUE AND status IN ('PENDING', 'CONFIRMED')))
+)";
+
+// Claim stamps; never 0, which marks an unclaimed slot
+std::int64_t claimStamp(std::chrono::steady_clock::time_point time) {
+    return std::max<std::int64_t>(time.time_since_epoch().count(), 1);
+}
+
+} // namespace
+
+EmergencyDispatchIndex& EmergencyDispatchIndex::getInstance() {
+    static EmergencyDispatchIndex instance;
+    return instance;
+}
+
+EmergencyDispatchIndex::~EmergencyDispatchIndex() {
+    stop();
+}
+
+void EmergencyDispatchIndex::configure(const EmergencyDispatchConfig& config) {
+    config_ = config;
+}
+
+bool EmergencyDispatchIndex::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // Dispatch finds nobody until a load succeeds, so keep retrying in the background
+    if (!reloadRoster()) {
+        LOG_WARN("Initial emergency roster load failed, retrying in {}s", config_.roster_refresh_interval_seconds);
+    }
+
+    refresh_thread_ = std::thread(&EmergencyDispatchIndex::refreshLoop, this);
+    LOG_INFO("Emergency dispatch index started with {} doctors", getStats().registered_doctors);
+    return true;
+}
+
+void EmergencyDispatchIndex::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    refresh_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+        refresh_thread_.join();
+    }
+}
+
+// Roster maintenance
+
+bool EmergencyDispatchIndex::reloadRoster() {
+    std::vector<RosterEntry> roster;
+    try {
+        roster = loadRoster();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Emergency roster load failed: {}", e.what());
+        return false;
+    }
+
+    // Upserts keep the occupancy of doctors already in the index
+    std::unordered_set<std::string> listed;
+    for (const auto& entry : roster) {
+        registerDoctor(entry.doctor_id, entry.clinic_id, entry.city, entry.latitude, entry.longitude, entry.on_duty);
+        listed.insert(entry.doctor_id);
+    }
+
+    std::vector<std::string> dropped;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [doctor_id, slot] : slots_) {
+            if (listed.count(doctor_id) == 0) dropped.push_back(doctor_id);
+        }
+    }
+    for (const auto& doctor_id : dropped) {
+        removeDoctor(doctor_id);
+    }
+
+    // A restart or a write on another instance leaves memory behind Postgres
+    try {
+        restoreOccupancy(loadOccupancy());
+    } catch (const std::exception& e) {
+        LOG_ERROR("Emergency occupancy load failed: {}", e.what());
+        return false;
+    }
+    return true;
+}
+
+void EmergencyDispatchIndex::refreshDoctor(const std::string& doctor_id) {
+    std::vector<RosterEntry> roster;
+    try {
+        roster = loadRoster(doctor_id);
+    } catch (const std::exception& e) {
+        LOG_WARN("Failed to refresh emergency roster entry for doctor {}: {}", doctor_id, e.what());
+        return;
+    }
+
+    if (roster.empty()) {
+        removeDoctor(doctor_id);  // No longer verified or no emergency clinic
+        return;
+    }
+    const auto& entry = roster.front();
+    registerDoctor(entry.doctor_id, entry.clinic_id, entry.city, entry.latitude, entry.longitude, entry.on_duty);
+}
+
+void EmergencyDispatchIndex::registerDoctor(const std::string& doctor_id, const std::string& clinic_id,
+                                            const std::string& city, double latitude, double longitude,
+                                            bool on_duty) {
+    std::string normalized_city = normalizeCity(city);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto& slot = slots_[doctor_id];
+    if (!slot) {
+        slot = std::make_unique<DutySlot>();
+        slot->doctor_id = doctor_id;
+        slot->state.store(on_duty ? DutyState::FREE : DutyState::OFF_DUTY, std::memory_order_release);
+    } else {
+        if (slot->city != normalized_city) {
+            detachSlot(*slot);
+        }
+        std::lock_guard<std::mutex> occupancy(slot->occupancy_mutex);
+        if (!on_duty) {
+            slot->state.store(DutyState::OFF_DUTY, std::memory_order_release);
+        } else {
+            DutyState expected = DutyState::OFF_DUTY;
+            slot->state.compare_exchange_strong(expected, DutyState::FREE, std::memory_order_acq_rel);
+            settleState(*slot);
+        }
+    }
+    slot->clinic_id = clinic_id;
+    slot->city = normalized_city;
+
+    auto& locations = cities_[normalized_city];
+    if (!locations) {
+        locations = std::make_unique<utils::geo::GeoIndex>(kCellSizeDegrees);
+    }
+    locations->upsert(doctor_id, latitude, longitude);
+}
+
+bool EmergencyDispatchIndex::removeDoctor(const std::string& doctor_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(doctor_id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    detachSlot(*it->second);
+    slots_.erase(it);
+    return true;
+}
+
+bool EmergencyDispatchIndex::setOnDuty(const std::string& doctor_id, bool on_duty) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(doctor_id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    auto& slot = *it->second;
+    std::lock_guard<std::mutex> occupancy(slot.occupancy_mutex);
+    if (on_duty) {
+        DutyState expected = DutyState::OFF_DUTY;
+        slot.state.compare_exchange_strong(expected, DutyState::FREE, std::memory_order_acq_rel);
+        settleState(slot);
+    } else {
+        slot.state.store(DutyState::OFF_DUTY, std::memory_order_release);
+    }
+    return true;
+}
+
+void EmergencyDispatchIndex::onAppointmentStatusChanged(const models::Appointment& appointment) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(appointment.getDoctorId());
+    if (it == slots_.end()) {
+        return;
+    }
+
+    auto& slot = *it->second;
+    const std::string& appointment_id = appointment.getId();
+    std::lock_guard<std::mutex> occupancy(slot.occupancy_mutex);
+
+    switch (appointment.getStatus()) {
+        case models::AppointmentStatus::IN_PROGRESS:
+            slot.in_progress.insert(appointment_id);
+            break;
+
+        case models::AppointmentStatus::COMPLETED:
+        case models::AppointmentStatus::CANCELLED:
+        case models::AppointmentStatus::NO_SHOW:
+        case models::AppointmentStatus::RESCHEDULED:
+            // Only the claiming appointment ends the claim; other bookings finishing leave it alone
+            slot.in_progress.erase(appointment_id);
+            if (slot.claimed_at.load(std::memory_order_acquire) != 0 && slot.claim_appointment_id == appointment_id) {
+                dropClaim(slot);
+            }
+            break;
+
+        default:
+            return;
+    }
+    settleState(slot);
+}
+
+void EmergencyDispatchIndex::onAppointmentRemoved(const std::string& appointment_id) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // Deletes are rare and carry no doctor id, so scan rather than keep a reverse index
+    for (auto& [doctor_id, slot] : slots_) {
+        std::lock_guard<std::mutex> occupancy(slot->occupancy_mutex);
+        bool held = slot->in_progress.erase(appointment_id) > 0;
+        if (slot->claimed_at.load(std::memory_order_acquire) != 0 && slot->claim_appointment_id == appointment_id) {
+            dropClaim(*slot);
+            held = true;
+        }
+        if (held) {
+            settleState(*slot);
+        }
+    }
+}
+
+// Dispatch
+
+template <typename Visitor>
+void EmergencyDispatchIndex::visitNearest(const std::string& city, double latitude, double longitude,
+                                          double max_radius_km, Visitor&& visitor) const {
+    auto city_it = cities_.find(normalizeCity(city));
+    if (city_it == cities_.end()) {
+        return;
+    }
+    const auto& locations = *city_it->second;
+
+    // Nearest doctors come back in distance order; widen the batch only while every one was taken
+    std::unordered_set<const DutySlot*> visited;
+    for (size_t batch = kNearestBatch;; batch *= 4) {
+        auto hits = locations.nearest(latitude, longitude, batch, max_radius_km);
+        for (const auto& hit : hits) {
+            auto slot_it = slots_.find(hit.id);
+            if (slot_it == slots_.end() || !visited.insert(slot_it->second.get()).second) continue;
+
+            DutySlot& slot = *slot_it->second;
+            if (slot.state.load(std::memory_order_acquire) != DutyState::FREE) continue;
+            if (visitor(slot, hit.distance_km)) {
+                return;
+            }
+        }
+        if (hits.size() < batch) {
+            return;  // Everything within the radius has been seen
+        }
+    }
+}
+
+std::optional<EmergencyCandidate> EmergencyDispatchIndex::findNearestFree(const std::string& city,
+                                                                          double latitude, double longitude,
+                                                                          double max_radius_km) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::optional<EmergencyCandidate> result;
+    visitNearest(city, latitude, longitude, max_radius_km, [&result](const DutySlot& slot, double distance) {
+        if (slot.state.load(std::memory_order_acquire) != DutyState::FREE) {
+            return false;
+        }
+        result = EmergencyCandidate{slot.doctor_id, slot.clinic_id, distance};
+        return true;
+    });
+    return result;
+}
+
+std::optional<EmergencyCandidate> EmergencyDispatchIndex::claimNearest(const std::string& city,
+                                                                       double latitude, double longitude,
+                                                                       double max_radius_km) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::optional<EmergencyCandidate> result;
+    auto stamp = claimStamp(std::chrono::steady_clock::now());
+    visitNearest(city, latitude, longitude, max_radius_km, [this, &result, stamp](DutySlot& slot, double distance) {
+        // Taking the stamp makes this dispatch the only claimant; losing it moves on to the next nearest doctor
+        std::int64_t unclaimed = 0;
+        if (!slot.claimed_at.compare_exchange_strong(unclaimed, stamp, std::memory_order_acq_rel)) {
+            claims_contended_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // FREE -> CLAIMED. A concurrent settleState may already have seen the stamp and moved it
+        DutyState expected = DutyState::FREE;
+        if (!slot.state.compare_exchange_strong(expected, DutyState::CLAIMED, std::memory_order_acq_rel) &&
+            expected != DutyState::CLAIMED) {
+            // The doctor went busy or off duty meanwhile; hand the stamp back and let the state settle
+            std::lock_guard<std::mutex> occupancy(slot.occupancy_mutex);
+            dropClaim(slot);
+            settleState(slot);
+            claims_contended_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        result = EmergencyCandidate{slot.doctor_id, slot.clinic_id, distance, stamp};
+        return true;
+    });
+
+    if (result) {
+        claims_succeeded_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        claims_failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+bool EmergencyDispatchIndex::bindClaim(const EmergencyCandidate& claim, const std::string& appointment_id) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(claim.doctor_id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    auto& slot = *it->second;
+    std::lock_guard<std::mutex> occupancy(slot.occupancy_mutex);
+    if (slot.claimed_at.load(std::memory_order_acquire) != claim.claim_stamp) {
+        return false;  // Expired before the booking got this far, and possibly claimed again since
+    }
+    slot.claim_appointment_id = appointment_id;
+    return true;
+}
+
+bool EmergencyDispatchIndex::release(const EmergencyCandidate& claim) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(claim.doctor_id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    auto& slot = *it->second;
+    std::lock_guard<std::mutex> occupancy(slot.occupancy_mutex);
+    if (slot.claimed_at.load(std::memory_order_acquire) != claim.claim_stamp) {
+        return false;  // Not ours any more; leave a later dispatch's claim alone
+    }
+    dropClaim(slot);
+    settleState(slot);
+    return true;
+}
+
+void EmergencyDispatchIndex::restoreOccupancy(const std::vector<OccupancyEntry>& entries) {
+    std::unordered_map<std::string, std::vector<const OccupancyEntry*>> by_doctor;
+    for (const auto& entry : entries) {
+        by_doctor[entry.doctor_id].push_back(&entry);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    auto settled_before = claimStamp(now - std::chrono::seconds(config_.claim_ttl_seconds));
+
+    for (auto& [doctor_id, slot] : slots_) {
+        std::lock_guard<std::mutex> occupancy(slot->occupancy_mutex);
+        slot->in_progress.clear();
+        std::string open_emergency;
+
+        auto listed = by_doctor.find(doctor_id);
+        if (listed != by_doctor.end()) {
+            for (const auto* entry : listed->second) {
+                if (entry->in_progress) {
+                    slot->in_progress.insert(entry->appointment_id);
+                } else if (open_emergency.empty()) {
+                    open_emergency = entry->appointment_id;
+                }
+            }
+        }
+
+        auto claimed_at = slot->claimed_at.load(std::memory_order_acquire);
+        if (!open_emergency.empty()) {
+            if (claimed_at == 0) {
+                slot->claimed_at.store(claimStamp(now), std::memory_order_release);
+            }
+            slot->claim_appointment_id = open_emergency;
+        } else if (claimed_at != 0 && !slot->claim_appointment_id.empty() && claimed_at < settled_before) {
+            // Its appointment has ended elsewhere. Younger bound claims may belong to a booking not yet committed
+            dropClaim(*slot);
+        }
+        settleState(*slot);
+    }
+}
+
+size_t EmergencyDispatchIndex::expireClaims(std::chrono::steady_clock::time_point now) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto expired_before = claimStamp(now - std::chrono::seconds(config_.claim_ttl_seconds));
+
+    size_t expired = 0;
+    for (auto& [doctor_id, slot] : slots_) {
+        auto claimed_at = slot->claimed_at.load(std::memory_order_acquire);
+        if (claimed_at == 0 || claimed_at >= expired_before) continue;
+
+        std::lock_guard<std::mutex> occupancy(slot->occupancy_mutex);
+        // Bound claims end with their appointment; only a booking that never got that far is abandoned
+        if (slot->claimed_at.load(std::memory_order_acquire) != claimed_at || !slot->claim_appointment_id.empty()) {
+            continue;
+        }
+        LOG_WARN("Emergency claim on doctor {} expired without a booking", doctor_id);
+        dropClaim(*slot);
+        settleState(*slot);
+        ++expired;
+    }
+    claims_expired_.fetch_add(expired, std::memory_order_relaxed);
+    return expired;
+}
+
+std::vector<std::string> EmergencyDispatchIndex::getFreeDoctorIds(const std::string& city) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::string> doctor_ids;
+    std::string normalized_city = normalizeCity(city);
+    for (const auto& [doctor_id, slot] : slots_) {
+        if (slot->city == normalized_city && slot->state.load(std::memory_order_acquire) == DutyState::FREE) {
+            doctor_ids.push_back(doctor_id);
+        }
+    }
+    return doctor_ids;
+}
+
+std::optional<DutyState> EmergencyDispatchIndex::getDutyState(const std::string& doctor_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = slots_.find(doctor_id);
+    if (it == slots_.end()) {
+        return std::nullopt;
+    }
+    return it->second->state.load(std::memory_order_acquire);
+}
+
+EmergencyDispatchStats EmergencyDispatchIndex::getStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    EmergencyDispatchStats stats;
+    stats.registered_doctors = slots_.size();
+    for (const auto& [doctor_id, slot] : slots_) {
+        if (slot->state.load(std::memory_order_relaxed) == DutyState::FREE) {
+            stats.free_doctors++;
+        }
+    }
+    stats.claims_succeeded = claims_succeeded_.load(std::memory_order_relaxed);
+    stats.claims_contended = claims_contended_.load(std::memory_order_relaxed);
+    stats.claims_failed = claims_failed_.load(std::memory_order_relaxed);
+    stats.claims_expired = claims_expired_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void EmergencyDispatchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    cities_.clear();
+    slots_.clear();
+}
+
+void EmergencyDispatchIndex::refreshLoop() {
+    std::unique_lock<std::mutex> lock(refresh_mutex_);
+
+    // Wake often enough to expire claims on time; reload the roster on its own, longer interval
+    auto refresh_interval = std::chrono::seconds(config_.roster_refresh_interval_seconds);
+    auto tick = std::min(refresh_interval, std::chrono::seconds(std::max(config_.claim_ttl_seconds, 1)));
+    auto next_reload = std::chrono::steady_clock::now() + refresh_interval;
+
+    while (running_) {
+        refresh_cv_.wait_for(lock, tick, [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        expireClaims();
+        if (std::chrono::steady_clock::now() >= next_reload) {
+            reloadRoster();
+            next_reload = std::chrono::steady_clock::now() + refresh_interval;
+        }
+        lock.lock();
+    }
+}
+
+// Helpers
+
+std::vector<EmergencyDispatchIndex::RosterEntry> EmergencyDispatchIndex::loadRoster(const std::string& doctor_id) {
+    auto& db_manager = database::DatabaseManager::getInstance();
+    auto result = doctor_id.empty()
+        ? db_manager.executeQuery(std::string(kRosterQuery) + " ORDER BY d.id, c.id")
+        : db_manager.executeQuery(std::string(kRosterQuery) + " AND d.id = $1 ORDER BY d.id, c.id", {doctor_id});
+
+    std::vector<RosterEntry> roster;
+    roster.reserve(result.size());
+    for (const auto& row : result) {
+        roster.push_back({row[0].as<std::string>(), row[1].as<std::string>(), row[2].as<std::string>(),
+                          row[3].as<double>(), row[4].as<double>(), row[5].as<bool>()});
+    }
+    return roster;
+}
+
+std::vector<OccupancyEntry> EmergencyDispatchIndex::loadOccupancy() {
+    auto result = database::DatabaseManager::getInstance().executeQuery(kOccupancyQuery);
+
+    std::vector<OccupancyEntry> entries;
+    entries.reserve(result.size());
+    for (const auto& row : result) {
+        entries.push_back({row[0].as<std::string>(), row[1].as<std::string>(), row[2].as<bool>()});
+    }
+    return entries;
+}
+
+std::string EmergencyDispatchIndex::normalizeCity(const std::string& city) {
+    std::string normalized = city;
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return normalized;
+}
+
+// BUSY while any consultation runs, else CLAIMED while an emergency holds the doctor, else FREE.
+// The claim stamp is re-read on every attempt since claims set it without the occupancy lock
+void EmergencyDispatchIndex::settleState(DutySlot& slot) {
+    DutyState current = slot.state.load(std::memory_order_acquire);
+    while (current != DutyState::OFF_DUTY) {
+        DutyState next = !slot.in_progress.empty() ? DutyState::BUSY
+                       : slot.claimed_at.load(std::memory_order_acquire) != 0 ? DutyState::CLAIMED
+                       : DutyState::FREE;
+        if (current == next || slot.state.compare_exchange_weak(current, next, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+void EmergencyDispatchIndex::dropClaim(DutySlot& slot) {
+    slot.claim_appointment_id.clear();
+    slot.claimed_at.store(0, std::memory_order_release);
+}
+
+void EmergencyDispatchIndex::detachSlot(const DutySlot& slot) {
+    auto city_it = cities_.find(slot.city);
+    if (city_it == cities_.end()) return;
+
+    city_it->second->remove(slot.doctor_id);
+    if (city_it->second->size() == 0) cities_.erase(city_it);
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -45,6 +45,12 @@ bool NotificationService::sendAppointmentReminder(const std::string& user_id, co
     return true;
 }
 
+bool NotificationService::sendAppointmentDigest(const std::string& user_id, const std::vector<std::string>& appointment_ids) {
+    LOG_INFO("Sending appointment digest to user: {} covering {} appointments", user_id, appointment_ids.size());
+    // Stub implementation - one message summarising a batch booking
+    return true;
+}
+
 bool NotificationService::sendPushNotification(const std::string& fcm_token, const std::string& title, const std::string& body) {
     LOG_INFO("Sending push notification to FCM token: {} - Title: {}", fcm_token, title);
     // Stub implementation - in production, this would integrate with FCM
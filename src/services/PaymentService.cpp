@@ -0,0 +1,206 @@
+#include "../../include/services/PaymentService.h"
+#include "../../include/utils/ConfigManager.h"
+#include "../../include/utils/CryptoUtils.h"
+#include "../../include/utils/Logger.h"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace healthcare::services {
+
+namespace {
+
+constexpr const char* kRazorpayBaseUrl = "https://api.razorpay.com/v1";
+
+size_t writeCallback(char* data, size_t size, size_t nmemb, void* userdata) {
+    static_cast<std::string*>(userdata)->append(data, size * nmemb);
+    return size * nmemb;
+}
+
+} // namespace
+
+PaymentService::PaymentService()
+    : base_url_(kRazorpayBaseUrl),
+      is_production_(false),
+      timeout_seconds_(30) {
+    auto& config = utils::GlobalConfig::getInstance();
+    configure(config.getString("payment.razorpay.key_id"),
+              config.getString("payment.razorpay.key_secret"),
+              config.getString("payment.upi.merchant_id"),
+              config.getString("payment.razorpay.webhook_secret"),
+              config.getString("environment") == "production");
+    timeout_seconds_ = config.getInt("payment.webhook_timeout", 30);
+}
+
+void PaymentService::configure(const std::string& razorpay_key_id,
+                               const std::string& razorpay_key_secret,
+                               const std::string& upi_merchant_id,
+                               const std::string& webhook_secret,
+                               bool is_production) {
+    razorpay_key_id_ = razorpay_key_id;
+    razorpay_key_secret_ = razorpay_key_secret;
+    upi_merchant_id_ = upi_merchant_id;
+    webhook_secret_ = webhook_secret;
+    is_production_ = is_production;
+}
+
+// Core payment operations
+
+PaymentResponse PaymentService::createPaymentOrder(const PaymentRequest& request) {
+    PaymentResponse response{};
+    response.amount = request.amount;
+    response.currency = request.currency;
+    response.created_at = std::chrono::system_clock::now();
+
+    if (!validatePaymentAmount(request.amount) || !validateCurrency(request.currency)) {
+        response.error = PaymentError::INVALID_AMOUNT;
+        response.message = getErrorMessage(response.error);
+        return response;
+    }
+
+    if (!validateRazorpayCredentials()) {
+        response.error = PaymentError::INVALID_CREDENTIALS;
+        response.message = getErrorMessage(response.error);
+        return response;
+    }
+
+    return createRazorpayOrder(request);
+}
+
+// Payment validation
+
+bool PaymentService::validatePaymentAmount(double amount) {
+    return isValidAmount(amount);
+}
+
+bool PaymentService::validateCurrency(const std::string& currency) {
+    return currency == "INR";
+}
+
+bool PaymentService::isValidAmount(double amount) {
+    return std::isfinite(amount) && amount > 0.0 && amount <= 10000000.0;
+}
+
+// Utility methods
+
+std::string PaymentService::formatAmount(double amount) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << amount;
+    return oss.str();
+}
+
+// HTTP client methods
+
+// Razorpay authenticates with HTTP basic auth over key id and secret
+std::string PaymentService::makePostRequest(const std::string& url, const nlohmann::json& data,
+                                            const std::map<std::string, std::string>& headers) {
+    std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> curl(curl_easy_init(), &curl_easy_cleanup);
+    if (!curl) {
+        throw std::runtime_error("Failed to initialise HTTP client");
+    }
+
+    struct curl_slist* header_list = curl_slist_append(nullptr, "Content-Type: application/json");
+    for (const auto& [name, value] : headers) {
+        header_list = curl_slist_append(header_list, (name + ": " + value).c_str());
+    }
+    std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)> header_guard(header_list, &curl_slist_free_all);
+
+    const std::string body = data.dump();
+    const std::string credentials = razorpay_key_id_ + ":" + razorpay_key_secret_;
+    std::string response_body;
+
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_POST, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, body.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_HTTPHEADER, header_list);
+    curl_easy_setopt(curl.get(), CURLOPT_USERPWD, credentials.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds_));
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, writeCallback);
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &response_body);
+
+    CURLcode rc = curl_easy_perform(curl.get());
+    if (rc != CURLE_OK) {
+        throw std::runtime_error(std::string("HTTP request failed: ") + curl_easy_strerror(rc));
+    }
+
+    long http_code = 0;
+    curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
+    if (http_code >= 400) {
+        throw std::runtime_error("HTTP " + std::to_string(http_code) + ": " + response_body);
+    }
+
+    return response_body;
+}
+
+// Razorpay specific methods
+
+PaymentResponse PaymentService::createRazorpayOrder(const PaymentRequest& request) {
+    PaymentResponse response{};
+    response.amount = request.amount;
+    response.currency = request.currency;
+    response.created_at = std::chrono::system_clock::now();
+
+    nlohmann::json order;
+    order["amount"] = static_cast<long long>(std::llround(request.amount * 100.0));  // Paise
+    order["currency"] = request.currency;
+    order["receipt"] = request.batch_id.empty() ? request.appointment_id : request.batch_id;
+    order["payment_capture"] = 1;
+    nlohmann::json notes = nlohmann::json::object();
+    for (const auto& [key, value] : request.metadata) {
+        notes[key] = value;
+    }
+    notes["user_id"] = request.user_id;
+    order["notes"] = notes;
+
+    try {
+        auto body = nlohmann::json::parse(makePostRequest(base_url_ + "/orders", order, {}));
+        response.error = PaymentError::SUCCESS;
+        response.message = "Payment order created";
+        response.order_id = body.value("id", "");
+        response.status = body.value("status", "created");
+        response.gateway_response = std::move(body);
+    } catch (const std::exception& e) {
+        response.error = PaymentError::PAYMENT_GATEWAY_ERROR;
+        response.message = getErrorMessage(response.error);
+        logPaymentError(e.what(), {{"appointment_id", request.appointment_id}, {"batch_id", request.batch_id},
+                                   {"user_id", request.user_id}});
+    }
+
+    return response;
+}
+
+// Error handling
+
+std::string PaymentService::getErrorMessage(PaymentError error) {
+    switch (error) {
+        case PaymentError::SUCCESS: return "Success";
+        case PaymentError::INVALID_AMOUNT: return "Invalid payment amount";
+        case PaymentError::PAYMENT_GATEWAY_ERROR: return "Payment gateway error";
+        case PaymentError::INSUFFICIENT_FUNDS: return "Insufficient funds";
+        case PaymentError::PAYMENT_DECLINED: return "Payment declined";
+        case PaymentError::NETWORK_ERROR: return "Network error";
+        case PaymentError::INVALID_PAYMENT_METHOD: return "Invalid payment method";
+        case PaymentError::PAYMENT_TIMEOUT: return "Payment timed out";
+        case PaymentError::VERIFICATION_FAILED: return "Payment verification failed";
+        case PaymentError::REFUND_FAILED: return "Refund failed";
+        case PaymentError::INVALID_CREDENTIALS: return "Payment gateway is not configured";
+        case PaymentError::APPOINTMENT_NOT_FOUND: return "Appointment not found";
+        case PaymentError::PAYMENT_ALREADY_PROCESSED: return "Payment already processed";
+        case PaymentError::REFUND_NOT_ALLOWED: return "Refund not allowed";
+    }
+    return "Unknown payment error";
+}
+
+// Validation helpers
+
+bool PaymentService::validateRazorpayCredentials() {
+    return !razorpay_key_id_.empty() && !razorpay_key_secret_.empty();
+}
+
+// Logging and monitoring
+
+void PaymentService::logPaymentError(const std::string& error, const nlohmann::json& context) {
+    LOG_ERROR("Payment error: {} {}", error, context.dump());
+}
+
+} // namespace healthcare::services
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "../../include/services/RankingService.h"
+#include "../../include/services/CatalogService.h"
+#include "../../include/database/DatabaseManager.h"
+#include "../../include/utils/GeoDistance.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace healthcare::services {
+
+namespace {
+
+constexpr float kNoDistance = -1.0f;
+
+bool isRankable(models::DoctorStatus status) {
+    return status == models::DoctorStatus::VERIFIED || status == models::DoctorStatus::PENDING_VERIFICATION;
+}
+
+std::uint8_t requiredMask(const std::optional<models::ConsultationType>& type) {
+    if (!type) return 0;
+    switch (*type) {
+        case models::ConsultationType::ONLINE: return CatalogSnapshot::kOnline;
+        case models::ConsultationType::OFFLINE: return CatalogSnapshot::kOffline;
+        case models::ConsultationType::BOTH: return CatalogSnapshot::kOnline | CatalogSnapshot::kOffline;
+    }
+    return 0;
+}
+
+} // namespace
+
+RankingService& RankingService::getInstance() {
+    static RankingService instance;
+    return instance;
+}
+
+RankingService::~RankingService() {
+    stop();
+}
+
+void RankingService::configure(const RankingConfig& config) {
+    config_ = config;
+}
+
+bool RankingService::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+
+    // Without booking stats the static score falls back to ratings alone
+    if (!refreshBookingStats()) {
+        LOG_WARN("Initial booking stats load failed, retrying in {}s", config_.stats_refresh_interval_seconds);
+    }
+    rescore();
+
+    ranking_thread_ = std::thread(&RankingService::rankingLoop, this);
+    LOG_INFO("Ranking service started");
+    return true;
+}
+
+void RankingService::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    ranking_cv_.notify_all();
+    if (ranking_thread_.joinable()) {
+        ranking_thread_.join();
+    }
+}
+
+// Request-time ranking
+
+std::vector<RankedDoctor> RankingService::rank(const RankingQuery& query) const {
+    std::vector<RankedDoctor> ranked;
+    auto table = std::atomic_load(&scores_);
+    if (!table || query.limit == 0) {
+        return ranked;
+    }
+
+    const CatalogSnapshot& catalog = *table->catalog;
+    const auto& statuses = catalog.doctorStatuses();
+    const auto& masks = catalog.consultationMasks();
+    const auto& available = catalog.availableToday();
+
+    std::optional<std::uint32_t> specialization;
+    if (!query.specialization.empty()) {
+        specialization = catalog.findString(query.specialization);
+        if (!specialization) {
+            return ranked;
+        }
+    }
+    std::uint8_t required = requiredMask(query.consultation_type);
+
+    // Distance to each clinic inside the radius; shared by every doctor practising there
+    bool located = query.latitude && query.longitude;
+    bool online_only = query.consultation_type == models::ConsultationType::ONLINE;
+    std::vector<float> clinic_distances;
+    if (located) {
+        // One batch kernel pass over the clinic coordinate columns
+        const auto& coordinates = catalog.clinicCoordinates();
+        std::vector<double> distances(coordinates.size());
+        coordinates.distancesFrom(*query.latitude, *query.longitude, distances.data());
+
+        clinic_distances.assign(catalog.clinicCount(), kNoDistance);
+        for (size_t clinic = 0; clinic < distances.size(); ++clinic) {
+            if (distances[clinic] <= query.radius_km) {
+                clinic_distances[clinic] = static_cast<float>(distances[clinic]);
+            }
+        }
+    }
+
+    using Entry = std::pair<float, std::uint32_t>;  // (score, doctor row); heap top is the worst kept
+    std::vector<Entry> heap;
+    heap.reserve(query.limit + 1);
+
+    for (std::uint32_t row = 0; row < catalog.doctorCount(); ++row) {
+        if (!isRankable(statuses[row]) || (masks[row] & required) != required) continue;
+
+        if (specialization) {
+            auto specializations = catalog.doctorSpecializations(row);
+            if (std::find(specializations.begin(), specializations.end(), *specialization) == specializations.end()) {
+                continue;
+            }
+        }
+
+        float distance_score = 0.0f;
+        if (located) {
+            float nearest = kNoDistance;
+            for (std::uint32_t clinic : catalog.doctorClinics(row)) {
+                float distance = clinic_distances[clinic];
+                if (distance != kNoDistance && (nearest == kNoDistance || distance < nearest)) {
+                    nearest = distance;
+                }
+            }
+            // In-person consultations need a clinic in range; online ones are ranked anyway
+            if (nearest == kNoDistance && !online_only) continue;
+            if (nearest != kNoDistance) {
+                distance_score = static_cast<float>(1.0 / (1.0 + nearest / config_.distance_decay_km));
+            }
+        }
+
+        float score = static_cast<float>(config_.static_weight) * table->static_scores[row] +
+                      static_cast<float>(config_.distance_weight) * distance_score +
+                      static_cast<float>(config_.availability_weight) * (available[row] ? 1.0f : 0.0f);
+
+        if (heap.size() < query.limit) {
+            heap.emplace_back(score, row);
+            std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        } else if (score > heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+            heap.back() = {score, row};
+            std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), std::greater<Entry>());  // Best first
+
+    ranked.reserve(heap.size());
+    for (const auto& [score, row] : heap) {
+        RankedDoctor doctor;
+        doctor.doctor_id = std::string(catalog.doctorId(row));
+        doctor.name = std::string(catalog.doctorName(row));
+        doctor.score = score;
+        doctor.static_score = table->static_scores[row];
+        doctor.available_today = available[row] != 0;
+
+        if (located) {
+            for (std::uint32_t clinic : catalog.doctorClinics(row)) {
+                float distance = clinic_distances[clinic];
+                if (distance != kNoDistance && (!doctor.distance_km || distance < *doctor.distance_km)) {
+                    doctor.distance_km = distance;
+                }
+            }
+        }
+        ranked.push_back(std::move(doctor));
+    }
+    return ranked;
+}
+
+// Background scoring
+
+bool RankingService::refreshBookingStats() {
+    std::unordered_map<utils::Uuid, std::uint32_t> bookings;
+
+    try {
+        auto result = database::DatabaseManager::getInstance().executeQuery(R"(
+            SELECT doctor_id, COUNT(*)
+            FROM appointments
+            WHERE is_deleted = FALSE
+              AND status IN ('CONFIRMED', 'IN_PROGRESS', 'COMPLETED')
+              AND start_time >= NOW() - make_interval(days => $1::int)
+            GROUP BY doctor_id
+        )", {std::to_string(config_.booking_window_days)});
+
+        for (const auto& row : result) {
+            if (row[0].is_null()) continue;
+            if (auto doctor_id = utils::Uuid::parse(row[0].as<std::string>())) {
+                bookings[*doctor_id] = row[1].as<std::uint32_t>();
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Booking stats refresh failed: {}", e.what());
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.failed_stats_refreshes++;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(bookings_mutex_);
+        recent_bookings_ = std::move(bookings);
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.stats_refreshes++;
+    stats_.last_stats_refresh = std::chrono::system_clock::now();
+    return true;
+}
+
+void RankingService::rescore() {
+    auto catalog = CatalogService::getInstance().snapshot();
+    const auto& ratings = catalog->doctorRatings();
+    const auto& reviews = catalog->doctorReviewCounts();
+    size_t doctors = catalog->doctorCount();
+
+    // Catalog-wide mean rating anchors doctors with few reviews
+    double rating_sum = 0.0;
+    double review_sum = 0.0;
+    for (size_t row = 0; row < doctors; ++row) {
+        rating_sum += static_cast<double>(ratings[row]) * reviews[row];
+        review_sum += reviews[row];
+    }
+    double mean_rating = review_sum > 0.0 ? rating_sum / review_sum : 0.0;
+
+    std::vector<std::uint32_t> volumes(doctors, 0);
+    std::uint32_t max_volume = 0;
+    {
+        std::lock_guard<std::mutex> lock(bookings_mutex_);
+        for (size_t row = 0; row < doctors; ++row) {
+            auto doctor_id = utils::Uuid::parse(catalog->doctorId(static_cast<std::uint32_t>(row)));
+            if (!doctor_id) continue;
+
+            auto it = recent_bookings_.find(*doctor_id);
+            if (it != recent_bookings_.end()) {
+                volumes[row] = it->second;
+                max_volume = std::max(max_volume, it->second);
+            }
+        }
+    }
+
+    auto table = std::make_shared<ScoreTable>();
+    table->catalog = catalog;
+    table->static_scores.resize(doctors);
+
+    double prior = config_.rating_prior_reviews;
+    double volume_scale = max_volume > 0 ? std::log1p(static_cast<double>(max_volume)) : 1.0;
+    for (size_t row = 0; row < doctors; ++row) {
+        double bayesian_rating = (ratings[row] * reviews[row] + mean_rating * prior) / (reviews[row] + prior);
+        double volume = std::log1p(static_cast<double>(volumes[row])) / volume_scale;
+        table->static_scores[row] = static_cast<float>(config_.rating_weight * bayesian_rating / 5.0 +
+                                                       config_.volume_weight * volume);
+    }
+
+    std::atomic_store(&scores_, std::shared_ptr<const ScoreTable>(std::move(table)));
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.catalog_version = catalog->version();
+    stats_.scored_doctors = doctors;
+    stats_.rescores++;
+}
+
+void RankingService::rankingLoop() {
+    std::unique_lock<std::mutex> lock(ranking_mutex_);
+    auto last_stats_refresh = std::chrono::steady_clock::now();
+
+    while (running_) {
+        ranking_cv_.wait_for(lock, std::chrono::seconds(config_.rescore_interval_seconds),
+                             [this] { return !running_; });
+        if (!running_) break;
+
+        lock.unlock();
+        bool stats_due = std::chrono::steady_clock::now() - last_stats_refresh >=
+                         std::chrono::seconds(config_.stats_refresh_interval_seconds);
+        if (stats_due) {
+            refreshBookingStats();
+            last_stats_refresh = std::chrono::steady_clock::now();
+        }
+
+        // Rescoring is in-memory; skip it when neither input has moved
+        auto table = std::atomic_load(&scores_);
+        if (stats_due || !table || table->catalog->version() != CatalogService::getInstance().snapshot()->version()) {
+            rescore();
+        }
+        lock.lock();
+    }
+}
+
+RankingStats RankingService::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+} // namespace healthcare::services
\ No newline at end of file
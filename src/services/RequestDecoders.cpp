@@ -0,0 +1,366 @@
+#include "../../include/services/RequestDecoders.h"
+#include "../../include/utils/CivilTime.h"
+#include "../../include/utils/Uuid.h"
+#include "../../include/utils/ValidationUtils.h"
+
+namespace healthcare::services {
+
+namespace {
+
+using utils::FieldType;
+using utils::FieldValue;
+using utils::ValidationUtils;
+
+constexpr size_t kMaxFreeTextLength = 1000;
+
+// "YYYY-MM-DD" -> days since 1970-01-01; rejects dates that do not exist
+bool parseIsoDate(std::string_view text, std::int64_t& days) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    int parts[3] = {0, 0, 0};
+    const size_t starts[3] = {0, 5, 8};
+    const size_t lengths[3] = {4, 2, 2};
+    for (int part = 0; part < 3; ++part) {
+        for (size_t i = 0; i < lengths[part]; ++i) {
+            char c = text[starts[part] + i];
+            if (c < '0' || c > '9') return false;
+            parts[part] = parts[part] * 10 + (c - '0');
+        }
+    }
+    if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) {
+        return false;
+    }
+
+    days = utils::civil::daysFromCivil(parts[0], parts[1], parts[2]);
+    auto date = utils::civil::civilFromDays(days);
+    return date.day == static_cast<unsigned>(parts[2]);  // 2024-02-30 rolls over to March
+}
+
+// Stores the canonical lowercase form so later string compares are exact
+std::string acceptUuid(std::string& target, const std::string& text, const char* message) {
+    auto id = utils::Uuid::parse(text);
+    if (!id) {
+        return message;
+    }
+    target = id->toString();
+    return "";
+}
+
+std::string acceptFreeText(std::string& target, FieldValue& value) {
+    if (value.text.size() > kMaxFreeTextLength) {
+        return "too long (max 1000 characters)";
+    }
+    target = std::move(value.text);
+    return "";
+}
+
+// Booking
+
+// The date and time arrive as separate members in either order; they are
+// combined in the clinic's default zone once both are known
+struct BookingDraft {
+    BookingRequest request;
+    std::int64_t local_days = 0;
+    int start_minute = utils::civil::kInvalidMinute;
+};
+
+const utils::RequestSchema<BookingDraft>& bookingSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<BookingDraft> schema;
+        schema
+            .field("doctor_id", FieldType::STRING, true, [](BookingDraft& draft, FieldValue& value) {
+                return acceptUuid(draft.request.doctor_id, value.text, "Invalid doctor ID format");
+            })
+            .field("clinic_id", FieldType::STRING, true, [](BookingDraft& draft, FieldValue& value) {
+                return acceptUuid(draft.request.clinic_id, value.text, "Invalid clinic ID format");
+            })
+            .field("appointment_date", FieldType::STRING, true, [](BookingDraft& draft, FieldValue& value) {
+                return parseIsoDate(value.text, draft.local_days) ? "" : "Invalid date format (use YYYY-MM-DD)";
+            })
+            .field("start_time", FieldType::STRING, true, [](BookingDraft& draft, FieldValue& value) {
+                draft.start_minute = utils::civil::parseHHMM(value.text);
+                bool valid = draft.start_minute != utils::civil::kInvalidMinute &&
+                             draft.start_minute < utils::civil::kMinutesPerDay;
+                return valid ? "" : "Invalid start time format (use HH:MM)";
+            })
+            .field("type", FieldType::STRING, true, [](BookingDraft& draft, FieldValue& value) {
+                if (value.text != "ONLINE" && value.text != "OFFLINE") {
+                    return "Invalid appointment type (must be ONLINE or OFFLINE)";
+                }
+                draft.request.type = models::stringToAppointmentType(value.text);
+                return "";
+            })
+            .field("symptoms", FieldType::STRING, false, [](BookingDraft& draft, FieldValue& value) {
+                return acceptFreeText(draft.request.symptoms, value);
+            })
+            .field("notes", FieldType::STRING, false, [](BookingDraft& draft, FieldValue& value) {
+                return acceptFreeText(draft.request.notes, value);
+            })
+            .field("is_emergency", FieldType::BOOLEAN, false, [](BookingDraft& draft, FieldValue& value) {
+                draft.request.is_emergency = value.flag;
+                return "";
+            })
+            .field("is_follow_up", FieldType::BOOLEAN, false, [](BookingDraft& draft, FieldValue& value) {
+                draft.request.is_follow_up = value.flag;
+                return "";
+            })
+            .field("parent_appointment_id", FieldType::STRING, false, [](BookingDraft& draft, FieldValue& value) {
+                return acceptUuid(draft.request.parent_appointment_id, value.text, "Invalid appointment ID format");
+            })
+            .field("city", FieldType::STRING, false, [](BookingDraft& draft, FieldValue& value) {
+                draft.request.city = std::move(value.text);
+                return "";
+            })
+            .field("latitude", FieldType::NUMBER, false, [](BookingDraft& draft, FieldValue& value) {
+                draft.request.latitude = value.number;
+                return ValidationUtils::isValidLatitude(value.number) ? "" : "Latitude out of range";
+            })
+            .field("longitude", FieldType::NUMBER, false, [](BookingDraft& draft, FieldValue& value) {
+                draft.request.longitude = value.number;
+                return ValidationUtils::isValidLongitude(value.number) ? "" : "Longitude out of range";
+            })
+            .finish([](BookingDraft& draft, std::vector<std::string>& errors) {
+                if (draft.request.is_follow_up && draft.request.parent_appointment_id.empty()) {
+                    errors.push_back("parent_appointment_id: is required for follow-ups");
+                }
+
+                const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+                draft.request.preferred_date = utils::civil::fromLocal(draft.local_days, 0, zone);
+                draft.request.preferred_start_time = utils::civil::fromLocal(draft.local_days, draft.start_minute, zone);
+                if (draft.request.preferred_start_time <= std::chrono::system_clock::now()) {
+                    errors.push_back("appointment_date: Appointment date must be in the future");
+                }
+            });
+        return schema;
+    }();
+    return schema;
+}
+
+// Payment
+
+std::optional<PaymentMethod> paymentMethodFromString(const std::string& method) {
+    if (method == "RAZORPAY") return PaymentMethod::RAZORPAY;
+    if (method == "UPI") return PaymentMethod::UPI;
+    if (method == "CREDIT_CARD") return PaymentMethod::CREDIT_CARD;
+    if (method == "DEBIT_CARD") return PaymentMethod::DEBIT_CARD;
+    if (method == "NET_BANKING") return PaymentMethod::NET_BANKING;
+    if (method == "WALLET") return PaymentMethod::WALLET;
+    return std::nullopt;
+}
+
+// Batch booking
+
+struct BatchItemDraft {
+    BatchBookingItem item;
+    std::int64_t local_days = 0;
+    int start_minute = utils::civil::kInvalidMinute;
+};
+
+const utils::RequestSchema<BatchItemDraft>& batchItemSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<BatchItemDraft> schema;
+        schema
+            .field("doctor_id", FieldType::STRING, true, [](BatchItemDraft& draft, FieldValue& value) {
+                return acceptUuid(draft.item.doctor_id, value.text, "Invalid doctor ID format");
+            })
+            .field("clinic_id", FieldType::STRING, true, [](BatchItemDraft& draft, FieldValue& value) {
+                return acceptUuid(draft.item.clinic_id, value.text, "Invalid clinic ID format");
+            })
+            .field("appointment_date", FieldType::STRING, true, [](BatchItemDraft& draft, FieldValue& value) {
+                return parseIsoDate(value.text, draft.local_days) ? "" : "Invalid date format (use YYYY-MM-DD)";
+            })
+            .field("start_time", FieldType::STRING, true, [](BatchItemDraft& draft, FieldValue& value) {
+                draft.start_minute = utils::civil::parseHHMM(value.text);
+                bool valid = draft.start_minute != utils::civil::kInvalidMinute &&
+                             draft.start_minute < utils::civil::kMinutesPerDay;
+                return valid ? "" : "Invalid start time format (use HH:MM)";
+            })
+            .field("type", FieldType::STRING, false, [](BatchItemDraft& draft, FieldValue& value) {
+                if (value.text != "ONLINE" && value.text != "OFFLINE") {
+                    return "Invalid appointment type (must be ONLINE or OFFLINE)";
+                }
+                draft.item.type = models::stringToAppointmentType(value.text);
+                return "";
+            })
+            .field("symptoms", FieldType::STRING, false, [](BatchItemDraft& draft, FieldValue& value) {
+                return acceptFreeText(draft.item.symptoms, value);
+            })
+            .field("notes", FieldType::STRING, false, [](BatchItemDraft& draft, FieldValue& value) {
+                return acceptFreeText(draft.item.notes, value);
+            })
+            .finish([](BatchItemDraft& draft, std::vector<std::string>& errors) {
+                const auto& zone = utils::civil::TimeZoneRegistry::getInstance().getDefault();
+                draft.item.start_time = utils::civil::fromLocal(draft.local_days, draft.start_minute, zone);
+                if (draft.item.start_time <= std::chrono::system_clock::now()) {
+                    errors.push_back("appointment_date: Appointment date must be in the future");
+                }
+            });
+        return schema;
+    }();
+    return schema;
+}
+
+const utils::RequestSchema<BatchBookingRequest>& batchBookingSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<BatchBookingRequest> schema;
+        schema
+            .field("items", FieldType::OBJECT_ARRAY, true, [](BatchBookingRequest& request, FieldValue& value) {
+                if (value.elements.empty()) {
+                    return std::string("must not be empty");
+                }
+                // Reports the first bad item; its errors already carry field paths
+                for (size_t i = 0; i < value.elements.size(); ++i) {
+                    auto draft = batchItemSchema().decode(value.elements[i]);
+                    if (!draft.ok()) {
+                        return "[" + std::to_string(i) + "]." + draft.errors.front();
+                    }
+                    request.items.push_back(std::move(draft.value->item));
+                }
+                return std::string();
+            })
+            .field("all_or_nothing", FieldType::BOOLEAN, false, [](BatchBookingRequest& request, FieldValue& value) {
+                request.all_or_nothing = value.flag;
+                return "";
+            })
+            .field("payment_method", FieldType::STRING, false, [](BatchBookingRequest& request, FieldValue& value) {
+                auto method = paymentMethodFromString(value.text);
+                if (!method) {
+                    return "Invalid payment method";
+                }
+                request.payment_method = *method;
+                return "";
+            })
+            .field("description", FieldType::STRING, false, [](BatchBookingRequest& request, FieldValue& value) {
+                return acceptFreeText(request.description, value);
+            });
+        return schema;
+    }();
+    return schema;
+}
+
+// Partition slot check
+
+std::chrono::system_clock::time_point fromUnixSeconds(double seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(static_cast<std::int64_t>(seconds)));
+}
+
+const utils::RequestSchema<SlotCheckRequest>& slotCheckSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<SlotCheckRequest> schema;
+        schema
+            .field("doctor_id", FieldType::STRING, true, [](SlotCheckRequest& request, FieldValue& value) {
+                return acceptUuid(request.doctor_id, value.text, "Invalid doctor ID format");
+            })
+            .field("start_time", FieldType::NUMBER, true, [](SlotCheckRequest& request, FieldValue& value) {
+                if (value.number < 0) {
+                    return "must be Unix seconds";
+                }
+                request.start_time = fromUnixSeconds(value.number);
+                return "";
+            })
+            .field("end_time", FieldType::NUMBER, true, [](SlotCheckRequest& request, FieldValue& value) {
+                if (value.number < 0) {
+                    return "must be Unix seconds";
+                }
+                request.end_time = fromUnixSeconds(value.number);
+                return "";
+            })
+            .finish([](SlotCheckRequest& request, std::vector<std::string>& errors) {
+                if (request.end_time <= request.start_time) {
+                    errors.push_back("end_time: must be after start_time");
+                }
+            });
+        return schema;
+    }();
+    return schema;
+}
+
+// Booking forwarded by a peer to the doctor's owner; validated once already on the
+// receiving node, so this only re-checks what the owner itself relies on
+const utils::RequestSchema<BookingRequest>& forwardedBookingSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<BookingRequest> schema;
+        schema
+            .field("user_id", FieldType::STRING, true, [](BookingRequest& request, FieldValue& value) {
+                return acceptUuid(request.user_id, value.text, "Invalid user ID format");
+            })
+            .field("doctor_id", FieldType::STRING, true, [](BookingRequest& request, FieldValue& value) {
+                return acceptUuid(request.doctor_id, value.text, "Invalid doctor ID format");
+            })
+            .field("clinic_id", FieldType::STRING, true, [](BookingRequest& request, FieldValue& value) {
+                return acceptUuid(request.clinic_id, value.text, "Invalid clinic ID format");
+            })
+            .field("appointment_date", FieldType::NUMBER, true, [](BookingRequest& request, FieldValue& value) {
+                if (value.number < 0) {
+                    return "must be Unix seconds";
+                }
+                request.preferred_date = fromUnixSeconds(value.number);
+                return "";
+            })
+            .field("start_time", FieldType::NUMBER, true, [](BookingRequest& request, FieldValue& value) {
+                if (value.number < 0) {
+                    return "must be Unix seconds";
+                }
+                request.preferred_start_time = fromUnixSeconds(value.number);
+                return "";
+            })
+            .field("type", FieldType::STRING, true, [](BookingRequest& request, FieldValue& value) {
+                if (value.text != "ONLINE" && value.text != "OFFLINE") {
+                    return "Invalid appointment type (must be ONLINE or OFFLINE)";
+                }
+                request.type = models::stringToAppointmentType(value.text);
+                return "";
+            })
+            .field("symptoms", FieldType::STRING, false, [](BookingRequest& request, FieldValue& value) {
+                return acceptFreeText(request.symptoms, value);
+            })
+            .field("notes", FieldType::STRING, false, [](BookingRequest& request, FieldValue& value) {
+                return acceptFreeText(request.notes, value);
+            });
+        return schema;
+    }();
+    return schema;
+}
+
+const utils::RequestSchema<ScheduleInvalidateRequest>& scheduleInvalidateSchema() {
+    static const auto schema = [] {
+        utils::RequestSchema<ScheduleInvalidateRequest> schema;
+        schema.field("doctor_id", FieldType::STRING, true, [](ScheduleInvalidateRequest& request, FieldValue& value) {
+            return acceptUuid(request.doctor_id, value.text, "Invalid doctor ID format");
+        });
+        return schema;
+    }();
+    return schema;
+}
+
+} // namespace
+
+utils::DecodeResult<BookingRequest> decodeBookingRequest(std::string_view body) {
+    auto draft = bookingSchema().decode(body);
+
+    utils::DecodeResult<BookingRequest> result;
+    result.errors = std::move(draft.errors);
+    if (draft.value) {
+        result.value = std::move(draft.value->request);
+    }
+    return result;
+}
+
+utils::DecodeResult<BatchBookingRequest> decodeBatchBookingRequest(std::string_view body) {
+    return batchBookingSchema().decode(body);
+}
+
+utils::DecodeResult<SlotCheckRequest> decodeSlotCheckRequest(std::string_view body) {
+    return slotCheckSchema().decode(body);
+}
+
+utils::DecodeResult<BookingRequest> decodeForwardedBookingRequest(std::string_view body) {
+    return forwardedBookingSchema().decode(body);
+}
+
+utils::DecodeResult<ScheduleInvalidateRequest> decodeScheduleInvalidateRequest(std::string_view body) {
+    return scheduleInvalidateSchema().decode(body);
+}
+
+} // namespace healthcare::services
\ No newline at end of file
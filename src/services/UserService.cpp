@@ -640,7 +640,9 @@ std::vector<std::unique_ptr<models::User>> UserService::searchUsers(const std::s
         database::PaginationParams pagination;
         pagination.page_size = 50;
         
-        auto result = user_repository_->search(query, {"first_name", "last_name", "email", "phone_number"}, pagination);
+        auto result = role == models::UserRole::DOCTOR
+            ? user_repository_->searchDoctors(query, pagination)
+            : user_repository_->searchUsers(query, pagination);
         
         if (result.success) {
             for (auto& user : result.data) {
@@ -0,0 +1,307 @@
+#include "../../include/utils/AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace healthcare::utils {
+
+namespace {
+
+constexpr size_t kSlots = AllocationTracker::kNoEndpoint + 1;
+
+// Nothing here may allocate through operator new: shards come from calloc
+struct Shard {
+    bool shared = false;  // The overflow shard has many writers and needs fetch_add
+    std::atomic<std::uint64_t> allocations[kSlots];
+    std::atomic<std::uint64_t> bytes[kSlots];
+    std::atomic<std::uint64_t> total_allocations{0};
+    std::atomic<std::uint64_t> total_bytes{0};
+    std::atomic<std::uint64_t> frees{0};
+};
+
+std::atomic<bool> tracking_enabled{false};
+std::atomic<Shard*> shards[AllocationTracker::kMaxThreads];
+std::atomic<size_t> shard_count{0};
+std::atomic<Shard*> overflow_shard{nullptr};
+
+thread_local Shard* local_shard = nullptr;
+thread_local AllocationTracker::EndpointId current_endpoint = AllocationTracker::kNoEndpoint;
+
+Shard* newShard(bool shared) {
+    void* memory = std::calloc(1, sizeof(Shard));
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    Shard* shard = new (memory) Shard();
+    shard->shared = shared;
+    for (size_t i = 0; i < kSlots; ++i) {
+        shard->allocations[i].store(0, std::memory_order_relaxed);
+        shard->bytes[i].store(0, std::memory_order_relaxed);
+    }
+    return shard;
+}
+
+// First allocation on a thread; shards outlive their threads so totals never go backwards
+Shard* attachShard() {
+    size_t index = shard_count.fetch_add(1, std::memory_order_relaxed);
+    if (index < AllocationTracker::kMaxThreads) {
+        Shard* shard = newShard(false);
+        shards[index].store(shard, std::memory_order_release);
+        return shard;
+    }
+
+    shard_count.store(AllocationTracker::kMaxThreads, std::memory_order_relaxed);
+    Shard* shared = overflow_shard.load(std::memory_order_acquire);
+    if (shared == nullptr) {
+        Shard* created = newShard(true);
+        if (!overflow_shard.compare_exchange_strong(shared, created, std::memory_order_acq_rel)) {
+            std::free(created);  // Lost the race; `shared` now holds the winner
+        } else {
+            shared = created;
+        }
+    }
+    return shared;
+}
+
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount, bool shared) {
+    if (shared) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+template <typename Visit>
+void forEachShard(Visit&& visit) {
+    size_t count = std::min(shard_count.load(std::memory_order_acquire), AllocationTracker::kMaxThreads);
+    for (size_t i = 0; i < count; ++i) {
+        if (const Shard* shard = shards[i].load(std::memory_order_acquire)) {
+            visit(*shard);
+        }
+    }
+    if (const Shard* shared = overflow_shard.load(std::memory_order_acquire)) {
+        visit(*shared);
+    }
+}
+
+void appendCounter(std::string& out, const char* name, std::string_view endpoint, std::uint64_t value) {
+    out += name;
+    out += "{endpoint=\"";
+    for (char c : endpoint) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += "\"} ";
+    out += std::to_string(value);
+    out += '\n';
+}
+
+} // namespace
+
+#ifdef HEALTHCARE_ALLOCATION_TRACKING
+bool AllocationTracker::isCompiledIn() {
+    return true;
+}
+#else
+bool AllocationTracker::isCompiledIn() {
+    return false;
+}
+#endif
+
+void AllocationTracker::setEnabled(bool enabled) {
+    tracking_enabled.store(enabled && isCompiledIn(), std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isEnabled() {
+    return tracking_enabled.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::setCurrentEndpoint(EndpointId endpoint) {
+    current_endpoint = endpoint < kNoEndpoint ? endpoint : kNoEndpoint;
+}
+
+void AllocationTracker::recordAllocation(std::size_t bytes) noexcept {
+    if (!tracking_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    Shard* shard = local_shard;
+    if (shard == nullptr) {
+        shard = local_shard = attachShard();
+        if (shard == nullptr) {
+            return;
+        }
+    }
+    EndpointId endpoint = current_endpoint;
+    bump(shard->allocations[endpoint], 1, shard->shared);
+    bump(shard->bytes[endpoint], bytes, shard->shared);
+    bump(shard->total_allocations, 1, shard->shared);
+    bump(shard->total_bytes, bytes, shard->shared);
+}
+
+void AllocationTracker::recordFree() noexcept {
+    if (!tracking_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (Shard* shard = local_shard) {
+        bump(shard->frees, 1, shard->shared);
+    }
+}
+
+AllocationCounters AllocationTracker::threadTotals() {
+    const Shard* shard = local_shard;
+    if (shard == nullptr) {
+        return {};
+    }
+    // On the shared shard these include other threads; still monotonic, just less precise
+    return {shard->total_allocations.load(std::memory_order_relaxed),
+            shard->total_bytes.load(std::memory_order_relaxed)};
+}
+
+AllocationCounters AllocationTracker::endpointTotals(EndpointId endpoint) {
+    AllocationCounters totals;
+    if (endpoint > kNoEndpoint) {
+        return totals;
+    }
+    forEachShard([&](const Shard& shard) {
+        totals.allocations += shard.allocations[endpoint].load(std::memory_order_relaxed);
+        totals.bytes += shard.bytes[endpoint].load(std::memory_order_relaxed);
+    });
+    return totals;
+}
+
+std::uint64_t AllocationTracker::totalFrees() {
+    std::uint64_t frees = 0;
+    forEachShard([&](const Shard& shard) { frees += shard.frees.load(std::memory_order_relaxed); });
+    return frees;
+}
+
+void AllocationTracker::renderPrometheus(std::string& out) {
+    if (!isCompiledIn()) {
+        return;
+    }
+
+    // Sum every shard once; the output strings are built afterwards
+    struct Totals {
+        std::uint64_t allocations[kSlots] = {};
+        std::uint64_t bytes[kSlots] = {};
+    };
+    auto totals = std::make_unique<Totals>();
+    forEachShard([&](const Shard& shard) {
+        for (size_t i = 0; i < kSlots; ++i) {
+            totals->allocations[i] += shard.allocations[i].load(std::memory_order_relaxed);
+            totals->bytes[i] += shard.bytes[i].load(std::memory_order_relaxed);
+        }
+    });
+
+    const auto& routes = RouteNormalizer::getInstance();
+    auto endpointName = [&routes](size_t slot) {
+        return slot == kNoEndpoint ? std::string_view("(none)") : routes.name(static_cast<EndpointId>(slot));
+    };
+
+    out += "# HELP process_heap_allocations_total Heap allocations by the endpoint being served, (none) outside requests\n";
+    out += "# TYPE process_heap_allocations_total counter\n";
+    for (size_t slot = 0; slot < kSlots; ++slot) {
+        if (totals->allocations[slot] > 0) {
+            appendCounter(out, "process_heap_allocations_total", endpointName(slot), totals->allocations[slot]);
+        }
+    }
+    out += "# HELP process_heap_allocated_bytes_total Bytes requested from operator new by endpoint\n";
+    out += "# TYPE process_heap_allocated_bytes_total counter\n";
+    for (size_t slot = 0; slot < kSlots; ++slot) {
+        if (totals->allocations[slot] > 0) {
+            appendCounter(out, "process_heap_allocated_bytes_total", endpointName(slot), totals->bytes[slot]);
+        }
+    }
+    out += "# HELP process_heap_frees_total Calls to operator delete\n";
+    out += "# TYPE process_heap_frees_total counter\n";
+    out += "process_heap_frees_total " + std::to_string(totalFrees()) + "\n";
+}
+
+} // namespace healthcare::utils
+
+#ifdef HEALTHCARE_ALLOCATION_TRACKING
+
+// Global operator new/delete replacements. Everything funnels into malloc and
+// free, including the aligned forms (aligned_alloc memory is free()-able).
+
+namespace {
+
+void* trackedAllocate(std::size_t size) {
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* memory = std::malloc(size)) {
+            healthcare::utils::AllocationTracker::recordAllocation(size);
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* trackedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    auto align = static_cast<std::size_t>(alignment);
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    std::size_t rounded = (size == 0 ? align : (size + align - 1) & ~(align - 1));
+    for (;;) {
+        if (void* memory = std::aligned_alloc(align, rounded)) {
+            healthcare::utils::AllocationTracker::recordAllocation(size);
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void trackedFree(void* memory) noexcept {
+    if (memory != nullptr) {
+        healthcare::utils::AllocationTracker::recordFree();
+        std::free(memory);
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return trackedAllocate(size); }
+void* operator new[](std::size_t size) { return trackedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return trackedAllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return trackedAllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept { trackedFree(memory); }
+void operator delete[](void* memory) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(memory); }
+
+#endif // HEALTHCARE_ALLOCATION_TRACKING
\ No newline at end of file
@@ -0,0 +1,579 @@
+#include "../../include/utils/AsyncLogSink.h"
+#include "../../include/utils/LogRecord.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <spdlog/details/os.h>
+
+namespace healthcare::utils {
+
+namespace {
+
+std::atomic<std::uint64_t> next_sink_id{1};
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 4096;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+// Ring
+
+// Single-producer byte ring of variable-length records. head_ only moves on
+// the owning thread; tail_ is advanced by the writer after it has copied a
+// record out, and under DROP_OLDEST also by the producer evicting the oldest
+// record. Both sides move tail_ with compare-exchange, so a writer that loses
+// the race discards its copy rather than emitting bytes the producer is
+// overwriting.
+struct AsyncLogSink::RecordHeader {
+    std::uint32_t size;  // Whole record, header included, multiple of 8
+    std::uint16_t level;
+    std::uint16_t kind;
+    std::uint32_t payload_size;
+    std::uint32_t reserved;
+    std::int64_t time_ns;
+    std::uint64_t thread_id;
+};
+static_assert(sizeof(AsyncLogSink::RecordHeader) == 32, "records are laid out on 8-byte boundaries");
+
+class AsyncLogSink::Ring {
+public:
+    using Header = RecordHeader;
+
+    static constexpr std::uint16_t kRecord = 0;      // Payload is formatted text
+    static constexpr std::uint16_t kPadding = 1;
+    static constexpr std::uint16_t kStructured = 2;  // Payload is a LogRecordEncoder buffer
+
+    explicit Ring(size_t bytes)
+        : capacity_(roundUpToPowerOfTwo(bytes)),
+          mask_(capacity_ - 1),
+          buffer_(new char[capacity_]) {}
+
+    size_t maxPayload() const { return capacity_ / 2 - sizeof(Header); }
+
+    double fill() const {
+        std::uint64_t used = head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
+        return static_cast<double>(used) / static_cast<double>(capacity_);
+    }
+
+    // Producer
+
+    bool tryPush(Header header, const char* payload) {
+        size_t need = (sizeof(Header) + header.payload_size + 7) & ~size_t{7};
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = tail_.load(std::memory_order_acquire);
+
+        // Records never wrap; the tail end of the buffer becomes padding instead
+        size_t offset = head & mask_;
+        size_t to_end = capacity_ - offset;
+        size_t skip = to_end < need ? to_end : 0;
+        if (head + skip + need - tail > capacity_) {
+            return false;
+        }
+
+        if (skip >= sizeof(Header)) {
+            Header padding{};
+            padding.size = static_cast<std::uint32_t>(skip);
+            padding.kind = kPadding;
+            std::memcpy(buffer_.get() + offset, &padding, sizeof(padding));
+        }
+
+        offset = (head + skip) & mask_;
+        header.size = static_cast<std::uint32_t>(need);
+        std::memcpy(buffer_.get() + offset, &header, sizeof(header));
+        std::memcpy(buffer_.get() + offset + sizeof(Header), payload, header.payload_size);
+
+        head_.store(head + skip + need, std::memory_order_release);
+        return true;
+    }
+
+    // Frees the oldest record; false if the ring was already empty
+    bool evictOldest() {
+        std::uint64_t tail = tail_.load(std::memory_order_acquire);
+        while (tail != head_.load(std::memory_order_relaxed)) {
+            bool record;
+            std::uint64_t next = tail + recordSize(tail, record);
+            if (tail_.compare_exchange_weak(tail, next, std::memory_order_acq_rel)) {
+                if (record) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                tail = next;
+            }
+        }
+        return false;
+    }
+
+    // Consumer
+
+    template<typename Handler>
+    void drain(std::string& scratch, Handler&& handler) {
+        std::uint64_t tail = tail_.load(std::memory_order_acquire);
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+
+        while (tail < head) {
+            size_t offset = tail & mask_;
+            size_t to_end = capacity_ - offset;
+            Header header{};
+            std::uint64_t next;
+
+            if (to_end < sizeof(Header)) {
+                next = tail + to_end;
+            } else {
+                std::memcpy(&header, buffer_.get() + offset, sizeof(header));
+                bool torn = header.size < sizeof(Header) || header.size > to_end ||
+                            header.payload_size > header.size - sizeof(Header);
+                if (torn) {
+                    // Only possible if an eviction overtook us; re-read the tail
+                    std::uint64_t current = tail_.load(std::memory_order_acquire);
+                    if (current == tail) break;
+                    tail = current;
+                    continue;
+                }
+                next = tail + header.size;
+                if (header.kind != kPadding) {
+                    scratch.assign(buffer_.get() + offset + sizeof(Header), header.payload_size);
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!tail_.compare_exchange_strong(tail, next, std::memory_order_acq_rel)) {
+                continue;  // Evicted while we copied; tail now holds the new position
+            }
+            if (to_end >= sizeof(Header) && header.kind != kPadding) {
+                handler(header, scratch);
+            }
+            tail = next;
+        }
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    // Producer-side counters; summed by getStats()
+    std::atomic<std::uint64_t> enqueued{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> sampled_out{0};
+    std::atomic<std::uint64_t> truncated{0};
+    std::atomic<std::uint64_t> blocked{0};
+    std::uint32_t sample_counter = 0;  // Producer only
+
+    std::atomic<bool> abandoned{false};  // Owning thread exited
+    std::atomic<bool> wake_pending{false};
+
+private:
+    size_t recordSize(std::uint64_t position, bool& record) const {
+        size_t offset = position & mask_;
+        size_t to_end = capacity_ - offset;
+        if (to_end < sizeof(Header)) {
+            record = false;
+            return to_end;
+        }
+        Header header;
+        std::memcpy(&header, buffer_.get() + offset, sizeof(header));
+        record = header.kind != kPadding;
+        return header.size;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<char[]> buffer_;
+
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+};
+
+namespace {
+
+// The calling thread's ring for the sink it last logged through. Logging
+// through a different sink (only after Logger::configure runs again) swaps
+// in a fresh ring and retires the old one.
+struct ThreadRingSlot {
+    std::uint64_t sink_id = 0;
+    std::shared_ptr<AsyncLogSink::Ring> ring;
+
+    ~ThreadRingSlot() {
+        if (ring) ring->abandoned.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadRingSlot thread_ring;
+
+// Records held back on this thread while a request's fate is undecided,
+// stored back to back as [Ring::Header][payload]
+struct RequestCapture {
+    static constexpr size_t kMaxBytes = 64 * 1024;
+
+    bool active = false;
+    bool must_keep = false;  // An error was logged; the lines are kept whatever the sampler says
+    size_t records = 0;
+    std::string held;
+};
+
+thread_local RequestCapture request_capture;
+
+} // namespace
+
+LogOverflowPolicy stringToLogOverflowPolicy(const std::string& policy) {
+    if (policy == "BLOCK") return LogOverflowPolicy::BLOCK;
+    if (policy == "SAMPLE") return LogOverflowPolicy::SAMPLE;
+    return LogOverflowPolicy::DROP_OLDEST;
+}
+
+// Lifecycle
+
+AsyncLogSink::AsyncLogSink(std::string logger_name, std::vector<spdlog::sink_ptr> sinks,
+                           const AsyncLogConfig& config)
+    : logger_name_(std::move(logger_name)),
+      config_(config),
+      sink_id_(next_sink_id.fetch_add(1, std::memory_order_relaxed)),
+      sinks_(std::move(sinks)) {
+    running_ = true;
+    writer_thread_ = std::thread(&AsyncLogSink::writerLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        running_ = false;
+    }
+    writer_cv_.notify_all();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+// Producer path
+
+AsyncLogSink::Ring& AsyncLogSink::threadRing() {
+    if (thread_ring.sink_id != sink_id_ || !thread_ring.ring) {
+        if (thread_ring.ring) {
+            thread_ring.ring->abandoned.store(true, std::memory_order_release);
+        }
+        auto ring = std::make_shared<Ring>(config_.ring_bytes);
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings_.push_back(ring);
+        }
+        thread_ring.sink_id = sink_id_;
+        thread_ring.ring = std::move(ring);
+    }
+    return *thread_ring.ring;
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+    Ring& ring = threadRing();
+
+    size_t payload_size = msg.payload.size();
+    if (payload_size > ring.maxPayload()) {
+        payload_size = ring.maxPayload();
+        ring.truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    enqueue(ring, msg.level, Ring::kRecord, time_ns, msg.thread_id, msg.payload.data(), payload_size);
+}
+
+void AsyncLogSink::logRecord(spdlog::level::level_enum level, std::string_view record) {
+    if (!should_log(level)) {
+        return;
+    }
+
+    Ring& ring = threadRing();
+    if (record.size() > ring.maxPayload()) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);  // Encoded values cannot be cut
+        return;
+    }
+
+    auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        spdlog::log_clock::now().time_since_epoch()).count();
+    enqueue(ring, level, Ring::kStructured, time_ns, spdlog::details::os::thread_id(), record.data(), record.size());
+}
+
+void AsyncLogSink::enqueue(Ring& ring, spdlog::level::level_enum level, std::uint16_t kind, std::int64_t time_ns,
+                           size_t thread_id, const char* payload, size_t payload_size) {
+    Ring::Header header{};
+    header.level = static_cast<std::uint16_t>(level);
+    header.kind = kind;
+    header.time_ns = time_ns;
+    header.thread_id = thread_id;
+    header.payload_size = static_cast<std::uint32_t>(payload_size);
+
+    auto& capture = request_capture;
+    if (!capture.active) {
+        push(ring, header, payload);
+        return;
+    }
+
+    capture.held.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    capture.held.append(payload, payload_size);
+    capture.records++;
+    capture.must_keep = capture.must_keep || level >= spdlog::level::err;
+
+    // A request that logs this much is worth keeping; stop holding its lines back
+    if (capture.held.size() > RequestCapture::kMaxBytes) {
+        capture_overflows_.fetch_add(1, std::memory_order_relaxed);
+        endCapture(true);
+    }
+}
+
+// Tail-based retention
+
+void AsyncLogSink::beginCapture() {
+    if (request_capture.active) {
+        endCapture(true);  // The previous request never reached endCapture(); keep its lines
+    }
+    request_capture.active = true;
+    request_capture.must_keep = false;
+}
+
+void AsyncLogSink::endCapture(bool keep) {
+    auto& capture = request_capture;
+    if (!capture.active) {
+        return;
+    }
+    capture.active = false;
+    keep = keep || capture.must_keep;
+
+    if (keep && !capture.held.empty()) {
+        Ring& ring = threadRing();
+        size_t pos = 0;
+        while (pos < capture.held.size()) {
+            Ring::Header header;
+            std::memcpy(&header, capture.held.data() + pos, sizeof(header));
+            push(ring, header, capture.held.data() + pos + sizeof(header));
+            pos += sizeof(header) + header.payload_size;
+        }
+    } else if (!keep) {
+        tail_discarded_.fetch_add(capture.records, std::memory_order_relaxed);
+    }
+
+    capture.held.clear();
+    capture.records = 0;
+    if (capture.held.capacity() > RequestCapture::kMaxBytes * 2) {
+        capture.held.shrink_to_fit();
+    }
+}
+
+void AsyncLogSink::push(Ring& ring, const Ring::Header& header, const char* payload) {
+    auto level = static_cast<spdlog::level::level_enum>(header.level);
+    bool pushed = false;
+    switch (config_.overflow) {
+        case LogOverflowPolicy::BLOCK:
+            while (!(pushed = ring.tryPush(header, payload)) && running_.load(std::memory_order_relaxed)) {
+                ring.blocked.fetch_add(1, std::memory_order_relaxed);
+                notifyWriter();
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            if (!pushed) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);  // Sink shutting down
+            }
+            break;
+
+        case LogOverflowPolicy::DROP_OLDEST:
+            // A record is at most half the ring, so an emptied ring always takes it
+            while (!(pushed = ring.tryPush(header, payload))) {
+                ring.evictOldest();
+            }
+            break;
+
+        case LogOverflowPolicy::SAMPLE:
+            if (ring.fill() >= config_.sample_high_water && level < spdlog::level::err &&
+                ++ring.sample_counter % std::max<std::uint32_t>(config_.sample_every, 1) != 0) {
+                ring.sampled_out.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            pushed = ring.tryPush(header, payload);
+            if (!pushed) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+    }
+
+    if (!pushed) {
+        return;
+    }
+    ring.enqueued.fetch_add(1, std::memory_order_relaxed);
+
+    // The writer polls on its own; only errors and a half-full ring are worth a wakeup
+    bool urgent = level >= spdlog::level::err || ring.fill() >= 0.5;
+    if (urgent && !ring.wake_pending.exchange(true, std::memory_order_relaxed)) {
+        notifyWriter();
+    }
+}
+
+void AsyncLogSink::notifyWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        wake_requested_ = true;
+    }
+    writer_cv_.notify_one();
+}
+
+// Writer
+
+void AsyncLogSink::writerLoop() {
+    auto interval = std::chrono::milliseconds(std::max(config_.drain_interval_ms, 1));
+
+    while (true) {
+        std::uint64_t flush_target;
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            writer_cv_.wait_for(lock, interval, [this] { return wake_requested_ || !running_; });
+            wake_requested_ = false;
+            flush_target = flush_requested_;
+            stopping = !running_;
+        }
+
+        bool wrote = drainOnce();
+        if (flush_target > flush_completed_ || stopping) {
+            if (!wrote) {
+                std::lock_guard<std::mutex> lock(sinks_mutex_);
+                for (auto& sink : sinks_) {
+                    sink->flush();
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(writer_mutex_);
+                flush_completed_ = flush_target;
+            }
+            flushed_cv_.notify_all();
+        }
+
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+bool AsyncLogSink::drainOnce() {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    std::uint64_t written = 0;
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        for (auto& ring : rings) {
+            ring->wake_pending.store(false, std::memory_order_relaxed);
+            ring->drain(scratch_, [&](const Ring::Header& header, const std::string& payload) {
+                auto level = static_cast<spdlog::level::level_enum>(header.level);
+                spdlog::log_clock::time_point time(
+                    std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(header.time_ns)));
+
+                std::string_view text = payload;
+                if (header.kind == Ring::kStructured) {
+                    rendered_.clear();
+                    if (!renderLogRecord(payload, rendered_)) {
+                        rendered_ = "{\"event\":\"malformed_log_record\"}";
+                    }
+                    text = rendered_;
+                }
+
+                spdlog::details::log_msg msg(time, spdlog::source_loc{}, logger_name_, level,
+                                             spdlog::string_view_t(text.data(), text.size()));
+                msg.thread_id = static_cast<size_t>(header.thread_id);
+                for (auto& sink : sinks_) {
+                    if (sink->should_log(level)) {
+                        sink->log(msg);
+                    }
+                }
+                ++written;
+            });
+        }
+
+        // One flush per batch rather than per record
+        if (written > 0) {
+            for (auto& sink : sinks_) {
+                sink->flush();
+            }
+        }
+    }
+
+    if (written > 0) {
+        written_.fetch_add(written, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Retire rings whose threads are gone once they are empty
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto retired = std::remove_if(rings_.begin(), rings_.end(), [this](const std::shared_ptr<Ring>& ring) {
+        if (!ring->abandoned.load(std::memory_order_acquire) || !ring->empty()) {
+            return false;
+        }
+        retired_enqueued_.fetch_add(ring->enqueued.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        retired_dropped_.fetch_add(ring->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        retired_sampled_out_.fetch_add(ring->sampled_out.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        retired_truncated_.fetch_add(ring->truncated.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        retired_blocked_.fetch_add(ring->blocked.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return true;
+    });
+    rings_.erase(retired, rings_.end());
+
+    return written > 0;
+}
+
+// spdlog sink interface
+
+void AsyncLogSink::flush() {
+    if (std::this_thread::get_id() == writer_thread_.get_id()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    if (!running_) {
+        return;
+    }
+    std::uint64_t target = ++flush_requested_;
+    wake_requested_ = true;
+    writer_cv_.notify_one();
+    flushed_cv_.wait(lock, [this, target] { return flush_completed_ >= target || !running_; });
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern) {
+    std::lock_guard<std::mutex> lock(sinks_mutex_);
+    for (auto& sink : sinks_) {
+        sink->set_pattern(pattern);
+    }
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    std::lock_guard<std::mutex> lock(sinks_mutex_);
+    for (auto& sink : sinks_) {
+        sink->set_formatter(sink_formatter->clone());
+    }
+}
+
+AsyncLogStats AsyncLogSink::getStats() const {
+    AsyncLogStats stats;
+    stats.enqueued = retired_enqueued_.load(std::memory_order_relaxed);
+    stats.dropped = retired_dropped_.load(std::memory_order_relaxed);
+    stats.sampled_out = retired_sampled_out_.load(std::memory_order_relaxed);
+    stats.truncated = retired_truncated_.load(std::memory_order_relaxed);
+    stats.blocked = retired_blocked_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.tail_discarded = tail_discarded_.load(std::memory_order_relaxed);
+    stats.capture_overflows = capture_overflows_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+        stats.enqueued += ring->enqueued.load(std::memory_order_relaxed);
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+        stats.sampled_out += ring->sampled_out.load(std::memory_order_relaxed);
+        stats.truncated += ring->truncated.load(std::memory_order_relaxed);
+        stats.blocked += ring->blocked.load(std::memory_order_relaxed);
+    }
+    stats.producer_threads = rings_.size();
+    return stats;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
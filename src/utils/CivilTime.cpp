@@ -0,0 +1,314 @@
+#include "../../include/utils/CivilTime.h"
+#include <algorithm>
+#include <limits>
+
+namespace healthcare::utils::civil {
+
+namespace {
+
+const char* const kDayNames[kDaysPerWeek] = {
+    "SUNDAY", "MONDAY", "TUESDAY", "WEDNESDAY", "THURSDAY", "FRIDAY", "SATURDAY"
+};
+
+std::int64_t lastSundayOfMonth(int year, unsigned month) {
+    std::int64_t last_day = month == 12
+        ? daysFromCivil(year + 1, 1, 1) - 1
+        : daysFromCivil(year, month + 1, 1) - 1;
+    return last_day - weekdayFromDays(last_day);
+}
+
+std::int64_t nthSundayOfMonth(int year, unsigned month, int n) {
+    std::int64_t first_day = daysFromCivil(year, month, 1);
+    std::int64_t first_sunday = first_day + (kDaysPerWeek - weekdayFromDays(first_day)) % kDaysPerWeek;
+    return first_sunday + static_cast<std::int64_t>(kDaysPerWeek) * (n - 1);
+}
+
+char toUpperAscii(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+int parseTwoDigits(std::string_view text, size_t pos) {
+    if (pos + 2 > text.size()) return -1;
+    char tens = text[pos];
+    char units = text[pos + 1];
+    if (tens < '0' || tens > '9' || units < '0' || units > '9') return -1;
+    return (tens - '0') * 10 + (units - '0');
+}
+
+} // namespace
+
+// TimeZone implementation
+TimeZone::TimeZone(const std::string& name, int offset_minutes)
+    : name_(name),
+      transitions_{{std::numeric_limits<std::int64_t>::min(), offset_minutes}},
+      fixed_offset_minutes_(offset_minutes) {
+}
+
+TimeZone::TimeZone(const std::string& name, std::vector<Transition> transitions)
+    : name_(name), transitions_(std::move(transitions)), fixed_offset_minutes_(0) {
+    std::sort(transitions_.begin(), transitions_.end(),
+        [](const Transition& a, const Transition& b) { return a.utc_seconds < b.utc_seconds; });
+
+    if (transitions_.empty()) {
+        transitions_.push_back({std::numeric_limits<std::int64_t>::min(), 0});
+    }
+    fixed_offset_minutes_ = transitions_.front().offset_minutes;
+}
+
+int TimeZone::offsetMinutesAt(std::int64_t utc_seconds) const {
+    if (transitions_.size() == 1) {
+        return fixed_offset_minutes_;
+    }
+
+    auto it = std::upper_bound(transitions_.begin(), transitions_.end(), utc_seconds,
+        [](std::int64_t value, const Transition& t) { return value < t.utc_seconds; });
+
+    if (it == transitions_.begin()) {
+        return transitions_.front().offset_minutes;
+    }
+    return std::prev(it)->offset_minutes;
+}
+
+// TimeZoneRegistry implementation
+TimeZoneRegistry& TimeZoneRegistry::getInstance() {
+    static TimeZoneRegistry instance;
+    return instance;
+}
+
+TimeZoneRegistry::TimeZoneRegistry() {
+    registerBuiltinZones();
+}
+
+const TimeZone& TimeZoneRegistry::get(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = zones_.find(name);
+    if (it == zones_.end()) {
+        it = zones_.find(kDefaultTimeZone);
+    }
+    return it->second;
+}
+
+const TimeZone* TimeZoneRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = zones_.find(name);
+    return it == zones_.end() ? nullptr : &it->second;
+}
+
+bool TimeZoneRegistry::registerZone(const TimeZone& zone) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return zones_.emplace(zone.getName(), zone).second;
+}
+
+std::vector<std::string> TimeZoneRegistry::getZoneNames() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::string> names;
+    names.reserve(zones_.size());
+    for (const auto& [name, zone] : zones_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+void TimeZoneRegistry::registerBuiltinZones() {
+    // Fixed-offset zones (India and neighbouring regions)
+    zones_.emplace("UTC", TimeZone("UTC", 0));
+    zones_.emplace("Asia/Kolkata", TimeZone("Asia/Kolkata", 330));
+    zones_.emplace("Asia/Calcutta", TimeZone("Asia/Calcutta", 330));
+    zones_.emplace("Asia/Colombo", TimeZone("Asia/Colombo", 330));
+    zones_.emplace("Asia/Kathmandu", TimeZone("Asia/Kathmandu", 345));
+    zones_.emplace("Asia/Dhaka", TimeZone("Asia/Dhaka", 360));
+    zones_.emplace("Asia/Karachi", TimeZone("Asia/Karachi", 300));
+    zones_.emplace("Asia/Dubai", TimeZone("Asia/Dubai", 240));
+    zones_.emplace("Asia/Singapore", TimeZone("Asia/Singapore", 480));
+
+    // Zones with daylight saving time
+    zones_.emplace("Europe/London", makeEuropeanZone("Europe/London", 0));
+    zones_.emplace("Europe/Berlin", makeEuropeanZone("Europe/Berlin", 60));
+    zones_.emplace("America/New_York", makeNorthAmericanZone("America/New_York", -300));
+    zones_.emplace("America/Chicago", makeNorthAmericanZone("America/Chicago", -360));
+    zones_.emplace("America/Los_Angeles", makeNorthAmericanZone("America/Los_Angeles", -480));
+}
+
+TimeZone makeEuropeanZone(const std::string& name, int standard_offset_minutes,
+                          int first_year, int last_year) {
+    // EU rule: summer time from 01:00 UTC on the last Sunday of March
+    // until 01:00 UTC on the last Sunday of October
+    std::vector<TimeZone::Transition> transitions;
+    transitions.push_back({std::numeric_limits<std::int64_t>::min(), standard_offset_minutes});
+
+    for (int year = first_year; year <= last_year; ++year) {
+        std::int64_t dst_start = lastSundayOfMonth(year, 3) * kSecondsPerDay + 3600;
+        std::int64_t dst_end = lastSundayOfMonth(year, 10) * kSecondsPerDay + 3600;
+        transitions.push_back({dst_start, standard_offset_minutes + 60});
+        transitions.push_back({dst_end, standard_offset_minutes});
+    }
+
+    return TimeZone(name, std::move(transitions));
+}
+
+TimeZone makeNorthAmericanZone(const std::string& name, int standard_offset_minutes,
+                               int first_year, int last_year) {
+    // US rule: daylight time from 02:00 local on the second Sunday of March
+    // until 02:00 local on the first Sunday of November
+    std::vector<TimeZone::Transition> transitions;
+    transitions.push_back({std::numeric_limits<std::int64_t>::min(), standard_offset_minutes});
+
+    const int daylight_offset_minutes = standard_offset_minutes + 60;
+    for (int year = first_year; year <= last_year; ++year) {
+        std::int64_t dst_start = nthSundayOfMonth(year, 3, 2) * kSecondsPerDay + 7200
+                               - static_cast<std::int64_t>(standard_offset_minutes) * kSecondsPerMinute;
+        std::int64_t dst_end = nthSundayOfMonth(year, 11, 1) * kSecondsPerDay + 7200
+                             - static_cast<std::int64_t>(daylight_offset_minutes) * kSecondsPerMinute;
+        transitions.push_back({dst_start, daylight_offset_minutes});
+        transitions.push_back({dst_end, standard_offset_minutes});
+    }
+
+    return TimeZone(name, std::move(transitions));
+}
+
+// Day arithmetic
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+    std::int64_t quotient = value / divisor;
+    return (value % divisor != 0 && ((value < 0) != (divisor < 0))) ? quotient - 1 : quotient;
+}
+
+std::int64_t daysFromCivil(int year, unsigned month, unsigned day) {
+    // Howard Hinnant's days_from_civil algorithm
+    std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2 ? 1 : 0);
+    std::int64_t era = floorDiv(y, 400);
+    std::int64_t year_of_era = y - era * 400;
+    std::int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    std::int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+CivilDate civilFromDays(std::int64_t days) {
+    days += 719468;
+    std::int64_t era = floorDiv(days, 146097);
+    std::int64_t day_of_era = days - era * 146097;
+    std::int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    std::int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    std::int64_t mp = (5 * day_of_year + 2) / 153;
+
+    CivilDate date;
+    date.day = static_cast<unsigned>(day_of_year - (153 * mp + 2) / 5 + 1);
+    date.month = static_cast<unsigned>(mp < 10 ? mp + 3 : mp - 9);
+    date.year = static_cast<int>(year_of_era + era * 400 + (date.month <= 2 ? 1 : 0));
+    return date;
+}
+
+int weekdayFromDays(std::int64_t days) {
+    // 1970-01-01 was a Thursday
+    return static_cast<int>(days + 4 - floorDiv(days + 4, kDaysPerWeek) * kDaysPerWeek);
+}
+
+// Conversions
+std::int64_t toUnixSeconds(const std::chrono::system_clock::time_point& time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+LocalTime toLocal(const std::chrono::system_clock::time_point& time, const TimeZone& zone) {
+    std::int64_t utc_seconds = toUnixSeconds(time);
+    int offset = zone.offsetMinutesAt(utc_seconds);
+    std::int64_t local_minutes = floorDiv(utc_seconds, kSecondsPerMinute) + offset;
+    std::int64_t local_days = floorDiv(local_minutes, kMinutesPerDay);
+
+    LocalTime local;
+    local.local_days = local_days;
+    local.minute_of_day = static_cast<int>(local_minutes - local_days * kMinutesPerDay);
+    local.day_of_week = weekdayFromDays(local_days);
+    local.offset_minutes = offset;
+    return local;
+}
+
+std::chrono::system_clock::time_point fromLocal(std::int64_t local_days, int minute_of_day,
+                                                const TimeZone& zone) {
+    std::int64_t local_seconds = local_days * kSecondsPerDay
+                               + static_cast<std::int64_t>(minute_of_day) * kSecondsPerMinute;
+
+    // Resolve the offset in two steps so times next to a DST transition land correctly
+    int offset = zone.offsetMinutesAt(local_seconds);
+    std::int64_t utc_seconds = local_seconds - static_cast<std::int64_t>(offset) * kSecondsPerMinute;
+    int corrected_offset = zone.offsetMinutesAt(utc_seconds);
+    if (corrected_offset != offset) {
+        utc_seconds = local_seconds - static_cast<std::int64_t>(corrected_offset) * kSecondsPerMinute;
+    }
+
+    return std::chrono::system_clock::time_point(std::chrono::seconds(utc_seconds));
+}
+
+int minuteOfWeek(const std::chrono::system_clock::time_point& time, const TimeZone& zone) {
+    return toLocal(time, zone).minuteOfWeek();
+}
+
+void minutesOfWeek(const std::chrono::system_clock::time_point* times, size_t count,
+                   const TimeZone& zone, int* out) {
+    if (zone.isFixedOffset()) {
+        // Shift the epoch so day 0 is a Sunday; the loop is then pure integer math
+        const std::int64_t offset = zone.getFixedOffsetMinutes() + 4LL * kMinutesPerDay;
+        for (size_t i = 0; i < count; ++i) {
+            std::int64_t minutes = floorDiv(toUnixSeconds(times[i]), kSecondsPerMinute) + offset;
+            std::int64_t wrapped = minutes % kMinutesPerWeek;
+            out[i] = static_cast<int>(wrapped < 0 ? wrapped + kMinutesPerWeek : wrapped);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = minuteOfWeek(times[i], zone);
+    }
+}
+
+// Parsing and formatting
+int parseHHMM(std::string_view text) {
+    // Accepts HH:MM and HH:MM:SS (seconds are ignored)
+    if (text.size() != 5 && text.size() != 8) return kInvalidMinute;
+    if (text[2] != ':') return kInvalidMinute;
+    if (text.size() == 8 && (text[5] != ':' || parseTwoDigits(text, 6) < 0)) return kInvalidMinute;
+
+    int hours = parseTwoDigits(text, 0);
+    int minutes = parseTwoDigits(text, 3);
+    if (hours < 0 || minutes < 0 || minutes >= kMinutesPerHour) return kInvalidMinute;
+    if (hours > 24 || (hours == 24 && minutes != 0)) return kInvalidMinute;
+
+    return hours * kMinutesPerHour + minutes;
+}
+
+std::string formatHHMM(int minute_of_day) {
+    if (minute_of_day < 0 || minute_of_day > kMinutesPerDay) return "";
+
+    int hours = minute_of_day / kMinutesPerHour;
+    int minutes = minute_of_day % kMinutesPerHour;
+
+    std::string result(5, '0');
+    result[0] = static_cast<char>('0' + hours / 10);
+    result[1] = static_cast<char>('0' + hours % 10);
+    result[2] = ':';
+    result[3] = static_cast<char>('0' + minutes / 10);
+    result[4] = static_cast<char>('0' + minutes % 10);
+    return result;
+}
+
+int dayIndexFromName(std::string_view day_name) {
+    for (int day = 0; day < kDaysPerWeek; ++day) {
+        std::string_view candidate(kDayNames[day]);
+        if (candidate.size() != day_name.size()) continue;
+
+        bool matches = true;
+        for (size_t i = 0; i < candidate.size() && matches; ++i) {
+            matches = toUpperAscii(day_name[i]) == candidate[i];
+        }
+        if (matches) return day;
+    }
+    return -1;
+}
+
+const char* dayName(int day_index) {
+    if (day_index < 0 || day_index >= kDaysPerWeek) return "";
+    return kDayNames[day_index];
+}
+
+} // namespace healthcare::utils::civil
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "../../include/utils/ConsistentHashRing.h"
+#include <algorithm>
+
+namespace healthcare::utils {
+
+namespace {
+
+const std::string kNoOwner;
+
+// Final avalanche step from MurmurHash3, spreads FNV output across the ring
+std::uint64_t mix64(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+ConsistentHashRing::ConsistentHashRing(int virtual_nodes)
+    : virtual_nodes_(std::max(virtual_nodes, 1)) {
+}
+
+void ConsistentHashRing::addNode(const std::string& node_id) {
+    auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node_id);
+    if (it != nodes_.end() && *it == node_id) {
+        return;
+    }
+    nodes_.insert(it, node_id);
+    rebuild();
+}
+
+bool ConsistentHashRing::removeNode(const std::string& node_id) {
+    auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node_id);
+    if (it == nodes_.end() || *it != node_id) {
+        return false;
+    }
+    nodes_.erase(it);
+    rebuild();
+    return true;
+}
+
+void ConsistentHashRing::setNodes(const std::vector<std::string>& node_ids) {
+    nodes_ = node_ids;
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+    rebuild();
+}
+
+void ConsistentHashRing::clear() {
+    nodes_.clear();
+    points_.clear();
+}
+
+const std::string& ConsistentHashRing::getOwner(std::string_view key) const {
+    if (points_.empty()) {
+        return kNoOwner;
+    }
+
+    // First point clockwise from the key's hash, wrapping around the ring
+    std::uint64_t key_hash = hash(key);
+    auto it = std::lower_bound(points_.begin(), points_.end(), key_hash,
+        [](const std::pair<std::uint64_t, size_t>& point, std::uint64_t value) { return point.first < value; });
+    if (it == points_.end()) {
+        it = points_.begin();
+    }
+    return nodes_[it->second];
+}
+
+bool ConsistentHashRing::hasNode(const std::string& node_id) const {
+    return std::binary_search(nodes_.begin(), nodes_.end(), node_id);
+}
+
+std::uint64_t ConsistentHashRing::hash(std::string_view key) {
+    // FNV-1a
+    std::uint64_t value = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        value ^= c;
+        value *= 0x100000001b3ULL;
+    }
+    return mix64(value);
+}
+
+void ConsistentHashRing::rebuild() {
+    points_.clear();
+    points_.reserve(nodes_.size() * static_cast<size_t>(virtual_nodes_));
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        for (int replica = 0; replica < virtual_nodes_; ++replica) {
+            points_.emplace_back(hash(nodes_[i] + "#" + std::to_string(replica)), i);
+        }
+    }
+    std::sort(points_.begin(), points_.end());
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
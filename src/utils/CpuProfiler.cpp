@@ -0,0 +1,392 @@
+#include "../../include/utils/CpuProfiler.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+
+namespace healthcare::utils {
+
+namespace {
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+constexpr bool kSupported = true;
+#else
+constexpr bool kSupported = false;
+#endif
+
+constexpr int kMaxDepthLimit = 128;
+constexpr std::uintptr_t kMaxFrameSize = 100000;  // A bigger step means the chain is not frame pointers
+
+// One capture's samples, packed as [depth, pc0 (leaf), pc1, ...] records.
+// Words start zeroed, so a depth of 0 marks the end of written data.
+struct SampleBuffer {
+    std::unique_ptr<std::uintptr_t[]> words;
+    size_t capacity = 0;
+    int max_depth = 0;
+    std::atomic<size_t> used{0};
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+static_assert(std::atomic<size_t>::is_always_lock_free, "signal handler needs lock-free atomics");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "signal handler needs lock-free atomics");
+
+std::atomic<SampleBuffer*> active_buffer{nullptr};
+std::atomic<int> handlers_in_flight{0};
+
+// [low, high) of this thread's stack; zero until registerThread() runs.
+// Trivially constructed so the handler reads it without a TLS init call
+struct StackBounds {
+    std::uintptr_t low;
+    std::uintptr_t high;
+};
+thread_local StackBounds thread_stack{0, 0};
+
+// Follows saved frame pointers from the interrupted context, with the same
+// sanity checks gperftools uses: frames must move up the stack by a bounded
+// step, and every frame read must lie inside the thread's registered stack,
+// so a corrupt or missing frame pointer ends the walk instead of faulting
+int walkStack(void* context, std::uintptr_t* frames, int max_depth) {
+    if constexpr (!kSupported) {
+        return 0;
+    }
+#if defined(__linux__) && defined(__x86_64__)
+    const auto& machine = static_cast<ucontext_t*>(context)->uc_mcontext;
+    auto pc = static_cast<std::uintptr_t>(machine.gregs[REG_RIP]);
+    auto fp = static_cast<std::uintptr_t>(machine.gregs[REG_RBP]);
+    auto sp = static_cast<std::uintptr_t>(machine.gregs[REG_RSP]);
+#elif defined(__linux__) && defined(__aarch64__)
+    const auto& machine = static_cast<ucontext_t*>(context)->uc_mcontext;
+    auto pc = static_cast<std::uintptr_t>(machine.pc);
+    auto fp = static_cast<std::uintptr_t>(machine.regs[29]);
+    auto sp = static_cast<std::uintptr_t>(machine.sp);
+#else
+    std::uintptr_t pc = 0, fp = 0, sp = 0;
+    (void)context;
+#endif
+
+    int depth = 0;
+    frames[depth++] = pc;
+    const StackBounds bounds = thread_stack;
+    if (bounds.high == 0 || fp < sp || fp - sp > kMaxFrameSize) {
+        return depth;
+    }
+
+    constexpr std::uintptr_t kFrameRecordSize = 2 * sizeof(std::uintptr_t);
+    while (depth < max_depth && fp != 0 && (fp & (sizeof(std::uintptr_t) - 1)) == 0) {
+        if (fp < bounds.low || fp > bounds.high - kFrameRecordSize) {
+            break;
+        }
+        const auto* frame = reinterpret_cast<const std::uintptr_t*>(fp);
+        std::uintptr_t next_fp = frame[0];
+        std::uintptr_t return_address = frame[1];
+        if (return_address == 0) {
+            break;
+        }
+        frames[depth++] = return_address;
+        if (next_fp <= fp || next_fp - fp > kMaxFrameSize) {
+            break;
+        }
+        fp = next_fp;
+    }
+    return depth;
+}
+
+void onProfileSignal(int /*signal*/, siginfo_t* /*info*/, void* context) {
+    int saved_errno = errno;
+    handlers_in_flight.fetch_add(1);
+
+    // Re-read after announcing ourselves; capture() clears it before waiting
+    SampleBuffer* buffer = active_buffer.load();
+    if (buffer != nullptr) {
+        std::uintptr_t frames[kMaxDepthLimit];
+        int depth = walkStack(context, frames, buffer->max_depth);
+        size_t record = static_cast<size_t>(depth) + 1;
+        size_t start = buffer->used.fetch_add(record, std::memory_order_relaxed);
+        if (depth > 0 && start + record <= buffer->capacity) {
+            std::memcpy(&buffer->words[start + 1], frames, static_cast<size_t>(depth) * sizeof(std::uintptr_t));
+            buffer->words[start] = static_cast<std::uintptr_t>(depth);
+            buffer->samples.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    handlers_in_flight.fetch_sub(1);
+    errno = saved_errno;
+}
+
+// Installed on first capture and never removed: a SIGPROF still pending
+// when a capture ends would otherwise hit the default action and kill us
+bool installSignalHandler() {
+    static bool installed = [] {
+        struct sigaction action{};
+        action.sa_sigaction = onProfileSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        return sigaction(SIGPROF, &action, nullptr) == 0;
+    }();
+    return installed;
+}
+
+std::string symbolize(std::uintptr_t address) {
+    char buffer[32];
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void*>(address), &info) != 0) {
+        if (info.dli_sname != nullptr) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string name = (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+            std::free(demangled);
+            return name;
+        }
+        if (info.dli_fname != nullptr) {
+            const char* module = std::strrchr(info.dli_fname, '/');
+            module = module ? module + 1 : info.dli_fname;
+            auto base = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+            std::snprintf(buffer, sizeof(buffer), "+0x%llx", static_cast<unsigned long long>(address - base));
+            return std::string(module) + buffer;
+        }
+    }
+    std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(address));
+    return buffer;
+}
+
+} // namespace
+
+// CpuProfile
+
+std::string CpuProfile::toFolded() const {
+    std::unordered_map<std::uintptr_t, std::string> names;
+    auto nameOf = [&names](std::uintptr_t address) -> const std::string& {
+        auto it = names.find(address);
+        if (it == names.end()) {
+            std::string name = symbolize(address);
+            std::replace(name.begin(), name.end(), ';', ':');  // ';' separates frames
+            it = names.emplace(address, std::move(name)).first;
+        }
+        return it->second;
+    };
+
+    // Distinct PCs within one function render the same, so merge by line
+    std::unordered_map<std::string, std::uint64_t> lines;
+    for (const auto& stack : stacks) {
+        std::string line;
+        // Root first; return addresses point past the call, so look up the call itself
+        for (size_t i = stack.frames.size(); i-- > 0;) {
+            line += nameOf(i == 0 ? stack.frames[i] : stack.frames[i] - 1);
+            if (i > 0) line += ';';
+        }
+        lines[line] += stack.count;
+    }
+
+    std::vector<std::pair<std::string, std::uint64_t>> ordered(lines.begin(), lines.end());
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::string out;
+    for (const auto& [line, count] : ordered) {
+        out += line;
+        out += ' ';
+        out += std::to_string(count);
+        out += '\n';
+    }
+    return out;
+}
+
+// Header, then [count, depth, pcs...] per stack, a trailer and /proc/self/maps
+// so pprof can map addresses back to binaries
+std::string CpuProfile::toPprof() const {
+    std::vector<std::uintptr_t> words = {
+        0, 3, 0, static_cast<std::uintptr_t>(frequency_hz > 0 ? 1000000 / frequency_hz : 10000), 0
+    };
+    for (const auto& stack : stacks) {
+        words.push_back(static_cast<std::uintptr_t>(stack.count));
+        words.push_back(stack.frames.size());
+        words.insert(words.end(), stack.frames.begin(), stack.frames.end());
+    }
+    words.insert(words.end(), {0, 1, 0});
+
+    std::string out(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(std::uintptr_t));
+    std::ifstream maps("/proc/self/maps");
+    std::ostringstream maps_text;
+    maps_text << maps.rdbuf();
+    out += maps_text.str();
+    return out;
+}
+
+// CpuProfiler
+
+CpuProfiler& CpuProfiler::getInstance() {
+    static CpuProfiler instance;
+    return instance;
+}
+
+void CpuProfiler::configure(const ProfilerConfig& config) {
+    config_ = config;
+    config_.max_stack_depth = std::clamp(config_.max_stack_depth, 1, kMaxDepthLimit);
+}
+
+bool CpuProfiler::isSupported() const {
+    return kSupported;
+}
+
+void CpuProfiler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stopped_ = true;
+    }
+    stop_cv_.notify_all();
+}
+
+void CpuProfiler::registerThread() {
+    if (thread_stack.high != 0) {
+        return;
+    }
+#if defined(__linux__)
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return;
+    }
+    void* stack_address = nullptr;
+    size_t stack_size = 0;
+    if (pthread_attr_getstack(&attributes, &stack_address, &stack_size) == 0 && stack_size > 0) {
+        // high goes last: a sample taken in between sees an unregistered thread
+        auto low = reinterpret_cast<std::uintptr_t>(stack_address);
+        thread_stack.low = low;
+        std::atomic_signal_fence(std::memory_order_release);
+        thread_stack.high = low + stack_size;
+    }
+    pthread_attr_destroy(&attributes);
+#endif
+}
+
+CpuProfile CpuProfiler::capture(int seconds, int frequency_hz) {
+    CpuProfile profile;
+    profile.duration_seconds = seconds;
+    profile.frequency_hz = frequency_hz;
+
+    if (!config_.enabled) {
+        profile.error = "CPU profiling is disabled";
+        return profile;
+    }
+    if (!kSupported) {
+        profile.error = "CPU profiling is not supported on this platform";
+        return profile;
+    }
+    if (seconds < 1 || seconds > config_.max_seconds) {
+        profile.error = "seconds must be between 1 and " + std::to_string(config_.max_seconds);
+        return profile;
+    }
+    if (frequency_hz < 1 || frequency_hz > config_.max_hz) {
+        profile.error = "hz must be between 1 and " + std::to_string(config_.max_hz);
+        return profile;
+    }
+
+    std::unique_lock<std::mutex> lock(capture_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        profile.error = "A profile capture is already running";
+        return profile;
+    }
+    {
+        std::lock_guard<std::mutex> stop_lock(stop_mutex_);
+        if (stopped_) {
+            profile.error = "CPU profiler is shutting down";
+            return profile;
+        }
+    }
+    if (!installSignalHandler()) {
+        profile.error = std::string("Failed to install SIGPROF handler: ") + std::strerror(errno);
+        return profile;
+    }
+
+    auto buffer = std::make_unique<SampleBuffer>();
+    buffer->capacity = config_.buffer_mb * 1024 * 1024 / sizeof(std::uintptr_t);
+    buffer->words.reset(new std::uintptr_t[buffer->capacity]());
+    buffer->max_depth = config_.max_stack_depth;
+
+    struct sigevent event{};
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGPROF;
+    timer_t timer;
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &timer) != 0) {
+        profile.error = std::string("timer_create failed: ") + std::strerror(errno);
+        return profile;
+    }
+
+    long interval_ns = 1000000000L / frequency_hz;
+    struct itimerspec spec{};
+    spec.it_interval.tv_sec = interval_ns / 1000000000L;
+    spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+    spec.it_value = spec.it_interval;
+
+    active_buffer.store(buffer.get());
+    running_.store(true, std::memory_order_release);
+    LOG_INFO("CPU profile capture started: {}s at {} Hz", seconds, frequency_hz);
+
+    if (timer_settime(timer, 0, &spec, nullptr) == 0) {
+        std::unique_lock<std::mutex> stop_lock(stop_mutex_);
+        stop_cv_.wait_for(stop_lock, std::chrono::seconds(seconds), [this] { return stopped_; });
+        profile.success = true;
+    } else {
+        profile.error = std::string("timer_settime failed: ") + std::strerror(errno);
+    }
+
+    timer_delete(timer);
+    active_buffer.store(nullptr);
+    while (handlers_in_flight.load() != 0) {
+        std::this_thread::yield();
+    }
+    running_.store(false, std::memory_order_release);
+
+    // Merge identical stacks
+    std::map<std::vector<std::uintptr_t>, std::uint64_t> counts;
+    size_t end = std::min(buffer->used.load(), buffer->capacity);
+    for (size_t pos = 0; pos < end;) {
+        auto depth = static_cast<size_t>(buffer->words[pos]);
+        if (depth == 0 || pos + 1 + depth > end) {
+            break;
+        }
+        const std::uintptr_t* frames = &buffer->words[pos + 1];
+        counts[std::vector<std::uintptr_t>(frames, frames + depth)]++;
+        pos += depth + 1;
+    }
+
+    profile.samples = buffer->samples.load();
+    profile.dropped = buffer->dropped.load();
+    profile.stacks.reserve(counts.size());
+    for (auto& [frames, count] : counts) {
+        profile.stacks.push_back(CpuProfile::Stack{frames, count});
+    }
+
+    LOG_INFO("CPU profile capture finished: {} samples, {} unique stacks, {} dropped",
+             profile.samples, profile.stacks.size(), profile.dropped);
+    return profile;
+}
+
+// Utility functions
+
+std::string profileFormatToString(ProfileFormat format) {
+    return format == ProfileFormat::PPROF ? "pprof" : "folded";
+}
+
+ProfileFormat stringToProfileFormat(const std::string& format_str) {
+    return format_str == "pprof" ? ProfileFormat::PPROF : ProfileFormat::FOLDED;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "../../include/utils/GeoDistance.h"
+#include "../../include/utils/GeoIndex.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HEALTHCARE_GEO_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace healthcare::utils::geo {
+
+namespace {
+
+constexpr double kDegToRad = M_PI / 180.0;
+
+// Half-angle differences are folded into [0, pi/2], where the odd Taylor series
+// through x^17 stays below 1e-11 absolute error
+constexpr double kSinCoefficients[] = {
+    1.0,
+    -1.0 / 6.0,
+    1.0 / 120.0,
+    -1.0 / 5040.0,
+    1.0 / 362880.0,
+    -1.0 / 39916800.0,
+    1.0 / 6227020800.0,
+    -1.0 / 1307674368000.0,
+    1.0 / 355687428096000.0
+};
+
+// asin series through x^19; exact to double precision for x <= kAsinSeriesLimit
+// (distances up to ~2,560 km). Lanes beyond it use std::asin.
+constexpr double kAsinSeriesLimit = 0.2;
+constexpr double kAsinCoefficients[] = {
+    1.0,
+    1.0 / 6.0,
+    3.0 / 40.0,
+    5.0 / 112.0,
+    35.0 / 1152.0,
+    63.0 / 2816.0,
+    231.0 / 13312.0,
+    143.0 / 10240.0,
+    6435.0 / 557056.0,
+    12155.0 / 1245184.0
+};
+
+double haversineFromTerms(double sin_half_lat, double sin_half_lon, double cos_product) {
+    double a = sin_half_lat * sin_half_lat + cos_product * sin_half_lon * sin_half_lon;
+    return 2.0 * kEarthRadiusKm * std::asin(std::sqrt(std::min(a, 1.0)));
+}
+
+void batchDistanceScalar(const double* latitude_radians, const double* longitude_radians,
+                         const double* cos_latitude, size_t count,
+                         double latitude, double longitude, double* out) {
+    double query_lat = latitude * kDegToRad;
+    double query_lon = longitude * kDegToRad;
+    double query_cos = std::cos(query_lat);
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = haversineFromTerms(std::sin((latitude_radians[i] - query_lat) * 0.5),
+                                    std::sin((longitude_radians[i] - query_lon) * 0.5),
+                                    query_cos * cos_latitude[i]);
+    }
+}
+
+#ifdef HEALTHCARE_GEO_HAS_AVX2
+
+// sin^2 is symmetric about pi/2, so |x| folds to min(|x|, pi - |x|) before the series
+__attribute__((target("avx2,fma")))
+inline __m256d squaredSin(__m256d x) {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d folded = _mm256_andnot_pd(sign_mask, x);
+    folded = _mm256_min_pd(folded, _mm256_sub_pd(_mm256_set1_pd(M_PI), folded));
+
+    __m256d x2 = _mm256_mul_pd(folded, folded);
+    __m256d poly = _mm256_set1_pd(kSinCoefficients[8]);
+    for (int i = 7; i >= 0; --i) {
+        poly = _mm256_fmadd_pd(poly, x2, _mm256_set1_pd(kSinCoefficients[i]));
+    }
+    __m256d sine = _mm256_mul_pd(poly, folded);
+    return _mm256_mul_pd(sine, sine);
+}
+
+__attribute__((target("avx2,fma")))
+void batchDistanceAvx2(const double* latitude_radians, const double* longitude_radians,
+                       const double* cos_latitude, size_t count,
+                       double latitude, double longitude, double* out) {
+    double query_lat = latitude * kDegToRad;
+    double query_lon = longitude * kDegToRad;
+    double query_cos = std::cos(query_lat);
+
+    const __m256d v_query_lat = _mm256_set1_pd(query_lat);
+    const __m256d v_query_lon = _mm256_set1_pd(query_lon);
+    const __m256d v_query_cos = _mm256_set1_pd(query_cos);
+    const __m256d v_half = _mm256_set1_pd(0.5);
+    const __m256d v_one = _mm256_set1_pd(1.0);
+    const __m256d v_limit = _mm256_set1_pd(kAsinSeriesLimit);
+    const __m256d v_diameter = _mm256_set1_pd(2.0 * kEarthRadiusKm);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d lat = _mm256_loadu_pd(latitude_radians + i);
+        __m256d lon = _mm256_loadu_pd(longitude_radians + i);
+        __m256d cos_lat = _mm256_loadu_pd(cos_latitude + i);
+
+        __m256d sin2_lat = squaredSin(_mm256_mul_pd(_mm256_sub_pd(lat, v_query_lat), v_half));
+        __m256d sin2_lon = squaredSin(_mm256_mul_pd(_mm256_sub_pd(lon, v_query_lon), v_half));
+        __m256d a = _mm256_fmadd_pd(_mm256_mul_pd(v_query_cos, cos_lat), sin2_lon, sin2_lat);
+        __m256d h = _mm256_sqrt_pd(_mm256_min_pd(a, v_one));
+
+        if (_mm256_movemask_pd(_mm256_cmp_pd(h, v_limit, _CMP_GT_OQ)) == 0) {
+            __m256d h2 = _mm256_mul_pd(h, h);
+            __m256d poly = _mm256_set1_pd(kAsinCoefficients[9]);
+            for (int c = 8; c >= 0; --c) {
+                poly = _mm256_fmadd_pd(poly, h2, _mm256_set1_pd(kAsinCoefficients[c]));
+            }
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_mul_pd(poly, h), v_diameter));
+        } else {
+            // Rare long-haul lanes: finish the block with libm
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, h);
+            for (int lane = 0; lane < 4; ++lane) {
+                out[i + lane] = 2.0 * kEarthRadiusKm * std::asin(lanes[lane]);
+            }
+        }
+    }
+
+    if (i < count) {
+        batchDistanceScalar(latitude_radians + i, longitude_radians + i, cos_latitude + i,
+                            count - i, latitude, longitude, out + i);
+    }
+}
+
+#endif
+
+DistanceKernel detectDistanceKernel() {
+#ifdef HEALTHCARE_GEO_HAS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return DistanceKernel::AVX2;
+    }
+#endif
+    return DistanceKernel::SCALAR;
+}
+
+} // namespace
+
+// Kernel dispatch
+
+DistanceKernel activeDistanceKernel() {
+    static const DistanceKernel kernel = detectDistanceKernel();
+    return kernel;
+}
+
+bool isDistanceKernelSupported(DistanceKernel kernel) {
+    return kernel == DistanceKernel::SCALAR || activeDistanceKernel() == DistanceKernel::AVX2;
+}
+
+const char* distanceKernelName(DistanceKernel kernel) {
+    switch (kernel) {
+        case DistanceKernel::AVX2: return "avx2";
+        case DistanceKernel::SCALAR: return "scalar";
+    }
+    return "scalar";
+}
+
+void batchDistanceKm(const double* latitude_radians, const double* longitude_radians,
+                     const double* cos_latitude, size_t count,
+                     double latitude, double longitude, double* out) {
+    batchDistanceKm(activeDistanceKernel(), latitude_radians, longitude_radians, cos_latitude,
+                    count, latitude, longitude, out);
+}
+
+void batchDistanceKm(DistanceKernel kernel,
+                     const double* latitude_radians, const double* longitude_radians,
+                     const double* cos_latitude, size_t count,
+                     double latitude, double longitude, double* out) {
+#ifdef HEALTHCARE_GEO_HAS_AVX2
+    if (kernel == DistanceKernel::AVX2 && isDistanceKernelSupported(kernel)) {
+        batchDistanceAvx2(latitude_radians, longitude_radians, cos_latitude, count, latitude, longitude, out);
+        return;
+    }
+#else
+    (void)kernel;
+#endif
+    batchDistanceScalar(latitude_radians, longitude_radians, cos_latitude, count, latitude, longitude, out);
+}
+
+// CoordinateStore
+
+void CoordinateStore::reserve(size_t capacity) {
+    latitude_.reserve(capacity);
+    longitude_.reserve(capacity);
+    latitude_radians_.reserve(capacity);
+    longitude_radians_.reserve(capacity);
+    cos_latitude_.reserve(capacity);
+}
+
+size_t CoordinateStore::add(double latitude, double longitude) {
+    size_t index = latitude_.size();
+    latitude_.push_back(latitude);
+    longitude_.push_back(longitude);
+    latitude_radians_.push_back(latitude * kDegToRad);
+    longitude_radians_.push_back(longitude * kDegToRad);
+    cos_latitude_.push_back(std::cos(latitude * kDegToRad));
+    return index;
+}
+
+void CoordinateStore::set(size_t index, double latitude, double longitude) {
+    latitude_[index] = latitude;
+    longitude_[index] = longitude;
+    latitude_radians_[index] = latitude * kDegToRad;
+    longitude_radians_[index] = longitude * kDegToRad;
+    cos_latitude_[index] = std::cos(latitude * kDegToRad);
+}
+
+void CoordinateStore::swapRemove(size_t index) {
+    size_t last = latitude_.size() - 1;
+    if (index != last) {
+        latitude_[index] = latitude_[last];
+        longitude_[index] = longitude_[last];
+        latitude_radians_[index] = latitude_radians_[last];
+        longitude_radians_[index] = longitude_radians_[last];
+        cos_latitude_[index] = cos_latitude_[last];
+    }
+    latitude_.pop_back();
+    longitude_.pop_back();
+    latitude_radians_.pop_back();
+    longitude_radians_.pop_back();
+    cos_latitude_.pop_back();
+}
+
+void CoordinateStore::clear() {
+    latitude_.clear();
+    longitude_.clear();
+    latitude_radians_.clear();
+    longitude_radians_.clear();
+    cos_latitude_.clear();
+}
+
+void CoordinateStore::distancesFrom(double latitude, double longitude, double* out) const {
+    distancesFrom(activeDistanceKernel(), latitude, longitude, out);
+}
+
+void CoordinateStore::distancesFrom(DistanceKernel kernel, double latitude, double longitude, double* out) const {
+    batchDistanceKm(kernel, latitude_radians_.data(), longitude_radians_.data(), cos_latitude_.data(),
+                    latitude_.size(), latitude, longitude, out);
+}
+
+} // namespace healthcare::utils::geo
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "../../include/utils/GeoIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace healthcare::utils::geo {
+
+namespace {
+
+constexpr double kDegToRad = M_PI / 180.0;
+
+bool byDistance(const GeoHit& a, const GeoHit& b) {
+    return a.distance_km < b.distance_km;
+}
+
+} // namespace
+
+BoundingBox boundingBox(double latitude, double longitude, double radius_km) {
+    double delta_lat = radius_km / kKmPerDegreeLatitude;
+    BoundingBox box;
+    box.min_latitude = std::max(latitude - delta_lat, -90.0);
+    box.max_latitude = std::min(latitude + delta_lat, 90.0);
+
+    // Longitude degrees shrink with cos(latitude); use the widest latitude in the box
+    double widest = std::max(std::fabs(box.min_latitude), std::fabs(box.max_latitude));
+    double cos_lat = std::cos(widest * kDegToRad);
+    if (cos_lat < 1e-6 || box.max_latitude >= 90.0 || box.min_latitude <= -90.0) {
+        box.min_longitude = -180.0;
+        box.max_longitude = 180.0;
+    } else {
+        double delta_lon = radius_km / (kKmPerDegreeLatitude * cos_lat);
+        box.min_longitude = std::max(longitude - delta_lon, -180.0);
+        box.max_longitude = std::min(longitude + delta_lon, 180.0);
+    }
+    return box;
+}
+
+double haversineKm(double lat1, double lon1, double lat2, double lon2) {
+    double delta_lat = (lat2 - lat1) * kDegToRad;
+    double delta_lon = (lon2 - lon1) * kDegToRad;
+    double sin_lat = std::sin(delta_lat / 2);
+    double sin_lon = std::sin(delta_lon / 2);
+    double a = sin_lat * sin_lat + std::cos(lat1 * kDegToRad) * std::cos(lat2 * kDegToRad) * sin_lon * sin_lon;
+    return 2.0 * kEarthRadiusKm * std::asin(std::sqrt(std::min(a, 1.0)));
+}
+
+GeoIndex::GeoIndex(double cell_size_degrees)
+    : cell_size_degrees_(cell_size_degrees > 0.0 ? cell_size_degrees : kDefaultCellSizeDegrees) {
+}
+
+// Incremental maintenance
+
+void GeoIndex::upsert(const std::string& id, double latitude, double longitude) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    std::uint64_t cell_key = cellKey(cellIndex(latitude), cellIndex(longitude));
+    auto it = index_.find(id);
+
+    if (it != index_.end()) {
+        if (it->second.cell == cell_key) {
+            cells_[cell_key].coordinates.set(it->second.slot, latitude, longitude);
+            return;
+        }
+
+        // Moved to another cell
+        detach(it->second);
+    }
+
+    Cell& cell = cells_[cell_key];
+    size_t slot = cell.coordinates.add(latitude, longitude);
+    cell.ids.push_back(id);
+    index_[id] = {cell_key, slot};
+}
+
+bool GeoIndex::remove(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return false;
+    }
+    detach(it->second);
+    index_.erase(it);
+    return true;
+}
+
+void GeoIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear();
+    cells_.clear();
+}
+
+size_t GeoIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.size();
+}
+
+// Queries
+
+std::vector<GeoHit> GeoIndex::queryRadius(double latitude, double longitude, double radius_km) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<GeoHit> hits;
+    BoundingBox box = boundingBox(latitude, longitude, radius_km);
+
+    int min_lat_cell = cellIndex(box.min_latitude);
+    int max_lat_cell = cellIndex(box.max_latitude);
+    int min_lon_cell = cellIndex(box.min_longitude);
+    int max_lon_cell = cellIndex(box.max_longitude);
+
+    // Walk whichever is smaller: the cells under the box or the populated cells
+    size_t box_cells = static_cast<size_t>(max_lat_cell - min_lat_cell + 1) *
+                       static_cast<size_t>(max_lon_cell - min_lon_cell + 1);
+
+    std::vector<double> distances;
+    auto refine = [&](const Cell& cell) {
+        distances.resize(cell.ids.size());
+        cell.coordinates.distancesFrom(latitude, longitude, distances.data());
+
+        for (size_t slot = 0; slot < distances.size(); ++slot) {
+            if (distances[slot] <= radius_km) {
+                hits.push_back({cell.ids[slot], distances[slot]});
+            }
+        }
+    };
+
+    if (box_cells > cells_.size()) {
+        for (const auto& [cell_key, cell] : cells_) {
+            int lat_cell = static_cast<int>(static_cast<std::int32_t>(cell_key >> 32));
+            int lon_cell = static_cast<int>(static_cast<std::int32_t>(cell_key & 0xffffffffULL));
+            if (lat_cell < min_lat_cell || lat_cell > max_lat_cell ||
+                lon_cell < min_lon_cell || lon_cell > max_lon_cell) {
+                continue;
+            }
+            refine(cell);
+        }
+    } else {
+        for (int lat_cell = min_lat_cell; lat_cell <= max_lat_cell; ++lat_cell) {
+            for (int lon_cell = min_lon_cell; lon_cell <= max_lon_cell; ++lon_cell) {
+                auto cell_it = cells_.find(cellKey(lat_cell, lon_cell));
+                if (cell_it != cells_.end()) {
+                    refine(cell_it->second);
+                }
+            }
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), byDistance);
+    return hits;
+}
+
+std::vector<GeoHit> GeoIndex::nearest(double latitude, double longitude, size_t k, double max_radius_km) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<GeoHit> results;
+    if (k == 0 || index_.empty()) {
+        return results;
+    }
+
+    // Narrowest cell extent near the query bounds the distance to any unvisited ring
+    double cos_lat = std::cos(std::min(std::fabs(latitude) + cell_size_degrees_, 89.0) * kDegToRad);
+    double cell_km = cell_size_degrees_ * kKmPerDegreeLatitude * std::max(cos_lat, 0.01);
+    int max_ring = static_cast<int>(std::ceil(max_radius_km / cell_km)) + 1;
+
+    int center_lat = cellIndex(latitude);
+    int center_lon = cellIndex(longitude);
+
+    std::vector<GeoHit> pending;  // Min-heap on distance
+    auto heap_order = [](const GeoHit& a, const GeoHit& b) { return a.distance_km > b.distance_km; };
+
+    std::vector<double> distances;
+    auto collect = [&](int lat_cell, int lon_cell) {
+        auto cell_it = cells_.find(cellKey(lat_cell, lon_cell));
+        if (cell_it == cells_.end()) return;
+
+        const Cell& cell = cell_it->second;
+        distances.resize(cell.ids.size());
+        cell.coordinates.distancesFrom(latitude, longitude, distances.data());
+
+        for (size_t slot = 0; slot < distances.size(); ++slot) {
+            if (distances[slot] <= max_radius_km) {
+                pending.push_back({cell.ids[slot], distances[slot]});
+                std::push_heap(pending.begin(), pending.end(), heap_order);
+            }
+        }
+    };
+
+    for (int ring = 0; ring <= max_ring && results.size() < k; ++ring) {
+        if (ring == 0) {
+            collect(center_lat, center_lon);
+        } else {
+            for (int d = -ring; d <= ring; ++d) {
+                collect(center_lat - ring, center_lon + d);
+                collect(center_lat + ring, center_lon + d);
+            }
+            for (int d = -ring + 1; d <= ring - 1; ++d) {
+                collect(center_lat + d, center_lon - ring);
+                collect(center_lat + d, center_lon + ring);
+            }
+        }
+
+        // Emit everything that no unvisited ring can beat
+        double settled_km = ring == max_ring ? max_radius_km : ring * cell_km;
+        while (!pending.empty() && results.size() < k && pending.front().distance_km <= settled_km) {
+            std::pop_heap(pending.begin(), pending.end(), heap_order);
+            results.push_back(std::move(pending.back()));
+            pending.pop_back();
+        }
+    }
+
+    return results;
+}
+
+// Helpers
+
+int GeoIndex::cellIndex(double degrees) const {
+    return static_cast<int>(std::floor(degrees / cell_size_degrees_));
+}
+
+std::uint64_t GeoIndex::cellKey(int lat_cell, int lon_cell) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(lat_cell)) << 32) |
+           static_cast<std::uint32_t>(lon_cell);
+}
+
+void GeoIndex::detach(const Location& location) {
+    auto cell_it = cells_.find(location.cell);
+    Cell& cell = cell_it->second;
+
+    // Swap the last slot into the freed one to keep the columns dense
+    size_t last = cell.ids.size() - 1;
+    if (location.slot != last) {
+        cell.ids[location.slot] = std::move(cell.ids[last]);
+        index_[cell.ids[location.slot]].slot = location.slot;
+    }
+    cell.ids.pop_back();
+    cell.coordinates.swapRemove(location.slot);
+
+    if (cell.ids.empty()) {
+        cells_.erase(cell_it);
+    }
+}
+
+} // namespace healthcare::utils::geo
\ No newline at end of file
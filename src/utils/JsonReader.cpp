@@ -0,0 +1,386 @@
+#include "../../include/utils/JsonReader.h"
+#include "../../include/utils/JsonWriter.h"
+#include <charconv>
+
+namespace healthcare::utils {
+
+namespace {
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUtf8(std::string& out, std::uint32_t code_point) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+} // namespace
+
+// Navigation
+
+JsonReader::ValueType JsonReader::peek() {
+    skipWhitespace();
+    if (pos_ >= text_.size()) {
+        return ValueType::INVALID;
+    }
+
+    switch (text_[pos_]) {
+        case '{': return ValueType::OBJECT;
+        case '[': return ValueType::ARRAY;
+        case '"': return ValueType::STRING;
+        case 't':
+        case 'f': return ValueType::BOOLEAN;
+        case 'n': return ValueType::NULL_VALUE;
+        default: {
+            char c = text_[pos_];
+            return c == '-' || (c >= '0' && c <= '9') ? ValueType::NUMBER : ValueType::INVALID;
+        }
+    }
+}
+
+bool JsonReader::beginObject() {
+    if (peek() != ValueType::OBJECT) {
+        return fail("expected an object");
+    }
+    ++pos_;
+    first_member_ = true;
+    return true;
+}
+
+bool JsonReader::nextMember(std::string_view& key) {
+    if (failed()) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == '}') {
+        ++pos_;
+        first_member_ = false;
+        return false;
+    }
+    if (!first_member_) {
+        if (pos_ >= text_.size() || text_[pos_] != ',') {
+            return fail("expected ',' or '}'");
+        }
+        ++pos_;
+        skipWhitespace();
+    }
+    first_member_ = false;
+
+    if (pos_ >= text_.size() || text_[pos_] != '"') {
+        return fail("expected a member name");
+    }
+
+    // Keys without escapes are handed out as views into the input
+    size_t start = pos_ + 1;
+    size_t end = text_.find_first_of("\"\\", start);
+    bool plain = end != std::string_view::npos && text_[end] == '"';
+    for (size_t i = start; plain && i < end; ++i) {
+        auto c = static_cast<unsigned char>(text_[i]);
+        plain = c >= 0x20 && c < 0x80;
+    }
+
+    if (plain) {
+        key = text_.substr(start, end - start);
+        pos_ = end + 1;
+    } else {
+        key_buffer_.clear();
+        if (!parseString(&key_buffer_)) {
+            return false;
+        }
+        key = key_buffer_;
+    }
+
+    skipWhitespace();
+    if (pos_ >= text_.size() || text_[pos_] != ':') {
+        return fail("expected ':'");
+    }
+    ++pos_;
+    return true;
+}
+
+bool JsonReader::beginArray() {
+    if (peek() != ValueType::ARRAY) {
+        return fail("expected an array");
+    }
+    ++pos_;
+    first_element_ = true;
+    return true;
+}
+
+bool JsonReader::nextElement() {
+    if (failed()) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == ']') {
+        ++pos_;
+        first_element_ = false;
+        return false;
+    }
+    if (!first_element_) {
+        if (pos_ >= text_.size() || text_[pos_] != ',') {
+            return fail("expected ',' or ']'");
+        }
+        ++pos_;
+    }
+    first_element_ = false;
+    return true;
+}
+
+bool JsonReader::finish() {
+    if (failed()) {
+        return false;
+    }
+    skipWhitespace();
+    return pos_ == text_.size() || fail("unexpected trailing characters");
+}
+
+// Values
+
+bool JsonReader::readString(std::string& out) {
+    if (peek() != ValueType::STRING) {
+        return fail("expected a string");
+    }
+    out.clear();
+    return parseString(&out);
+}
+
+bool JsonReader::readNumber(double& out) {
+    if (peek() != ValueType::NUMBER) {
+        return fail("expected a number");
+    }
+
+    size_t end;
+    if (!scanNumber(end)) {
+        return false;
+    }
+    auto result = std::from_chars(text_.data() + pos_, text_.data() + end, out);
+    if (result.ec != std::errc()) {
+        return fail("number out of range");
+    }
+    pos_ = end;
+    return true;
+}
+
+bool JsonReader::readBool(bool& out) {
+    if (peek() != ValueType::BOOLEAN) {
+        return fail("expected a boolean");
+    }
+    out = text_[pos_] == 't';
+    return parseLiteral(out ? "true" : "false");
+}
+
+bool JsonReader::skipValue() {
+    return skipValue(0);
+}
+
+bool JsonReader::readRaw(std::string_view& out) {
+    peek();
+    size_t start = pos_;
+    if (!skipValue()) {
+        return false;
+    }
+    out = text_.substr(start, pos_ - start);
+    return true;
+}
+
+bool JsonReader::skipValue(int depth) {
+    if (depth > kMaxDepth) {
+        return fail("nesting too deep");
+    }
+
+    switch (peek()) {
+        case ValueType::OBJECT: {
+            if (!beginObject()) return false;
+            std::string_view key;
+            while (nextMember(key)) {
+                if (!skipValue(depth + 1)) return false;
+            }
+            return !failed();
+        }
+        case ValueType::ARRAY: {
+            ++pos_;
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ']') {
+                ++pos_;
+                return true;
+            }
+            while (true) {
+                if (!skipValue(depth + 1)) return false;
+                skipWhitespace();
+                if (pos_ >= text_.size()) return fail("unterminated array");
+                char c = text_[pos_++];
+                if (c == ']') return true;
+                if (c != ',') return fail("expected ',' or ']'");
+            }
+        }
+        case ValueType::STRING:
+            return parseString(nullptr);
+        case ValueType::NUMBER: {
+            size_t end;
+            if (!scanNumber(end)) return false;
+            pos_ = end;
+            return true;
+        }
+        case ValueType::BOOLEAN:
+            return parseLiteral(text_[pos_] == 't' ? "true" : "false");
+        case ValueType::NULL_VALUE:
+            return parseLiteral("null");
+        case ValueType::INVALID:
+            break;
+    }
+    return fail(pos_ >= text_.size() ? "unexpected end of input" : "unexpected character");
+}
+
+// Lexing
+
+bool JsonReader::fail(const char* message) {
+    if (error_.empty()) {
+        error_ = std::string(message) + " at offset " + std::to_string(pos_);
+    }
+    return false;
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        ++pos_;
+    }
+}
+
+bool JsonReader::parseLiteral(std::string_view literal) {
+    if (text_.substr(pos_, literal.size()) != literal) {
+        return fail("invalid literal");
+    }
+    pos_ += literal.size();
+    return true;
+}
+
+bool JsonReader::scanNumber(size_t& end) {
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    size_t i = pos_;
+    auto digit = [this](size_t at) { return at < text_.size() && text_[at] >= '0' && text_[at] <= '9'; };
+
+    if (i < text_.size() && text_[i] == '-') ++i;
+    if (!digit(i)) return fail("invalid number");
+    if (text_[i] == '0') {
+        ++i;
+    } else {
+        while (digit(i)) ++i;
+    }
+
+    if (i < text_.size() && text_[i] == '.') {
+        ++i;
+        if (!digit(i)) return fail("invalid number");
+        while (digit(i)) ++i;
+    }
+    if (i < text_.size() && (text_[i] == 'e' || text_[i] == 'E')) {
+        ++i;
+        if (i < text_.size() && (text_[i] == '+' || text_[i] == '-')) ++i;
+        if (!digit(i)) return fail("invalid number");
+        while (digit(i)) ++i;
+    }
+
+    end = i;
+    return true;
+}
+
+bool JsonReader::parseString(std::string* out) {
+    ++pos_;  // Opening quote
+    size_t run_start = pos_;
+
+    while (pos_ < text_.size()) {
+        auto c = static_cast<unsigned char>(text_[pos_]);
+
+        if (c == '"') {
+            if (out) out->append(text_.data() + run_start, pos_ - run_start);
+            ++pos_;
+            return true;
+        }
+        if (c < 0x20) {
+            return fail("control character in string");
+        }
+        if (c >= 0x80) {
+            size_t length = utf8SequenceLength(reinterpret_cast<const unsigned char*>(text_.data()) + pos_,
+                                               text_.size() - pos_);
+            if (length == 0) {
+                return fail("invalid UTF-8 in string");
+            }
+            pos_ += length;
+            continue;
+        }
+        if (c != '\\') {
+            ++pos_;
+            continue;
+        }
+
+        if (out) out->append(text_.data() + run_start, pos_ - run_start);
+        if (++pos_ >= text_.size()) break;
+
+        char escape = text_[pos_++];
+        switch (escape) {
+            case '"': if (out) out->push_back('"'); break;
+            case '\\': if (out) out->push_back('\\'); break;
+            case '/': if (out) out->push_back('/'); break;
+            case 'b': if (out) out->push_back('\b'); break;
+            case 'f': if (out) out->push_back('\f'); break;
+            case 'n': if (out) out->push_back('\n'); break;
+            case 'r': if (out) out->push_back('\r'); break;
+            case 't': if (out) out->push_back('\t'); break;
+            case 'u': {
+                auto readHex4 = [this](std::uint32_t& value) {
+                    if (pos_ + 4 > text_.size()) return false;
+                    value = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        int digit = hexDigit(text_[pos_++]);
+                        if (digit < 0) return false;
+                        value = (value << 4) | static_cast<std::uint32_t>(digit);
+                    }
+                    return true;
+                };
+
+                std::uint32_t code_point;
+                if (!readHex4(code_point)) return fail("invalid \\u escape");
+
+                // Surrogates must come as a high/low pair
+                if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                    std::uint32_t low;
+                    if (text_.substr(pos_, 2) != "\\u") return fail("unpaired surrogate");
+                    pos_ += 2;
+                    if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) return fail("unpaired surrogate");
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                    return fail("unpaired surrogate");
+                }
+                if (out) appendUtf8(*out, code_point);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+        }
+        run_start = pos_;
+    }
+    return fail("unterminated string");
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
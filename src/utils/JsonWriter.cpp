@@ -0,0 +1,227 @@
+#include "../../include/utils/JsonWriter.h"
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace healthcare::utils {
+
+// Structure
+
+void JsonWriter::separate() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (depth_ == 0) {
+        return;
+    }
+
+    std::uint64_t bit = std::uint64_t{1} << (depth_ - 1);
+    if (first_flags_ & bit) {
+        first_flags_ &= ~bit;
+    } else {
+        out_.push_back(',');
+    }
+}
+
+void JsonWriter::open(char bracket) {
+    if (depth_ >= kMaxDepth) {
+        throw std::length_error("JSON nesting exceeds JsonWriter::kMaxDepth");
+    }
+    separate();
+    out_.push_back(bracket);
+    first_flags_ |= std::uint64_t{1} << depth_;
+    depth_++;
+}
+
+void JsonWriter::close(char bracket) {
+    depth_--;
+    first_flags_ &= ~(std::uint64_t{1} << depth_);
+    out_.push_back(bracket);
+}
+
+void JsonWriter::beginObject() {
+    open('{');
+}
+
+void JsonWriter::endObject() {
+    close('}');
+}
+
+void JsonWriter::beginArray() {
+    open('[');
+}
+
+void JsonWriter::endArray() {
+    close(']');
+}
+
+void JsonWriter::key(std::string_view name) {
+    separate();
+    writeEscaped(name);
+    out_.push_back(':');
+    after_key_ = true;
+}
+
+void JsonWriter::rollback(const Checkpoint& checkpoint) {
+    out_.resize(checkpoint.size);
+    first_flags_ = checkpoint.first_flags;
+    depth_ = checkpoint.depth;
+    after_key_ = checkpoint.after_key;
+}
+
+// Values
+
+void JsonWriter::value(std::string_view text) {
+    separate();
+    writeEscaped(text);
+}
+
+void JsonWriter::value(bool flag) {
+    separate();
+    out_.append(flag ? "true" : "false");
+}
+
+void JsonWriter::value(double number) {
+    separate();
+    if (!std::isfinite(number)) {
+        out_.append("null");
+        return;
+    }
+
+    // nlohmann's own Grisu2 formatter, so doubles render exactly as dump() does
+    char buffer[64];
+    char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, static_cast<size_t>(end - buffer));
+}
+
+void JsonWriter::value(const Uuid& id) {
+    separate();
+    if (id.isNil()) {
+        out_.append("\"\"");
+        return;
+    }
+
+    size_t offset = out_.size();
+    out_.resize(offset + Uuid::kStringLength + 2);
+    out_[offset] = '"';
+    id.format(&out_[offset + 1]);
+    out_[offset + Uuid::kStringLength + 1] = '"';
+}
+
+void JsonWriter::value(const std::chrono::system_clock::time_point& time) {
+    writeSigned(static_cast<long long>(std::chrono::system_clock::to_time_t(time)));
+}
+
+void JsonWriter::value(const std::vector<std::string>& strings) {
+    beginArray();
+    for (const auto& text : strings) {
+        value(text);
+    }
+    endArray();
+}
+
+void JsonWriter::null() {
+    separate();
+    out_.append("null");
+}
+
+void JsonWriter::writeSigned(long long number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+void JsonWriter::writeUnsigned(unsigned long long number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+void JsonWriter::writeEscaped(std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+
+    out_.push_back('"');
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+    size_t run_start = 0;
+    size_t i = 0;
+
+    // Copy runs of plain characters in one append; only escapes and multi-byte
+    // sequences leave the fast path
+    while (i < size) {
+        unsigned char c = bytes[i];
+        if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        if (c >= 0x80) {
+            size_t length = utf8SequenceLength(bytes + i, size - i);
+            if (length == 0) {
+                throw std::invalid_argument("Invalid UTF-8 in JSON string");
+            }
+            i += length;
+            continue;
+        }
+
+        out_.append(text.data() + run_start, i - run_start);
+        switch (c) {
+            case '"': out_.append("\\\""); break;
+            case '\\': out_.append("\\\\"); break;
+            case '\b': out_.append("\\b"); break;
+            case '\f': out_.append("\\f"); break;
+            case '\n': out_.append("\\n"); break;
+            case '\r': out_.append("\\r"); break;
+            case '\t': out_.append("\\t"); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0x0F]};
+                out_.append(escape, sizeof(escape));
+                break;
+            }
+        }
+        run_start = ++i;
+    }
+
+    out_.append(text.data() + run_start, size - run_start);
+    out_.push_back('"');
+}
+
+// UTF-8
+
+// Overlong forms, surrogates and code points past U+10FFFF are rejected
+size_t utf8SequenceLength(const unsigned char* text, size_t available) {
+    unsigned char lead = text[0];
+    size_t length;
+    unsigned char min_second = 0x80;
+    unsigned char max_second = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) min_second = 0xA0;
+        if (lead == 0xED) max_second = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) min_second = 0x90;
+        if (lead == 0xF4) max_second = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (available < length || text[1] < min_second || text[1] > max_second) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if (text[i] < 0x80 || text[i] > 0xBF) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
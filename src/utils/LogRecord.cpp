@@ -0,0 +1,173 @@
+#include "../../include/utils/LogRecord.h"
+#include "../../include/utils/JsonWriter.h"
+#include <cstring>
+
+namespace healthcare::utils {
+
+namespace {
+
+template<typename T>
+void appendRaw(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool readRaw(std::string_view bytes, size_t& pos, T& value) {
+    if (bytes.size() - pos < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, bytes.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+// Log input is untrusted (paths, headers); JsonWriter rejects invalid UTF-8
+void writeSanitized(JsonWriter& writer, std::string_view text, std::string& scratch) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t i = 0;
+    while (i < text.size()) {
+        if (bytes[i] < 0x80) {
+            ++i;
+        } else if (size_t length = utf8SequenceLength(bytes + i, text.size() - i)) {
+            i += length;
+        } else {
+            break;
+        }
+    }
+    if (i == text.size()) {
+        writer.value(text);
+        return;
+    }
+
+    scratch.assign(text.data(), i);
+    while (i < text.size()) {
+        size_t length = bytes[i] < 0x80 ? 1 : utf8SequenceLength(bytes + i, text.size() - i);
+        if (length == 0) {
+            scratch.append("\xEF\xBF\xBD");
+            ++i;
+        } else {
+            scratch.append(text.data() + i, length);
+            i += length;
+        }
+    }
+    writer.value(std::string_view(scratch));
+}
+
+} // namespace
+
+// Encoding
+
+void LogRecordEncoder::begin(const LogFormat& format) {
+    buffer_.clear();
+    const LogFormat* pointer = &format;
+    appendRaw(buffer_, pointer);
+}
+
+void LogRecordEncoder::add(std::string_view text) {
+    buffer_.push_back(static_cast<char>(STRING));
+    appendRaw(buffer_, static_cast<std::uint32_t>(text.size()));
+    buffer_.append(text.data(), text.size());
+}
+
+void LogRecordEncoder::add(bool flag) {
+    buffer_.push_back(static_cast<char>(BOOLEAN));
+    buffer_.push_back(flag ? 1 : 0);
+}
+
+void LogRecordEncoder::add(double number) {
+    buffer_.push_back(static_cast<char>(DOUBLE));
+    appendRaw(buffer_, number);
+}
+
+void LogRecordEncoder::add(std::nullptr_t) {
+    buffer_.push_back(static_cast<char>(NULL_VALUE));
+}
+
+void LogRecordEncoder::addSigned(long long number) {
+    buffer_.push_back(static_cast<char>(SIGNED));
+    appendRaw(buffer_, static_cast<std::int64_t>(number));
+}
+
+void LogRecordEncoder::addUnsigned(unsigned long long number) {
+    buffer_.push_back(static_cast<char>(UNSIGNED));
+    appendRaw(buffer_, static_cast<std::uint64_t>(number));
+}
+
+// Rendering
+
+bool renderLogRecord(std::string_view bytes, std::string& out) {
+    size_t pos = 0;
+    const LogFormat* format = nullptr;
+    if (!readRaw(bytes, pos, format) || format == nullptr) {
+        return false;
+    }
+
+    size_t start = out.size();
+    std::string scratch;
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.field("event", format->event);
+
+    for (size_t index = 0; pos < bytes.size(); ++index) {
+        // Values past the declared names still render rather than vanish
+        if (index < format->fields.size()) {
+            writer.key(format->fields[index]);
+        } else {
+            writer.key("_" + std::to_string(index));
+        }
+
+        auto tag = static_cast<std::uint8_t>(bytes[pos++]);
+        bool valid = true;
+        switch (tag) {
+            case LogRecordEncoder::NULL_VALUE:
+                writer.null();
+                break;
+            case LogRecordEncoder::BOOLEAN: {
+                std::uint8_t flag = 0;
+                valid = readRaw(bytes, pos, flag);
+                if (valid) writer.value(flag != 0);
+                break;
+            }
+            case LogRecordEncoder::SIGNED: {
+                std::int64_t number = 0;
+                valid = readRaw(bytes, pos, number);
+                if (valid) writer.value(static_cast<long long>(number));
+                break;
+            }
+            case LogRecordEncoder::UNSIGNED: {
+                std::uint64_t number = 0;
+                valid = readRaw(bytes, pos, number);
+                if (valid) writer.value(static_cast<unsigned long long>(number));
+                break;
+            }
+            case LogRecordEncoder::DOUBLE: {
+                double number = 0.0;
+                valid = readRaw(bytes, pos, number);
+                if (valid) writer.value(number);
+                break;
+            }
+            case LogRecordEncoder::STRING: {
+                std::uint32_t length = 0;
+                valid = readRaw(bytes, pos, length) && bytes.size() - pos >= length;
+                if (valid) {
+                    writeSanitized(writer, bytes.substr(pos, length), scratch);
+                    pos += length;
+                }
+                break;
+            }
+            default:
+                valid = false;
+                break;
+        }
+
+        if (!valid) {
+            out.resize(start);
+            return false;
+        }
+    }
+
+    writer.endObject();
+    return true;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
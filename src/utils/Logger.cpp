@@ -1,261 +1,367 @@
 #include "../../include/utils/Logger.h"
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
-#include <spdlog/sinks/daily_file_sink.h>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
+#include <typeinfo>
 
 namespace healthcare::utils {
 
+namespace {
+
+constexpr size_t kMaxLogFileSize = 100 * 1024 * 1024;
+constexpr size_t kMaxLogFiles = 10;
+
+spdlog::level::level_enum toSpdlogLevel(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return spdlog::level::trace;
+        case LogLevel::DEBUG: return spdlog::level::debug;
+        case LogLevel::INFO: return spdlog::level::info;
+        case LogLevel::WARN: return spdlog::level::warn;
+        case LogLevel::ERROR: return spdlog::level::err;
+        case LogLevel::CRITICAL: return spdlog::level::critical;
+    }
+    return spdlog::level::info;
+}
+
+const char* overflowPolicyToString(LogOverflowPolicy policy) {
+    switch (policy) {
+        case LogOverflowPolicy::BLOCK: return "BLOCK";
+        case LogOverflowPolicy::DROP_OLDEST: return "DROP_OLDEST";
+        case LogOverflowPolicy::SAMPLE: return "SAMPLE";
+    }
+    return "DROP_OLDEST";
+}
+
+} // namespace
+
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
 }
 
-void Logger::initialize(const LogConfig& config) {
-    config_ = config;
-    
+void Logger::configure(const std::string& level, const std::string& log_file,
+                       bool enable_console, const std::string& pattern,
+                       const AsyncLogConfig& async_config) {
+    current_level_ = stringToLogLevel(level);
+    log_file_path_ = log_file;
+    console_enabled_ = enable_console;
+    async_config_ = async_config;
+
     try {
+        // Only the async writer thread touches these, so the _st variants suffice
         std::vector<spdlog::sink_ptr> sinks;
-        
-        // Console sink
-        if (config_.enable_console) {
-            auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-            console_sink->set_level(spdlog::level::from_str(config_.log_level));
-            console_sink->set_pattern(config_.pattern);
-            sinks.push_back(console_sink);
+        if (console_enabled_) {
+            sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
         }
-        
-        // File sink
-        if (config_.enable_file) {
-            spdlog::sink_ptr file_sink;
-            
-            if (config_.use_daily_rotation) {
-                file_sink = std::make_shared<spdlog::sinks::daily_file_sink_mt>(
-                    config_.file_path, 
-                    config_.rotation_hour, 
-                    config_.rotation_minute
-                );
-            } else {
-                file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                    config_.file_path,
-                    config_.max_file_size,
-                    config_.max_files
-                );
-            }
-            
-            file_sink->set_level(spdlog::level::from_str(config_.log_level));
-            file_sink->set_pattern(config_.pattern);
-            sinks.push_back(file_sink);
+        if (!log_file_path_.empty()) {
+            sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_st>(
+                log_file_path_, kMaxLogFileSize, kMaxLogFiles));
         }
-        
-        // Create logger
-        logger_ = std::make_shared<spdlog::logger>("healthcare", sinks.begin(), sinks.end());
-        logger_->set_level(spdlog::level::from_str(config_.log_level));
-        logger_->flush_on(spdlog::level::err);
-        
-        // Register as default logger
+
+        async_sink_ = std::make_shared<AsyncLogSink>("healthcare", std::move(sinks), async_config_);
+        async_sink_->set_pattern(pattern);
+
+        logger_ = std::make_shared<spdlog::logger>("healthcare", async_sink_);
+        logger_->set_level(toSpdlogLevel(current_level_));
+        logger_->flush_on(spdlog::level::off);  // The writer flushes once per batch
+
         spdlog::set_default_logger(logger_);
-        
-        // Set flush interval
-        spdlog::flush_every(std::chrono::seconds(config_.flush_interval_seconds));
-        
-        info("Logger initialized with level: {}", config_.log_level);
-        
+
+        info("Logger initialized with level: {}, overflow policy: {}", level,
+             overflowPolicyToString(async_config_.overflow));
     } catch (const spdlog::spdlog_ex& ex) {
         std::cerr << "Logger initialization failed: " << ex.what() << std::endl;
     }
 }
 
-void Logger::setLogLevel(const std::string& level) {
-    if (logger_) {
-        logger_->set_level(spdlog::level::from_str(level));
-        config_.log_level = level;
-        info("Log level changed to: {}", level);
-    }
+// Basic logging methods
+
+void Logger::trace(const std::string& message) {
+    if (logger_) logger_->trace(message);
 }
 
-void Logger::enableFileLogging(const std::string& file_path) {
-    config_.enable_file = true;
-    config_.file_path = file_path;
-    initialize(config_); // Reinitialize with new config
+void Logger::debug(const std::string& message) {
+    if (logger_) logger_->debug(message);
 }
 
-void Logger::disableFileLogging() {
-    config_.enable_file = false;
-    initialize(config_); // Reinitialize with new config
+void Logger::info(const std::string& message) {
+    if (logger_) logger_->info(message);
 }
 
-void Logger::enableConsoleLogging() {
-    config_.enable_console = true;
-    initialize(config_); // Reinitialize with new config
+void Logger::warn(const std::string& message) {
+    if (logger_) logger_->warn(message);
 }
 
-void Logger::disableConsoleLogging() {
-    config_.enable_console = false;
-    initialize(config_); // Reinitialize with new config
+void Logger::error(const std::string& message) {
+    if (logger_) logger_->error(message);
 }
 
-void Logger::flush() {
-    if (logger_) {
-        logger_->flush();
-    }
+void Logger::critical(const std::string& message) {
+    if (logger_) logger_->critical(message);
 }
 
-void Logger::logWithContext(const std::string& level, const std::string& message, const nlohmann::json& context) {
-    if (!logger_) return;
-    
-    nlohmann::json log_entry;
+// Structured logging
+
+void Logger::logWithContext(LogLevel level, const std::string& message, const nlohmann::json& context) {
+    if (!logger_ || !isLevelEnabled(level)) return;
+
+    nlohmann::json log_entry = createLogContext("log");
     log_entry["message"] = message;
     log_entry["context"] = context;
-    log_entry["timestamp"] = getCurrentTimestamp();
-    
-    auto level_enum = spdlog::level::from_str(level);
-    logger_->log(level_enum, log_entry.dump());
+
+    logger_->log(toSpdlogLevel(level), log_entry.dump());
 }
 
-void Logger::logRequest(const std::string& method, const std::string& path, 
-                       const std::string& client_ip, const nlohmann::json& headers) {
+void Logger::submitRecord(LogLevel level, const LogRecordEncoder& encoder) {
+    if (async_sink_) {
+        async_sink_->logRecord(toSpdlogLevel(level), encoder.bytes());
+    }
+}
+
+void Logger::logRequest(const std::string& method, const std::string& endpoint,
+                        const std::string& user_id, const nlohmann::json& params) {
+    if (!isLevelEnabled(LogLevel::INFO)) return;
+
     nlohmann::json context;
     context["type"] = "request";
     context["method"] = method;
-    context["path"] = path;
-    context["client_ip"] = client_ip;
-    context["headers"] = headers;
-    
-    info("HTTP Request: {} {}", method, path);
-    logWithContext("debug", "Request details", context);
+    context["endpoint"] = endpoint;
+    context["user_id"] = user_id;
+    context["params"] = params;
+
+    logWithContext(LogLevel::INFO, "HTTP Request: " + method + " " + endpoint, context);
 }
 
-void Logger::logResponse(const std::string& method, const std::string& path, 
-                        int status_code, double response_time_ms) {
+void Logger::logResponse(const std::string& endpoint, int status_code,
+                         double duration_ms, const std::string& user_id) {
+    LogLevel level = (status_code >= 500) ? LogLevel::ERROR :
+                     (status_code >= 400) ? LogLevel::WARN : LogLevel::INFO;
+    if (!isLevelEnabled(level)) return;
+
     nlohmann::json context;
     context["type"] = "response";
-    context["method"] = method;
-    context["path"] = path;
+    context["endpoint"] = endpoint;
     context["status_code"] = status_code;
-    context["response_time_ms"] = response_time_ms;
-    
-    std::string level = (status_code >= 500) ? "error" : 
-                       (status_code >= 400) ? "warn" : "info";
-    
-    logWithContext(level, 
-        "HTTP Response: " + method + " " + path + " - " + std::to_string(status_code), 
-        context);
-}
-
-void Logger::logError(const std::string& error_type, const std::string& message, 
-                     const nlohmann::json& details) {
+    context["duration_ms"] = duration_ms;
+    context["user_id"] = user_id;
+
+    logWithContext(level, "HTTP Response: " + endpoint + " - " + std::to_string(status_code), context);
+}
+
+void Logger::logError(const std::string& message, const std::exception& ex,
+                      const nlohmann::json& context) {
+    nlohmann::json error_context;
+    error_context["type"] = "error";
+    error_context["exception_type"] = typeid(ex).name();
+    error_context["exception_message"] = ex.what();
+    error_context["details"] = context;
+
+    logWithContext(LogLevel::ERROR, message, error_context);
+}
+
+void Logger::logUserAction(const std::string& user_id, const std::string& action,
+                           const nlohmann::json& details) {
     nlohmann::json context;
-    context["type"] = "error";
-    context["error_type"] = error_type;
+    context["type"] = "user_action";
+    context["user_id"] = user_id;
+    context["action"] = action;
     context["details"] = details;
-    context["stack_trace"] = getStackTrace();
-    
-    error("{}: {}", error_type, message);
-    logWithContext("error", "Error details", context);
+
+    logWithContext(LogLevel::INFO, "User action: " + action, context);
 }
 
-void Logger::logException(const std::exception& e, const nlohmann::json& context) {
-    nlohmann::json error_context = context;
-    error_context["exception_type"] = typeid(e).name();
-    error_context["exception_message"] = e.what();
-    
-    logError("Exception", e.what(), error_context);
+void Logger::logSystemEvent(const std::string& event, const nlohmann::json& details) {
+    nlohmann::json context;
+    context["type"] = "system_event";
+    context["event"] = event;
+    context["details"] = details;
+
+    logWithContext(LogLevel::INFO, "System event: " + event, context);
 }
 
-void Logger::logBusinessEvent(const std::string& event_type, const std::string& entity_type,
-                             const std::string& entity_id, const nlohmann::json& details) {
+void Logger::logSecurityEvent(const std::string& event, const std::string& user_id,
+                              const nlohmann::json& details) {
     nlohmann::json context;
-    context["type"] = "business_event";
-    context["event_type"] = event_type;
-    context["entity_type"] = entity_type;
-    context["entity_id"] = entity_id;
+    context["type"] = "security_event";
+    context["event"] = event;
+    context["user_id"] = user_id;
     context["details"] = details;
-    
-    info("Business Event: {} - {} {}", event_type, entity_type, entity_id);
-    logWithContext("info", "Business event details", context);
+
+    logWithContext(LogLevel::WARN, "Security event: " + event, context);
 }
 
-void Logger::logPerformance(const std::string& operation, double duration_ms, 
-                           const nlohmann::json& metrics) {
+void Logger::logPerformance(const std::string& operation, double duration_ms,
+                            const nlohmann::json& metrics) {
+    // Log as warning if operation takes more than 1 second
+    LogLevel level = duration_ms > 1000 ? LogLevel::WARN : LogLevel::DEBUG;
+    if (!isLevelEnabled(level)) return;
+
     nlohmann::json context;
     context["type"] = "performance";
     context["operation"] = operation;
     context["duration_ms"] = duration_ms;
     context["metrics"] = metrics;
-    
-    if (duration_ms > 1000) { // Log as warning if operation takes more than 1 second
-        warn("Slow operation: {} took {}ms", operation, duration_ms);
-    } else {
-        debug("Performance: {} completed in {}ms", operation, duration_ms);
-    }
-    
-    logWithContext("debug", "Performance metrics", context);
+
+    logWithContext(level, "Performance: " + operation, context);
 }
 
-void Logger::logDatabase(const std::string& query, double execution_time_ms, bool success) {
+void Logger::logDatabaseQuery(const std::string& query, double duration_ms, int affected_rows) {
+    LogLevel level = duration_ms > 100 ? LogLevel::WARN : LogLevel::DEBUG;
+    if (!isLevelEnabled(level)) return;
+
     nlohmann::json context;
     context["type"] = "database";
-    context["query"] = query.substr(0, 200); // Truncate long queries
-    context["execution_time_ms"] = execution_time_ms;
-    context["success"] = success;
-    
-    if (!success) {
-        error("Database query failed: {}", query.substr(0, 50));
-    } else if (execution_time_ms > 100) {
-        warn("Slow query ({}ms): {}", execution_time_ms, query.substr(0, 50));
-    } else {
-        debug("Database query executed in {}ms", execution_time_ms);
-    }
-    
-    logWithContext("debug", "Database query details", context);
+    context["query"] = query.substr(0, 200);  // Truncate long queries
+    context["duration_ms"] = duration_ms;
+    context["affected_rows"] = affected_rows;
+
+    logWithContext(level, duration_ms > 100 ? "Slow query" : "Database query", context);
+}
+
+void Logger::logDatabaseError(const std::string& query, const std::string& error) {
+    nlohmann::json context;
+    context["type"] = "database_error";
+    context["query"] = query.substr(0, 200);
+    context["error"] = error;
+
+    logWithContext(LogLevel::ERROR, "Database query failed", context);
 }
 
-void Logger::logPayment(const std::string& transaction_id, const std::string& status,
-                       double amount, const std::string& currency, const nlohmann::json& details) {
+void Logger::logPaymentEvent(const std::string& event, const std::string& payment_id,
+                             const std::string& user_id, double amount,
+                             const nlohmann::json& details) {
     nlohmann::json context;
     context["type"] = "payment";
-    context["transaction_id"] = transaction_id;
-    context["status"] = status;
+    context["event"] = event;
+    context["payment_id"] = payment_id;
+    context["user_id"] = user_id;
     context["amount"] = amount;
-    context["currency"] = currency;
     context["details"] = details;
-    
-    info("Payment Transaction: {} - {} {} {}", transaction_id, status, amount, currency);
-    logWithContext("info", "Payment details", context);
+
+    logWithContext(LogLevel::INFO, "Payment " + event + ": " + payment_id, context);
 }
 
-void Logger::logAppointment(const std::string& appointment_id, const std::string& action,
-                           const nlohmann::json& details) {
+void Logger::logAppointmentEvent(const std::string& event, const std::string& appointment_id,
+                                 const std::string& user_id, const std::string& doctor_id,
+                                 const nlohmann::json& details) {
     nlohmann::json context;
     context["type"] = "appointment";
+    context["event"] = event;
     context["appointment_id"] = appointment_id;
-    context["action"] = action;
+    context["user_id"] = user_id;
+    context["doctor_id"] = doctor_id;
     context["details"] = details;
-    
-    info("Appointment {}: {}", action, appointment_id);
-    logWithContext("info", "Appointment details", context);
+
+    logWithContext(LogLevel::INFO, "Appointment " + event + ": " + appointment_id, context);
+}
+
+void Logger::beginRequestCapture() {
+    if (async_sink_) {
+        async_sink_->beginCapture();
+    }
+}
+
+void Logger::endRequestCapture(bool keep) {
+    if (async_sink_) {
+        async_sink_->endCapture(keep);
+    }
+}
+
+// Utility methods
+
+void Logger::setLogLevel(LogLevel level) {
+    current_level_ = level;
+    if (logger_) {
+        logger_->set_level(toSpdlogLevel(level));
+    }
+}
+
+LogLevel Logger::getLogLevel() const {
+    return current_level_;
+}
+
+void Logger::flush() {
+    if (logger_) {
+        logger_->flush();
+    }
+}
+
+bool Logger::isLevelEnabled(LogLevel level) const {
+    return logger_ && logger_->should_log(toSpdlogLevel(level));
+}
+
+bool Logger::isHealthy() const {
+    return logger_ && async_sink_ && async_sink_->isRunning();
+}
+
+nlohmann::json Logger::getLoggerStats() const {
+    nlohmann::json stats;
+    stats["level"] = logLevelToString(current_level_);
+    stats["log_file"] = log_file_path_;
+    stats["console_enabled"] = console_enabled_;
+    stats["healthy"] = isHealthy();
+
+    if (async_sink_) {
+        AsyncLogStats async_stats = async_sink_->getStats();
+        stats["async"] = {
+            {"overflow_policy", overflowPolicyToString(async_config_.overflow)},
+            {"producer_threads", async_stats.producer_threads},
+            {"enqueued", async_stats.enqueued},
+            {"written", async_stats.written},
+            {"dropped", async_stats.dropped},
+            {"sampled_out", async_stats.sampled_out},
+            {"truncated", async_stats.truncated},
+            {"blocked", async_stats.blocked},
+            {"batches", async_stats.batches},
+            {"tail_discarded", async_stats.tail_discarded},
+            {"capture_overflows", async_stats.capture_overflows}
+        };
+    }
+    return stats;
+}
+
+// Helper methods
+
+std::string Logger::logLevelToString(LogLevel level) const {
+    switch (level) {
+        case LogLevel::TRACE: return "TRACE";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::CRITICAL: return "CRITICAL";
+    }
+    return "INFO";
+}
+
+LogLevel Logger::stringToLogLevel(const std::string& level) const {
+    if (level == "TRACE") return LogLevel::TRACE;
+    if (level == "DEBUG") return LogLevel::DEBUG;
+    if (level == "WARN") return LogLevel::WARN;
+    if (level == "ERROR") return LogLevel::ERROR;
+    if (level == "CRITICAL") return LogLevel::CRITICAL;
+    return LogLevel::INFO;
 }
 
-std::string Logger::getCurrentTimestamp() const {
+nlohmann::json Logger::createLogContext(const std::string& event_type) const {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()
     ) % 1000;
-    
+
+    std::tm utc{};
+    gmtime_r(&time_t, &utc);
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    
-    return ss.str();
-}
+    ss << std::put_time(&utc, "%Y-%m-%dT%H:%M:%S");
+    ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
 
-std::string Logger::getStackTrace() const {
-    // In a real implementation, this would use platform-specific
-    // stack trace functionality (e.g., backtrace on Linux)
-    return "Stack trace not available";
+    nlohmann::json context;
+    context["type"] = event_type;
+    context["timestamp"] = ss.str();
+    return context;
 }
 
 } // namespace healthcare::utils
\ No newline at end of file
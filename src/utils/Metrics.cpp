@@ -0,0 +1,299 @@
+#include "../../include/utils/Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace healthcare::utils {
+
+namespace {
+
+std::atomic<size_t> next_histogram_index{0};
+
+constexpr double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+constexpr std::string_view kOtherLabel = "(other)";
+
+std::uint64_t hashLabels(std::string_view first, std::string_view second) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](std::string_view text) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(first);
+    hash ^= 0xff;  // Keeps ("ab", "c") apart from ("a", "bc")
+    hash *= 1099511628211ULL;
+    mix(second);
+    return hash;
+}
+
+void appendEscaped(std::string& out, std::string_view value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+// {a="x",b="y",quantile="0.99"}; empty when there is nothing to print
+void appendLabels(std::string& out, const std::vector<std::string>& names,
+                  std::string_view first, std::string_view second, const char* quantile) {
+    bool any = false;
+    auto label = [&](std::string_view name, std::string_view value) {
+        out += any ? ',' : '{';
+        any = true;
+        out.append(name.data(), name.size());
+        out += "=\"";
+        appendEscaped(out, value);
+        out += '"';
+    };
+    if (names.size() > 0) label(names[0], first);
+    if (names.size() > 1) label(names[1], second);
+    if (quantile) label("quantile", quantile);
+    if (any) out += '}';
+}
+
+} // namespace
+
+// LatencyHistogram
+
+LatencyHistogram::LatencyHistogram()
+    : index_(next_histogram_index.fetch_add(1, std::memory_order_relaxed)) {}
+
+size_t LatencyHistogram::bucketIndex(std::uint64_t micros) {
+    if (micros < kSubBuckets) {
+        return static_cast<size_t>(micros);
+    }
+    micros = std::min(micros, kMaxTrackableMicros);
+    int exponent = 63 - __builtin_clzll(micros);
+    int shift = exponent - kSubBucketBits;
+    size_t sub_bucket = static_cast<size_t>(micros >> shift) & (kSubBuckets - 1);
+    return static_cast<size_t>(shift + 1) * kSubBuckets + sub_bucket;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    int shift = static_cast<int>(index / kSubBuckets) - 1;
+    std::uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+    return lower + (std::uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    std::uint64_t nanos = duration.count() > 0 ? static_cast<std::uint64_t>(duration.count()) : 0;
+    std::uint64_t micros = nanos / 1000;
+
+    // Only this thread writes its shard, so plain load/store is enough
+    Shard& shard = localShard();
+    auto& bucket = shard.buckets[bucketIndex(micros)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    shard.count.store(shard.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    shard.sum_ns.store(shard.sum_ns.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+    if (micros > shard.max_us.load(std::memory_order_relaxed)) {
+        shard.max_us.store(micros, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::recordMillis(double duration_ms) {
+    record(std::chrono::nanoseconds(static_cast<std::int64_t>(duration_ms * 1e6)));
+}
+
+LatencyHistogram::Shard& LatencyHistogram::localShard() {
+    thread_local std::vector<Shard*> thread_shards;  // Indexed by index_
+    if (index_ < thread_shards.size() && thread_shards[index_] != nullptr) {
+        return *thread_shards[index_];
+    }
+    return attachShard(thread_shards);
+}
+
+// First record from this thread; the shard stays with the histogram after the thread exits
+LatencyHistogram::Shard& LatencyHistogram::attachShard(std::vector<Shard*>& thread_shards) {
+    if (thread_shards.size() <= index_) {
+        thread_shards.resize(std::max(index_ + 1, thread_shards.size() * 2), nullptr);
+    }
+
+    auto shard = std::make_unique<Shard>();
+    Shard* raw = shard.get();
+    {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        shards_.push_back(std::move(shard));
+    }
+    thread_shards[index_] = raw;
+    return *raw;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot merged;
+    merged.buckets.assign(kBucketCount, 0);
+
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            merged.buckets[i] += shard->buckets[i].load(std::memory_order_relaxed);
+        }
+        merged.count += shard->count.load(std::memory_order_relaxed);
+        merged.sum_ns += shard->sum_ns.load(std::memory_order_relaxed);
+        merged.max_us = std::max(merged.max_us, shard->max_us.load(std::memory_order_relaxed));
+    }
+    return merged;
+}
+
+std::uint64_t LatencyHistogram::Snapshot::quantileMicros(double q) const {
+    // Buckets and count are read separately from live shards; trust the buckets
+    std::uint64_t total = 0;
+    for (std::uint64_t bucket : buckets) total += bucket;
+    if (total == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max_us);
+        }
+    }
+    return max_us;
+}
+
+// LatencyFamily
+
+LatencyFamily::LatencyFamily(std::string name, std::string help, std::vector<std::string> label_names)
+    : name_(std::move(name)), help_(std::move(help)), label_names_(std::move(label_names)) {
+    for (auto& slot : slots_) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+    other_ = std::make_unique<Series>();
+    other_->first = label_names_.size() > 0 ? std::string(kOtherLabel) : std::string();
+    other_->second = label_names_.size() > 1 ? std::string(kOtherLabel) : std::string();
+}
+
+LatencyHistogram& LatencyFamily::series(std::string_view first, std::string_view second) {
+    std::uint64_t hash = hashLabels(first, second);
+    Series* found = find(first, second, hash);
+    return found ? found->histogram : insert(first, second, hash).histogram;
+}
+
+LatencyFamily::Series* LatencyFamily::find(std::string_view first, std::string_view second,
+                                           std::uint64_t hash) const {
+    for (size_t probe = 0; probe < kTableSize; ++probe) {
+        Series* series = slots_[(hash + probe) & (kTableSize - 1)].load(std::memory_order_acquire);
+        if (series == nullptr) {
+            return nullptr;
+        }
+        if (series->first == first && series->second == second) {
+            return series;
+        }
+    }
+    return nullptr;
+}
+
+LatencyFamily::Series& LatencyFamily::insert(std::string_view first, std::string_view second,
+                                             std::uint64_t hash) {
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+
+    if (Series* existing = find(first, second, hash)) {
+        return *existing;
+    }
+    if (series_.size() >= kMaxSeries) {
+        return *other_;
+    }
+
+    auto series = std::make_unique<Series>();
+    series->first.assign(first.data(), first.size());
+    series->second.assign(second.data(), second.size());
+
+    size_t slot = hash & (kTableSize - 1);
+    while (slots_[slot].load(std::memory_order_relaxed) != nullptr) {
+        slot = (slot + 1) & (kTableSize - 1);
+    }
+    slots_[slot].store(series.get(), std::memory_order_release);
+    series_.push_back(std::move(series));
+    return *series_.back();
+}
+
+void LatencyFamily::render(std::string& out) const {
+    out += "# HELP " + name_ + " " + help_ + "\n";
+    out += "# TYPE " + name_ + " summary\n";
+
+    auto renderSeries = [&](const Series& series) {
+        LatencyHistogram::Snapshot snapshot = series.histogram.snapshot();
+        if (snapshot.count == 0) {
+            return;
+        }
+        for (double q : kQuantiles) {
+            char quantile[16];
+            std::snprintf(quantile, sizeof(quantile), "%g", q);
+            out += name_;
+            appendLabels(out, label_names_, series.first, series.second, quantile);
+            out += ' ';
+            appendNumber(out, static_cast<double>(snapshot.quantileMicros(q)) / 1e6);
+            out += '\n';
+        }
+        out += name_ + "_sum";
+        appendLabels(out, label_names_, series.first, series.second, nullptr);
+        out += ' ';
+        appendNumber(out, static_cast<double>(snapshot.sum_ns) / 1e9);
+        out += '\n';
+        out += name_ + "_count";
+        appendLabels(out, label_names_, series.first, series.second, nullptr);
+        out += ' ' + std::to_string(snapshot.count) + '\n';
+    };
+
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+    for (const auto& series : series_) {
+        renderSeries(*series);
+    }
+    renderSeries(*other_);
+}
+
+// MetricsRegistry
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+LatencyFamily& MetricsRegistry::latencyFamily(const std::string& name, const std::string& help,
+                                              std::vector<std::string> label_names) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        if (family->name() == name) {
+            return *family;
+        }
+    }
+    families_.push_back(std::make_unique<LatencyFamily>(name, help, std::move(label_names)));
+    return *families_.back();
+}
+
+void MetricsRegistry::addCollector(std::function<void(std::string&)> collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors_.push_back(std::move(collector));
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::string out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        family->render(out);
+    }
+    for (const auto& collector : collectors_) {
+        collector(out);
+    }
+    return out;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
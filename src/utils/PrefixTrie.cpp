@@ -0,0 +1,261 @@
+#include "../../include/utils/PrefixTrie.h"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+
+namespace healthcare::utils {
+
+namespace {
+
+constexpr std::uint32_t kNoNode = UINT32_MAX;
+constexpr std::uint32_t kRoot = 0;
+
+size_t commonPrefixLength(const std::string& a, size_t a_offset, const std::string& b) {
+    size_t length = 0;
+    while (a_offset + length < a.size() && length < b.size() && a[a_offset + length] == b[length]) {
+        ++length;
+    }
+    return length;
+}
+
+} // namespace
+
+PrefixTrie::PrefixTrie() {
+    clear();
+}
+
+std::string PrefixTrie::foldKey(const std::string& term) {
+    std::string key;
+    key.reserve(term.size());
+    bool pending_space = false;
+
+    // Lowercase and collapse runs of whitespace so "New  Delhi " == "new delhi"
+    for (unsigned char c : term) {
+        if (std::isspace(c)) {
+            pending_space = !key.empty();
+            continue;
+        }
+        if (pending_space) {
+            key.push_back(' ');
+            pending_space = false;
+        }
+        key.push_back(static_cast<char>(std::tolower(c)));
+    }
+    return key;
+}
+
+// Updates
+
+void PrefixTrie::set(const std::string& term, std::int64_t weight) {
+    std::string key = foldKey(term);
+    if (key.empty()) return;
+
+    std::vector<std::uint32_t> path;
+    std::uint32_t node = descendOrCreate(key, path);
+    if (nodes_[node].weight == kNoWeight) {
+        ++size_;
+    }
+    nodes_[node].weight = weight;
+    nodes_[node].display = term;
+    refreshBest(path);
+}
+
+void PrefixTrie::add(const std::string& term, std::int64_t delta) {
+    std::string key = foldKey(term);
+    if (key.empty()) return;
+
+    std::vector<std::uint32_t> path;
+    std::uint32_t node = descendOrCreate(key, path);
+    if (nodes_[node].weight == kNoWeight) {
+        ++size_;
+        nodes_[node].weight = delta;
+        nodes_[node].display = term;
+    } else {
+        nodes_[node].weight += delta;
+    }
+    refreshBest(path);
+}
+
+bool PrefixTrie::remove(const std::string& term) {
+    std::vector<std::uint32_t> path;
+    std::uint32_t node = descend(foldKey(term), &path);
+    if (node == kNoNode || nodes_[node].weight == kNoWeight) {
+        return false;
+    }
+
+    // The node stays as an interior branch; only its term is dropped
+    nodes_[node].weight = kNoWeight;
+    nodes_[node].display.clear();
+    --size_;
+    refreshBest(path);
+    return true;
+}
+
+void PrefixTrie::clear() {
+    nodes_.clear();
+    nodes_.emplace_back();
+    size_ = 0;
+}
+
+// Queries
+
+std::optional<std::int64_t> PrefixTrie::weightOf(const std::string& term) const {
+    std::uint32_t node = descend(foldKey(term), nullptr);
+    if (node == kNoNode || nodes_[node].weight == kNoWeight) {
+        return std::nullopt;
+    }
+    return nodes_[node].weight;
+}
+
+std::vector<Suggestion> PrefixTrie::complete(const std::string& prefix, size_t limit) const {
+    std::vector<Suggestion> suggestions;
+    if (limit == 0) {
+        return suggestions;
+    }
+
+    // Locate the subtree; the prefix may end part-way along an edge
+    std::string key = foldKey(prefix);
+    std::uint32_t node = kRoot;
+    size_t offset = 0;
+    while (offset < key.size()) {
+        std::uint32_t child = findChild(node, key[offset]);
+        if (child == kNoNode) {
+            return suggestions;
+        }
+        const std::string& label = nodes_[child].label;
+        size_t matched = commonPrefixLength(key, offset, label);
+        if (matched < label.size() && offset + matched < key.size()) {
+            return suggestions;  // Diverges inside the edge
+        }
+        offset += matched;
+        node = child;
+    }
+
+    // Best-first: a node's `best` bounds everything beneath it, and a term entry
+    // is queued with its own weight, so entries pop in descending weight order
+    struct Entry {
+        std::int64_t weight;
+        std::uint32_t node;
+        bool is_term;
+        bool operator<(const Entry& other) const { return weight < other.weight; }
+    };
+
+    std::priority_queue<Entry> frontier;
+    if (nodes_[node].best != kNoWeight) {
+        frontier.push({nodes_[node].best, node, false});
+    }
+
+    while (!frontier.empty() && suggestions.size() < limit) {
+        Entry entry = frontier.top();
+        frontier.pop();
+        const Node& current = nodes_[entry.node];
+
+        if (entry.is_term) {
+            suggestions.push_back({current.display, current.weight});
+            continue;
+        }
+        if (current.weight != kNoWeight) {
+            frontier.push({current.weight, entry.node, true});
+        }
+        for (std::uint32_t child : current.children) {
+            if (nodes_[child].best != kNoWeight) {
+                frontier.push({nodes_[child].best, child, false});
+            }
+        }
+    }
+    return suggestions;
+}
+
+// Helpers
+
+std::uint32_t PrefixTrie::newNode(std::string label) {
+    nodes_.emplace_back();
+    nodes_.back().label = std::move(label);
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+std::uint32_t PrefixTrie::findChild(std::uint32_t node, char first) const {
+    const auto& children = nodes_[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), first,
+                               [this](std::uint32_t child, char c) { return nodes_[child].label[0] < c; });
+    if (it != children.end() && nodes_[*it].label[0] == first) {
+        return *it;
+    }
+    return kNoNode;
+}
+
+void PrefixTrie::insertChild(std::uint32_t parent, std::uint32_t child) {
+    char first = nodes_[child].label[0];
+    auto& children = nodes_[parent].children;
+    auto it = std::lower_bound(children.begin(), children.end(), first,
+                               [this](std::uint32_t existing, char c) { return nodes_[existing].label[0] < c; });
+    children.insert(it, child);
+}
+
+std::uint32_t PrefixTrie::descendOrCreate(const std::string& key, std::vector<std::uint32_t>& path) {
+    std::uint32_t node = kRoot;
+    size_t offset = 0;
+    path.push_back(node);
+
+    while (offset < key.size()) {
+        std::uint32_t child = findChild(node, key[offset]);
+        if (child == kNoNode) {
+            std::uint32_t leaf = newNode(key.substr(offset));
+            insertChild(node, leaf);
+            path.push_back(leaf);
+            return leaf;
+        }
+
+        size_t matched = commonPrefixLength(key, offset, nodes_[child].label);
+        if (matched < nodes_[child].label.size()) {
+            // Split the edge: parent -> middle(label[0, matched)) -> child(label[matched...])
+            std::uint32_t middle = newNode(nodes_[child].label.substr(0, matched));
+            nodes_[child].label.erase(0, matched);
+            nodes_[middle].children.push_back(child);
+            nodes_[middle].best = nodes_[child].best;
+
+            auto& siblings = nodes_[node].children;
+            std::replace(siblings.begin(), siblings.end(), child, middle);
+            child = middle;
+        }
+
+        offset += matched;
+        node = child;
+        path.push_back(node);
+    }
+    return node;
+}
+
+std::uint32_t PrefixTrie::descend(const std::string& key, std::vector<std::uint32_t>* path) const {
+    std::uint32_t node = kRoot;
+    size_t offset = 0;
+    if (path) path->push_back(node);
+
+    while (offset < key.size()) {
+        std::uint32_t child = findChild(node, key[offset]);
+        if (child == kNoNode) {
+            return kNoNode;
+        }
+        const std::string& label = nodes_[child].label;
+        if (key.compare(offset, label.size(), label) != 0) {
+            return kNoNode;
+        }
+        offset += label.size();
+        node = child;
+        if (path) path->push_back(node);
+    }
+    return node;
+}
+
+void PrefixTrie::refreshBest(const std::vector<std::uint32_t>& path) {
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        Node& node = nodes_[*it];
+        std::int64_t best = node.weight;
+        for (std::uint32_t child : node.children) {
+            best = std::max(best, nodes_[child].best);
+        }
+        node.best = best;
+    }
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../../include/utils/RequestArena.h"
+#include <algorithm>
+#include <memory>
+
+namespace healthcare::utils {
+
+namespace {
+
+// Sits between the monotonic arena and the thread's pool to see how much
+// a request spilled past the first buffer
+class OverflowCounter : public std::pmr::memory_resource {
+public:
+    explicit OverflowCounter(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+    size_t outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* memory = upstream_->allocate(bytes, alignment);
+        outstanding += bytes;
+        return memory;
+    }
+
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(memory, bytes, alignment);
+        outstanding -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+};
+
+std::pmr::pool_options overflowPoolOptions() {
+    std::pmr::pool_options options;
+    options.largest_required_pool_block = 1024 * 1024;  // Keep the arena's growing chunks pooled too
+    return options;
+}
+
+struct ThreadArena {
+    ThreadArena()
+        : buffer(std::make_unique<std::byte[]>(RequestArena::kInitialBufferSize)),
+          pool(overflowPoolOptions(), std::pmr::new_delete_resource()),
+          counter(&pool),
+          arena(buffer.get(), RequestArena::kInitialBufferSize, &counter) {}
+
+    std::unique_ptr<std::byte[]> buffer;
+    std::pmr::unsynchronized_pool_resource pool;
+    OverflowCounter counter;
+    std::pmr::monotonic_buffer_resource arena;
+    RequestArena::ThreadStats stats;
+};
+
+ThreadArena& threadArena() {
+    thread_local ThreadArena arena;
+    return arena;
+}
+
+// Null outside a request; checked before touching the lazily built ThreadArena
+thread_local ThreadArena* active_arena = nullptr;
+
+void releaseArena(ThreadArena& state) {
+    size_t overflow = state.counter.outstanding;
+    if (overflow > 0) {
+        state.stats.overflowed_requests++;
+        state.stats.peak_overflow_bytes = std::max(state.stats.peak_overflow_bytes, overflow);
+    }
+    // Hands overflow chunks back to the pool and rewinds to the first buffer
+    state.arena.release();
+}
+
+} // namespace
+
+std::pmr::memory_resource* RequestArena::begin() {
+    ThreadArena& state = threadArena();
+    if (active_arena != nullptr) {
+        releaseArena(state);  // after_handle never ran for the last request
+    }
+    state.stats.requests++;
+    active_arena = &state;
+    return &state.arena;
+}
+
+void RequestArena::end() {
+    if (active_arena == nullptr) {
+        return;
+    }
+    releaseArena(*active_arena);
+    active_arena = nullptr;
+}
+
+bool RequestArena::active() {
+    return active_arena != nullptr;
+}
+
+std::pmr::memory_resource* RequestArena::resource() {
+    return active_arena != nullptr ? static_cast<std::pmr::memory_resource*>(&active_arena->arena)
+                                   : std::pmr::get_default_resource();
+}
+
+RequestArena::ThreadStats RequestArena::threadStats() {
+    return threadArena().stats;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -1,7 +1,65 @@
 #include "../../include/utils/ResponseHelper.h"
+#include <algorithm>
 
 namespace healthcare::utils {
 
+namespace {
+
+// Largest body recently streamed on this thread; reserving it up front keeps a
+// streamed response to one allocation, which is then moved into the response
+thread_local size_t streamed_body_hint = 1024;
+
+crow::response streamEnvelope(const std::function<void(JsonWriter&)>& write_data,
+                              const std::string& message,
+                              const PaginationInfo* pagination) {
+    ApiResponse envelope(true, ErrorCode::SUCCESS);
+
+    std::string body;
+    body.reserve(streamed_body_hint);
+    JsonWriter writer(body);
+
+    // Keys follow ApiResponse::toJson's sorted dump order
+    writer.beginObject();
+
+    auto before_data = writer.checkpoint();
+    writer.key("data");
+    size_t data_start = body.size();
+    write_data(writer);
+    std::string_view data(body.data() + data_start, body.size() - data_start);
+    if (data == "null" || data == "[]" || data == "{}") {
+        writer.rollback(before_data);  // toJson() omits empty data
+    }
+
+    if (!message.empty()) {
+        writer.field("message", message);
+    }
+
+    if (pagination != nullptr) {
+        writer.key("pagination");
+        writer.beginObject();
+        writer.field("has_next", pagination->has_next);
+        writer.field("has_previous", pagination->has_previous);
+        writer.field("page", pagination->page);
+        writer.field("page_size", pagination->page_size);
+        writer.field("total_count", pagination->total_count);
+        writer.field("total_pages", pagination->total_pages);
+        writer.endObject();
+    }
+
+    writer.field("success", true);
+    writer.field("timestamp", envelope.timestamp);
+    writer.endObject();
+
+    streamed_body_hint = std::max(streamed_body_hint, body.size());
+
+    crow::response res(200);
+    res.set_header("Content-Type", "application/json");
+    res.body = std::move(body);
+    return res;
+}
+
+} // namespace
+
 crow::response ResponseHelper::success(const nlohmann::json& data, const std::string& message) {
     ApiResponse response(true, ErrorCode::SUCCESS);
     response.message = message;
@@ -46,6 +104,17 @@ crow::response ResponseHelper::successWithPagination(const nlohmann::json& data,
     return res;
 }
 
+crow::response ResponseHelper::streamSuccess(const std::function<void(JsonWriter&)>& write_data,
+                                             const std::string& message) {
+    return streamEnvelope(write_data, message, nullptr);
+}
+
+crow::response ResponseHelper::streamSuccessWithPagination(const std::function<void(JsonWriter&)>& write_data,
+                                                           const PaginationInfo& pagination,
+                                                           const std::string& message) {
+    return streamEnvelope(write_data, message, &pagination);
+}
+
 crow::response ResponseHelper::error(ErrorCode code, const std::string& message, 
                                    const nlohmann::json& details) {
     ApiResponse response(false, code);
@@ -0,0 +1,336 @@
+#include "../../include/utils/RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+namespace healthcare::utils {
+
+namespace {
+
+inline std::uint16_t highBits(std::uint32_t value) { return static_cast<std::uint16_t>(value >> 16); }
+inline std::uint16_t lowBits(std::uint32_t value) { return static_cast<std::uint16_t>(value & 0xffff); }
+
+} // namespace
+
+bool RoaringBitmap::Container::contains(std::uint16_t low) const {
+    if (is_bitmap) {
+        return (bitmap[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+// Updates
+
+void RoaringBitmap::add(std::uint32_t value) {
+    std::uint16_t key = highBits(value);
+    std::uint16_t low = lowBits(value);
+
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    if (it == containers_.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        container.count = 1;
+        container.array.push_back(low);
+        containers_.insert(it, std::move(container));
+        return;
+    }
+
+    Container& container = *it;
+    if (container.is_bitmap) {
+        std::uint64_t& word = container.bitmap[low >> 6];
+        std::uint64_t bit = std::uint64_t{1} << (low & 63);
+        if (!(word & bit)) {
+            word |= bit;
+            ++container.count;
+        }
+        return;
+    }
+
+    auto position = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (position != container.array.end() && *position == low) {
+        return;
+    }
+    container.array.insert(position, low);
+    ++container.count;
+    if (container.count > kArrayLimit) {
+        toBitmap(container);
+    }
+}
+
+bool RoaringBitmap::remove(std::uint32_t value) {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), highBits(value),
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    if (it == containers_.end() || it->key != highBits(value)) {
+        return false;
+    }
+
+    Container& container = *it;
+    std::uint16_t low = lowBits(value);
+    if (container.is_bitmap) {
+        std::uint64_t& word = container.bitmap[low >> 6];
+        std::uint64_t bit = std::uint64_t{1} << (low & 63);
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+        --container.count;
+        if (container.count <= kArrayLimit) {
+            toArray(container);
+        }
+    } else {
+        auto position = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (position == container.array.end() || *position != low) {
+            return false;
+        }
+        container.array.erase(position);
+        --container.count;
+    }
+
+    if (container.count == 0) {
+        containers_.erase(it);
+    }
+    return true;
+}
+
+// Queries
+
+bool RoaringBitmap::contains(std::uint32_t value) const {
+    const Container* container = find(highBits(value));
+    return container != nullptr && container->contains(lowBits(value));
+}
+
+std::uint64_t RoaringBitmap::cardinality() const {
+    std::uint64_t total = 0;
+    for (const auto& container : containers_) {
+        total += container.count;
+    }
+    return total;
+}
+
+std::vector<std::uint32_t> RoaringBitmap::toVector() const {
+    std::vector<std::uint32_t> values;
+    values.reserve(cardinality());
+    forEach([&values](std::uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+// Set operations
+
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    auto left = containers_.begin();
+    auto right = other.containers_.begin();
+
+    while (left != containers_.end() && right != other.containers_.end()) {
+        if (left->key < right->key) {
+            ++left;
+        } else if (right->key < left->key) {
+            ++right;
+        } else {
+            Container merged = intersect(*left, *right);
+            if (merged.count > 0) {
+                result.containers_.push_back(std::move(merged));
+            }
+            ++left;
+            ++right;
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    auto left = containers_.begin();
+    auto right = other.containers_.begin();
+
+    while (left != containers_.end() || right != other.containers_.end()) {
+        if (right == other.containers_.end() || (left != containers_.end() && left->key < right->key)) {
+            result.containers_.push_back(*left++);
+        } else if (left == containers_.end() || right->key < left->key) {
+            result.containers_.push_back(*right++);
+        } else {
+            result.containers_.push_back(unite(*left, *right));
+            ++left;
+            ++right;
+        }
+    }
+    return result;
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other) {
+    *this = *this & other;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other) {
+    *this = *this | other;
+    return *this;
+}
+
+std::uint64_t RoaringBitmap::andCardinality(const RoaringBitmap& other) const {
+    std::uint64_t total = 0;
+    auto left = containers_.begin();
+    auto right = other.containers_.begin();
+
+    while (left != containers_.end() && right != other.containers_.end()) {
+        if (left->key < right->key) {
+            ++left;
+        } else if (right->key < left->key) {
+            ++right;
+        } else {
+            total += intersectCount(*left, *right);
+            ++left;
+            ++right;
+        }
+    }
+    return total;
+}
+
+// Container helpers
+
+RoaringBitmap::Container* RoaringBitmap::find(std::uint16_t key) {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+const RoaringBitmap::Container* RoaringBitmap::find(std::uint16_t key) const {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, std::uint16_t k) { return container.key < k; });
+    return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+void RoaringBitmap::toBitmap(Container& container) {
+    container.bitmap.assign(kBitmapWords, 0);
+    for (std::uint16_t low : container.array) {
+        container.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+    }
+    container.array.clear();
+    container.array.shrink_to_fit();
+    container.is_bitmap = true;
+}
+
+void RoaringBitmap::toArray(Container& container) {
+    container.array.clear();
+    container.array.reserve(container.count);
+    for (size_t word = 0; word < kBitmapWords; ++word) {
+        std::uint64_t bits = container.bitmap[word];
+        while (bits != 0) {
+            container.array.push_back(static_cast<std::uint16_t>(word * 64 + __builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+    container.bitmap.clear();
+    container.bitmap.shrink_to_fit();
+    container.is_bitmap = false;
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (a.is_bitmap && b.is_bitmap) {
+        result.bitmap.resize(kBitmapWords);
+        std::uint32_t count = 0;
+        for (size_t word = 0; word < kBitmapWords; ++word) {
+            result.bitmap[word] = a.bitmap[word] & b.bitmap[word];
+            count += static_cast<std::uint32_t>(__builtin_popcountll(result.bitmap[word]));
+        }
+        result.is_bitmap = true;
+        result.count = count;
+        if (count <= kArrayLimit) {
+            toArray(result);
+        }
+        return result;
+    }
+
+    if (a.is_bitmap || b.is_bitmap) {
+        // Probe the bitmap with each array element
+        const Container& array = a.is_bitmap ? b : a;
+        const Container& bitmap = a.is_bitmap ? a : b;
+        for (std::uint16_t low : array.array) {
+            if (bitmap.contains(low)) {
+                result.array.push_back(low);
+            }
+        }
+    } else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+    }
+    result.count = static_cast<std::uint32_t>(result.array.size());
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+
+    if (!a.is_bitmap && !b.is_bitmap && a.count + b.count <= kArrayLimit) {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.count = static_cast<std::uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bitmap.assign(kBitmapWords, 0);
+    for (const Container* source : {&a, &b}) {
+        if (source->is_bitmap) {
+            for (size_t word = 0; word < kBitmapWords; ++word) {
+                result.bitmap[word] |= source->bitmap[word];
+            }
+        } else {
+            for (std::uint16_t low : source->array) {
+                result.bitmap[low >> 6] |= std::uint64_t{1} << (low & 63);
+            }
+        }
+    }
+
+    std::uint32_t count = 0;
+    for (std::uint64_t word : result.bitmap) {
+        count += static_cast<std::uint32_t>(__builtin_popcountll(word));
+    }
+    result.is_bitmap = true;
+    result.count = count;
+    if (count <= kArrayLimit) {
+        toArray(result);
+    }
+    return result;
+}
+
+std::uint64_t RoaringBitmap::intersectCount(const Container& a, const Container& b) {
+    std::uint64_t count = 0;
+
+    if (a.is_bitmap && b.is_bitmap) {
+        for (size_t word = 0; word < kBitmapWords; ++word) {
+            count += static_cast<std::uint64_t>(__builtin_popcountll(a.bitmap[word] & b.bitmap[word]));
+        }
+        return count;
+    }
+
+    if (a.is_bitmap || b.is_bitmap) {
+        const Container& array = a.is_bitmap ? b : a;
+        const Container& bitmap = a.is_bitmap ? a : b;
+        for (std::uint16_t low : array.array) {
+            count += bitmap.contains(low) ? 1 : 0;
+        }
+        return count;
+    }
+
+    // Merge walk over two sorted arrays
+    auto left = a.array.begin();
+    auto right = b.array.begin();
+    while (left != a.array.end() && right != b.array.end()) {
+        if (*left < *right) {
+            ++left;
+        } else if (*right < *left) {
+            ++right;
+        } else {
+            ++count;
+            ++left;
+            ++right;
+        }
+    }
+    return count;
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
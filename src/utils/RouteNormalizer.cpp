@@ -0,0 +1,173 @@
+#include "../../include/utils/RouteNormalizer.h"
+#include <cstring>
+
+namespace healthcare::utils {
+
+namespace {
+
+constexpr std::string_view kIdPlaceholder = ":id";
+constexpr std::string_view kOtherName = "(other)";
+
+bool isHex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// 8-4-4-4-12 hex digits, either case
+bool isUuid(std::string_view segment) {
+    if (segment.size() != 36) {
+        return false;
+    }
+    for (size_t i = 0; i < segment.size(); ++i) {
+        bool dash_position = i == 8 || i == 13 || i == 18 || i == 23;
+        if (dash_position ? segment[i] != '-' : !isHex(segment[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isNumeric(std::string_view segment) {
+    if (segment.empty()) {
+        return false;
+    }
+    for (char c : segment) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+std::uint64_t fnv1a(std::string_view key) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+RouteNormalizer& RouteNormalizer::getInstance() {
+    static RouteNormalizer instance;
+    return instance;
+}
+
+RouteNormalizer::RouteNormalizer() : entries_(new Entry[kMaxEndpoints]) {
+    for (auto& slot : slots_) {
+        slot.store(kOtherEndpoint, std::memory_order_relaxed);
+    }
+    std::memcpy(entries_[kOtherEndpoint].name, kOtherName.data(), kOtherName.size());
+    entries_[kOtherEndpoint].length = static_cast<std::uint8_t>(kOtherName.size());
+}
+
+RouteNormalizer::EndpointId RouteNormalizer::normalize(std::string_view path) {
+    char buffer[kMaxPathLength];
+    size_t length = 0;
+    if (!buildKey(path, buffer, length)) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        return kOtherEndpoint;
+    }
+
+    std::string_view key(buffer, length);
+    std::uint64_t hash = fnv1a(key);
+    EndpointId id = find(key, hash);
+    return id != kOtherEndpoint ? id : insert(key, hash);
+}
+
+RouteNormalizer::EndpointId RouteNormalizer::lookup(std::string_view path) const {
+    char buffer[kMaxPathLength];
+    size_t length = 0;
+    if (!buildKey(path, buffer, length)) {
+        return kOtherEndpoint;
+    }
+
+    std::string_view key(buffer, length);
+    return find(key, fnv1a(key));
+}
+
+std::string_view RouteNormalizer::name(EndpointId id) const {
+    if (id >= count_.load(std::memory_order_acquire)) {
+        return kOtherName;
+    }
+    return entries_[id].view();
+}
+
+bool RouteNormalizer::buildKey(std::string_view path, char* buffer, size_t& length) const {
+    size_t query = path.find('?');
+    if (query != std::string_view::npos) {
+        path = path.substr(0, query);
+    }
+
+    // Build the template on the stack, one segment at a time
+    length = 0;
+    size_t pos = 0;
+    while (pos < path.size()) {
+        if (path[pos] == '/') {
+            if (length == kMaxPathLength) {
+                return false;
+            }
+            buffer[length++] = '/';
+            ++pos;
+            continue;
+        }
+
+        size_t end = path.find('/', pos);
+        if (end == std::string_view::npos) {
+            end = path.size();
+        }
+        std::string_view segment = path.substr(pos, end - pos);
+        if (isNumeric(segment) || isUuid(segment)) {
+            segment = kIdPlaceholder;
+        }
+        if (length + segment.size() > kMaxPathLength) {
+            return false;
+        }
+        std::memcpy(buffer + length, segment.data(), segment.size());
+        length += segment.size();
+        pos = end;
+    }
+    return true;
+}
+
+RouteNormalizer::EndpointId RouteNormalizer::find(std::string_view key, std::uint64_t hash) const {
+    for (size_t probe = 0; probe < kTableSize; ++probe) {
+        size_t slot = (hash + probe) & (kTableSize - 1);
+        EndpointId id = slots_[slot].load(std::memory_order_acquire);
+        if (id == kOtherEndpoint) {
+            return kOtherEndpoint;  // Empty slot ends the probe sequence
+        }
+        if (entries_[id].view() == key) {
+            return id;
+        }
+    }
+    return kOtherEndpoint;
+}
+
+RouteNormalizer::EndpointId RouteNormalizer::insert(std::string_view key, std::uint64_t hash) {
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+
+    // Another thread may have published it while we waited
+    EndpointId existing = find(key, hash);
+    if (existing != kOtherEndpoint) {
+        return existing;
+    }
+
+    size_t id = count_.load(std::memory_order_relaxed);
+    if (id >= kMaxEndpoints) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        return kOtherEndpoint;
+    }
+
+    std::memcpy(entries_[id].name, key.data(), key.size());
+    entries_[id].length = static_cast<std::uint8_t>(key.size());
+
+    size_t slot = hash & (kTableSize - 1);
+    while (slots_[slot].load(std::memory_order_relaxed) != kOtherEndpoint) {
+        slot = (slot + 1) & (kTableSize - 1);
+    }
+    slots_[slot].store(static_cast<EndpointId>(id), std::memory_order_release);
+    count_.store(id + 1, std::memory_order_release);
+    return static_cast<EndpointId>(id);
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
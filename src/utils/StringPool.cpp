@@ -0,0 +1,88 @@
+#include "../../include/utils/StringPool.h"
+
+namespace healthcare::utils {
+
+namespace {
+
+constexpr size_t kInitialSlots = 64;
+
+} // namespace
+
+StringPool::StringPool()
+    : offsets_{0}, slots_(kInitialSlots, kEmptySlot) {
+}
+
+std::uint32_t StringPool::intern(std::string_view value) {
+    std::uint64_t hash_value = hash(value);
+    size_t slot = slotFor(value, hash_value);
+    if (slots_[slot] != kEmptySlot) {
+        return slots_[slot];
+    }
+
+    std::uint32_t id = static_cast<std::uint32_t>(size());
+    chars_.append(value.data(), value.size());
+    offsets_.push_back(static_cast<std::uint32_t>(chars_.size()));
+    slots_[slot] = id;
+
+    // Keep the load factor at or below one half so probe chains stay short
+    if (size() * 2 > slots_.size()) {
+        grow();
+    }
+    return id;
+}
+
+std::optional<std::uint32_t> StringPool::find(std::string_view value) const {
+    std::uint32_t id = slots_[slotFor(value, hash(value))];
+    if (id == kEmptySlot) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+std::string_view StringPool::view(std::uint32_t id) const {
+    return std::string_view(chars_.data() + offsets_[id], offsets_[id + 1] - offsets_[id]);
+}
+
+void StringPool::shrinkToFit() {
+    chars_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+}
+
+// Helpers
+
+std::uint64_t StringPool::hash(std::string_view value) {
+    // FNV-1a: short ids and names dominate, so a simple byte hash is enough
+    std::uint64_t hash_value = 1469598103934665603ULL;
+    for (unsigned char c : value) {
+        hash_value ^= c;
+        hash_value *= 1099511628211ULL;
+    }
+    return hash_value;
+}
+
+size_t StringPool::slotFor(std::string_view value, std::uint64_t hash_value) const {
+    size_t mask = slots_.size() - 1;
+    size_t slot = static_cast<size_t>(hash_value) & mask;
+    while (slots_[slot] != kEmptySlot && view(slots_[slot]) != value) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void StringPool::grow() {
+    std::vector<std::uint32_t> old_slots(slots_.size() * 2, kEmptySlot);
+    old_slots.swap(slots_);
+
+    size_t mask = slots_.size() - 1;
+    for (std::uint32_t id : old_slots) {
+        if (id == kEmptySlot) continue;
+
+        size_t slot = static_cast<size_t>(hash(view(id))) & mask;
+        while (slots_[slot] != kEmptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = id;
+    }
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "../../include/utils/TextSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace healthcare::utils {
+
+namespace {
+
+constexpr float kExactMatchScore = 1.0f;
+constexpr float kPrefixMatchScore = 0.75f;
+constexpr float kFuzzyMatchScale = 0.7f;
+constexpr size_t kMinFuzzyLength = 3;
+
+size_t countCommon(const std::vector<std::uint32_t>& a, const std::vector<std::uint32_t>& b) {
+    size_t common = 0;
+    auto left = a.begin();
+    auto right = b.begin();
+    while (left != a.end() && right != b.end()) {
+        if (*left < *right) {
+            ++left;
+        } else if (*right < *left) {
+            ++right;
+        } else {
+            ++common;
+            ++left;
+            ++right;
+        }
+    }
+    return common;
+}
+
+float similarity(const std::vector<std::uint32_t>& a, const std::vector<std::uint32_t>& b) {
+    size_t common = countCommon(a, b);
+    size_t combined = a.size() + b.size() - common;
+    return combined == 0 ? 0.0f : static_cast<float>(common) / static_cast<float>(combined);
+}
+
+bool startsWith(const std::string& text, const std::string& prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+// Tokenization
+
+std::vector<std::string> TextSearchIndex::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+
+    for (unsigned char c : text) {
+        // Bytes >= 0x80 belong to UTF-8 sequences and stay inside the token
+        if (std::isalnum(c) || c >= 0x80) {
+            current.push_back(static_cast<char>(std::tolower(c)));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+std::vector<std::uint32_t> TextSearchIndex::trigramsOf(const std::string& token, bool include_suffix) {
+    // Two leading blanks and one trailing blank, as pg_trgm pads words
+    std::string padded = "  " + token + " ";
+    size_t windows = padded.size() - 2 - (include_suffix ? 0 : 1);
+
+    std::vector<std::uint32_t> trigrams;
+    trigrams.reserve(windows);
+    for (size_t i = 0; i < windows; ++i) {
+        trigrams.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                           (static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                           static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+// Incremental maintenance
+
+void TextSearchIndex::upsert(const std::string& id, const std::vector<SearchField>& fields) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto existing = document_ids_.find(id);
+    if (existing != document_ids_.end()) {
+        detach(existing->second);
+    }
+
+    std::uint32_t document;
+    if (!free_documents_.empty()) {
+        document = free_documents_.back();
+        free_documents_.pop_back();
+    } else {
+        document = static_cast<std::uint32_t>(documents_.size());
+        documents_.emplace_back();
+    }
+
+    // A token that appears in several fields keeps its heaviest weight
+    std::unordered_map<std::uint32_t, float> token_weights;
+    for (const auto& field : fields) {
+        for (const auto& text : tokenize(field.text)) {
+            std::uint32_t token_id = internToken(text);
+            float& weight = token_weights[token_id];
+            weight = std::max(weight, field.weight);
+        }
+    }
+
+    Document& entry = documents_[document];
+    entry.id = id;
+    entry.tokens.clear();
+    for (const auto& [token_id, weight] : token_weights) {
+        tokens_[token_id].postings.push_back({document, weight});
+        entry.tokens.push_back(token_id);
+    }
+    document_ids_[id] = document;
+}
+
+bool TextSearchIndex::remove(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = document_ids_.find(id);
+    if (it == document_ids_.end()) {
+        return false;
+    }
+    detach(it->second);
+    return true;
+}
+
+void TextSearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    documents_.clear();
+    free_documents_.clear();
+    document_ids_.clear();
+    tokens_.clear();
+    free_tokens_.clear();
+    token_ids_.clear();
+    trigram_postings_.clear();
+}
+
+size_t TextSearchIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return document_ids_.size();
+}
+
+size_t TextSearchIndex::tokenCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return token_ids_.size();
+}
+
+// Queries
+
+std::vector<SearchHit> TextSearchIndex::search(const std::string& query, const SearchOptions& options) const {
+    std::vector<SearchHit> hits;
+    auto query_tokens = tokenize(query);
+    if (query_tokens.empty() || options.limit == 0) {
+        return hits;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // document -> (accumulated score, query tokens matched)
+    std::unordered_map<std::uint32_t, std::pair<float, size_t>> scores;
+
+    for (size_t q = 0; q < query_tokens.size(); ++q) {
+        const std::string& query_token = query_tokens[q];
+        bool is_prefix = options.prefix_last_token && q + 1 == query_tokens.size();
+        bool fuzzy = query_token.size() >= kMinFuzzyLength;
+
+        auto lookup_trigrams = trigramsOf(query_token, !is_prefix);
+        auto full_trigrams = is_prefix ? trigramsOf(query_token, true) : lookup_trigrams;
+
+        // Count shared trigrams per indexed token to find candidates cheaply
+        std::unordered_map<std::uint32_t, std::uint32_t> shared;
+        for (std::uint32_t trigram : lookup_trigrams) {
+            auto postings = trigram_postings_.find(trigram);
+            if (postings == trigram_postings_.end()) continue;
+            for (std::uint32_t token_id : postings->second) {
+                ++shared[token_id];
+            }
+        }
+
+        size_t required = fuzzy
+            ? std::max<size_t>(1, static_cast<size_t>(options.min_similarity * lookup_trigrams.size()))
+            : lookup_trigrams.size();
+
+        std::unordered_map<std::uint32_t, float> best;
+        for (const auto& [token_id, count] : shared) {
+            if (count < required) continue;
+
+            const Token& token = tokens_[token_id];
+            float match = 0.0f;
+            if (token.text == query_token) {
+                match = kExactMatchScore;
+            } else if (is_prefix && startsWith(token.text, query_token)) {
+                // Shorter completions rank above longer ones
+                match = kPrefixMatchScore + 0.2f * static_cast<float>(query_token.size()) /
+                                            static_cast<float>(token.text.size());
+            } else if (fuzzy) {
+                float score = similarity(full_trigrams, token.trigrams);
+                if (is_prefix && token.text.size() > query_token.size()) {
+                    // Compare a half-typed word against the same-length start of the token
+                    score = std::max(score, similarity(full_trigrams,
+                                                       trigramsOf(token.text.substr(0, query_token.size()), true)));
+                }
+                if (score >= options.min_similarity) {
+                    match = kFuzzyMatchScale * score;
+                }
+            }
+            if (match <= 0.0f) continue;
+
+            for (const auto& posting : token.postings) {
+                float& slot = best[posting.document];
+                slot = std::max(slot, match * posting.weight);
+            }
+        }
+
+        // Every query token must match: the first seeds the candidates, later ones intersect
+        if (q == 0) {
+            for (const auto& [document, score] : best) {
+                scores.emplace(document, std::make_pair(score, size_t{1}));
+            }
+        } else {
+            for (auto it = scores.begin(); it != scores.end();) {
+                auto match = best.find(it->first);
+                if (match == best.end()) {
+                    it = scores.erase(it);
+                } else {
+                    it->second.first += match->second;
+                    ++it->second.second;
+                    ++it;
+                }
+            }
+        }
+
+        if (scores.empty()) {
+            return hits;
+        }
+    }
+
+    // Top-K without sorting the whole candidate set
+    std::vector<std::pair<float, std::uint32_t>> ranked;
+    ranked.reserve(scores.size());
+    for (const auto& [document, score] : scores) {
+        ranked.emplace_back(score.first, document);
+    }
+
+    auto better = [this](const std::pair<float, std::uint32_t>& a, const std::pair<float, std::uint32_t>& b) {
+        if (a.first != b.first) return a.first > b.first;
+        return documents_[a.second].id < documents_[b.second].id;
+    };
+    size_t keep = std::min(options.limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(), better);
+
+    hits.reserve(keep);
+    float normalizer = static_cast<float>(query_tokens.size());
+    for (size_t i = 0; i < keep; ++i) {
+        hits.push_back({documents_[ranked[i].second].id, ranked[i].first / normalizer});
+    }
+    return hits;
+}
+
+// Helpers
+
+std::uint32_t TextSearchIndex::internToken(const std::string& text) {
+    auto it = token_ids_.find(text);
+    if (it != token_ids_.end()) {
+        return it->second;
+    }
+
+    std::uint32_t token_id;
+    if (!free_tokens_.empty()) {
+        token_id = free_tokens_.back();
+        free_tokens_.pop_back();
+    } else {
+        token_id = static_cast<std::uint32_t>(tokens_.size());
+        tokens_.emplace_back();
+    }
+
+    Token& token = tokens_[token_id];
+    token.text = text;
+    token.trigrams = trigramsOf(text, true);
+    token.postings.clear();
+    for (std::uint32_t trigram : token.trigrams) {
+        trigram_postings_[trigram].push_back(token_id);
+    }
+    token_ids_.emplace(text, token_id);
+    return token_id;
+}
+
+void TextSearchIndex::releaseToken(std::uint32_t token_id, std::uint32_t document) {
+    Token& token = tokens_[token_id];
+    auto& postings = token.postings;
+    postings.erase(std::remove_if(postings.begin(), postings.end(),
+                                  [document](const Posting& posting) { return posting.document == document; }),
+                   postings.end());
+    if (!postings.empty()) {
+        return;
+    }
+
+    // Last document using this token; drop it so typos don't accumulate forever
+    for (std::uint32_t trigram : token.trigrams) {
+        auto it = trigram_postings_.find(trigram);
+        if (it == trigram_postings_.end()) continue;
+
+        auto& token_ids = it->second;
+        auto position = std::find(token_ids.begin(), token_ids.end(), token_id);
+        if (position != token_ids.end()) {
+            *position = token_ids.back();
+            token_ids.pop_back();
+        }
+        if (token_ids.empty()) {
+            trigram_postings_.erase(it);
+        }
+    }
+
+    token_ids_.erase(token.text);
+    token.text.clear();
+    token.trigrams.clear();
+    free_tokens_.push_back(token_id);
+}
+
+void TextSearchIndex::detach(std::uint32_t document) {
+    Document& entry = documents_[document];
+    for (std::uint32_t token_id : entry.tokens) {
+        releaseToken(token_id, document);
+    }
+
+    document_ids_.erase(entry.id);
+    entry.id.clear();
+    entry.tokens.clear();
+    free_documents_.push_back(document);
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
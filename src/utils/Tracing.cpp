@@ -0,0 +1,469 @@
+#include "../../include/utils/Tracing.h"
+#include "../../include/utils/JsonWriter.h"
+#include "../../include/utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <curl/curl.h>
+
+namespace healthcare::utils {
+
+namespace {
+
+// The calling thread's trace; spans land in `spans`, which keeps its
+// capacity from one request to the next
+struct ThreadTrace {
+    std::array<std::uint8_t, 16> trace_id{};
+    std::int64_t unix_offset_ns = 0;
+    std::vector<SpanRecord> spans;
+    std::uint32_t current = SpanRecord::kNoParent;
+    size_t max_spans = 0;
+    long long dropped_spans = 0;
+    std::uint64_t id_state = 0;
+};
+
+thread_local ThreadTrace thread_trace;
+thread_local ThreadTrace* active_trace = nullptr;  // Set only while a sampled trace is open
+
+std::int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::uint64_t fnv1a(std::string_view text, std::uint64_t seed) {
+    std::uint64_t hash = seed;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// A 32-hex-digit request ID (e.g. from an upstream tracer) is used as is;
+// anything else is hashed, so one request ID always maps to one trace ID
+std::array<std::uint8_t, 16> traceIdFor(std::string_view request_id) {
+    std::array<std::uint8_t, 16> id{};
+    bool hex = request_id.size() == 32;
+    for (size_t i = 0; hex && i < 16; ++i) {
+        int high = hexValue(request_id[2 * i]);
+        int low = hexValue(request_id[2 * i + 1]);
+        hex = high >= 0 && low >= 0;
+        id[i] = static_cast<std::uint8_t>(high << 4 | low);
+    }
+    if (hex) {
+        return id;
+    }
+
+    std::uint64_t high = fnv1a(request_id, 14695981039346656037ULL);
+    std::uint64_t low = fnv1a(request_id, 0x84222325cbf29ce4ULL);
+    for (size_t i = 0; i < 8; ++i) {
+        id[i] = static_cast<std::uint8_t>(high >> (56 - 8 * i));
+        id[8 + i] = static_cast<std::uint8_t>(low >> (56 - 8 * i));
+    }
+    return id;
+}
+
+// Same decision for the same trace on every node that sees it
+bool isSampled(const std::array<std::uint8_t, 16>& trace_id, double rate) {
+    if (rate >= 1.0) return true;
+    if (rate <= 0.0) return false;
+    std::uint64_t bits = 0;
+    for (size_t i = 8; i < 16; ++i) {
+        bits = bits << 8 | trace_id[i];
+    }
+    return static_cast<double>(bits >> 11) < rate * static_cast<double>(std::uint64_t{1} << 53);
+}
+
+std::uint64_t nextSpanId(ThreadTrace& trace) {
+    if (trace.id_state == 0) {
+        trace.id_state = (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+    }
+    // splitmix64
+    std::uint64_t z = (trace.id_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;  // All-zero span IDs are invalid in OTLP
+}
+
+void addAttribute(SpanRecord& span, const char* key, std::string_view value) {
+    if (span.attribute_count >= SpanRecord::kMaxAttributes) {
+        return;
+    }
+    auto& attribute = span.attributes[span.attribute_count++];
+    attribute.key = key;
+    size_t length = std::min(value.size(), SpanRecord::kMaxValueLength);
+    for (size_t i = 0; i < length; ++i) {
+        char c = value[i];
+        attribute.value[i] = (c >= 0x20 && c < 0x7f) ? c : '?';
+    }
+    attribute.length = static_cast<std::uint8_t>(length);
+}
+
+SpanRecord* openSpan(ThreadTrace& trace, const char* name, SpanKind kind) {
+    if (trace.spans.size() >= trace.max_spans) {
+        trace.dropped_spans++;
+        return nullptr;
+    }
+    SpanRecord& span = trace.spans.emplace_back();
+    span.name = name;
+    span.span_id = nextSpanId(trace);
+    span.parent = trace.current;
+    span.kind = kind;
+    span.start_ns = steadyNanos();
+    trace.current = static_cast<std::uint32_t>(trace.spans.size() - 1);
+    return &span;
+}
+
+void appendHex(std::string& out, const std::uint8_t* bytes, size_t size) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; ++i) {
+        out += kHex[bytes[i] >> 4];
+        out += kHex[bytes[i] & 0x0f];
+    }
+}
+
+std::string spanIdHex(std::uint64_t span_id) {
+    std::uint8_t bytes[8];
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<std::uint8_t>(span_id >> (56 - 8 * i));
+    }
+    std::string hex;
+    appendHex(hex, bytes, sizeof(bytes));
+    return hex;
+}
+
+size_t discardResponseBody(char* /*data*/, size_t size, size_t count, void* /*user*/) {
+    return size * count;
+}
+
+} // namespace
+
+// Tracer
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+void Tracer::configure(const TracingConfig& config) {
+    config_ = config;
+}
+
+bool Tracer::start() {
+    if (!config_.enabled || running_.exchange(true)) {
+        return true;
+    }
+    if (config_.export_file.empty() && config_.collector_url.empty()) {
+        LOG_WARN("Tracing enabled without export_file or collector_url; slow traces will be discarded");
+    }
+
+    exporter_thread_ = std::thread(&Tracer::exportLoop, this);
+    enabled_.store(true, std::memory_order_release);
+    LOG_INFO("Tracing started: sample_rate={}, slow_threshold_ms={}", config_.sample_rate, config_.slow_threshold_ms);
+    return true;
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_release);
+    if (!running_.exchange(false)) {
+        return;
+    }
+    queue_cv_.notify_all();
+    if (exporter_thread_.joinable()) {
+        exporter_thread_.join();
+    }
+}
+
+void Tracer::beginTrace(std::string_view request_id, std::string_view method, std::string_view route) {
+    active_trace = nullptr;
+    if (!enabled_.load(std::memory_order_acquire)) {
+        return;
+    }
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    auto trace_id = traceIdFor(request_id);
+    if (!isSampled(trace_id, config_.sample_rate)) {
+        return;
+    }
+    sampled_.fetch_add(1, std::memory_order_relaxed);
+
+    ThreadTrace& trace = thread_trace;
+    trace.trace_id = trace_id;
+    trace.max_spans = std::max<size_t>(config_.max_spans, 1);
+    if (trace.spans.capacity() < trace.max_spans) {
+        trace.spans.reserve(trace.max_spans);
+    }
+    trace.spans.clear();
+    trace.current = SpanRecord::kNoParent;
+    trace.dropped_spans = 0;
+
+    auto system_now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    trace.unix_offset_ns = system_now - steadyNanos();
+
+    SpanRecord* root = openSpan(trace, "http.request", SpanKind::SERVER);
+    addAttribute(*root, "http.method", method);
+    addAttribute(*root, "http.route", route);
+    active_trace = &trace;
+}
+
+void Tracer::endTrace(int status_code) {
+    ThreadTrace* trace = active_trace;
+    if (trace == nullptr) {
+        return;
+    }
+    active_trace = nullptr;
+
+    SpanRecord& root = trace->spans.front();
+    root.end_ns = steadyNanos();
+    root.error = status_code >= 500;
+    char status[12];
+    int length = std::snprintf(status, sizeof(status), "%d", status_code);
+    addAttribute(root, "http.status_code", std::string_view(status, static_cast<size_t>(length)));
+
+    if (trace->dropped_spans > 0) {
+        dropped_spans_.fetch_add(trace->dropped_spans, std::memory_order_relaxed);
+    }
+
+    double duration_ms = static_cast<double>(root.end_ns - root.start_ns) / 1e6;
+    if (duration_ms < config_.slow_threshold_ms && status_code < 500) {
+        return;
+    }
+
+    // Spans still open (an exception unwound past them) end with the request
+    for (auto& span : trace->spans) {
+        if (span.end_ns == 0) span.end_ns = root.end_ns;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (queue_.size() >= config_.max_queued_traces) {
+            dropped_traces_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue_.push_back(FinishedTrace{trace->trace_id, trace->unix_offset_ns, trace->spans});
+    }
+    queue_cv_.notify_one();
+}
+
+TracingStats Tracer::getStats() const {
+    TracingStats stats;
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.sampled = sampled_.load(std::memory_order_relaxed);
+    stats.exported = exported_.load(std::memory_order_relaxed);
+    stats.dropped_spans = dropped_spans_.load(std::memory_order_relaxed);
+    stats.dropped_traces = dropped_traces_.load(std::memory_order_relaxed);
+    stats.export_failures = export_failures_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Export
+
+void Tracer::exportLoop() {
+    std::deque<FinishedTrace> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return !queue_.empty() || !running_.load(); });
+            if (queue_.empty() && !running_.load()) {
+                return;
+            }
+            batch.swap(queue_);
+        }
+        for (const auto& trace : batch) {
+            exportTrace(trace);
+        }
+        batch.clear();
+    }
+}
+
+void Tracer::exportTrace(const FinishedTrace& trace) {
+    std::string body;
+    try {
+        renderTrace(trace, body);
+    } catch (const std::exception& e) {
+        export_failures_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("Failed to render trace: {}", e.what());
+        return;
+    }
+
+    bool ok = true;
+    if (!config_.export_file.empty()) {
+        std::ofstream file(config_.export_file, std::ios::app);
+        file << body << '\n';
+        ok = ok && static_cast<bool>(file);
+    }
+
+    if (!config_.collector_url.empty()) {
+        CURL* curl = curl_easy_init();
+        if (curl) {
+            struct curl_slist* headers = curl_slist_append(nullptr, "Content-Type: application/json");
+            curl_easy_setopt(curl, CURLOPT_URL, config_.collector_url.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(config_.collector_timeout_ms));
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardResponseBody);
+
+            long status = 0;
+            CURLcode code = curl_easy_perform(curl);
+            if (code == CURLE_OK) {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+            }
+            ok = ok && code == CURLE_OK && status >= 200 && status < 300;
+
+            curl_slist_free_all(headers);
+            curl_easy_cleanup(curl);
+        } else {
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        exported_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        export_failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// OTLP/JSON ExportTraceServiceRequest with one resource and scope
+void Tracer::renderTrace(const FinishedTrace& trace, std::string& out) const {
+    std::string trace_id;
+    appendHex(trace_id, trace.trace_id.data(), trace.trace_id.size());
+
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.key("resourceSpans");
+    writer.beginArray();
+    writer.beginObject();
+
+    writer.key("resource");
+    writer.beginObject();
+    writer.key("attributes");
+    writer.beginArray();
+    writer.beginObject();
+    writer.field("key", "service.name");
+    writer.key("value");
+    writer.beginObject();
+    writer.field("stringValue", config_.service_name);
+    writer.endObject();
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+
+    writer.key("scopeSpans");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("scope");
+    writer.beginObject();
+    writer.field("name", "healthcare.tracing");
+    writer.endObject();
+
+    writer.key("spans");
+    writer.beginArray();
+    for (const auto& span : trace.spans) {
+        writer.beginObject();
+        writer.field("traceId", trace_id);
+        writer.field("spanId", spanIdHex(span.span_id));
+        if (span.parent != SpanRecord::kNoParent && span.parent < trace.spans.size()) {
+            writer.field("parentSpanId", spanIdHex(trace.spans[span.parent].span_id));
+        }
+        writer.field("name", span.name);
+        writer.field("kind", static_cast<int>(span.kind));
+        // 64-bit integers are strings in OTLP/JSON
+        writer.field("startTimeUnixNano", std::to_string(span.start_ns + trace.unix_offset_ns));
+        writer.field("endTimeUnixNano", std::to_string(span.end_ns + trace.unix_offset_ns));
+
+        writer.key("attributes");
+        writer.beginArray();
+        for (size_t i = 0; i < span.attribute_count; ++i) {
+            const auto& attribute = span.attributes[i];
+            writer.beginObject();
+            writer.field("key", attribute.key);
+            writer.key("value");
+            writer.beginObject();
+            writer.field("stringValue", std::string_view(attribute.value, attribute.length));
+            writer.endObject();
+            writer.endObject();
+        }
+        writer.endArray();
+
+        if (span.error) {
+            writer.key("status");
+            writer.beginObject();
+            writer.field("code", 2);  // STATUS_CODE_ERROR
+            writer.endObject();
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+}
+
+// TraceSpan
+
+TraceSpan::TraceSpan(const char* name, SpanKind kind) {
+    ThreadTrace* trace = active_trace;
+    if (trace == nullptr) {
+        return;
+    }
+    if (openSpan(*trace, name, kind) != nullptr) {
+        index_ = trace->current;
+    }
+}
+
+TraceSpan::TraceSpan(const char* name, SpanKind kind, const char* key, std::string_view value)
+    : TraceSpan(name, kind) {
+    setAttribute(key, value);
+}
+
+TraceSpan::~TraceSpan() {
+    ThreadTrace* trace = active_trace;
+    if (trace == nullptr || index_ >= trace->spans.size()) {
+        return;
+    }
+    SpanRecord& span = trace->spans[index_];
+    span.end_ns = steadyNanos();
+    trace->current = span.parent;
+}
+
+void TraceSpan::setAttribute(const char* key, std::string_view value) {
+    ThreadTrace* trace = active_trace;
+    if (trace != nullptr && index_ < trace->spans.size()) {
+        addAttribute(trace->spans[index_], key, value);
+    }
+}
+
+void TraceSpan::setError() {
+    ThreadTrace* trace = active_trace;
+    if (trace != nullptr && index_ < trace->spans.size()) {
+        trace->spans[index_].error = true;
+    }
+}
+
+bool TraceSpan::recording() const {
+    ThreadTrace* trace = active_trace;
+    return trace != nullptr && index_ < trace->spans.size();
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
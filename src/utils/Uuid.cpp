@@ -0,0 +1,191 @@
+#include "../../include/utils/Uuid.h"
+#include <uuid/uuid.h>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace healthcare::utils {
+
+namespace {
+
+std::uint64_t loadBigEndian(const std::uint8_t* bytes) {
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+void storeBigEndian(std::uint64_t value, std::uint8_t* bytes) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+#if defined(__SSE2__)
+
+// 16 hex characters -> 16 nibble values; clears `valid` if any character is not hex
+__m128i decodeNibbles(__m128i chars, bool& valid) {
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    valid = valid && _mm_movemask_epi8(_mm_or_si128(digit, alpha)) == 0xFFFF;
+
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                        _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// Pairs of nibbles (high first) -> bytes, eight per 16-bit lane pair
+__m128i packNibbles(__m128i nibbles) {
+    __m128i high = _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF));
+    __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(_mm_slli_epi16(high, 4), low);
+}
+
+bool decodeHex(const char* hex, std::uint8_t* out) {
+    bool valid = true;
+    __m128i first = packNibbles(decodeNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), valid));
+    __m128i second = packNibbles(decodeNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), valid));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(first, second));
+    return valid;
+}
+
+__m128i encodeNibbles(__m128i nibbles) {
+    __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+void encodeHex(const std::uint8_t* bytes, char* hex) {
+    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), mask);
+    __m128i low = _mm_and_si128(value, mask);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hex), encodeNibbles(_mm_unpacklo_epi8(high, low)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hex + 16), encodeNibbles(_mm_unpackhi_epi8(high, low)));
+}
+
+#else
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool decodeHex(const char* hex, std::uint8_t* out) {
+    for (size_t i = 0; i < 16; ++i) {
+        int high = hexValue(hex[2 * i]);
+        int low = hexValue(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+void encodeHex(const std::uint8_t* bytes, char* hex) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    for (size_t i = 0; i < 16; ++i) {
+        hex[2 * i] = kDigits[bytes[i] >> 4];
+        hex[2 * i + 1] = kDigits[bytes[i] & 0x0F];
+    }
+}
+
+#endif
+
+} // namespace
+
+Uuid::Uuid(const std::array<std::uint8_t, 16>& bytes)
+    : high_(loadBigEndian(bytes.data())), low_(loadBigEndian(bytes.data() + 8)) {
+}
+
+Uuid Uuid::generate() {
+    uuid_t raw;
+    uuid_generate_random(raw);
+
+    std::array<std::uint8_t, 16> bytes;
+    std::memcpy(bytes.data(), raw, bytes.size());
+    return Uuid(bytes);
+}
+
+// Text conversion
+
+std::optional<Uuid> Uuid::parse(std::string_view text) {
+    if (text.size() != kStringLength || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+        return std::nullopt;
+    }
+
+    // Drop the dashes so the 32 digits can be decoded as two 16-byte vectors
+    char hex[32];
+    const char* in = text.data();
+    std::memcpy(hex, in, 8);
+    std::memcpy(hex + 8, in + 9, 4);
+    std::memcpy(hex + 12, in + 14, 4);
+    std::memcpy(hex + 16, in + 19, 4);
+    std::memcpy(hex + 20, in + 24, 12);
+
+    std::array<std::uint8_t, 16> bytes;
+    if (!decodeHex(hex, bytes.data())) {
+        return std::nullopt;
+    }
+    return Uuid(bytes);
+}
+
+Uuid Uuid::fromString(std::string_view text) {
+    auto uuid = parse(text);
+    if (!uuid) {
+        throw std::invalid_argument("Invalid UUID: " + std::string(text));
+    }
+    return *uuid;
+}
+
+std::string Uuid::toString() const {
+    std::string text(kStringLength, '\0');
+    format(text.data());
+    return text;
+}
+
+void Uuid::format(char* out) const {
+    std::uint8_t raw[16];
+    storeBigEndian(high_, raw);
+    storeBigEndian(low_, raw + 8);
+
+    char hex[32];
+    encodeHex(raw, hex);
+
+    std::memcpy(out, hex, 8);
+    out[8] = '-';
+    std::memcpy(out + 9, hex + 8, 4);
+    out[13] = '-';
+    std::memcpy(out + 14, hex + 12, 4);
+    out[18] = '-';
+    std::memcpy(out + 19, hex + 16, 4);
+    out[23] = '-';
+    std::memcpy(out + 24, hex + 20, 12);
+}
+
+// Accessors
+
+std::array<std::uint8_t, 16> Uuid::bytes() const {
+    std::array<std::uint8_t, 16> bytes;
+    storeBigEndian(high_, bytes.data());
+    storeBigEndian(low_, bytes.data() + 8);
+    return bytes;
+}
+
+size_t Uuid::hash() const {
+    // Multiply-xorshift so both halves reach the low bits used by bucket masks
+    std::uint64_t mixed = (high_ ^ (low_ * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+    return static_cast<size_t>(mixed ^ (mixed >> 31));
+}
+
+} // namespace healthcare::utils
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../../include/utils/ValidationUtils.h"
+#include "../../include/utils/Uuid.h"
 #include <regex>
 #include <algorithm>
 #include <cctype>
@@ -113,15 +114,7 @@ bool ValidationUtils::isValidTime(const std::string& time, bool is_24_hour) {
 }
 
 bool ValidationUtils::isValidUUID(const std::string& uuid) {
-    if (uuid.length() != 36) {
-        return false;
-    }
-    
-    const std::regex uuid_pattern(
-        R"(^[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}$)"
-    );
-    
-    return std::regex_match(uuid, uuid_pattern);
+    return Uuid::parse(uuid).has_value();
 }
 
 bool ValidationUtils::isValidPincode(const std::string& pincode, const std::string& country_code) {
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "database/SlowQueryLog.h"
+
+using healthcare::database::SlowQueryLog;
+
+namespace {
+
+std::string fingerprintOf(std::string_view sql) {
+    std::string out;
+    SlowQueryLog::fingerprint(sql, out);
+    return out;
+}
+
+} // namespace
+
+TEST(SlowQueryFingerprintTest, LiteralsCommentsAndWhitespaceCollapse) {
+    auto expected = "select * from doctors where id=?";
+    EXPECT_EQ(fingerprintOf("SELECT * FROM doctors WHERE id = 'a1'"), expected);
+    EXPECT_EQ(fingerprintOf("select *  from doctors\n  where id='b2' -- trailing comment\n"), expected);
+    EXPECT_EQ(fingerprintOf("/* lead */ SELECT * FROM doctors WHERE id = $1"), expected);
+}
+
+TEST(SlowQueryFingerprintTest, NumbersAndListsBecomeOnePlaceholder) {
+    EXPECT_EQ(fingerprintOf("SELECT id, name FROM users WHERE age > 42 AND score < 3.5e2 LIMIT $1"),
+              "select id,name from users where age>? and score<? limit ?");
+    // IN lists of any length share one fingerprint
+    EXPECT_EQ(fingerprintOf("SELECT * FROM t WHERE id IN (1, 2, 3)"), fingerprintOf("SELECT * FROM t WHERE id IN (7)"));
+    EXPECT_EQ(fingerprintOf("INSERT INTO t (a, b) VALUES ($1, $2)"), "insert into t(a,b) values(?)");
+    // Digits inside identifiers are not literals
+    EXPECT_EQ(fingerprintOf("SELECT col1, t2.x FROM t2"), "select col1,t2.x from t2");
+}
+
+TEST(SlowQueryFingerprintTest, QuotedStringsAndIdentifiers) {
+    // Doubled quotes, E'' escapes and dollar quoting all end up as one literal
+    EXPECT_EQ(fingerprintOf("SELECT \"Name\" FROM t WHERE x = 'it''s' AND y = $tag$ a 'b' $tag$"),
+              "select \"Name\" from t where x=? and y=?");
+    EXPECT_EQ(fingerprintOf("SELECT * FROM t WHERE s = E'it\\'s' AND n = 1"),
+              "select * from t where s=? and n=?");
+}
+
+TEST(SlowQueryFingerprintTest, AppendsToTheOutput) {
+    std::string out = "prefix:";
+    SlowQueryLog::fingerprint("SELECT 1", out);
+    EXPECT_EQ(out, "prefix:select ?");
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "models/Doctor.h"
+
+using healthcare::models::ConsultationType;
+using healthcare::models::Doctor;
+using healthcare::models::parseWeeklyAvailability;
+namespace civil = healthcare::utils::civil;
+
+namespace {
+
+// Availability patterns are read in the default zone (IST)
+std::chrono::system_clock::time_point localTime(int year, unsigned month, unsigned day, int hour, int minute) {
+    const auto& zone = civil::TimeZoneRegistry::getInstance().getDefault();
+    return civil::fromLocal(civil::daysFromCivil(year, month, day), hour * 60 + minute, zone);
+}
+
+Doctor doctorWith(const std::string& pattern) {
+    Doctor doctor;
+    doctor.setConsultationTypes({ConsultationType::OFFLINE, ConsultationType::BOTH});
+    doctor.setConsultationDuration(30);
+    doctor.setAvailabilityPattern(pattern);
+    return doctor;
+}
+
+} // namespace
+
+TEST(DoctorAvailabilityTest, ParsesObjectAndStringRanges) {
+    auto weekly = parseWeeklyAvailability(R"({"1": [{"start": "09:00", "end": "12:00"}, "14:00-17:30"]})");
+
+    ASSERT_EQ(weekly[civil::MONDAY].size(), 2u);
+    EXPECT_EQ(weekly[civil::MONDAY][0].start, 540);
+    EXPECT_EQ(weekly[civil::MONDAY][1].end, 1050);
+    EXPECT_TRUE(weekly[civil::TUESDAY].empty());
+}
+
+TEST(DoctorAvailabilityTest, SplitsOvernightRangesAcrossMidnight) {
+    auto weekly = parseWeeklyAvailability(R"({"6": ["22:00-06:00"], "0": ["10:00-12:00"]})");
+
+    ASSERT_EQ(weekly[civil::SATURDAY].size(), 1u);
+    EXPECT_EQ(weekly[civil::SATURDAY][0].start, 22 * 60);
+    EXPECT_EQ(weekly[civil::SATURDAY][0].end, civil::kMinutesPerDay);
+
+    // Saturday night spills into Sunday, ahead of Sunday's own range
+    ASSERT_EQ(weekly[civil::SUNDAY].size(), 2u);
+    EXPECT_EQ(weekly[civil::SUNDAY][0].start, 0);
+    EXPECT_EQ(weekly[civil::SUNDAY][0].end, 6 * 60);
+    EXPECT_EQ(weekly[civil::SUNDAY][1].start, 10 * 60);
+}
+
+TEST(DoctorAvailabilityTest, MalformedPatternsYieldNoAvailability) {
+    for (const char* pattern : {"", "not json", "[]", R"({"1": ["25:00-26:00", "10:00-10:00"]})"}) {
+        auto weekly = parseWeeklyAvailability(pattern);
+        for (const auto& ranges : weekly) {
+            EXPECT_TRUE(ranges.empty()) << pattern;
+        }
+    }
+}
+
+TEST(DoctorAvailabilityTest, IsAvailableAtUsesCompiledPattern) {
+    // 2024-06-03 is a Monday
+    auto doctor = doctorWith(R"({"1": ["09:00-12:00", "22:00-02:00"]})");
+
+    EXPECT_TRUE(doctor.isAvailableAt(localTime(2024, 6, 3, 9, 0), ConsultationType::OFFLINE));
+    EXPECT_FALSE(doctor.isAvailableAt(localTime(2024, 6, 3, 12, 0), ConsultationType::OFFLINE));
+    EXPECT_TRUE(doctor.isAvailableAt(localTime(2024, 6, 3, 23, 30), ConsultationType::OFFLINE));
+    EXPECT_TRUE(doctor.isAvailableAt(localTime(2024, 6, 4, 1, 30), ConsultationType::OFFLINE));
+    EXPECT_FALSE(doctor.isAvailableAt(localTime(2024, 6, 4, 2, 0), ConsultationType::OFFLINE));
+
+    EXPECT_FALSE(doctor.isAvailableAt(localTime(2024, 6, 3, 9, 0), ConsultationType::ONLINE));
+
+    // Replacing the pattern recompiles it
+    doctor.setAvailabilityPattern(R"({"2": ["09:00-10:00"]})");
+    EXPECT_FALSE(doctor.isAvailableAt(localTime(2024, 6, 3, 9, 0), ConsultationType::OFFLINE));
+    EXPECT_TRUE(doctor.isAvailableAt(localTime(2024, 6, 4, 9, 0), ConsultationType::OFFLINE));
+}
+
+TEST(DoctorAvailabilityTest, SlotsCoverBothSidesOfAnOvernightShift) {
+    auto doctor = doctorWith(R"({"1": ["23:00-01:00"]})");
+
+    auto slots = doctor.getAvailableSlots(localTime(2024, 6, 3, 0, 0), localTime(2024, 6, 4, 23, 59));
+    ASSERT_EQ(slots.size(), 4u);
+    EXPECT_EQ(slots.front().start_time, localTime(2024, 6, 3, 23, 0));
+    EXPECT_EQ(slots.back().start_time, localTime(2024, 6, 4, 0, 30));
+    EXPECT_EQ(slots.back().end_time, localTime(2024, 6, 4, 1, 0));
+}
+
+TEST(DoctorAvailabilityTest, WorkingThroughoutCrossesAdjacentRangesAndMidnight) {
+    auto doctor = doctorWith(R"({"1": ["09:00-12:00", "12:00-13:00", "23:00-01:00"]})");
+
+    EXPECT_TRUE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 9, 0), localTime(2024, 6, 3, 9, 30)));
+    EXPECT_TRUE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 11, 45), localTime(2024, 6, 3, 12, 15)));
+    EXPECT_TRUE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 23, 45), localTime(2024, 6, 4, 0, 15)));
+
+    EXPECT_FALSE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 12, 45), localTime(2024, 6, 3, 13, 15)));
+    EXPECT_FALSE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 8, 45), localTime(2024, 6, 3, 9, 15)));
+    EXPECT_FALSE(doctor.isWorkingThroughout(localTime(2024, 6, 3, 10, 0), localTime(2024, 6, 3, 10, 0)));
+}
+
+TEST(DoctorAvailabilityTest, JsonRoundTripKeepsCompiledPattern) {
+    auto doctor = doctorWith(R"({"1": ["09:00-12:00"]})");
+
+    Doctor copy;
+    copy.fromJson(doctor.toJson());
+    EXPECT_EQ(copy.getAvailabilityPattern(), doctor.getAvailabilityPattern());
+    EXPECT_TRUE(copy.isAvailableAt(localTime(2024, 6, 3, 10, 0), ConsultationType::OFFLINE));
+}
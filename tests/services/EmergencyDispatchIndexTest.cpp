@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "services/EmergencyDispatchIndex.h"
+#include "utils/Uuid.h"
+
+using healthcare::models::Appointment;
+using healthcare::models::AppointmentStatus;
+using healthcare::services::DutyState;
+using healthcare::services::EmergencyDispatchConfig;
+using healthcare::services::EmergencyDispatchIndex;
+using healthcare::services::OccupancyEntry;
+
+namespace {
+
+class EmergencyDispatchIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        index_.configure(EmergencyDispatchConfig());
+        index_.clear();
+        doctor_id_ = healthcare::utils::Uuid::generate().toString();
+        index_.registerDoctor(doctor_id_, healthcare::utils::Uuid::generate().toString(), "Pune", 18.52, 73.85);
+    }
+
+    void TearDown() override {
+        index_.clear();
+    }
+
+    Appointment appointment(AppointmentStatus status, const std::string& id = "") {
+        Appointment result;
+        if (!id.empty()) result.setId(id);
+        result.setDoctorId(doctor_id_);
+        result.setStatus(status);
+        return result;
+    }
+
+    EmergencyDispatchIndex& index_ = EmergencyDispatchIndex::getInstance();
+    std::string doctor_id_;
+};
+
+TEST_F(EmergencyDispatchIndexTest, ClaimsNearestFreeDoctorOnce) {
+    auto first = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->doctor_id, doctor_id_);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+
+    EXPECT_FALSE(index_.claimNearest("pune", 18.52, 73.85).has_value());
+}
+
+TEST_F(EmergencyDispatchIndexTest, UnrelatedAppointmentEndingKeepsClaim) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    auto emergency = appointment(AppointmentStatus::CONFIRMED);
+    ASSERT_TRUE(index_.bindClaim(*claim, emergency.getId()));
+
+    // A routine booking for the same doctor finishing must not free them
+    index_.onAppointmentStatusChanged(appointment(AppointmentStatus::COMPLETED));
+    index_.onAppointmentStatusChanged(appointment(AppointmentStatus::CANCELLED));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+
+    index_.onAppointmentStatusChanged(appointment(AppointmentStatus::COMPLETED, emergency.getId()));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+}
+
+TEST_F(EmergencyDispatchIndexTest, BusyUntilEveryConsultationEnds) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    auto emergency = appointment(AppointmentStatus::IN_PROGRESS);
+    ASSERT_TRUE(index_.bindClaim(*claim, emergency.getId()));
+
+    auto routine = appointment(AppointmentStatus::IN_PROGRESS);
+    index_.onAppointmentStatusChanged(routine);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::BUSY);
+
+    // The routine consultation ends first; the claim still holds the doctor
+    index_.onAppointmentStatusChanged(appointment(AppointmentStatus::COMPLETED, routine.getId()));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+
+    index_.onAppointmentStatusChanged(emergency);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::BUSY);
+    index_.onAppointmentStatusChanged(appointment(AppointmentStatus::COMPLETED, emergency.getId()));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+}
+
+TEST_F(EmergencyDispatchIndexTest, ReleaseDropsUnboundClaim) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    EXPECT_TRUE(index_.release(*claim));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+    EXPECT_FALSE(index_.release(*claim));
+}
+
+TEST_F(EmergencyDispatchIndexTest, RemovedClaimAppointmentFreesDoctor) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    auto emergency = appointment(AppointmentStatus::CONFIRMED);
+    ASSERT_TRUE(index_.bindClaim(*claim, emergency.getId()));
+
+    index_.onAppointmentRemoved(emergency.getId());
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+}
+
+TEST_F(EmergencyDispatchIndexTest, OffDutyDoctorKeepsOccupancyForReturn) {
+    auto routine = appointment(AppointmentStatus::IN_PROGRESS);
+    index_.onAppointmentStatusChanged(routine);
+    ASSERT_TRUE(index_.setOnDuty(doctor_id_, false));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::OFF_DUTY);
+
+    ASSERT_TRUE(index_.setOnDuty(doctor_id_, true));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::BUSY);
+}
+
+TEST_F(EmergencyDispatchIndexTest, ConcurrentClaimsGrabTheDoctorOnce) {
+    std::atomic<int> winners{0};
+    std::vector<std::thread> dispatchers;
+    for (int i = 0; i < 8; ++i) {
+        dispatchers.emplace_back([this, &winners] {
+            if (index_.claimNearest("pune", 18.52, 73.85)) winners.fetch_add(1);
+        });
+    }
+    for (auto& dispatcher : dispatchers) dispatcher.join();
+
+    EXPECT_EQ(winners.load(), 1);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+}
+
+TEST_F(EmergencyDispatchIndexTest, UnboundClaimExpiresAfterTtl) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    auto later = std::chrono::steady_clock::now() + std::chrono::seconds(EmergencyDispatchConfig().claim_ttl_seconds + 1);
+
+    EXPECT_EQ(index_.expireClaims(std::chrono::steady_clock::now()), 0u);
+    EXPECT_EQ(index_.expireClaims(later), 1u);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+    EXPECT_FALSE(index_.bindClaim(*claim, healthcare::utils::Uuid::generate().toString()));
+}
+
+TEST_F(EmergencyDispatchIndexTest, ExpiredClaimCannotTouchTheNextDispatch) {
+    auto stale = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(stale.has_value());
+    auto later = std::chrono::steady_clock::now() + std::chrono::seconds(EmergencyDispatchConfig().claim_ttl_seconds + 1);
+    ASSERT_EQ(index_.expireClaims(later), 1u);
+
+    auto fresh = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(fresh.has_value());
+    ASSERT_NE(fresh->claim_stamp, stale->claim_stamp);
+
+    // The first booking must neither bind the doctor nor free them from under the second
+    EXPECT_FALSE(index_.bindClaim(*stale, appointment(AppointmentStatus::CONFIRMED).getId()));
+    EXPECT_FALSE(index_.release(*stale));
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+    EXPECT_TRUE(index_.bindClaim(*fresh, appointment(AppointmentStatus::CONFIRMED).getId()));
+}
+
+TEST_F(EmergencyDispatchIndexTest, BoundClaimOutlivesTtl) {
+    auto claim = index_.claimNearest("pune", 18.52, 73.85);
+    ASSERT_TRUE(claim.has_value());
+    ASSERT_TRUE(index_.bindClaim(*claim, appointment(AppointmentStatus::CONFIRMED).getId()));
+
+    auto later = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    EXPECT_EQ(index_.expireClaims(later), 0u);
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::CLAIMED);
+}
+
+TEST_F(EmergencyDispatchIndexTest, RestoresOccupancyFromStoredAppointments) {
+    auto other_id = healthcare::utils::Uuid::generate().toString();
+    index_.registerDoctor(other_id, healthcare::utils::Uuid::generate().toString(), "Pune", 18.53, 73.86);
+    auto emergency = healthcare::utils::Uuid::generate().toString();
+
+    index_.restoreOccupancy({
+        {doctor_id_, healthcare::utils::Uuid::generate().toString(), true},
+        {other_id, emergency, false},
+    });
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::BUSY);
+    EXPECT_EQ(index_.getDutyState(other_id), DutyState::CLAIMED);
+    EXPECT_FALSE(index_.claimNearest("pune", 18.52, 73.85).has_value());
+
+    // The restored claim is bound, so its appointment ending frees the doctor
+    index_.onAppointmentStatusChanged([&] {
+        Appointment done;
+        done.setId(emergency);
+        done.setDoctorId(other_id);
+        done.setStatus(AppointmentStatus::COMPLETED);
+        return done;
+    }());
+    EXPECT_EQ(index_.getDutyState(other_id), DutyState::FREE);
+
+    // Nothing listed any more: the consultation finished elsewhere
+    index_.restoreOccupancy({});
+    EXPECT_EQ(index_.getDutyState(doctor_id_), DutyState::FREE);
+}
+
+} // namespace
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "services/RequestDecoders.h"
+#include "utils/CivilTime.h"
+
+using healthcare::models::AppointmentType;
+using healthcare::services::PaymentMethod;
+using healthcare::services::decodeBatchBookingRequest;
+namespace civil = healthcare::utils::civil;
+
+namespace {
+
+const char* kDoctorId = "6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5f";
+const char* kClinicId = "0a1b2c3d-4e5f-4a7b-8c9d-0e1f2a3b4c5d";
+
+// A date comfortably in the future, in the decoders' YYYY-MM-DD form
+std::string futureDate(int days_ahead) {
+    auto today = civil::toUnixSeconds(std::chrono::system_clock::now()) / 86400;
+    auto date = civil::civilFromDays(today + days_ahead);
+    char text[11];
+    std::snprintf(text, sizeof(text), "%04d-%02u-%02u", date.year, date.month, date.day);
+    return text;
+}
+
+std::string item(const std::string& date, const std::string& time, const std::string& extra = "") {
+    return std::string(R"({"doctor_id": ")") + kDoctorId + R"(", "clinic_id": ")" + kClinicId +
+           R"(", "appointment_date": ")" + date + R"(", "start_time": ")" + time + "\"" + extra + "}";
+}
+
+} // namespace
+
+TEST(BatchBookingDecoderTest, DecodesItemsAndOptions) {
+    std::string body = "{\"items\": [" + item(futureDate(3), "09:00") + ", " +
+                       item(futureDate(10), "10:30", R"(, "type": "ONLINE", "notes": "review")") +
+                       R"(], "all_or_nothing": true, "payment_method": "UPI"})";
+
+    auto decoded = decodeBatchBookingRequest(body);
+    ASSERT_TRUE(decoded.ok()) << decoded.errors.front();
+    const auto& request = *decoded.value;
+
+    ASSERT_EQ(request.items.size(), 2u);
+    EXPECT_EQ(request.items[0].doctor_id, kDoctorId);
+    EXPECT_EQ(request.items[0].type, AppointmentType::OFFLINE);
+    EXPECT_EQ(request.items[1].type, AppointmentType::ONLINE);
+    EXPECT_EQ(request.items[1].notes, "review");
+    EXPECT_LT(request.items[0].start_time, request.items[1].start_time);
+    EXPECT_TRUE(request.all_or_nothing);
+    EXPECT_EQ(request.payment_method, PaymentMethod::UPI);
+    EXPECT_TRUE(request.user_id.empty());  // Filled from the token, never the body
+}
+
+TEST(BatchBookingDecoderTest, ReportsTheFirstBadItemWithItsPath) {
+    std::string body = "{\"items\": [" + item(futureDate(3), "09:00") + ", " + item(futureDate(4), "25:00") + "]}";
+
+    auto decoded = decodeBatchBookingRequest(body);
+    ASSERT_FALSE(decoded.ok());
+    ASSERT_EQ(decoded.errors.size(), 1u);
+    EXPECT_EQ(decoded.errors[0], "items: [1].start_time: Invalid start time format (use HH:MM)");
+}
+
+TEST(BatchBookingDecoderTest, RejectsPastEmptyAndMalformedItems) {
+    EXPECT_FALSE(decodeBatchBookingRequest("{\"items\": [" + item("2020-01-06", "09:00") + "]}").ok());
+    EXPECT_FALSE(decodeBatchBookingRequest(R"({"items": []})").ok());
+    EXPECT_FALSE(decodeBatchBookingRequest(R"({"all_or_nothing": true})").ok());
+
+    auto not_objects = decodeBatchBookingRequest(R"({"items": [1, "two"]})");
+    ASSERT_FALSE(not_objects.ok());
+    EXPECT_EQ(not_objects.errors.front(), "items[0]: must be an object");
+
+    auto truncated = decodeBatchBookingRequest("{\"items\": [" + item(futureDate(3), "09:00"));
+    ASSERT_FALSE(truncated.ok());
+    EXPECT_EQ(truncated.errors.front().rfind("body: ", 0), 0u);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "utils/CivilTime.h"
+
+namespace civil = healthcare::utils::civil;
+
+namespace {
+
+std::chrono::system_clock::time_point utc(int year, unsigned month, unsigned day, int hour, int minute) {
+    std::int64_t seconds = civil::daysFromCivil(year, month, day) * civil::kSecondsPerDay + hour * 3600 + minute * 60;
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+} // namespace
+
+TEST(CivilTimeTest, DaysRoundTripThroughCivilDates) {
+    EXPECT_EQ(civil::daysFromCivil(1970, 1, 1), 0);
+    EXPECT_EQ(civil::daysFromCivil(2000, 3, 1), 11017);
+    EXPECT_EQ(civil::daysFromCivil(1969, 12, 31), -1);
+
+    for (std::int64_t days : {-719468LL, -1LL, 0LL, 11016LL, 19782LL, 47482LL}) {
+        auto date = civil::civilFromDays(days);
+        EXPECT_EQ(civil::daysFromCivil(date.year, date.month, date.day), days);
+    }
+
+    auto leap_day = civil::civilFromDays(civil::daysFromCivil(2024, 2, 29));
+    EXPECT_EQ(leap_day.month, 2u);
+    EXPECT_EQ(leap_day.day, 29u);
+}
+
+TEST(CivilTimeTest, WeekdaysFollowTmConvention) {
+    EXPECT_EQ(civil::weekdayFromDays(0), civil::THURSDAY);
+    EXPECT_EQ(civil::weekdayFromDays(-1), civil::WEDNESDAY);
+    EXPECT_EQ(civil::weekdayFromDays(civil::daysFromCivil(2024, 6, 2)), civil::SUNDAY);
+}
+
+TEST(CivilTimeTest, FixedOffsetZoneShiftsIntoNextDay) {
+    const auto& kolkata = civil::TimeZoneRegistry::getInstance().get("Asia/Kolkata");
+    ASSERT_TRUE(kolkata.isFixedOffset());
+
+    // 20:00 UTC on a Monday is 01:30 IST on Tuesday
+    auto local = civil::toLocal(utc(2024, 6, 3, 20, 0), kolkata);
+    EXPECT_EQ(local.local_days, civil::daysFromCivil(2024, 6, 4));
+    EXPECT_EQ(local.minute_of_day, 90);
+    EXPECT_EQ(local.day_of_week, civil::TUESDAY);
+    EXPECT_EQ(local.offset_minutes, 330);
+
+    EXPECT_EQ(civil::fromLocal(local.local_days, local.minute_of_day, kolkata), utc(2024, 6, 3, 20, 0));
+}
+
+TEST(CivilTimeTest, EuropeanZoneAppliesSummerTime) {
+    const auto& london = civil::TimeZoneRegistry::getInstance().get("Europe/London");
+    EXPECT_FALSE(london.isFixedOffset());
+
+    EXPECT_EQ(civil::toLocal(utc(2024, 1, 15, 12, 0), london).offset_minutes, 0);
+    EXPECT_EQ(civil::toLocal(utc(2024, 7, 15, 12, 0), london).offset_minutes, 60);
+
+    // Summer time starts at 01:00 UTC on the last Sunday of March
+    EXPECT_EQ(civil::toLocal(utc(2024, 3, 31, 0, 59), london).offset_minutes, 0);
+    EXPECT_EQ(civil::toLocal(utc(2024, 3, 31, 1, 0), london).offset_minutes, 60);
+
+    auto noon = civil::fromLocal(civil::daysFromCivil(2024, 7, 15), 12 * 60, london);
+    EXPECT_EQ(noon, utc(2024, 7, 15, 11, 0));
+}
+
+TEST(CivilTimeTest, BatchMinutesOfWeekMatchScalarPath) {
+    const auto& registry = civil::TimeZoneRegistry::getInstance();
+    std::vector<std::chrono::system_clock::time_point> times;
+    for (int hour = 0; hour < 24 * 9; hour += 7) {
+        times.push_back(utc(2024, 3, 28, 0, 0) + std::chrono::hours(hour) + std::chrono::minutes(13));
+    }
+
+    for (const char* name : {"Asia/Kolkata", "Asia/Kathmandu", "Europe/Berlin", "America/New_York"}) {
+        const auto& zone = registry.get(name);
+        std::vector<int> batch(times.size());
+        civil::minutesOfWeek(times.data(), times.size(), zone, batch.data());
+        for (size_t i = 0; i < times.size(); ++i) {
+            EXPECT_EQ(batch[i], civil::minuteOfWeek(times[i], zone)) << name << " #" << i;
+        }
+    }
+}
+
+TEST(CivilTimeTest, ParsesAndFormatsClockTimes) {
+    EXPECT_EQ(civil::parseHHMM("09:30"), 570);
+    EXPECT_EQ(civil::parseHHMM("23:59:59"), 1439);
+    EXPECT_EQ(civil::parseHHMM("24:00"), civil::kMinutesPerDay);
+    EXPECT_EQ(civil::parseHHMM("24:01"), civil::kInvalidMinute);
+    EXPECT_EQ(civil::parseHHMM("9:30"), civil::kInvalidMinute);
+    EXPECT_EQ(civil::parseHHMM("09:60"), civil::kInvalidMinute);
+
+    EXPECT_EQ(civil::formatHHMM(570), "09:30");
+    EXPECT_EQ(civil::formatHHMM(-1), "");
+
+    EXPECT_EQ(civil::dayIndexFromName("monday"), civil::MONDAY);
+    EXPECT_EQ(civil::dayIndexFromName("Funday"), -1);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <map>
+#include "utils/ConsistentHashRing.h"
+
+using healthcare::utils::ConsistentHashRing;
+
+namespace {
+
+std::vector<std::string> sampleKeys(size_t count) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back("doctor-" + std::to_string(i));
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(ConsistentHashRingTest, EmptyRingHasNoOwner) {
+    ConsistentHashRing ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.getOwner("doctor-1"), "");
+}
+
+TEST(ConsistentHashRingTest, OwnershipIsDeterministicAndIndependentOfInsertOrder) {
+    ConsistentHashRing forward;
+    forward.setNodes({"node-a", "node-b", "node-c"});
+    ConsistentHashRing backward;
+    backward.addNode("node-c");
+    backward.addNode("node-b");
+    backward.addNode("node-a");
+    backward.addNode("node-a");  // Duplicates are ignored
+
+    EXPECT_EQ(backward.size(), 3u);
+    for (const auto& key : sampleKeys(500)) {
+        EXPECT_EQ(forward.getOwner(key), backward.getOwner(key)) << key;
+    }
+}
+
+TEST(ConsistentHashRingTest, SpreadsKeysAcrossNodes) {
+    ConsistentHashRing ring;
+    ring.setNodes({"node-a", "node-b", "node-c", "node-d"});
+
+    std::map<std::string, size_t> owned;
+    auto keys = sampleKeys(8000);
+    for (const auto& key : keys) {
+        ++owned[ring.getOwner(key)];
+    }
+
+    ASSERT_EQ(owned.size(), 4u);
+    for (const auto& [node, count] : owned) {
+        EXPECT_GT(count, keys.size() / 8) << node;  // Each node gets at least half its fair share
+    }
+}
+
+TEST(ConsistentHashRingTest, RemovingANodeOnlyMovesItsKeys) {
+    ConsistentHashRing ring;
+    ring.setNodes({"node-a", "node-b", "node-c"});
+    auto keys = sampleKeys(2000);
+
+    std::map<std::string, std::string> before;
+    for (const auto& key : keys) before[key] = ring.getOwner(key);
+
+    EXPECT_TRUE(ring.removeNode("node-b"));
+    EXPECT_FALSE(ring.removeNode("node-b"));
+    EXPECT_FALSE(ring.hasNode("node-b"));
+
+    for (const auto& key : keys) {
+        const auto& owner = ring.getOwner(key);
+        EXPECT_NE(owner, "node-b");
+        if (before[key] != "node-b") {
+            EXPECT_EQ(owner, before[key]) << key;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "utils/GeoDistance.h"
+#include "utils/GeoIndex.h"
+
+using healthcare::utils::geo::CoordinateStore;
+using healthcare::utils::geo::DistanceKernel;
+using healthcare::utils::geo::haversineKm;
+using healthcare::utils::geo::isDistanceKernelSupported;
+
+namespace {
+
+CoordinateStore randomStore(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> latitude(-80.0, 80.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    CoordinateStore store;
+    for (size_t i = 0; i < count; ++i) {
+        store.add(latitude(rng), longitude(rng));
+    }
+    return store;
+}
+
+} // namespace
+
+TEST(GeoDistanceTest, ScalarKernelMatchesHaversine) {
+    auto store = randomStore(37);
+    std::vector<double> out(store.size());
+    store.distancesFrom(DistanceKernel::SCALAR, 12.97, 77.59, out.data());
+
+    for (size_t i = 0; i < store.size(); ++i) {
+        EXPECT_NEAR(out[i], haversineKm(12.97, 77.59, store.latitude(i), store.longitude(i)), 1e-6) << i;
+    }
+}
+
+TEST(GeoDistanceTest, Avx2KernelMatchesScalar) {
+    if (!isDistanceKernelSupported(DistanceKernel::AVX2)) {
+        GTEST_SKIP() << "CPU has no AVX2/FMA";
+    }
+
+    // Odd sizes exercise the scalar tail after the 4-wide loop
+    for (size_t count : {0u, 1u, 3u, 4u, 5u, 64u, 1001u}) {
+        auto store = randomStore(count);
+        std::vector<double> scalar(count);
+        std::vector<double> vector(count);
+        store.distancesFrom(DistanceKernel::SCALAR, -33.86, 151.21, scalar.data());
+        store.distancesFrom(DistanceKernel::AVX2, -33.86, 151.21, vector.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            // Within a millimetre; the polynomial approximations differ only in the last bits
+            EXPECT_NEAR(vector[i], scalar[i], 1e-6) << "count " << count << " index " << i;
+        }
+    }
+}
+
+TEST(GeoDistanceTest, SwapRemoveKeepsSlotsDense) {
+    CoordinateStore store;
+    store.add(1.0, 2.0);
+    store.add(3.0, 4.0);
+    store.add(5.0, 6.0);
+
+    store.swapRemove(0);
+    ASSERT_EQ(store.size(), 2u);
+    EXPECT_DOUBLE_EQ(store.latitude(0), 5.0);
+    EXPECT_DOUBLE_EQ(store.longitude(0), 6.0);
+
+    store.set(1, 7.0, 8.0);
+    std::vector<double> out(store.size());
+    store.distancesFrom(7.0, 8.0, out.data());
+    EXPECT_NEAR(out[1], 0.0, 1e-9);
+}
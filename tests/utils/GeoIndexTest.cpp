@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "utils/GeoIndex.h"
+
+using healthcare::utils::geo::GeoIndex;
+using healthcare::utils::geo::boundingBox;
+using healthcare::utils::geo::haversineKm;
+
+namespace {
+
+// Central Bengaluru and points at known offsets from it
+constexpr double kLatitude = 12.9716;
+constexpr double kLongitude = 77.5946;
+
+} // namespace
+
+TEST(GeoIndexTest, HaversineMatchesKnownDistances) {
+    EXPECT_DOUBLE_EQ(haversineKm(kLatitude, kLongitude, kLatitude, kLongitude), 0.0);
+    // One degree of latitude on the mean sphere
+    EXPECT_NEAR(haversineKm(10.0, 77.0, 11.0, 77.0), 111.195, 0.01);
+    // Bengaluru to Chennai, ~290 km
+    EXPECT_NEAR(haversineKm(kLatitude, kLongitude, 13.0827, 80.2707), 290.0, 5.0);
+}
+
+TEST(GeoIndexTest, BoundingBoxContainsTheRadius) {
+    auto box = boundingBox(kLatitude, kLongitude, 10.0);
+    EXPECT_TRUE(box.contains(kLatitude, kLongitude));
+    EXPECT_TRUE(box.contains(kLatitude + 0.08, kLongitude));
+    EXPECT_FALSE(box.contains(kLatitude + 0.2, kLongitude));
+
+    auto polar = boundingBox(89.95, 0.0, 50.0);
+    EXPECT_DOUBLE_EQ(polar.max_latitude, 90.0);
+    EXPECT_DOUBLE_EQ(polar.min_longitude, -180.0);
+    EXPECT_DOUBLE_EQ(polar.max_longitude, 180.0);
+}
+
+TEST(GeoIndexTest, RadiusQueryReturnsSortedHitsAcrossCells) {
+    GeoIndex index;
+    index.upsert("near", kLatitude + 0.01, kLongitude);
+    index.upsert("mid", kLatitude, kLongitude + 0.15);   // Different cell, ~16 km
+    index.upsert("far", kLatitude + 1.0, kLongitude);
+
+    auto hits = index.queryRadius(kLatitude, kLongitude, 20.0);
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].id, "near");
+    EXPECT_EQ(hits[1].id, "mid");
+    EXPECT_NEAR(hits[0].distance_km, 1.11, 0.01);
+    EXPECT_LT(hits[0].distance_km, hits[1].distance_km);
+}
+
+TEST(GeoIndexTest, UpsertMovesAndRemoveDetaches) {
+    GeoIndex index;
+    index.upsert("a", kLatitude, kLongitude);
+    index.upsert("b", kLatitude + 0.02, kLongitude);
+    index.upsert("a", kLatitude + 2.0, kLongitude);  // Moves out of range
+    EXPECT_EQ(index.size(), 2u);
+
+    auto hits = index.queryRadius(kLatitude, kLongitude, 5.0);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].id, "b");
+
+    EXPECT_TRUE(index.remove("b"));
+    EXPECT_FALSE(index.remove("b"));
+    EXPECT_TRUE(index.queryRadius(kLatitude, kLongitude, 5.0).empty());
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(GeoIndexTest, NearestExpandsRingsAndHonoursTheRadiusCap) {
+    GeoIndex index;
+    for (int i = 1; i <= 20; ++i) {
+        index.upsert("clinic-" + std::to_string(i), kLatitude + 0.05 * i, kLongitude);
+    }
+
+    auto nearest = index.nearest(kLatitude, kLongitude, 3, 100.0);
+    ASSERT_EQ(nearest.size(), 3u);
+    EXPECT_EQ(nearest[0].id, "clinic-1");
+    EXPECT_EQ(nearest[1].id, "clinic-2");
+    EXPECT_EQ(nearest[2].id, "clinic-3");
+
+    auto capped = index.nearest(kLatitude, kLongitude, 10, 12.0);  // Only the first two are within 12 km
+    ASSERT_EQ(capped.size(), 2u);
+    EXPECT_LE(capped.back().distance_km, 12.0);
+}
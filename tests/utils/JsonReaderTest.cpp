@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "utils/JsonReader.h"
+
+using healthcare::utils::JsonReader;
+using ValueType = healthcare::utils::JsonReader::ValueType;
+
+namespace {
+
+// True when JsonReader accepts exactly one value followed by whitespace
+bool accepts(std::string_view text) {
+    JsonReader reader(text);
+    return reader.skipValue() && reader.finish();
+}
+
+} // namespace
+
+TEST(JsonReaderTest, WalksObjectsInOrder) {
+    JsonReader reader(R"({"name": "Asha", "age": 34, "active": true, "tags": ["a"], "note": null})");
+    ASSERT_TRUE(reader.beginObject());
+
+    std::string_view key;
+    std::string name;
+    double age = 0;
+    bool active = false;
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "name");
+    ASSERT_TRUE(reader.readString(name));
+    ASSERT_TRUE(reader.nextMember(key));
+    ASSERT_TRUE(reader.readNumber(age));
+    ASSERT_TRUE(reader.nextMember(key));
+    ASSERT_TRUE(reader.readBool(active));
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(reader.peek(), ValueType::ARRAY);
+    ASSERT_TRUE(reader.skipValue());
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(reader.peek(), ValueType::NULL_VALUE);
+    ASSERT_TRUE(reader.skipValue());
+    EXPECT_FALSE(reader.nextMember(key));
+    EXPECT_TRUE(reader.finish());
+    EXPECT_FALSE(reader.failed());
+
+    EXPECT_EQ(name, "Asha");
+    EXPECT_EQ(age, 34);
+    EXPECT_TRUE(active);
+}
+
+TEST(JsonReaderTest, UnescapesStringsAndKeys) {
+    JsonReader reader(R"({"a\"b": "line\nbreak \u00e9 \ud83d\ude00"})");
+    ASSERT_TRUE(reader.beginObject());
+    std::string_view key;
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "a\"b");
+
+    std::string value;
+    ASSERT_TRUE(reader.readString(value));
+    EXPECT_EQ(value, "line\nbreak \xc3\xa9 \xf0\x9f\x98\x80");
+}
+
+TEST(JsonReaderTest, ArraysAndRawElements) {
+    JsonReader reader(R"([ {"id": 1, "x": [2, 3]} , "two", [] ])");
+    ASSERT_TRUE(reader.beginArray());
+
+    std::string_view raw;
+    ASSERT_TRUE(reader.nextElement());
+    ASSERT_TRUE(reader.readRaw(raw));
+    EXPECT_EQ(raw, R"({"id": 1, "x": [2, 3]})");
+
+    ASSERT_TRUE(reader.nextElement());
+    ASSERT_TRUE(reader.readRaw(raw));
+    EXPECT_EQ(raw, "\"two\"");
+
+    ASSERT_TRUE(reader.nextElement());
+    ASSERT_TRUE(reader.beginArray());
+    EXPECT_FALSE(reader.nextElement());
+    EXPECT_FALSE(reader.failed());
+
+    EXPECT_FALSE(reader.nextElement());
+    EXPECT_TRUE(reader.finish());
+
+    JsonReader empty("[]");
+    ASSERT_TRUE(empty.beginArray());
+    EXPECT_FALSE(empty.nextElement());
+    EXPECT_FALSE(empty.failed());
+}
+
+TEST(JsonReaderTest, ReportsErrorsWithOffsets) {
+    JsonReader reader(R"({"a": 1,})");
+    ASSERT_TRUE(reader.beginObject());
+    std::string_view key;
+    ASSERT_TRUE(reader.nextMember(key));
+    double value = 0;
+    ASSERT_TRUE(reader.readNumber(value));
+    EXPECT_FALSE(reader.nextMember(key));
+    EXPECT_TRUE(reader.failed());
+    EXPECT_NE(reader.error().find("offset"), std::string::npos) << reader.error();
+
+    JsonReader wrong_type(R"("text")");
+    EXPECT_FALSE(wrong_type.beginArray());
+    EXPECT_TRUE(wrong_type.failed());
+
+    JsonReader trailing("1 2");
+    ASSERT_TRUE(trailing.skipValue());
+    EXPECT_FALSE(trailing.finish());
+}
+
+TEST(JsonReaderTest, AcceptsTheSameGrammarAsNlohmann) {
+    const char* documents[] = {
+        "0", "-0.5e+10", "01", "1.", ".5", "-", "1e", "true", "tru", "null", "\"\"",
+        "\"\\u12\"", "\"\\x\"", "\"tab\there\"", "\"\xc3\xa9\"", "\"\xc3\"", "\"\xed\xa0\x80\"",
+        "[1,]", "[,1]", "[1 2]", "{\"a\":}", "{\"a\" 1}", "{1:2}", "{\"a\":1}", "[[[]]]", "  [ ]  ",
+    };
+    for (const char* document : documents) {
+        EXPECT_EQ(accepts(document), nlohmann::json::accept(document)) << document;
+    }
+
+    // Nesting is bounded so hostile bodies cannot exhaust the stack
+    auto nested = [](size_t depth) { return std::string(depth, '[') + std::string(depth, ']'); };
+    EXPECT_TRUE(accepts(nested(JsonReader::kMaxDepth / 2)));
+    EXPECT_FALSE(accepts(nested(100000)));
+}
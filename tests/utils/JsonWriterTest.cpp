@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include "models/Appointment.h"
+#include "models/Clinic.h"
+#include "models/Doctor.h"
+#include "models/User.h"
+#include "utils/JsonWriter.h"
+
+using healthcare::utils::JsonWriter;
+namespace models = healthcare::models;
+
+namespace {
+
+// Free text with the characters that need escaping or are multi-byte
+const char* kNotes = "Patient says \"sharp\" pain\nnear the left knee\t\\ \x01 \xe2\x80\x94 \xe0\xa4\xb8";
+
+const char* kIdA = "6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5f";
+const char* kIdB = "0a1b2c3d-4e5f-4a7b-8c9d-0e1f2a3b4c5d";
+
+template<typename T>
+std::string written(const T& value) {
+    std::string out;
+    JsonWriter writer(out);
+    writer.value(value);
+    return out;
+}
+
+template<typename Model>
+void expectSameBytes(const nlohmann::json& source) {
+    Model model;
+    model.fromJson(source);
+
+    std::string streamed;
+    JsonWriter writer(streamed);
+    model.writeJson(writer);
+    EXPECT_EQ(streamed, model.toJson().dump());
+}
+
+nlohmann::json userJson() {
+    return {
+        {"id", kIdA}, {"created_at", 1700000000}, {"updated_at", 1700000100}, {"is_deleted", false},
+        {"email", "patient@example.com"}, {"first_name", kNotes}, {"last_name", "Sharma"},
+        {"phone_number", "+919876543210"}, {"role", "USER"}, {"gender", "FEMALE"},
+        {"date_of_birth", "1990-04-12"}, {"address", kNotes}, {"city", "Lucknow"},
+        {"state", "Uttar Pradesh"}, {"pincode", "226001"}, {"profile_image_url", ""},
+        {"is_verified", true}, {"fcm_token", ""}
+    };
+}
+
+nlohmann::json doctorJson() {
+    return {
+        {"id", kIdA}, {"created_at", 1700000000}, {"updated_at", 1700000100}, {"is_deleted", false},
+        {"user_id", kIdB}, {"medical_license_number", "UP-12345"}, {"qualification", "MBBS, MD"},
+        {"years_of_experience", 12}, {"status", "VERIFIED"},
+        {"consultation_fee", 499.5}, {"consultation_duration_minutes", 15},
+        {"consultation_types", {"ONLINE", "OFFLINE"}}, {"rating", 4.3}, {"total_reviews", 128},
+        {"availability_pattern", "{\"MONDAY\":[\"09:00-13:00\"]}"}, {"is_available_today", true},
+        {"bio", kNotes}, {"languages", "hi,en"},
+        {"specializations", {{{"id", "cardio"}, {"name", "Cardiology"}, {"description", kNotes}, {"category", "MEDICAL"}}}},
+        {"clinic_ids", {kIdA, kIdB}},
+        {"documents", {{{"id", kIdB}, {"type", "medical_license"}, {"url", "https://cdn.example.com/l.pdf"},
+                        {"is_verified", true}, {"uploaded_at", 1700000000}, {"verified_at", 1700000200}}}}
+    };
+}
+
+nlohmann::json clinicJson() {
+    return {
+        {"id", kIdA}, {"created_at", 1700000000}, {"updated_at", 1700000100}, {"is_deleted", false},
+        {"name", "Sanjeevani Clinic"}, {"description", kNotes}, {"registration_number", "REG-778"},
+        {"status", "ACTIVE"},
+        {"contact_info", {{"phone_primary", "+915222345678"}, {"phone_secondary", ""},
+                          {"email", "desk@example.com"}, {"website", ""}}},
+        {"address", {{"street_address", kNotes}, {"landmark", "Near bus stand"}, {"city", "Lucknow"},
+                     {"state", "Uttar Pradesh"}, {"pincode", "226001"}, {"country", "India"},
+                     {"latitude", 26.8467}, {"longitude", 80.9462}}},
+        {"timezone", "Asia/Kolkata"},
+        {"working_hours", {{{"day_of_week", "MONDAY"}, {"start_time", "09:00"}, {"end_time", "18:00"},
+                            {"is_closed", false}, {"break_start", "13:00"}, {"break_end", "14:00"}}}},
+        {"facilities", {{{"name", "Pharmacy"}, {"description", kNotes}, {"is_available", true}}}},
+        {"services", {"General medicine", "Pathology"}}, {"logo_url", ""}, {"image_urls", nlohmann::json::array()},
+        {"rating", 4.1}, {"total_reviews", 57}, {"owner_id", kIdB}, {"doctor_ids", {kIdA}},
+        {"has_emergency_services", true}, {"emergency_contact", "108"}
+    };
+}
+
+nlohmann::json appointmentJson(bool cancelled) {
+    nlohmann::json json = {
+        {"id", kIdA}, {"created_at", 1700000000}, {"updated_at", 1700000100}, {"is_deleted", false},
+        {"user_id", kIdB}, {"doctor_id", kIdA}, {"clinic_id", kIdB},
+        {"appointment_date", 1700006400}, {"start_time", 1700038800}, {"end_time", 1700039700},
+        {"type", "OFFLINE"}, {"status", cancelled ? "CANCELLED" : "CONFIRMED"},
+        {"symptoms", kNotes}, {"notes", kNotes}, {"is_emergency", false},
+        {"patient_age", "34"}, {"patient_gender", "MALE"}, {"consultation_fee", 1250.75},
+        {"payment_info", {{"payment_id", "pay_29QQoUBi66xm2f"}, {"order_id", "order_9A33XWu170gUtm"},
+                          {"transaction_id", ""}, {"amount", 0.1}, {"currency", "INR"},
+                          {"status", "COMPLETED"}, {"payment_method", "UPI"}, {"paid_at", 1700000050},
+                          {"razorpay_signature", ""}}},
+        {"confirmation_code", "HC7K2M9Q1Z"}, {"booked_at", 1700000000}, {"confirmed_at", 1700000060},
+        {"consultation_info", {{"video_call_link", ""}, {"meeting_id", ""}, {"room_password", ""},
+                               {"call_started_at", 0}, {"call_ended_at", 0}, {"duration_minutes", 0},
+                               {"recording_url", ""}, {"call_notes", kNotes}}},
+        {"prescription_id", ""}, {"follow_up_date", 0}, {"follow_up_notes", kNotes}
+    };
+    if (cancelled) {
+        json["cancellation_info"] = {
+            {"reason", "PATIENT_REQUEST"}, {"description", kNotes}, {"cancelled_at", 1700000300},
+            {"cancelled_by_user_id", kIdB}, {"refund_amount", 1e7}, {"refund_id", ""},
+            {"is_refund_processed", true}
+        };
+    }
+    return json;
+}
+
+} // namespace
+
+TEST(JsonWriterTest, StringsEscapeLikeNlohmann) {
+    for (const char* text : {"", "plain", kNotes, "\x7f", "/slash", "\xf0\x9f\x98\x80"}) {
+        EXPECT_EQ(written(text), nlohmann::json(text).dump()) << text;
+    }
+}
+
+TEST(JsonWriterTest, NumbersFormatLikeNlohmann) {
+    for (double number : {0.0, -0.0, 0.1, 1.0, 299.0, 1250.75, 1e7, 1e21, 1.5e-7, 4.3, 26.8467,
+                          std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min()}) {
+        EXPECT_EQ(written(number), nlohmann::json(number).dump()) << number;
+    }
+    EXPECT_EQ(written(std::nan("")), "null");
+    EXPECT_EQ(written(std::numeric_limits<long long>::min()), nlohmann::json(std::numeric_limits<long long>::min()).dump());
+    EXPECT_EQ(written(std::numeric_limits<unsigned long long>::max()),
+              nlohmann::json(std::numeric_limits<unsigned long long>::max()).dump());
+}
+
+TEST(JsonWriterTest, ContainersAndRollback) {
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.field("a", 1);
+    auto checkpoint = writer.checkpoint();
+    writer.field("dropped", std::vector<std::string>{"x"});
+    writer.rollback(checkpoint);
+    writer.field("b", std::vector<std::string>{"x", "y"});
+    writer.key("c");
+    writer.beginArray();
+    writer.endArray();
+    writer.key("d");
+    writer.null();
+    writer.endObject();
+
+    EXPECT_EQ(out, R"({"a":1,"b":["x","y"],"c":[],"d":null})");
+}
+
+TEST(JsonWriterTest, ModelsMatchTheirDomDump) {
+    expectSameBytes<models::User>(userJson());
+    expectSameBytes<models::Doctor>(doctorJson());
+    expectSameBytes<models::Clinic>(clinicJson());
+    expectSameBytes<models::Appointment>(appointmentJson(false));
+    expectSameBytes<models::Appointment>(appointmentJson(true));
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "utils/Metrics.h"
+
+using healthcare::utils::LatencyHistogram;
+
+TEST(LatencyHistogramTest, SmallValuesGetExactBuckets) {
+    for (std::uint64_t micros = 0; micros < LatencyHistogram::kSubBuckets; ++micros) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(micros), micros);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(micros), micros);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguousAndBounded) {
+    // Every value lands in a bucket whose upper edge covers it within 1/kSubBuckets
+    std::uint64_t previous_upper = 0;
+    for (size_t index = 1; index < LatencyHistogram::kBucketCount; ++index) {
+        std::uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_EQ(LatencyHistogram::bucketIndex(previous_upper + 1), index);
+        EXPECT_EQ(LatencyHistogram::bucketIndex(upper), index);
+        EXPECT_LE(upper - previous_upper, (previous_upper + 1) / LatencyHistogram::kSubBuckets + 1);
+        previous_upper = upper;
+    }
+    EXPECT_EQ(previous_upper, LatencyHistogram::kMaxTrackableMicros);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~std::uint64_t{0}), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, QuantilesAcrossThreads) {
+    LatencyHistogram histogram;
+    std::thread worker([&] {
+        for (int i = 0; i < 99; ++i) histogram.recordMillis(1.0);
+    });
+    worker.join();
+    histogram.recordMillis(250.0);
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100u);
+    EXPECT_EQ(snapshot.max_us, 250000u);
+    EXPECT_EQ(snapshot.sum_ns, 99u * 1000000u + 250000000u);
+
+    auto p50 = snapshot.quantileMicros(0.5);
+    EXPECT_GE(p50, 1000u);
+    EXPECT_LE(p50, 1000u + 1000u / LatencyHistogram::kSubBuckets);
+    EXPECT_EQ(snapshot.quantileMicros(1.0), 250000u);  // Capped at the max seen
+    EXPECT_EQ(LatencyHistogram::Snapshot{}.quantileMicros(0.99), 0u);
+}
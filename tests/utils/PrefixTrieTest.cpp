@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "utils/PrefixTrie.h"
+
+using healthcare::utils::PrefixTrie;
+using healthcare::utils::Suggestion;
+
+namespace {
+
+std::vector<std::string> terms(const std::vector<Suggestion>& suggestions) {
+    std::vector<std::string> out;
+    for (const auto& suggestion : suggestions) out.push_back(suggestion.term);
+    return out;
+}
+
+} // namespace
+
+TEST(PrefixTrieTest, FoldKeyLowercasesAndCollapsesWhitespace) {
+    EXPECT_EQ(PrefixTrie::foldKey("  New   Delhi "), "new delhi");
+    EXPECT_EQ(PrefixTrie::foldKey("\t\n"), "");
+}
+
+TEST(PrefixTrieTest, CompletesByWeightWithDisplayForms) {
+    PrefixTrie trie;
+    trie.set("Cardiology", 50);
+    trie.set("Cardiac Surgery", 80);
+    trie.set("Card Clinic", 10);
+    trie.set("Dermatology", 100);
+
+    EXPECT_EQ(terms(trie.complete("CAR", 10)),
+              (std::vector<std::string>{"Cardiac Surgery", "Cardiology", "Card Clinic"}));
+    EXPECT_EQ(terms(trie.complete("card", 2)), (std::vector<std::string>{"Cardiac Surgery", "Cardiology"}));
+    EXPECT_EQ(terms(trie.complete("cardio", 10)), (std::vector<std::string>{"Cardiology"}));
+    EXPECT_TRUE(trie.complete("x", 10).empty());
+    EXPECT_EQ(trie.complete("", 1).front().term, "Dermatology");
+}
+
+TEST(PrefixTrieTest, SplitsEdgesWhenATermIsAPrefixOfAnother) {
+    PrefixTrie trie;
+    trie.set("neurology", 5);
+    trie.set("neuro", 7);
+    trie.set("neural", 3);
+
+    EXPECT_EQ(trie.size(), 3u);
+    EXPECT_EQ(trie.weightOf("neuro"), 7);
+    EXPECT_EQ(trie.weightOf("neurology"), 5);
+    EXPECT_FALSE(trie.weightOf("neur").has_value());
+    EXPECT_EQ(terms(trie.complete("neur", 10)), (std::vector<std::string>{"neuro", "neurology", "neural"}));
+}
+
+TEST(PrefixTrieTest, AddAccumulatesAndRemoveRefreshesCachedBest) {
+    PrefixTrie trie;
+    trie.add("ent", 2);
+    trie.add("ENT", 3);  // Same folded key; add() keeps the first display form
+    trie.set("endocrinology", 4);
+    EXPECT_EQ(trie.weightOf("ent"), 5);
+    EXPECT_EQ(trie.complete("en", 1).front().term, "ent");
+
+    EXPECT_TRUE(trie.remove("Ent"));
+    EXPECT_FALSE(trie.remove("ent"));
+    EXPECT_EQ(trie.size(), 1u);
+    auto remaining = trie.complete("en", 5);
+    ASSERT_EQ(remaining.size(), 1u);
+    EXPECT_EQ(remaining[0].term, "endocrinology");
+    EXPECT_EQ(remaining[0].weight, 4);
+}
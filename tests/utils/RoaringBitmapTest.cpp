@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include "utils/RoaringBitmap.h"
+
+using healthcare::utils::RoaringBitmap;
+
+namespace {
+
+// Values spread over three containers: sparse, dense and in between
+std::set<std::uint32_t> randomValues(std::uint32_t seed, size_t dense_count) {
+    std::mt19937 rng(seed);
+    std::set<std::uint32_t> values;
+    std::uniform_int_distribution<std::uint32_t> low(0, 0xFFFF);
+    for (size_t i = 0; i < 100; ++i) values.insert(low(rng));
+    for (size_t i = 0; i < dense_count; ++i) values.insert((1u << 16) | low(rng));
+    for (size_t i = 0; i < 3000; ++i) values.insert((7u << 16) | low(rng));
+    return values;
+}
+
+RoaringBitmap toBitmap(const std::set<std::uint32_t>& values) {
+    RoaringBitmap bitmap;
+    for (auto value : values) bitmap.add(value);
+    return bitmap;
+}
+
+} // namespace
+
+TEST(RoaringBitmapTest, AddContainsRemoveAcrossContainerKinds) {
+    auto values = randomValues(1, 20000);
+    auto bitmap = toBitmap(values);
+
+    EXPECT_EQ(bitmap.cardinality(), values.size());
+    EXPECT_EQ(bitmap.toVector(), std::vector<std::uint32_t>(values.begin(), values.end()));
+    for (auto value : values) {
+        ASSERT_TRUE(bitmap.contains(value)) << value;
+    }
+    EXPECT_FALSE(bitmap.contains(3u << 16));
+
+    // Shrinking the dense container below the array limit converts it back
+    std::vector<std::uint32_t> dense;
+    for (auto value : values) if ((value >> 16) == 1) dense.push_back(value);
+    for (size_t i = 0; i < dense.size() - 100; ++i) {
+        EXPECT_TRUE(bitmap.remove(dense[i]));
+        values.erase(dense[i]);
+    }
+    EXPECT_FALSE(bitmap.remove(dense[0]));
+    EXPECT_EQ(bitmap.toVector(), std::vector<std::uint32_t>(values.begin(), values.end()));
+}
+
+TEST(RoaringBitmapTest, SetOperationsMatchStdSet) {
+    auto left = randomValues(2, 20000);
+    auto right = randomValues(3, 2000);
+    auto a = toBitmap(left);
+    auto b = toBitmap(right);
+
+    std::vector<std::uint32_t> intersection;
+    std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(intersection));
+    std::vector<std::uint32_t> all;
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(all));
+
+    EXPECT_EQ((a & b).toVector(), intersection);
+    EXPECT_EQ((b & a).toVector(), intersection);
+    EXPECT_EQ(a.andCardinality(b), intersection.size());
+    EXPECT_EQ((a | b).toVector(), all);
+
+    RoaringBitmap c = a;
+    c &= b;
+    EXPECT_EQ(c.cardinality(), intersection.size());
+    c |= a;
+    EXPECT_EQ(c.cardinality(), left.size());
+}
+
+TEST(RoaringBitmapTest, EmptyIntersectionDropsContainers) {
+    RoaringBitmap a;
+    RoaringBitmap b;
+    a.add(1);
+    b.add(2);
+    EXPECT_TRUE((a & b).empty());
+    EXPECT_EQ(a.andCardinality(b), 0u);
+
+    std::vector<std::uint32_t> seen;
+    (a | b).forEach([&](std::uint32_t value) { seen.push_back(value); });
+    EXPECT_EQ(seen, (std::vector<std::uint32_t>{1, 2}));
+}
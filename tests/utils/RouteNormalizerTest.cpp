@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "utils/RouteNormalizer.h"
+
+using healthcare::utils::RouteNormalizer;
+
+// The normalizer is a process-wide singleton, so each test uses its own paths
+
+TEST(RouteNormalizerTest, ReplacesIdSegmentsAndDropsTheQuery) {
+    auto& routes = RouteNormalizer::getInstance();
+
+    auto id = routes.normalize("/api/v1/doctors/6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5f/slots?date=2026-01-01");
+    EXPECT_NE(id, RouteNormalizer::kOtherEndpoint);
+    EXPECT_EQ(routes.name(id), "/api/v1/doctors/:id/slots");
+
+    EXPECT_EQ(routes.normalize("/api/v1/doctors/6F1C2D3E-4B5A-4C7D-8E9F-0A1B2C3D4E5F/slots"), id);
+    EXPECT_EQ(routes.name(routes.normalize("/api/v1/appointments/12345")), "/api/v1/appointments/:id");
+
+    // Near-misses stay literal
+    EXPECT_EQ(routes.name(routes.normalize("/api/v1/doctors/12a45")), "/api/v1/doctors/12a45");
+}
+
+TEST(RouteNormalizerTest, LookupDoesNotIntern) {
+    auto& routes = RouteNormalizer::getInstance();
+    size_t before = routes.size();
+
+    EXPECT_EQ(routes.lookup("/lookup-test/unknown/42"), RouteNormalizer::kOtherEndpoint);
+    EXPECT_EQ(routes.size(), before);
+
+    auto id = routes.normalize("/lookup-test/unknown/7");
+    EXPECT_EQ(routes.size(), before + 1);
+    EXPECT_EQ(routes.lookup("/lookup-test/unknown/42"), id);
+}
+
+TEST(RouteNormalizerTest, OverlongPathsMapToOther) {
+    auto& routes = RouteNormalizer::getInstance();
+    std::string path = "/" + std::string(RouteNormalizer::kMaxPathLength, 'x');
+
+    auto overflows = routes.overflowCount();
+    EXPECT_EQ(routes.normalize(path), RouteNormalizer::kOtherEndpoint);
+    EXPECT_EQ(routes.name(RouteNormalizer::kOtherEndpoint), "(other)");
+    EXPECT_GT(routes.overflowCount(), overflows);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "utils/TextSearchIndex.h"
+
+using healthcare::utils::SearchOptions;
+using healthcare::utils::TextSearchIndex;
+
+namespace {
+
+void addDoctors(TextSearchIndex& index) {
+    index.upsert("d1", {{"Priya Sharma", 2.0f}, {"Cardiology", 1.0f}});
+    index.upsert("d2", {{"Rahul Verma", 2.0f}, {"Dermatology", 1.0f}});
+    index.upsert("d3", {{"Anita Cardoso", 2.0f}, {"Pediatrics", 1.0f}});
+}
+
+} // namespace
+
+TEST(TextSearchIndexTest, TokenizeLowercasesAndSplitsOnPunctuation) {
+    EXPECT_EQ(TextSearchIndex::tokenize("Dr. Priya-Sharma, MD"),
+              (std::vector<std::string>{"dr", "priya", "sharma", "md"}));
+    EXPECT_TRUE(TextSearchIndex::tokenize("  ,.-  ").empty());
+}
+
+TEST(TextSearchIndexTest, ExactMatchOutranksPrefixAndFieldWeightsCount) {
+    TextSearchIndex index;
+    addDoctors(index);
+
+    auto hits = index.search("cardio");
+    ASSERT_EQ(hits.size(), 2u);  // "cardiology" and "cardoso" both start near "cardio"
+    EXPECT_EQ(hits[0].id, "d1");
+
+    auto exact = index.search("sharma");
+    ASSERT_FALSE(exact.empty());
+    EXPECT_EQ(exact[0].id, "d1");
+    EXPECT_GT(exact[0].score, index.search("cardiology")[0].score);  // Name field weighs double
+}
+
+TEST(TextSearchIndexTest, EveryQueryTokenMustMatch) {
+    TextSearchIndex index;
+    addDoctors(index);
+
+    auto hits = index.search("rahul dermatology");
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].id, "d2");
+    EXPECT_TRUE(index.search("rahul pediatrics").empty());
+}
+
+TEST(TextSearchIndexTest, ToleratesTypos) {
+    TextSearchIndex index;
+    addDoctors(index);
+
+    SearchOptions options;
+    options.prefix_last_token = false;
+    auto hits = index.search("dermatolgy", options);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].id, "d2");
+
+    options.min_similarity = 0.95f;
+    EXPECT_TRUE(index.search("dermatolgy", options).empty());
+}
+
+TEST(TextSearchIndexTest, UpsertReplacesAndRemoveReleasesTokens) {
+    TextSearchIndex index;
+    addDoctors(index);
+    size_t tokens = index.tokenCount();
+
+    index.upsert("d2", {{"Rahul Verma", 2.0f}, {"Neurology", 1.0f}});
+    EXPECT_TRUE(index.search("dermatology").empty());
+    ASSERT_EQ(index.search("neurology").size(), 1u);
+    EXPECT_EQ(index.tokenCount(), tokens);
+
+    EXPECT_TRUE(index.remove("d2"));
+    EXPECT_FALSE(index.remove("d2"));
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_TRUE(index.search("rahul").empty());
+    EXPECT_EQ(index.tokenCount(), tokens - 3);
+}
+
+TEST(TextSearchIndexTest, LimitKeepsTheTopScores) {
+    TextSearchIndex index;
+    for (int i = 0; i < 30; ++i) {
+        index.upsert("doc-" + std::to_string(i), {{"general medicine", 1.0f + (i == 17 ? 1.0f : 0.0f)}});
+    }
+
+    SearchOptions options;
+    options.limit = 5;
+    auto hits = index.search("general", options);
+    ASSERT_EQ(hits.size(), 5u);
+    EXPECT_EQ(hits[0].id, "doc-17");
+    for (size_t i = 1; i < hits.size(); ++i) {
+        EXPECT_LE(hits[i].score, hits[i - 1].score);
+    }
+}
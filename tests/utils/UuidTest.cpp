@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <unordered_set>
+#include "utils/Uuid.h"
+
+using healthcare::utils::Uuid;
+
+TEST(UuidTest, ParseAndFormatRoundTrip) {
+    auto uuid = Uuid::parse("6F1C2D3E-4b5a-4c7d-8e9f-0a1b2c3d4e5f");
+    ASSERT_TRUE(uuid.has_value());
+    EXPECT_EQ(uuid->toString(), "6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5f");
+
+    auto bytes = uuid->bytes();
+    EXPECT_EQ(bytes[0], 0x6f);
+    EXPECT_EQ(bytes[15], 0x5f);
+    EXPECT_EQ(Uuid(bytes), *uuid);
+}
+
+TEST(UuidTest, RejectsMalformedText) {
+    EXPECT_FALSE(Uuid::parse("").has_value());
+    EXPECT_FALSE(Uuid::parse("6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5").has_value());    // Short
+    EXPECT_FALSE(Uuid::parse("6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5f0").has_value());  // Long
+    EXPECT_FALSE(Uuid::parse("6f1c2d3e4b5a-4c7d-8e9f-0a1b2c3d4e5f-").has_value());   // Misplaced dash
+    EXPECT_FALSE(Uuid::parse("6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e5g").has_value());   // Not hex
+    EXPECT_FALSE(Uuid::parse("6f1c2d3e-4b5a-4c7d-8e9f-0a1b2c3d4e:f").has_value());   // Just past '9'
+    EXPECT_THROW(Uuid::fromString("not-a-uuid"), std::invalid_argument);
+}
+
+TEST(UuidTest, OrderingMatchesTextOrdering) {
+    auto low = Uuid::fromString("00000000-0000-0000-0000-0000000000ff");
+    auto mid = Uuid::fromString("00000000-0000-0000-0100-000000000000");
+    auto high = Uuid::fromString("01000000-0000-0000-0000-000000000000");
+    EXPECT_LT(low, mid);
+    EXPECT_LT(mid, high);
+    EXPECT_FALSE(high < low);
+    EXPECT_TRUE(Uuid().isNil());
+}
+
+TEST(UuidTest, GenerateProducesDistinctVersion4Ids) {
+    std::unordered_set<Uuid> seen;
+    for (int i = 0; i < 1000; ++i) {
+        auto uuid = Uuid::generate();
+        auto text = uuid.toString();
+        EXPECT_EQ(text[14], '4');
+        EXPECT_NE(std::string("89ab").find(text[19]), std::string::npos) << text;
+        EXPECT_EQ(Uuid::parse(text), uuid);
+        EXPECT_TRUE(seen.insert(uuid).second);
+    }
+}